@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotcommands/Cbor.h>
+#include <aws/iotcommands/Exports.h>
+
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <memory>
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        class CommandExecutionEvent;
+        class BorrowedCommandExecutionEventBuffer;
+
+        /**
+         * A command execution whose execution id, content type and payload are not copied out of the incoming MQTT
+         * message.
+         *
+         * The cursors of a borrowed event are only valid while the stream handler runs.  A handler that needs the
+         * execution afterwards calls Detach(), which moves the data into one reference-counted buffer shared by the
+         * event and all its copies.
+         */
+        class AWS_IOTCOMMANDS_API BorrowedCommandExecutionEvent final
+        {
+          public:
+            BorrowedCommandExecutionEvent() = default;
+
+            /**
+             * @param executionId unique ID of the command execution
+             * @param payload opaque command payload
+             * @param contentType data format of the payload, if known
+             * @param timeout number of seconds before the execution times out, if known
+             */
+            BorrowedCommandExecutionEvent(
+                Aws::Crt::ByteCursor executionId,
+                Aws::Crt::ByteCursor payload,
+                const Aws::Crt::Optional<Aws::Crt::ByteCursor> &contentType,
+                const Aws::Crt::Optional<int32_t> &timeout);
+
+            /**
+             * @return unique ID of the command execution
+             */
+            Aws::Crt::ByteCursor GetExecutionId() const { return m_executionId; }
+
+            /**
+             * @return opaque data containing instructions sent from the IoT commands service
+             */
+            Aws::Crt::ByteCursor GetPayload() const { return m_payload; }
+
+            /**
+             * @return a view over the payload of a command received on the CBOR request topic
+             */
+            CborView GetCborPayload() const { return CborView(m_payload); }
+
+            /**
+             * @return data format of the payload, if the message carried one
+             */
+            const Aws::Crt::Optional<Aws::Crt::ByteCursor> &GetContentType() const { return m_contentType; }
+
+            /**
+             * @return number of seconds before the IoT commands service decides that the execution timed out, if the
+             * message carried an expiry interval
+             */
+            const Aws::Crt::Optional<int32_t> &GetTimeout() const { return m_timeout; }
+
+            /**
+             * @return true if the event owns its data
+             */
+            bool IsDetached() const { return m_buffer != nullptr; }
+
+            /**
+             * Takes ownership of the event's data, so that the event and its copies stay valid after the stream
+             * handler returns.  The data is copied once into a single reference-counted buffer; detaching an event
+             * that is already detached does nothing.
+             *
+             * @param allocator memory allocator to use for the buffer
+             *
+             * @return success/failure
+             */
+            bool Detach(Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * @return a copy of the event as the owning model type
+             */
+            CommandExecutionEvent ToEvent() const;
+
+          private:
+            Aws::Crt::ByteCursor m_executionId{0, nullptr};
+            Aws::Crt::ByteCursor m_payload{0, nullptr};
+            Aws::Crt::Optional<Aws::Crt::ByteCursor> m_contentType;
+            Aws::Crt::Optional<int32_t> m_timeout;
+
+            std::shared_ptr<BorrowedCommandExecutionEventBuffer> m_buffer;
+        };
+
+    } // namespace Iotcommands
+} // namespace Aws
@@ -0,0 +1,302 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotcommands/Exports.h>
+
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <functional>
+
+struct aws_cbor_decoder;
+struct aws_cbor_encoder;
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        /**
+         * Type of a CBOR (RFC 8949) data item.  Tags are skipped and report the type of the tagged item.
+         */
+        enum class CborType
+        {
+            Invalid,
+            UnsignedInteger,
+            NegativeInteger,
+            ByteString,
+            TextString,
+            Array,
+            Map,
+            Bool,
+            Null,
+            Undefined,
+            Float,
+            Break,
+        };
+
+        /**
+         * Key of a CBOR map member; constructible from either string type used by the service models.
+         */
+        struct AWS_IOTCOMMANDS_API CborKey
+        {
+            CborKey(const char *key) noexcept;
+            CborKey(const Aws::Crt::String &key) noexcept;
+
+            struct aws_byte_cursor cursor;
+        };
+
+        /**
+         * Streaming CBOR writer over the aws-c-common encoder.  Integers, lengths and floats use the shortest
+         * encoding that preserves their value (integral floats are written as integers), and byte strings are written
+         * as raw bytes.
+         *
+         * Definite-length containers are written with WriteArrayStart()/WriteMapStart() followed by exactly the
+         * announced number of items (for maps, key and value pairs); they need no end marker.  Indefinite-length
+         * containers are closed with WriteBreak().
+         *
+         * The With*() functions write one key/value pair of the current map and mirror the JsonWriter interface used
+         * by the service models.
+         */
+        class AWS_IOTCOMMANDS_API CborWriter final
+        {
+          public:
+            /**
+             * @param allocator memory allocator for the encoder and its output buffer
+             */
+            explicit CborWriter(Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            ~CborWriter();
+
+            CborWriter(const CborWriter &) = delete;
+            CborWriter(CborWriter &&) = delete;
+            CborWriter &operator=(const CborWriter &) = delete;
+            CborWriter &operator=(CborWriter &&) = delete;
+
+            CborWriter &WriteUInt64(uint64_t value);
+            CborWriter &WriteInt64(int64_t value);
+            CborWriter &WriteDouble(double value);
+            CborWriter &WriteBool(bool value);
+            CborWriter &WriteNull();
+
+            CborWriter &WriteText(struct aws_byte_cursor value);
+            CborWriter &WriteText(const Aws::Crt::String &value);
+            CborWriter &WriteText(const char *value);
+
+            CborWriter &WriteBytes(struct aws_byte_cursor value);
+
+            CborWriter &WriteArrayStart(size_t count);
+            CborWriter &WriteMapStart(size_t count);
+            CborWriter &WriteIndefiniteArrayStart();
+            CborWriter &WriteIndefiniteMapStart();
+            CborWriter &WriteBreak();
+
+            CborWriter &WithString(const CborKey &key, const Aws::Crt::String &value);
+            CborWriter &WithString(const CborKey &key, struct aws_byte_cursor value);
+            CborWriter &WithBool(const CborKey &key, bool value);
+            CborWriter &WithInt64(const CborKey &key, int64_t value);
+            CborWriter &WithDouble(const CborKey &key, double value);
+            CborWriter &WithBytes(const CborKey &key, struct aws_byte_cursor value);
+            CborWriter &WithBytes(const CborKey &key, const Aws::Crt::Vector<uint8_t> &value);
+
+            /**
+             * Writes the key of a map valued member, followed by the head of a map with count pairs.
+             */
+            CborWriter &WithMapStart(const CborKey &key, size_t count);
+
+            /**
+             * @return a cursor over the CBOR written so far, valid until the writer is modified
+             */
+            struct aws_byte_cursor ToCursor() const noexcept;
+
+            /**
+             * @return false if the encoder could not be created
+             */
+            explicit operator bool() const noexcept { return m_encoder != nullptr; }
+
+          private:
+            struct aws_cbor_encoder *m_encoder;
+        };
+
+        /**
+         * Pull parser over a buffer of CBOR data items, on top of the aws-c-common decoder.  Text and byte strings are
+         * returned as cursors into the buffer, so nothing is copied.  Indefinite-length strings, which would have to
+         * be reassembled, are rejected.
+         *
+         * Each Read*() function consumes one data item and returns false if the next item is malformed or of a
+         * different type, in which case nothing is consumed.  An integer that does not fit the requested type is
+         * consumed nonetheless.
+         */
+        class AWS_IOTCOMMANDS_API CborReader final
+        {
+          public:
+            /**
+             * Count reported by ReadArrayStart()/ReadMapStart() for an indefinite-length container, whose items are
+             * followed by a break.
+             */
+            static constexpr uint64_t INDEFINITE_LENGTH = UINT64_MAX;
+
+            /**
+             * @param data encoded data items; must outlive the reader and any cursor it returns
+             * @param allocator memory allocator for the decoder
+             */
+            explicit CborReader(
+                struct aws_byte_cursor data,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            ~CborReader();
+
+            CborReader(const CborReader &) = delete;
+            CborReader(CborReader &&) = delete;
+            CborReader &operator=(const CborReader &) = delete;
+            CborReader &operator=(CborReader &&) = delete;
+
+            /**
+             * Consumes any tags in front of the next data item.
+             *
+             * @return the type of the next data item, or CborType::Invalid at the end of the data
+             */
+            CborType PeekType();
+
+            bool ReadUInt64(uint64_t &value);
+
+            /**
+             * Reads an unsigned or negative integer that fits into an int64_t.
+             */
+            bool ReadInt64(int64_t &value);
+
+            /**
+             * Reads a float or an integer.
+             */
+            bool ReadDouble(double &value);
+
+            bool ReadBool(bool &value);
+            bool ReadNull();
+
+            bool ReadText(struct aws_byte_cursor &value);
+            bool ReadBytes(struct aws_byte_cursor &value);
+
+            /**
+             * @param count number of elements, or INDEFINITE_LENGTH
+             */
+            bool ReadArrayStart(uint64_t &count);
+
+            /**
+             * @param count number of key/value pairs, or INDEFINITE_LENGTH
+             */
+            bool ReadMapStart(uint64_t &count);
+
+            bool ReadBreak();
+
+            /**
+             * Consumes the next data item, including everything nested in it.
+             */
+            bool SkipItem();
+
+            /**
+             * Consumes the next data item, including everything nested in it.
+             *
+             * @param item set to the encoding of the item, excluding tags already consumed by PeekType()
+             */
+            bool ReadItem(struct aws_byte_cursor &item);
+
+            /**
+             * @return true if all data has been consumed
+             */
+            bool IsDone();
+
+          private:
+            bool SkipTags();
+            void OnConsumed();
+
+            struct aws_byte_cursor m_data;
+            struct aws_cbor_decoder *m_decoder;
+
+            /* Offset of the first byte not consumed yet; the decoder does not count an item cached by a peek */
+            size_t m_offset;
+        };
+
+        /**
+         * Read-only view over one encoded CBOR data item, e.g. a command payload received on the CBOR request topic.
+         *
+         * The view validates the item once when created and then navigates the encoding in place, with a short-lived
+         * CborReader per call; strings are returned as cursors into the payload, which must outlive the view.  Map
+         * lookups scan the map, which is cheap for the small maps typical of command payloads.
+         */
+        class AWS_IOTCOMMANDS_API CborView final
+        {
+          public:
+            CborView() noexcept = default;
+
+            /**
+             * @param data encoded data; the view covers its first data item
+             * @param allocator memory allocator for the readers the view creates
+             */
+            explicit CborView(struct aws_byte_cursor data, Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * @return false if the data did not start with a well-formed data item, or for a missing member/element
+             */
+            bool IsValid() const noexcept { return m_item.ptr != nullptr; }
+
+            CborType GetType() const;
+
+            bool IsNull() const { return GetType() == CborType::Null; }
+
+            Aws::Crt::Optional<uint64_t> AsUInt64() const;
+            Aws::Crt::Optional<int64_t> AsInt64() const;
+            Aws::Crt::Optional<double> AsDouble() const;
+            Aws::Crt::Optional<bool> AsBool() const;
+            Aws::Crt::Optional<struct aws_byte_cursor> AsText() const;
+            Aws::Crt::Optional<struct aws_byte_cursor> AsBytes() const;
+
+            /**
+             * @return a copy of a text string item
+             */
+            Aws::Crt::Optional<Aws::Crt::String> AsString() const;
+
+            /**
+             * @return the number of elements of an array or key/value pairs of a map; 0 for any other item
+             */
+            size_t GetLength() const;
+
+            /**
+             * @return the value of the map member with a text key, or an invalid view if there is none
+             */
+            CborView GetMember(const CborKey &key) const;
+
+            bool ValueExists(const CborKey &key) const { return GetMember(key).IsValid(); }
+
+            /**
+             * @return the array element at index, or an invalid view if there is none
+             */
+            CborView GetElement(size_t index) const;
+
+            /**
+             * Calls visitor for each key/value pair of a map, in encoding order, until it returns false.
+             */
+            void ForEachMember(const std::function<bool(const CborView &key, const CborView &value)> &visitor) const;
+
+            /**
+             * Calls visitor for each element of an array, in order, until it returns false.
+             */
+            void ForEachElement(const std::function<bool(const CborView &element)> &visitor) const;
+
+            /**
+             * @return the encoding of the item
+             */
+            struct aws_byte_cursor GetEncoded() const noexcept { return m_item; }
+
+          private:
+            static CborView FromItem(struct aws_byte_cursor item, Aws::Crt::Allocator *allocator);
+
+            struct aws_byte_cursor m_item = {0, nullptr};
+            Aws::Crt::Allocator *m_allocator = nullptr;
+        };
+
+    } // namespace Iotcommands
+} // namespace Aws
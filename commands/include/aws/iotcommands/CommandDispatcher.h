@@ -0,0 +1,233 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotcommands/BorrowedCommandExecutionEvent.h>
+#include <aws/iotcommands/CommandExecutionResult.h>
+#include <aws/iotcommands/CommandExecutionStatus.h>
+#include <aws/iotcommands/DeviceType.h>
+#include <aws/iotcommands/Exports.h>
+#include <aws/iotcommands/IotCommandsClientV2.h>
+#include <aws/iotcommands/StatusReason.h>
+
+#include <aws/crt/Types.h>
+
+#include <functional>
+#include <memory>
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        class CommandDispatcherState;
+
+        /**
+         * Request topic a command execution stream subscribes to.
+         */
+        enum class CommandPayloadFormat
+        {
+            Json,
+            Cbor,
+            Generic,
+        };
+
+        /**
+         * Reports the final status of a command execution to the dispatcher.  Must be invoked once per execution,
+         * from any thread, with a terminal status (SUCCEEDED, FAILED, REJECTED or TIMED_OUT); further invocations are
+         * ignored.  A status reason without fields and an empty result are not sent.
+         */
+        using CommandCompletionCallback = std::function<void(
+            CommandExecutionStatus status,
+            const StatusReason &statusReason,
+            const Aws::Crt::Map<Aws::Crt::String, CommandExecutionResult> &result)>;
+
+        /**
+         * Executes a command on one of the dispatcher's worker threads.  The execution is detached, so it may be kept
+         * beyond the call.  The handler may return before completing the execution; the execution counts against the
+         * handler's concurrency limit until the completion callback has been invoked.
+         */
+        using CommandHandler = std::function<
+            void(const BorrowedCommandExecutionEvent &execution, const CommandCompletionCallback &complete)>;
+
+        /**
+         * Chooses the handler for a command execution by name.  Invoked on the thread delivering the execution,
+         * before its payload has been copied, so it must not keep the execution.
+         */
+        using CommandRouter = std::function<Aws::Crt::String(const BorrowedCommandExecutionEvent &execution)>;
+
+        /**
+         * Receives the error code of a failed operation of the dispatcher, e.g. a status update the service rejected.
+         */
+        using CommandDispatcherErrorHandler = std::function<void(int errorCode)>;
+
+        /**
+         * Configuration options for a CommandDispatcher.
+         */
+        class AWS_IOTCOMMANDS_API CommandDispatcherOptions final
+        {
+          public:
+            CommandDispatcherOptions();
+
+            /**
+             * Sets the request topics to receive command executions on.  Defaults to all of them.
+             *
+             * @param payloadFormats payload formats to open a stream for
+             * @return reference to this options object
+             */
+            CommandDispatcherOptions &WithPayloadFormats(const Aws::Crt::Vector<CommandPayloadFormat> &payloadFormats);
+
+            /**
+             * Sets the number of worker threads running command handlers.  Defaults to one.
+             *
+             * @param threadCount number of worker threads; at least one is started
+             * @return reference to this options object
+             */
+            CommandDispatcherOptions &WithThreadCount(size_t threadCount);
+
+            /**
+             * Sets the number of command executions that may wait for a handler.  Executions arriving while the queue
+             * is full are reported as FAILED.  Defaults to 64.
+             *
+             * @param maxQueuedExecutions maximum number of queued executions, excluding running ones
+             * @return reference to this options object
+             */
+            CommandDispatcherOptions &WithMaxQueuedExecutions(size_t maxQueuedExecutions);
+
+            /**
+             * Sets how many finished execution ids are remembered to recognize redelivered executions.  Executions
+             * that are queued or running are always recognized.  Defaults to 256.
+             *
+             * @param deduplicationWindow number of finished execution ids to remember
+             * @return reference to this options object
+             */
+            CommandDispatcherOptions &WithDeduplicationWindow(size_t deduplicationWindow);
+
+            /**
+             * Sets whether executions are updated to IN_PROGRESS before their handler runs.  Defaults to false.
+             *
+             * @param reportInProgress true to report IN_PROGRESS
+             * @return reference to this options object
+             */
+            CommandDispatcherOptions &WithInProgressReports(bool reportInProgress);
+
+            const Aws::Crt::Vector<CommandPayloadFormat> &GetPayloadFormats() const { return m_payloadFormats; }
+
+            size_t GetThreadCount() const { return m_threadCount; }
+
+            size_t GetMaxQueuedExecutions() const { return m_maxQueuedExecutions; }
+
+            size_t GetDeduplicationWindow() const { return m_deduplicationWindow; }
+
+            bool GetInProgressReports() const { return m_reportInProgress; }
+
+          private:
+            Aws::Crt::Vector<CommandPayloadFormat> m_payloadFormats;
+            size_t m_threadCount;
+            size_t m_maxQueuedExecutions;
+            size_t m_deduplicationWindow;
+            bool m_reportInProgress;
+        };
+
+        /**
+         * Receives the command executions of a device and runs them on a pool of worker threads.
+         *
+         * Each execution is routed to a handler by name; by default the name is the execution's content type, or
+         * application/json and application/cbor for executions without one received on the JSON and CBOR topics.
+         * Every handler has a concurrency limit; executions beyond it wait in a shared, bounded queue while
+         * executions of other handlers proceed.  Executions without a handler go to the default handler, or are
+         * rejected if there is none.
+         *
+         * Executions are received as borrowed events, so redelivered executions, which are recognized by their
+         * execution id, and executions whose message expiry interval has run out are dropped without copying their
+         * payload.  Executions that expire while queued are dropped without running; the service times them out.
+         * The final status of every execution that ran is reported to the service through a CommandStatusReporter.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTCOMMANDS_API CommandDispatcher final
+        {
+          public:
+            /**
+             * @param client service client used to receive and update command executions
+             * @param deviceType type of the device executing commands
+             * @param deviceId IoT thing name or MQTT client id of the device
+             * @param options dispatcher configuration
+             * @param allocator memory allocator to use for dispatcher state
+             */
+            CommandDispatcher(
+                std::shared_ptr<IClientV2> client,
+                DeviceType deviceType,
+                const Aws::Crt::String &deviceId,
+                const CommandDispatcherOptions &options = CommandDispatcherOptions(),
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * Stops the dispatcher, drops queued executions and joins the worker threads.  Executions that are still
+             * running can still be completed and are reported to the service.
+             */
+            ~CommandDispatcher();
+
+            CommandDispatcher(const CommandDispatcher &) = delete;
+            CommandDispatcher &operator=(const CommandDispatcher &) = delete;
+
+            /**
+             * Registers a handler, replacing any previous handler of the same name.
+             *
+             * @param name name the router returns for executions of this handler
+             * @param handler function object executing commands
+             * @param maxConcurrency maximum number of executions of this handler running at once; at least one
+             */
+            void RegisterHandler(
+                const Aws::Crt::String &name,
+                const CommandHandler &handler,
+                size_t maxConcurrency = 1);
+
+            /**
+             * Sets the handler for executions routed to a name without a registered handler.
+             *
+             * @param handler function object executing commands
+             * @param maxConcurrency maximum number of executions of this handler running at once; at least one
+             */
+            void SetDefaultHandler(const CommandHandler &handler, size_t maxConcurrency = 1);
+
+            /**
+             * Replaces the content type based routing, e.g. with one reading a handler name from the payload.
+             *
+             * @param router function object choosing the handler of an execution
+             */
+            void SetRouter(const CommandRouter &router);
+
+            /**
+             * Sets the function object invoked when an operation of the dispatcher fails.
+             *
+             * @param handler function object receiving the error code
+             */
+            void SetErrorHandler(const CommandDispatcherErrorHandler &handler);
+
+            /**
+             * Opens the command execution streams.  Starting a dispatcher that is already started does nothing.
+             *
+             * @return success/failure
+             */
+            bool Start();
+
+            /**
+             * Closes the streams.  Queued and running executions are not affected.
+             */
+            void Stop();
+
+            /**
+             * @return the number of executions that are queued or running
+             */
+            size_t GetActiveExecutionCount() const;
+
+          private:
+            std::shared_ptr<CommandDispatcherState> m_state;
+        };
+
+    } // namespace Iotcommands
+} // namespace Aws
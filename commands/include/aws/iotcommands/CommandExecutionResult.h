@@ -13,8 +13,14 @@
 
 namespace Aws
 {
+    namespace Iotdevicecommon
+    {
+        class JsonWriter;
+    }
+
     namespace Iotcommands
     {
+        class CborWriter;
 
         /**
          * The result value of the command execution. The device can use the result field to share additional details
@@ -31,6 +37,13 @@ namespace Aws
 
             void SerializeToObject(Crt::JsonObject &doc) const;
 
+            void SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const;
+
+            /**
+             * Writes the result as a CBOR map.
+             */
+            void SerializeTo(CborWriter &writer) const;
+
             /**
              * An attribute of type String.
              *
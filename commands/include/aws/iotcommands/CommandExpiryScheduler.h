@@ -0,0 +1,226 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotcommands/DeviceType.h>
+#include <aws/iotcommands/Exports.h>
+#include <aws/iotcommands/IotCommandsClientV2.h>
+
+#include <aws/crt/Types.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Io
+        {
+            class EventLoopGroup;
+        }
+    } // namespace Crt
+
+    namespace Iotcommands
+    {
+
+        class CommandStatusReporter;
+        class CommandExpirySchedulerState;
+
+        /**
+         * Shared flag through which a command handler learns that its execution has been abandoned.  Copies refer to
+         * the same flag.
+         */
+        class AWS_IOTCOMMANDS_API CommandCancellationToken final
+        {
+          public:
+            CommandCancellationToken();
+
+            /**
+             * @return true once the execution has been cancelled
+             */
+            bool IsCancelled() const noexcept { return m_cancelled->load(); }
+
+            /**
+             * Cancels the execution.  Cancelling more than once has no further effect.
+             */
+            void Cancel() noexcept { m_cancelled->store(true); }
+
+          private:
+            std::shared_ptr<std::atomic<bool>> m_cancelled;
+        };
+
+        /**
+         * Configuration options for a CommandExpiryScheduler.
+         */
+        class AWS_IOTCOMMANDS_API CommandExpirySchedulerOptions final
+        {
+          public:
+            CommandExpirySchedulerOptions() = default;
+
+            /**
+             * Sets the resolution of the timer wheel.  Executions expire at most one tick after their deadline, never
+             * before it.  Defaults to 100 milliseconds.
+             *
+             * @param tickInterval time between two ticks of the wheel
+             * @return reference to this options object
+             */
+            CommandExpirySchedulerOptions &WithTickInterval(std::chrono::milliseconds tickInterval);
+
+            /**
+             * Sets the event loop group whose next event loop runs the timer wheel.  The group must outlive the
+             * scheduler.  Without an event loop group the wheel only turns when ExpireDue is called, and a clock must
+             * be set.
+             *
+             * @param eventLoopGroup event loop group to schedule the wheel on
+             * @return reference to this options object
+             */
+            CommandExpirySchedulerOptions &WithEventLoopGroup(Aws::Crt::Io::EventLoopGroup &eventLoopGroup);
+
+            /**
+             * Sets the reporter used to send TIMED_OUT updates.  Sharing the reporter that sends the executions' other
+             * updates keeps a TIMED_OUT update from racing them.  Defaults to a reporter of the scheduler's own.
+             *
+             * @param statusReporter reporter to send TIMED_OUT updates with
+             * @return reference to this options object
+             */
+            CommandExpirySchedulerOptions &WithStatusReporter(std::shared_ptr<CommandStatusReporter> statusReporter);
+
+            /**
+             * Sets the clock that timeouts are counted on by a scheduler without an event loop group, which needs
+             * one.  A scheduler with an event loop group uses the clock of its event loop instead.
+             *
+             * @param clock function returning a monotonic time in nanoseconds
+             * @return reference to this options object
+             */
+            CommandExpirySchedulerOptions &WithClock(std::function<uint64_t()> clock);
+
+            std::chrono::milliseconds GetTickInterval() const { return m_tickInterval; }
+
+            Aws::Crt::Io::EventLoopGroup *GetEventLoopGroup() const { return m_eventLoopGroup; }
+
+            const std::shared_ptr<CommandStatusReporter> &GetStatusReporter() const { return m_statusReporter; }
+
+            const std::function<uint64_t()> &GetClock() const { return m_clock; }
+
+          private:
+            std::chrono::milliseconds m_tickInterval{100};
+            Aws::Crt::Io::EventLoopGroup *m_eventLoopGroup = nullptr;
+            std::shared_ptr<CommandStatusReporter> m_statusReporter;
+            std::function<uint64_t()> m_clock;
+        };
+
+        /**
+         * Enforces the timeouts of command executions.  When an execution's deadline passes before it is untracked,
+         * its cancellation token is cancelled and the execution is updated to TIMED_OUT.
+         *
+         * Deadlines are kept in a hierarchical timer wheel of four levels of 64 slots, which turns on one CRT event
+         * loop while any execution is tracked.  Tracking, untracking and expiring an execution take constant time,
+         * and an execution moves down a level at most three times before it expires, so tens of thousands of
+         * executions cost one scheduled task rather than a timer or thread each.  Deadlines beyond the range of the
+         * wheel, 64^4 ticks, are re-filed when the top level comes around.
+         *
+         * All functions are thread-safe.  Tokens are cancelled and TIMED_OUT updates sent on the event loop thread, or
+         * on the thread calling ExpireDue if the scheduler has no event loop.
+         */
+        class AWS_IOTCOMMANDS_API CommandExpiryScheduler final
+        {
+          public:
+            /**
+             * @param client service client used to send TIMED_OUT updates if the options have no status reporter
+             * @param deviceType type of the device executing the tracked commands
+             * @param deviceId IoT thing name or MQTT client id of the device
+             * @param options expiry configuration
+             * @param allocator memory allocator to use for scheduler state
+             */
+            CommandExpiryScheduler(
+                std::shared_ptr<IClientV2> client,
+                DeviceType deviceType,
+                const Aws::Crt::String &deviceId,
+                const CommandExpirySchedulerOptions &options,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * Stops expiring executions.  Tokens of tracked executions are not cancelled.
+             */
+            ~CommandExpiryScheduler();
+
+            CommandExpiryScheduler(const CommandExpiryScheduler &) = delete;
+            CommandExpiryScheduler &operator=(const CommandExpiryScheduler &) = delete;
+
+            /**
+             * Starts enforcing the timeout of a command execution.  Tracking an execution that is already tracked
+             * replaces its deadline and token.
+             *
+             * @param executionId id of the command execution
+             * @param timeout time from now until the execution expires
+             * @param token token to cancel when the execution expires
+             *
+             * @return success/failure
+             */
+            bool Track(
+                const Aws::Crt::String &executionId,
+                std::chrono::milliseconds timeout,
+                const CommandCancellationToken &token);
+
+            /**
+             * Starts enforcing the timeout of a received command execution, counted from now.  Executions without a
+             * timeout are not tracked.
+             *
+             * @param execution command execution; its timeout is the remaining message expiry interval
+             * @param token token to cancel when the execution expires
+             *
+             * @return success/failure
+             */
+            bool Track(const CommandExecutionEvent &execution, const CommandCancellationToken &token);
+
+            /**
+             * Starts enforcing the timeout of a borrowed command execution, counted from now.  Executions without a
+             * timeout are not tracked.
+             *
+             * @param execution command execution; its timeout is the remaining message expiry interval
+             * @param token token to cancel when the execution expires
+             *
+             * @return success/failure
+             */
+            bool Track(const BorrowedCommandExecutionEvent &execution, const CommandCancellationToken &token);
+
+            /**
+             * Stops enforcing the timeout of a command execution.  Must be called before the execution's final update.
+             *
+             * @param executionId id of the command execution
+             *
+             * @return true if the execution was tracked and had not expired.  An execution that expired has had its
+             * token cancelled by the time this returns, and must not be updated again.
+             */
+            bool Untrack(const Aws::Crt::String &executionId);
+
+            /**
+             * Turns the wheel up to the current time of the scheduler's clock, expiring every execution whose deadline
+             * has passed.  Only for schedulers configured without an event loop group, which do not turn on their own.
+             *
+             * @return success/failure
+             */
+            bool ExpireDue();
+
+            /**
+             * @return the number of tracked command executions
+             */
+            size_t GetTrackedCount() const;
+
+            /**
+             * @return true if the scheduler was configured successfully, false otherwise
+             */
+            explicit operator bool() const noexcept;
+
+          private:
+            std::shared_ptr<CommandExpirySchedulerState> m_state;
+        };
+
+    } // namespace Iotcommands
+} // namespace Aws
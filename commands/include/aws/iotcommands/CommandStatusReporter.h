@@ -0,0 +1,128 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotcommands/Exports.h>
+#include <aws/iotcommands/IotCommandsClientV2.h>
+
+#include <aws/crt/Types.h>
+
+#include <memory>
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        class CommandStatusReporterState;
+
+        /**
+         * Configuration options for a CommandStatusReporter.
+         */
+        class AWS_IOTCOMMANDS_API CommandStatusReporterOptions final
+        {
+          public:
+            CommandStatusReporterOptions() = default;
+
+            /**
+             * Sets the number of status updates, across all executions, that may be in flight at once.  Executions
+             * with an update beyond the limit wait in FIFO order.  Zero disables the limit.
+             *
+             * @param maxInFlightUpdates maximum number of in-flight updates
+             * @return reference to this options object
+             */
+            CommandStatusReporterOptions &WithMaxInFlightUpdates(size_t maxInFlightUpdates);
+
+            /**
+             * Sets how many times an update with a terminal status is resent after failing without a response from
+             * the service, e.g. after timing out.  Updates the service rejected are not resent.  Defaults to 3.
+             *
+             * @param terminalRetryLimit number of retries of a terminal update
+             * @return reference to this options object
+             */
+            CommandStatusReporterOptions &WithTerminalRetryLimit(uint32_t terminalRetryLimit);
+
+            /**
+             * Sets whether updates are encoded as CBOR rather than JSON.  Defaults to false.
+             *
+             * @param useCbor true to send updates with UpdateCommandExecutionCbor
+             * @return reference to this options object
+             */
+            CommandStatusReporterOptions &WithCborEncoding(bool useCbor);
+
+            size_t GetMaxInFlightUpdates() const { return m_maxInFlightUpdates; }
+
+            uint32_t GetTerminalRetryLimit() const { return m_terminalRetryLimit; }
+
+            bool GetCborEncoding() const { return m_useCbor; }
+
+          private:
+            size_t m_maxInFlightUpdates = 0;
+            uint32_t m_terminalRetryLimit = 3;
+            bool m_useCbor = false;
+        };
+
+        /**
+         * Pipelines status updates of command executions.
+         *
+         * Each execution has at most one update in flight; the service's responses carry no correlation token, so
+         * concurrent updates of one execution could not be told apart.  While an update is in flight, later updates
+         * of the same execution wait, and a waiting IN_PROGRESS update is replaced by any later update instead of
+         * being sent.  Every caller's handler is completed from the response to the update that was sent in place of
+         * its own.
+         *
+         * Once an execution has been given a terminal status (SUCCEEDED, FAILED, REJECTED or TIMED_OUT), further
+         * updates are refused until that update completes.  A terminal update that fails without a response from the
+         * service is resent.
+         *
+         * Updates still in flight or waiting when the reporter is destroyed are sent and completed normally.
+         *
+         * With many executions updated at once, consider a client created with
+         * ClientV2Options::WithSharedResponseSubscription, so their updates do not each hold response subscriptions.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTCOMMANDS_API CommandStatusReporter final
+        {
+          public:
+            /**
+             * @param client service client used to send the updates
+             * @param options reporter configuration
+             * @param allocator memory allocator to use for reporter state
+             */
+            CommandStatusReporter(
+                std::shared_ptr<IClientV2> client,
+                const CommandStatusReporterOptions &options = CommandStatusReporterOptions(),
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            CommandStatusReporter(const CommandStatusReporter &) = delete;
+            CommandStatusReporter &operator=(const CommandStatusReporter &) = delete;
+
+            /**
+             * Queues a status update of a command execution.
+             *
+             * @param request update to send; DeviceType, DeviceId, ExecutionId and Status must be set
+             * @param handler function object to invoke upon completion of the update sent in place of this one; may
+             * be empty
+             *
+             * @return success/failure.  Fails with AWS_ERROR_INVALID_STATE if the execution already has a terminal
+             * update pending.
+             */
+            bool UpdateCommandExecution(
+                const UpdateCommandExecutionRequest &request,
+                const UpdateCommandExecutionResultHandler &handler = UpdateCommandExecutionResultHandler());
+
+            /**
+             * @return the number of executions with an update in flight or waiting
+             */
+            size_t GetPendingExecutionCount() const;
+
+          private:
+            std::shared_ptr<CommandStatusReporterState> m_state;
+        };
+
+    } // namespace Iotcommands
+} // namespace Aws
@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotcommands/IotCommandsClientV2.h>
+
+#include <aws/iotcommands/UpdateCommandExecutionResponse.h>
+#include <aws/iotcommands/V2ErrorResponse.h>
+
+#include <aws/iotdevicecommon/RequestFuture.h>
+
+#include <memory>
+#include <utility>
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        /**
+         * Future-based facade over the commands service client.  Each request operation returns a future for its
+         * result instead of taking a handler.  When compiled as C++20, the futures can be awaited directly:
+         *
+         *     UpdateCommandExecutionResult result = co_await asyncClient.UpdateCommandExecution(request);
+         *
+         * Futures complete on the event loop thread that delivered the response; see
+         * Aws::Iotdevicecommon::RequestFuture for the threading rules.
+         */
+        class AsyncClientV2 final
+        {
+          public:
+            /**
+             * @param client service client to submit requests with
+             * @param allocator memory allocator for the state of each request
+             */
+            explicit AsyncClientV2(
+                std::shared_ptr<IClientV2> client,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator())
+                : m_client(std::move(client)), m_allocator(allocator)
+            {
+            }
+
+            /**
+             * Update the status of a command execution.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<UpdateCommandExecutionResult> UpdateCommandExecution(
+                const UpdateCommandExecutionRequest &request)
+            {
+                return Submit<UpdateCommandExecutionResult>(
+                    [this, &request](const UpdateCommandExecutionResultHandler &handler)
+                    { return m_client->UpdateCommandExecution(request, handler); });
+            }
+
+            /**
+             * Update the status of a command execution, encoding the request as CBOR.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<UpdateCommandExecutionResult> UpdateCommandExecutionCbor(
+                const UpdateCommandExecutionRequest &request)
+            {
+                return Submit<UpdateCommandExecutionResult>(
+                    [this, &request](const UpdateCommandExecutionResultHandler &handler)
+                    { return m_client->UpdateCommandExecutionCbor(request, handler); });
+            }
+
+            /**
+             * @return the wrapped service client, e.g. for creating streaming operations
+             */
+            const std::shared_ptr<IClientV2> &GetClient() const { return m_client; }
+
+          private:
+            template <typename R, typename Submitter>
+            Aws::Iotdevicecommon::RequestFuture<R> Submit(Submitter &&submit)
+            {
+                return Aws::Iotdevicecommon::RequestFuture<R>::Start(
+                    m_allocator,
+                    std::forward<Submitter>(submit),
+                    [](int errorCode) { return R(ServiceErrorV2<V2ErrorResponse>(errorCode)); });
+            }
+
+            std::shared_ptr<IClientV2> m_client;
+            Aws::Crt::Allocator *m_allocator;
+        };
+
+    } // namespace Iotcommands
+} // namespace Aws
@@ -64,6 +64,7 @@ namespace Aws
             Aws::Crt::Optional<E> m_modeledError;
         };
 
+        class BorrowedCommandExecutionEvent;
         class CommandExecutionEvent;
         class CommandExecutionsSubscriptionRequest;
         class UpdateCommandExecutionRequest;
@@ -143,6 +144,132 @@ namespace Aws
                 CreateCommandExecutionsJsonPayloadStream(
                     const CommandExecutionsSubscriptionRequest &request,
                     const Aws::Iot::RequestResponse::StreamingOperationOptions<CommandExecutionEvent> &options) = 0;
+
+            /*
+             * Operations added after IClientV2 was first released have default implementations that fail with
+             * AWS_ERROR_UNSUPPORTED_OPERATION, so existing implementations of the interface keep compiling.
+             */
+
+            /**
+             * Update the status of a command execution, encoding the request as CBOR.  Binary results are sent as raw
+             * bytes instead of base64 text, and the service responds in CBOR as well.
+             *
+             * @param request operation to perform
+             * @param handler function object to invoke upon operation completion
+             *
+             * @return success/failure
+             */
+            virtual bool UpdateCommandExecutionCbor(
+                const UpdateCommandExecutionRequest &request,
+                const UpdateCommandExecutionResultHandler &handler)
+            {
+                (void)request;
+                (void)handler;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return false;
+            }
+
+            /**
+             * Creates a stream of CommandExecution notifications for a given IoT thing, emitting events that borrow
+             * the payload of the MQTT message instead of copying it.  See BorrowedCommandExecutionEvent.
+             *
+             * @param request Modeled streaming operation subscription configuration.
+             * @param options Configuration options for the streaming operation.
+             *
+             * @return A streaming operation which will emit a borrowed event every time a message is received on the
+             * associated MQTT topic.
+             */
+            virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>
+                CreateCommandExecutionsCborPayloadStream(
+                    const CommandExecutionsSubscriptionRequest &request,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent>
+                        &options)
+            {
+                (void)request;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
+
+            /**
+             * Creates a stream of CommandExecution notifications for a given IoT thing, emitting events that borrow
+             * the payload of the MQTT message instead of copying it.  See BorrowedCommandExecutionEvent.
+             *
+             * @param request Modeled streaming operation subscription configuration.
+             * @param options Configuration options for the streaming operation.
+             *
+             * @return A streaming operation which will emit a borrowed event every time a message is received on the
+             * associated MQTT topic.
+             */
+            virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>
+                CreateCommandExecutionsGenericPayloadStream(
+                    const CommandExecutionsSubscriptionRequest &request,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent>
+                        &options)
+            {
+                (void)request;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
+
+            /**
+             * Creates a stream of CommandExecution notifications for a given IoT thing, emitting events that borrow
+             * the payload of the MQTT message instead of copying it.  See BorrowedCommandExecutionEvent.
+             *
+             * @param request Modeled streaming operation subscription configuration.
+             * @param options Configuration options for the streaming operation.
+             *
+             * @return A streaming operation which will emit a borrowed event every time a message is received on the
+             * associated MQTT topic.
+             */
+            virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>
+                CreateCommandExecutionsJsonPayloadStream(
+                    const CommandExecutionsSubscriptionRequest &request,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent>
+                        &options)
+            {
+                (void)request;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
+        };
+
+        /**
+         * Service client configuration options that are specific to the commands service.
+         */
+        class AWS_IOTCOMMANDS_API ClientV2Options final
+        {
+          public:
+            ClientV2Options() = default;
+
+            /**
+             * Sets whether command execution updates share one response subscription per device and payload format.
+             *
+             * By default each update subscribes to the accepted and rejected response topics of its own execution, so
+             * every execution with an update in flight holds request-response subscriptions of its own.  With a shared
+             * subscription, all updates of a device subscribe to the single wildcard filter
+             * $aws/commands/<device type>/<device id>/executions/+/response/+/<json|cbor> instead, and responses are
+             * still matched to their update by exact topic.  This keeps many concurrent updates within the
+             * request-response client's subscription limit, at the cost of receiving the responses of every
+             * execution of the device.
+             *
+             * The device's IoT policy must then allow iot:Subscribe on that wildcard filter.  Policies match the MQTT
+             * wildcards literally, so the topicfilter resource has to name the filter itself, e.g.
+             * $aws/commands/things/<thing name>/executions/+/response/+/json, or cover it with a policy wildcard.  A
+             * policy that only grants the per-execution response topics refuses the subscription, and every update
+             * fails.  Defaults to false.
+             *
+             * @param sharedResponseSubscription true to subscribe to the wildcard response filter
+             * @return reference to this options object
+             */
+            ClientV2Options &WithSharedResponseSubscription(bool sharedResponseSubscription);
+
+            bool GetSharedResponseSubscription() const { return m_sharedResponseSubscription; }
+
+          private:
+            bool m_sharedResponseSubscription = false;
         };
 
         /**
@@ -173,5 +300,52 @@ namespace Aws
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
             Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
 
+        /**
+         * Creates a new service client that uses an SDK MQTT5 client for transport.
+         *
+         * @param protocolClient MQTT client to use as transport
+         * @param options request-response MQTT client configuration options
+         * @param clientOptions commands service client configuration options
+         * @param allocator memory allocator to use for all client functionality
+         *
+         * @return a new service client
+         */
+        AWS_IOTCOMMANDS_API std::shared_ptr<IClientV2> NewClientFrom5(
+            const Aws::Crt::Mqtt5::Mqtt5Client &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            const ClientV2Options &clientOptions,
+            Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+        /**
+         * Creates a new service client that uses an SDK MQTT311 client for transport.
+         *
+         * @param protocolClient MQTT client to use as transport
+         * @param options request-response MQTT client configuration options
+         * @param clientOptions commands service client configuration options
+         * @param allocator memory allocator to use for all client functionality
+         *
+         * @return a new service client
+         */
+        AWS_IOTCOMMANDS_API std::shared_ptr<IClientV2> NewClientFrom311(
+            const Aws::Crt::Mqtt::MqttConnection &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            const ClientV2Options &clientOptions,
+            Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+        /**
+         * Creates a new service client on top of an existing request-response MQTT client, e.g. one shared with other
+         * service clients.
+         *
+         * @param bindingClient request-response MQTT client to use as transport
+         * @param clientOptions commands service client configuration options
+         * @param allocator memory allocator to use for all client functionality
+         *
+         * @return a new service client
+         */
+        AWS_IOTCOMMANDS_API std::shared_ptr<IClientV2> NewClientFromRequestResponseClient(
+            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+            const ClientV2Options &clientOptions = ClientV2Options(),
+            Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
     } // namespace Iotcommands
 } // namespace Aws
@@ -13,8 +13,14 @@
 
 namespace Aws
 {
+    namespace Iotdevicecommon
+    {
+        class JsonWriter;
+    }
+
     namespace Iotcommands
     {
+        class CborWriter;
 
         /**
          * Additional information on provided update.
@@ -30,6 +36,13 @@ namespace Aws
 
             void SerializeToObject(Crt::JsonObject &doc) const;
 
+            void SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const;
+
+            /**
+             * Writes the status reason as a CBOR map.
+             */
+            void SerializeTo(CborWriter &writer) const;
+
             /**
              * Reason code in the [A-Z0-9_-]+ format and not exceeding 64 characters in length.
              *
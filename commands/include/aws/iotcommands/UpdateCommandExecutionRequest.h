@@ -18,8 +18,14 @@
 
 namespace Aws
 {
+    namespace Iotdevicecommon
+    {
+        class JsonWriter;
+    }
+
     namespace Iotcommands
     {
+        class CborWriter;
 
         /**
          * Data needed to make an UpdateCommandExecution request.
@@ -35,6 +41,13 @@ namespace Aws
 
             void SerializeToObject(Crt::JsonObject &doc) const;
 
+            void SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const;
+
+            /**
+             * Writes the request as a CBOR map.
+             */
+            void SerializeTo(CborWriter &writer) const;
+
             /**
              * The type of a target device. Determine if the device should subscribe for commands addressed to an IoT
              * Thing or MQTT client.
@@ -0,0 +1,92 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotcommands/BorrowedCommandExecutionEvent.h>
+
+#include <aws/iotcommands/CommandExecutionEvent.h>
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        class BorrowedCommandExecutionEventBuffer
+        {
+          public:
+            BorrowedCommandExecutionEventBuffer() { AWS_ZERO_STRUCT(buffer); }
+
+            ~BorrowedCommandExecutionEventBuffer() { aws_byte_buf_clean_up(&buffer); }
+
+            BorrowedCommandExecutionEventBuffer(const BorrowedCommandExecutionEventBuffer &) = delete;
+            BorrowedCommandExecutionEventBuffer &operator=(const BorrowedCommandExecutionEventBuffer &) = delete;
+
+            /* Appends a cursor and returns a cursor over the appended copy; capacity is reserved up front */
+            Aws::Crt::ByteCursor Append(Aws::Crt::ByteCursor cursor)
+            {
+                uint8_t *start = buffer.buffer + buffer.len;
+                aws_byte_buf_append(&buffer, &cursor);
+                return aws_byte_cursor_from_array(start, cursor.len);
+            }
+
+            struct aws_byte_buf buffer;
+        };
+
+        BorrowedCommandExecutionEvent::BorrowedCommandExecutionEvent(
+            Aws::Crt::ByteCursor executionId,
+            Aws::Crt::ByteCursor payload,
+            const Aws::Crt::Optional<Aws::Crt::ByteCursor> &contentType,
+            const Aws::Crt::Optional<int32_t> &timeout)
+            : m_executionId(executionId), m_payload(payload), m_contentType(contentType), m_timeout(timeout)
+        {
+        }
+
+        bool BorrowedCommandExecutionEvent::Detach(Aws::Crt::Allocator *allocator)
+        {
+            if (m_buffer)
+            {
+                return true;
+            }
+
+            size_t size = m_executionId.len + m_payload.len;
+            if (m_contentType.has_value())
+            {
+                size += m_contentType->len;
+            }
+
+            auto buffer = Aws::Crt::MakeShared<BorrowedCommandExecutionEventBuffer>(allocator);
+            if (!buffer || aws_byte_buf_init(&buffer->buffer, allocator, size > 0 ? size : 1) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            m_executionId = buffer->Append(m_executionId);
+            m_payload = buffer->Append(m_payload);
+            if (m_contentType.has_value())
+            {
+                m_contentType = buffer->Append(*m_contentType);
+            }
+            m_buffer = std::move(buffer);
+
+            return true;
+        }
+
+        CommandExecutionEvent BorrowedCommandExecutionEvent::ToEvent() const
+        {
+            CommandExecutionEvent event;
+            event.SetExecutionId(m_executionId);
+            event.SetPayload(m_payload);
+            if (m_contentType.has_value())
+            {
+                event.SetContentType(*m_contentType);
+            }
+            if (m_timeout.has_value())
+            {
+                event.SetTimeout(*m_timeout);
+            }
+
+            return event;
+        }
+
+    } // namespace Iotcommands
+} // namespace Aws
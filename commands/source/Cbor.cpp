@@ -0,0 +1,681 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotcommands/Cbor.h>
+
+#include <aws/common/cbor.h>
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        constexpr uint64_t CborReader::INDEFINITE_LENGTH;
+
+        CborKey::CborKey(const char *key) noexcept : cursor(aws_byte_cursor_from_c_str(key)) {}
+
+        CborKey::CborKey(const Aws::Crt::String &key) noexcept
+            : cursor(aws_byte_cursor_from_array(key.data(), key.length()))
+        {
+        }
+
+        CborWriter::CborWriter(Aws::Crt::Allocator *allocator) : m_encoder(aws_cbor_encoder_new(allocator)) {}
+
+        CborWriter::~CborWriter()
+        {
+            if (m_encoder != nullptr)
+            {
+                aws_cbor_encoder_destroy(m_encoder);
+            }
+        }
+
+        CborWriter &CborWriter::WriteUInt64(uint64_t value)
+        {
+            aws_cbor_encoder_write_uint(m_encoder, value);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteInt64(int64_t value)
+        {
+            if (value >= 0)
+            {
+                aws_cbor_encoder_write_uint(m_encoder, static_cast<uint64_t>(value));
+            }
+            else
+            {
+                /* A negative integer n is encoded as -1 - n, which is the bitwise complement */
+                aws_cbor_encoder_write_negint(m_encoder, ~static_cast<uint64_t>(value));
+            }
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteDouble(double value)
+        {
+            aws_cbor_encoder_write_float(m_encoder, value);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteBool(bool value)
+        {
+            aws_cbor_encoder_write_bool(m_encoder, value);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteNull()
+        {
+            aws_cbor_encoder_write_null(m_encoder);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteText(struct aws_byte_cursor value)
+        {
+            aws_cbor_encoder_write_text(m_encoder, value);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteText(const Aws::Crt::String &value)
+        {
+            return WriteText(aws_byte_cursor_from_array(value.data(), value.length()));
+        }
+
+        CborWriter &CborWriter::WriteText(const char *value)
+        {
+            return WriteText(aws_byte_cursor_from_c_str(value));
+        }
+
+        CborWriter &CborWriter::WriteBytes(struct aws_byte_cursor value)
+        {
+            aws_cbor_encoder_write_bytes(m_encoder, value);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteArrayStart(size_t count)
+        {
+            aws_cbor_encoder_write_array_start(m_encoder, count);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteMapStart(size_t count)
+        {
+            aws_cbor_encoder_write_map_start(m_encoder, count);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteIndefiniteArrayStart()
+        {
+            aws_cbor_encoder_write_indef_array_start(m_encoder);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteIndefiniteMapStart()
+        {
+            aws_cbor_encoder_write_indef_map_start(m_encoder);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WriteBreak()
+        {
+            aws_cbor_encoder_write_break(m_encoder);
+            return *this;
+        }
+
+        CborWriter &CborWriter::WithString(const CborKey &key, const Aws::Crt::String &value)
+        {
+            return WriteText(key.cursor).WriteText(value);
+        }
+
+        CborWriter &CborWriter::WithString(const CborKey &key, struct aws_byte_cursor value)
+        {
+            return WriteText(key.cursor).WriteText(value);
+        }
+
+        CborWriter &CborWriter::WithBool(const CborKey &key, bool value)
+        {
+            return WriteText(key.cursor).WriteBool(value);
+        }
+
+        CborWriter &CborWriter::WithInt64(const CborKey &key, int64_t value)
+        {
+            return WriteText(key.cursor).WriteInt64(value);
+        }
+
+        CborWriter &CborWriter::WithDouble(const CborKey &key, double value)
+        {
+            return WriteText(key.cursor).WriteDouble(value);
+        }
+
+        CborWriter &CborWriter::WithBytes(const CborKey &key, struct aws_byte_cursor value)
+        {
+            return WriteText(key.cursor).WriteBytes(value);
+        }
+
+        CborWriter &CborWriter::WithBytes(const CborKey &key, const Aws::Crt::Vector<uint8_t> &value)
+        {
+            return WithBytes(key, aws_byte_cursor_from_array(value.data(), value.size()));
+        }
+
+        CborWriter &CborWriter::WithMapStart(const CborKey &key, size_t count)
+        {
+            return WriteText(key.cursor).WriteMapStart(count);
+        }
+
+        struct aws_byte_cursor CborWriter::ToCursor() const noexcept
+        {
+            return aws_cbor_encoder_get_encoded_data(m_encoder);
+        }
+
+        CborReader::CborReader(struct aws_byte_cursor data, Aws::Crt::Allocator *allocator)
+            : m_data(data), m_decoder(aws_cbor_decoder_new(allocator, data)), m_offset(0)
+        {
+        }
+
+        CborReader::~CborReader()
+        {
+            if (m_decoder != nullptr)
+            {
+                aws_cbor_decoder_destroy(m_decoder);
+            }
+        }
+
+        /* Tags annotate the following item, which is what the caller is interested in */
+        bool CborReader::SkipTags()
+        {
+            enum aws_cbor_type type;
+            while (aws_cbor_decoder_peek_type(m_decoder, &type) == AWS_OP_SUCCESS)
+            {
+                if (type != AWS_CBOR_TYPE_TAG)
+                {
+                    return true;
+                }
+
+                uint64_t tag;
+                aws_cbor_decoder_pop_next_tag_val(m_decoder, &tag);
+                OnConsumed();
+            }
+
+            return false;
+        }
+
+        /* Nothing is cached right after a consume, so the decoder's remaining length is exact */
+        void CborReader::OnConsumed()
+        {
+            m_offset = m_data.len - aws_cbor_decoder_get_remaining_length(m_decoder);
+        }
+
+        CborType CborReader::PeekType()
+        {
+            enum aws_cbor_type type;
+            if (!SkipTags() || aws_cbor_decoder_peek_type(m_decoder, &type) != AWS_OP_SUCCESS)
+            {
+                return CborType::Invalid;
+            }
+
+            switch (type)
+            {
+                case AWS_CBOR_TYPE_UINT:
+                    return CborType::UnsignedInteger;
+                case AWS_CBOR_TYPE_NEGINT:
+                    return CborType::NegativeInteger;
+                case AWS_CBOR_TYPE_BYTES:
+                case AWS_CBOR_TYPE_INDEF_BYTES_START:
+                    return CborType::ByteString;
+                case AWS_CBOR_TYPE_TEXT:
+                case AWS_CBOR_TYPE_INDEF_TEXT_START:
+                    return CborType::TextString;
+                case AWS_CBOR_TYPE_ARRAY_START:
+                case AWS_CBOR_TYPE_INDEF_ARRAY_START:
+                    return CborType::Array;
+                case AWS_CBOR_TYPE_MAP_START:
+                case AWS_CBOR_TYPE_INDEF_MAP_START:
+                    return CborType::Map;
+                case AWS_CBOR_TYPE_BOOL:
+                    return CborType::Bool;
+                case AWS_CBOR_TYPE_NULL:
+                    return CborType::Null;
+                case AWS_CBOR_TYPE_UNDEFINED:
+                    return CborType::Undefined;
+                case AWS_CBOR_TYPE_FLOAT:
+                    return CborType::Float;
+                case AWS_CBOR_TYPE_BREAK:
+                    return CborType::Break;
+                default:
+                    return CborType::Invalid;
+            }
+        }
+
+        bool CborReader::ReadUInt64(uint64_t &value)
+        {
+            if (!SkipTags() || aws_cbor_decoder_pop_next_unsigned_int_val(m_decoder, &value) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            OnConsumed();
+            return true;
+        }
+
+        bool CborReader::ReadInt64(int64_t &value)
+        {
+            CborType type = PeekType();
+            uint64_t argument;
+            if (type == CborType::UnsignedInteger)
+            {
+                aws_cbor_decoder_pop_next_unsigned_int_val(m_decoder, &argument);
+            }
+            else if (type == CborType::NegativeInteger)
+            {
+                aws_cbor_decoder_pop_next_negative_int_val(m_decoder, &argument);
+            }
+            else
+            {
+                return false;
+            }
+
+            OnConsumed();
+            if (argument > static_cast<uint64_t>(INT64_MAX))
+            {
+                return false;
+            }
+
+            value = type == CborType::UnsignedInteger ? static_cast<int64_t>(argument)
+                                                      : -1 - static_cast<int64_t>(argument);
+            return true;
+        }
+
+        bool CborReader::ReadDouble(double &value)
+        {
+            CborType type = PeekType();
+            uint64_t argument;
+            if (type == CborType::UnsignedInteger)
+            {
+                aws_cbor_decoder_pop_next_unsigned_int_val(m_decoder, &argument);
+                value = static_cast<double>(argument);
+            }
+            else if (type == CborType::NegativeInteger)
+            {
+                aws_cbor_decoder_pop_next_negative_int_val(m_decoder, &argument);
+                value = -1.0 - static_cast<double>(argument);
+            }
+            else if (type == CborType::Float)
+            {
+                aws_cbor_decoder_pop_next_float_val(m_decoder, &value);
+            }
+            else
+            {
+                return false;
+            }
+
+            OnConsumed();
+            return true;
+        }
+
+        bool CborReader::ReadBool(bool &value)
+        {
+            if (!SkipTags() || aws_cbor_decoder_pop_next_boolean_val(m_decoder, &value) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            OnConsumed();
+            return true;
+        }
+
+        bool CborReader::ReadNull()
+        {
+            if (PeekType() != CborType::Null ||
+                aws_cbor_decoder_consume_next_single_element(m_decoder) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            OnConsumed();
+            return true;
+        }
+
+        bool CborReader::ReadText(struct aws_byte_cursor &value)
+        {
+            if (!SkipTags() || aws_cbor_decoder_pop_next_text_val(m_decoder, &value) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            OnConsumed();
+            return true;
+        }
+
+        bool CborReader::ReadBytes(struct aws_byte_cursor &value)
+        {
+            if (!SkipTags() || aws_cbor_decoder_pop_next_bytes_val(m_decoder, &value) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            OnConsumed();
+            return true;
+        }
+
+        bool CborReader::ReadArrayStart(uint64_t &count)
+        {
+            enum aws_cbor_type type;
+            if (!SkipTags() || aws_cbor_decoder_peek_type(m_decoder, &type) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            if (type == AWS_CBOR_TYPE_ARRAY_START)
+            {
+                aws_cbor_decoder_pop_next_array_start(m_decoder, &count);
+            }
+            else if (type == AWS_CBOR_TYPE_INDEF_ARRAY_START)
+            {
+                aws_cbor_decoder_consume_next_single_element(m_decoder);
+                count = INDEFINITE_LENGTH;
+            }
+            else
+            {
+                return false;
+            }
+
+            OnConsumed();
+            return true;
+        }
+
+        bool CborReader::ReadMapStart(uint64_t &count)
+        {
+            enum aws_cbor_type type;
+            if (!SkipTags() || aws_cbor_decoder_peek_type(m_decoder, &type) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            if (type == AWS_CBOR_TYPE_MAP_START)
+            {
+                aws_cbor_decoder_pop_next_map_start(m_decoder, &count);
+            }
+            else if (type == AWS_CBOR_TYPE_INDEF_MAP_START)
+            {
+                aws_cbor_decoder_consume_next_single_element(m_decoder);
+                count = INDEFINITE_LENGTH;
+            }
+            else
+            {
+                return false;
+            }
+
+            OnConsumed();
+            return true;
+        }
+
+        bool CborReader::ReadBreak()
+        {
+            enum aws_cbor_type type;
+            if (aws_cbor_decoder_peek_type(m_decoder, &type) != AWS_OP_SUCCESS || type != AWS_CBOR_TYPE_BREAK)
+            {
+                return false;
+            }
+
+            aws_cbor_decoder_consume_next_single_element(m_decoder);
+            OnConsumed();
+            return true;
+        }
+
+        bool CborReader::SkipItem()
+        {
+            struct aws_byte_cursor item;
+            return ReadItem(item);
+        }
+
+        bool CborReader::ReadItem(struct aws_byte_cursor &item)
+        {
+            size_t start = m_offset;
+            if (aws_cbor_decoder_consume_next_whole_data_item(m_decoder) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            OnConsumed();
+            item = aws_byte_cursor_from_array(m_data.ptr + start, m_offset - start);
+            return true;
+        }
+
+        bool CborReader::IsDone()
+        {
+            /* An item cached by a peek is no longer counted as remaining, but it is not consumed either */
+            enum aws_cbor_type type;
+            return aws_cbor_decoder_get_remaining_length(m_decoder) == 0 &&
+                   aws_cbor_decoder_peek_type(m_decoder, &type) != AWS_OP_SUCCESS;
+        }
+
+        CborView::CborView(struct aws_byte_cursor data, Aws::Crt::Allocator *allocator)
+        {
+            CborReader reader(data, allocator);
+            if (reader.ReadItem(m_item))
+            {
+                m_allocator = allocator;
+            }
+            else
+            {
+                m_item = {0, nullptr};
+            }
+        }
+
+        CborView CborView::FromItem(struct aws_byte_cursor item, Aws::Crt::Allocator *allocator)
+        {
+            CborView view;
+            view.m_item = item;
+            view.m_allocator = allocator;
+            return view;
+        }
+
+        CborType CborView::GetType() const
+        {
+            if (!IsValid())
+            {
+                return CborType::Invalid;
+            }
+
+            return CborReader(m_item, m_allocator).PeekType();
+        }
+
+        Aws::Crt::Optional<uint64_t> CborView::AsUInt64() const
+        {
+            uint64_t value;
+            if (!IsValid() || !CborReader(m_item, m_allocator).ReadUInt64(value))
+            {
+                return {};
+            }
+
+            return value;
+        }
+
+        Aws::Crt::Optional<int64_t> CborView::AsInt64() const
+        {
+            int64_t value;
+            if (!IsValid() || !CborReader(m_item, m_allocator).ReadInt64(value))
+            {
+                return {};
+            }
+
+            return value;
+        }
+
+        Aws::Crt::Optional<double> CborView::AsDouble() const
+        {
+            double value;
+            if (!IsValid() || !CborReader(m_item, m_allocator).ReadDouble(value))
+            {
+                return {};
+            }
+
+            return value;
+        }
+
+        Aws::Crt::Optional<bool> CborView::AsBool() const
+        {
+            bool value;
+            if (!IsValid() || !CborReader(m_item, m_allocator).ReadBool(value))
+            {
+                return {};
+            }
+
+            return value;
+        }
+
+        Aws::Crt::Optional<struct aws_byte_cursor> CborView::AsText() const
+        {
+            struct aws_byte_cursor value;
+            if (!IsValid() || !CborReader(m_item, m_allocator).ReadText(value))
+            {
+                return {};
+            }
+
+            return value;
+        }
+
+        Aws::Crt::Optional<struct aws_byte_cursor> CborView::AsBytes() const
+        {
+            struct aws_byte_cursor value;
+            if (!IsValid() || !CborReader(m_item, m_allocator).ReadBytes(value))
+            {
+                return {};
+            }
+
+            return value;
+        }
+
+        Aws::Crt::Optional<Aws::Crt::String> CborView::AsString() const
+        {
+            auto text = AsText();
+            if (!text.has_value())
+            {
+                return {};
+            }
+
+            return Aws::Crt::String(reinterpret_cast<const char *>(text->ptr), text->len);
+        }
+
+        size_t CborView::GetLength() const
+        {
+            size_t length = 0;
+            if (GetType() == CborType::Map)
+            {
+                ForEachMember(
+                    [&length](const CborView &, const CborView &)
+                    {
+                        ++length;
+                        return true;
+                    });
+            }
+            else
+            {
+                ForEachElement(
+                    [&length](const CborView &)
+                    {
+                        ++length;
+                        return true;
+                    });
+            }
+
+            return length;
+        }
+
+        CborView CborView::GetMember(const CborKey &key) const
+        {
+            CborView member;
+            ForEachMember(
+                [&key, &member](const CborView &memberKey, const CborView &value)
+                {
+                    auto text = memberKey.AsText();
+                    if (text.has_value() && aws_byte_cursor_eq(&*text, &key.cursor))
+                    {
+                        member = value;
+                        return false;
+                    }
+                    return true;
+                });
+
+            return member;
+        }
+
+        CborView CborView::GetElement(size_t index) const
+        {
+            CborView element;
+            size_t position = 0;
+            ForEachElement(
+                [index, &position, &element](const CborView &value)
+                {
+                    if (position++ == index)
+                    {
+                        element = value;
+                        return false;
+                    }
+                    return true;
+                });
+
+            return element;
+        }
+
+        void CborView::ForEachMember(
+            const std::function<bool(const CborView &key, const CborView &value)> &visitor) const
+        {
+            if (!IsValid())
+            {
+                return;
+            }
+
+            CborReader reader(m_item, m_allocator);
+            uint64_t count;
+            if (!reader.ReadMapStart(count))
+            {
+                return;
+            }
+
+            for (uint64_t i = 0; count == CborReader::INDEFINITE_LENGTH || i < count; ++i)
+            {
+                if (count == CborReader::INDEFINITE_LENGTH && reader.ReadBreak())
+                {
+                    return;
+                }
+
+                struct aws_byte_cursor key;
+                struct aws_byte_cursor value;
+                if (!reader.ReadItem(key) || !reader.ReadItem(value) ||
+                    !visitor(FromItem(key, m_allocator), FromItem(value, m_allocator)))
+                {
+                    return;
+                }
+            }
+        }
+
+        void CborView::ForEachElement(const std::function<bool(const CborView &element)> &visitor) const
+        {
+            if (!IsValid())
+            {
+                return;
+            }
+
+            CborReader reader(m_item, m_allocator);
+            uint64_t count;
+            if (!reader.ReadArrayStart(count))
+            {
+                return;
+            }
+
+            for (uint64_t i = 0; count == CborReader::INDEFINITE_LENGTH || i < count; ++i)
+            {
+                if (count == CborReader::INDEFINITE_LENGTH && reader.ReadBreak())
+                {
+                    return;
+                }
+
+                struct aws_byte_cursor element;
+                if (!reader.ReadItem(element) || !visitor(FromItem(element, m_allocator)))
+                {
+                    return;
+                }
+            }
+        }
+
+    } // namespace Iotcommands
+} // namespace Aws
@@ -0,0 +1,676 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotcommands/CommandDispatcher.h>
+
+#include <aws/iotcommands/CommandExecutionsSubscriptionRequest.h>
+#include <aws/iotcommands/CommandStatusReporter.h>
+#include <aws/iotcommands/UpdateCommandExecutionRequest.h>
+#include <aws/iotcommands/UpdateCommandExecutionResponse.h>
+#include <aws/iotcommands/V2ErrorResponse.h>
+
+#include <aws/crt/StlAllocator.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        CommandDispatcherOptions::CommandDispatcherOptions()
+            : m_payloadFormats({CommandPayloadFormat::Json, CommandPayloadFormat::Cbor, CommandPayloadFormat::Generic}),
+              m_threadCount(1), m_maxQueuedExecutions(64), m_deduplicationWindow(256), m_reportInProgress(false)
+        {
+        }
+
+        CommandDispatcherOptions &CommandDispatcherOptions::WithPayloadFormats(
+            const Aws::Crt::Vector<CommandPayloadFormat> &payloadFormats)
+        {
+            m_payloadFormats = payloadFormats;
+            return *this;
+        }
+
+        CommandDispatcherOptions &CommandDispatcherOptions::WithThreadCount(size_t threadCount)
+        {
+            m_threadCount = threadCount;
+            return *this;
+        }
+
+        CommandDispatcherOptions &CommandDispatcherOptions::WithMaxQueuedExecutions(size_t maxQueuedExecutions)
+        {
+            m_maxQueuedExecutions = maxQueuedExecutions;
+            return *this;
+        }
+
+        CommandDispatcherOptions &CommandDispatcherOptions::WithDeduplicationWindow(size_t deduplicationWindow)
+        {
+            m_deduplicationWindow = deduplicationWindow;
+            return *this;
+        }
+
+        CommandDispatcherOptions &CommandDispatcherOptions::WithInProgressReports(bool reportInProgress)
+        {
+            m_reportInProgress = reportInProgress;
+            return *this;
+        }
+
+        static Aws::Crt::String s_routeByContentType(
+            const BorrowedCommandExecutionEvent &execution,
+            CommandPayloadFormat payloadFormat)
+        {
+            const auto &contentType = execution.GetContentType();
+            if (contentType.has_value())
+            {
+                return Aws::Crt::String(reinterpret_cast<const char *>(contentType->ptr), contentType->len);
+            }
+
+            switch (payloadFormat)
+            {
+                case CommandPayloadFormat::Json:
+                    return "application/json";
+                case CommandPayloadFormat::Cbor:
+                    return "application/cbor";
+                default:
+                    return "";
+            }
+        }
+
+        static StatusReason s_makeStatusReason(const char *reasonCode, const char *reasonDescription)
+        {
+            StatusReason statusReason;
+            statusReason.ReasonCode = reasonCode;
+            statusReason.ReasonDescription = reasonDescription;
+            return statusReason;
+        }
+
+        struct CommandDispatcherExecution
+        {
+            BorrowedCommandExecutionEvent event;
+            Aws::Crt::String executionId;
+            bool hasDeadline = false;
+            std::chrono::steady_clock::time_point deadline;
+        };
+
+        /* Handler and its executions; the handler is in the ready list whenever it can start one of them */
+        struct CommandDispatcherHandler
+        {
+            CommandHandler handler;
+            size_t maxConcurrency = 1;
+            size_t running = 0;
+            Aws::Crt::List<std::shared_ptr<CommandDispatcherExecution>> queue;
+            bool ready = false;
+        };
+
+        class CommandDispatcherState : public std::enable_shared_from_this<CommandDispatcherState>
+        {
+          public:
+            CommandDispatcherState(
+                std::shared_ptr<IClientV2> client,
+                DeviceType deviceType,
+                const Aws::Crt::String &deviceId,
+                const CommandDispatcherOptions &options,
+                Aws::Crt::Allocator *allocator)
+                : m_allocator(allocator), m_client(std::move(client)),
+                  m_reporter(m_client, CommandStatusReporterOptions(), allocator), m_deviceType(deviceType),
+                  m_deviceId(deviceId), m_options(options), m_knownExecutions(
+                                          std::less<Aws::Crt::String>(),
+                                          Aws::Crt::StlAllocator<Aws::Crt::String>(allocator)),
+                  m_queuedExecutions(0), m_activeExecutions(0), m_running(false), m_stopping(false)
+            {
+            }
+
+            void StartWorkers()
+            {
+                /* Workers keep the state alive in case one of them is detached by Shutdown() */
+                auto state = shared_from_this();
+                size_t threadCount = m_options.GetThreadCount() > 0 ? m_options.GetThreadCount() : 1;
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    m_workers.emplace_back([state]() { state->RunWorker(); });
+                }
+            }
+
+            void RegisterHandler(const Aws::Crt::String &name, const CommandHandler &handler, size_t maxConcurrency)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                Configure(m_handlers[name], handler, maxConcurrency);
+            }
+
+            void SetDefaultHandler(const CommandHandler &handler, size_t maxConcurrency)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                Configure(m_defaultHandler, handler, maxConcurrency);
+            }
+
+            void SetRouter(const CommandRouter &router)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_router = router;
+            }
+
+            void SetErrorHandler(const CommandDispatcherErrorHandler &handler)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_errorHandler = handler;
+            }
+
+            bool Start();
+
+            void Stop();
+
+            /* Drops queued executions and joins the workers */
+            void Shutdown();
+
+            size_t GetActiveExecutionCount() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_activeExecutions;
+            }
+
+          private:
+            /* Requires the lock */
+            void Configure(CommandDispatcherHandler &entry, const CommandHandler &handler, size_t maxConcurrency)
+            {
+                entry.handler = handler;
+                entry.maxConcurrency = maxConcurrency > 0 ? maxConcurrency : 1;
+                MakeReady(entry);
+            }
+
+            /* Requires the lock */
+            void MakeReady(CommandDispatcherHandler &entry)
+            {
+                if (!entry.ready && !entry.queue.empty() && entry.running < entry.maxConcurrency)
+                {
+                    entry.ready = true;
+                    m_ready.push_back(&entry);
+                    m_workAvailable.notify_one();
+                }
+            }
+
+            /* Requires the lock */
+            void Forget(const Aws::Crt::String &executionId)
+            {
+                --m_activeExecutions;
+                m_finishedExecutions.push_back(executionId);
+                while (m_finishedExecutions.size() > m_options.GetDeduplicationWindow())
+                {
+                    m_knownExecutions.erase(m_finishedExecutions.front());
+                    m_finishedExecutions.pop_front();
+                }
+            }
+
+            void OnExecution(BorrowedCommandExecutionEvent &&event, CommandPayloadFormat payloadFormat);
+
+            void RunWorker();
+
+            void Complete(
+                CommandDispatcherHandler *entry,
+                const Aws::Crt::String &executionId,
+                const CommandExecutionStatus *status,
+                const StatusReason &statusReason,
+                const Aws::Crt::Map<Aws::Crt::String, CommandExecutionResult> &result);
+
+            void Report(
+                const Aws::Crt::String &executionId,
+                CommandExecutionStatus status,
+                const StatusReason &statusReason,
+                const Aws::Crt::Map<Aws::Crt::String, CommandExecutionResult> &result);
+
+            void ReportError(int errorCode);
+
+            using ExecutionIdSet =
+                std::set<Aws::Crt::String, std::less<Aws::Crt::String>, Aws::Crt::StlAllocator<Aws::Crt::String>>;
+
+            Aws::Crt::Allocator *m_allocator;
+            std::shared_ptr<IClientV2> m_client;
+
+            /* Keeps an IN_PROGRESS update from racing the final status of the same execution */
+            CommandStatusReporter m_reporter;
+            DeviceType m_deviceType;
+            Aws::Crt::String m_deviceId;
+            CommandDispatcherOptions m_options;
+
+            Aws::Crt::Vector<std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>> m_streams;
+
+            mutable std::mutex m_lock;
+            std::condition_variable m_workAvailable;
+
+            /* Map nodes never move, so the ready list can point at them */
+            Aws::Crt::Map<Aws::Crt::String, CommandDispatcherHandler> m_handlers;
+            CommandDispatcherHandler m_defaultHandler;
+            CommandRouter m_router;
+            CommandDispatcherErrorHandler m_errorHandler;
+
+            /* Handlers with queued executions and spare concurrency, in the order they became runnable */
+            Aws::Crt::List<CommandDispatcherHandler *> m_ready;
+
+            /* Ids of active executions and of the most recently finished ones */
+            ExecutionIdSet m_knownExecutions;
+            Aws::Crt::List<Aws::Crt::String> m_finishedExecutions;
+
+            size_t m_queuedExecutions;
+            size_t m_activeExecutions;
+            bool m_running;
+            bool m_stopping;
+
+            Aws::Crt::Vector<std::thread> m_workers;
+        };
+
+        bool CommandDispatcherState::Start()
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_running)
+                {
+                    return true;
+                }
+                m_running = true;
+            }
+
+            CommandExecutionsSubscriptionRequest request;
+            request.DeviceType = m_deviceType;
+            request.DeviceId = m_deviceId;
+
+            std::weak_ptr<CommandDispatcherState> weakState = shared_from_this();
+            Aws::Crt::Vector<std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>> streams;
+            for (CommandPayloadFormat payloadFormat : m_options.GetPayloadFormats())
+            {
+                Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent> streamOptions;
+                streamOptions.WithStreamHandler(
+                    [weakState, payloadFormat](BorrowedCommandExecutionEvent &&event)
+                    {
+                        if (auto state = weakState.lock())
+                        {
+                            state->OnExecution(std::move(event), payloadFormat);
+                        }
+                    });
+
+                std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> stream;
+                switch (payloadFormat)
+                {
+                    case CommandPayloadFormat::Json:
+                        stream = m_client->CreateCommandExecutionsJsonPayloadStream(request, streamOptions);
+                        break;
+                    case CommandPayloadFormat::Cbor:
+                        stream = m_client->CreateCommandExecutionsCborPayloadStream(request, streamOptions);
+                        break;
+                    default:
+                        stream = m_client->CreateCommandExecutionsGenericPayloadStream(request, streamOptions);
+                        break;
+                }
+
+                if (!stream)
+                {
+                    /* The streams created so far are released after the lock */
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_running = false;
+                    return false;
+                }
+
+                streams.push_back(std::move(stream));
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!m_running)
+                {
+                    /* Stopped while the streams were being created; they are released after the lock */
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                m_streams = streams;
+            }
+
+            for (auto &stream : streams)
+            {
+                stream->Open();
+            }
+
+            return true;
+        }
+
+        void CommandDispatcherState::Stop()
+        {
+            Aws::Crt::Vector<std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>> streams;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_running = false;
+                streams = std::move(m_streams);
+                m_streams.clear();
+            }
+
+            /* The streams are closed here, outside the lock */
+        }
+
+        void CommandDispatcherState::Shutdown()
+        {
+            /* Queued executions are released outside the lock */
+            Aws::Crt::List<std::shared_ptr<CommandDispatcherExecution>> dropped;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_stopping = true;
+                m_ready.clear();
+                for (auto &handler : m_handlers)
+                {
+                    dropped.splice(dropped.end(), handler.second.queue);
+                }
+                dropped.splice(dropped.end(), m_defaultHandler.queue);
+                m_activeExecutions -= dropped.size();
+                m_queuedExecutions = 0;
+            }
+            m_workAvailable.notify_all();
+            dropped.clear();
+
+            for (auto &worker : m_workers)
+            {
+                /* The last reference may be dropped by one of our own handlers */
+                if (worker.get_id() == std::this_thread::get_id())
+                {
+                    worker.detach();
+                }
+                else
+                {
+                    worker.join();
+                }
+            }
+            m_workers.clear();
+        }
+
+        void CommandDispatcherState::OnExecution(
+            BorrowedCommandExecutionEvent &&event,
+            CommandPayloadFormat payloadFormat)
+        {
+            struct aws_byte_cursor executionIdCursor = event.GetExecutionId();
+            Aws::Crt::String executionId(reinterpret_cast<const char *>(executionIdCursor.ptr), executionIdCursor.len);
+
+            CommandRouter router;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!m_running || m_stopping)
+                {
+                    return;
+                }
+
+                /* Redelivered, or delivered on more than one stream */
+                if (!m_knownExecutions.insert(executionId).second)
+                {
+                    return;
+                }
+
+                /* The broker counts the message expiry interval down while the message waits for delivery */
+                const auto &timeout = event.GetTimeout();
+                if (timeout.has_value() && *timeout <= 0)
+                {
+                    ++m_activeExecutions;
+                    Forget(executionId);
+                    return;
+                }
+
+                ++m_activeExecutions;
+                router = m_router;
+            }
+
+            Aws::Crt::String route = router ? router(event) : s_routeByContentType(event, payloadFormat);
+
+            /* The payload is only copied for executions that are going to run */
+            if (!event.Detach(m_allocator))
+            {
+                int errorCode = aws_last_error();
+                Complete(nullptr, executionId, nullptr, StatusReason(), {});
+                ReportError(errorCode);
+                Report(
+                    executionId,
+                    CommandExecutionStatus::FAILED,
+                    s_makeStatusReason("OUT_OF_MEMORY", "the device could not store the command"),
+                    {});
+                return;
+            }
+
+            auto execution = Aws::Crt::MakeShared<CommandDispatcherExecution>(m_allocator);
+            execution->event = std::move(event);
+            execution->executionId = executionId;
+            const auto &timeout = execution->event.GetTimeout();
+            if (timeout.has_value())
+            {
+                execution->hasDeadline = true;
+                execution->deadline = std::chrono::steady_clock::now() + std::chrono::seconds(*timeout);
+            }
+
+            CommandExecutionStatus status = CommandExecutionStatus::FAILED;
+            StatusReason statusReason;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                auto iter = m_handlers.find(route);
+                CommandDispatcherHandler *entry = iter != m_handlers.end() ? &iter->second : &m_defaultHandler;
+                if (!entry->handler)
+                {
+                    status = CommandExecutionStatus::REJECTED;
+                    statusReason = s_makeStatusReason("UNSUPPORTED_COMMAND", "no handler for the command");
+                }
+                else if (m_queuedExecutions >= m_options.GetMaxQueuedExecutions())
+                {
+                    statusReason = s_makeStatusReason("QUEUE_FULL", "too many commands are waiting to run");
+                }
+                else
+                {
+                    entry->queue.push_back(std::move(execution));
+                    ++m_queuedExecutions;
+                    MakeReady(*entry);
+                    return;
+                }
+
+                Forget(executionId);
+            }
+
+            Report(executionId, status, statusReason, {});
+        }
+
+        void CommandDispatcherState::RunWorker()
+        {
+            auto state = shared_from_this();
+
+            std::unique_lock<std::mutex> guard(m_lock);
+            while (true)
+            {
+                m_workAvailable.wait(guard, [this]() { return !m_ready.empty() || m_stopping; });
+                if (m_stopping)
+                {
+                    return;
+                }
+
+                CommandDispatcherHandler *entry = m_ready.front();
+                m_ready.pop_front();
+                entry->ready = false;
+
+                std::shared_ptr<CommandDispatcherExecution> execution = std::move(entry->queue.front());
+                entry->queue.pop_front();
+                --m_queuedExecutions;
+                ++entry->running;
+                MakeReady(*entry);
+
+                CommandHandler handler = entry->handler;
+                bool reportInProgress = m_options.GetInProgressReports();
+                guard.unlock();
+
+                if (execution->hasDeadline && std::chrono::steady_clock::now() >= execution->deadline)
+                {
+                    /* Expired while queued; the service has timed it out already */
+                    Complete(entry, execution->executionId, nullptr, StatusReason(), {});
+                }
+                else
+                {
+                    if (reportInProgress)
+                    {
+                        Report(execution->executionId, CommandExecutionStatus::IN_PROGRESS, StatusReason(), {});
+                    }
+
+                    auto completed = Aws::Crt::MakeShared<std::atomic<bool>>(m_allocator, false);
+                    Aws::Crt::String executionId = execution->executionId;
+                    CommandCompletionCallback complete =
+                        [state, entry, completed, executionId](
+                            CommandExecutionStatus status,
+                            const StatusReason &statusReason,
+                            const Aws::Crt::Map<Aws::Crt::String, CommandExecutionResult> &result)
+                    {
+                        if (completed->exchange(true))
+                        {
+                            return;
+                        }
+
+                        state->Complete(entry, executionId, &status, statusReason, result);
+                    };
+
+                    handler(execution->event, complete);
+                }
+
+                execution = nullptr;
+                handler = nullptr;
+                guard.lock();
+            }
+        }
+
+        void CommandDispatcherState::Complete(
+            CommandDispatcherHandler *entry,
+            const Aws::Crt::String &executionId,
+            const CommandExecutionStatus *status,
+            const StatusReason &statusReason,
+            const Aws::Crt::Map<Aws::Crt::String, CommandExecutionResult> &result)
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (entry != nullptr)
+                {
+                    --entry->running;
+                    MakeReady(*entry);
+                }
+                Forget(executionId);
+            }
+
+            if (status != nullptr)
+            {
+                Report(executionId, *status, statusReason, result);
+            }
+        }
+
+        void CommandDispatcherState::Report(
+            const Aws::Crt::String &executionId,
+            CommandExecutionStatus status,
+            const StatusReason &statusReason,
+            const Aws::Crt::Map<Aws::Crt::String, CommandExecutionResult> &result)
+        {
+            UpdateCommandExecutionRequest request;
+            request.DeviceType = m_deviceType;
+            request.DeviceId = m_deviceId;
+            request.ExecutionId = executionId;
+            request.Status = status;
+            if (statusReason.ReasonCode.has_value() || statusReason.ReasonDescription.has_value())
+            {
+                request.StatusReason = statusReason;
+            }
+            if (!result.empty())
+            {
+                request.Result = result;
+            }
+
+            std::weak_ptr<CommandDispatcherState> weakState = shared_from_this();
+            if (!m_reporter.UpdateCommandExecution(
+                    request,
+                    [weakState](UpdateCommandExecutionResult &&updateResult)
+                    {
+                        auto state = weakState.lock();
+                        if (state && !updateResult.IsSuccess())
+                        {
+                            state->ReportError(updateResult.GetError().GetErrorCode());
+                        }
+                    }))
+            {
+                int errorCode = aws_last_error();
+                ReportError(errorCode != AWS_ERROR_SUCCESS ? errorCode : AWS_ERROR_UNKNOWN);
+            }
+        }
+
+        void CommandDispatcherState::ReportError(int errorCode)
+        {
+            CommandDispatcherErrorHandler errorHandler;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                errorHandler = m_errorHandler;
+            }
+
+            if (errorHandler)
+            {
+                errorHandler(errorCode);
+            }
+        }
+
+        CommandDispatcher::CommandDispatcher(
+            std::shared_ptr<IClientV2> client,
+            DeviceType deviceType,
+            const Aws::Crt::String &deviceId,
+            const CommandDispatcherOptions &options,
+            Aws::Crt::Allocator *allocator)
+            : m_state(Aws::Crt::MakeShared<CommandDispatcherState>(
+                  allocator,
+                  std::move(client),
+                  deviceType,
+                  deviceId,
+                  options,
+                  allocator))
+        {
+            m_state->StartWorkers();
+        }
+
+        CommandDispatcher::~CommandDispatcher()
+        {
+            m_state->Stop();
+            m_state->Shutdown();
+        }
+
+        void CommandDispatcher::RegisterHandler(
+            const Aws::Crt::String &name,
+            const CommandHandler &handler,
+            size_t maxConcurrency)
+        {
+            m_state->RegisterHandler(name, handler, maxConcurrency);
+        }
+
+        void CommandDispatcher::SetDefaultHandler(const CommandHandler &handler, size_t maxConcurrency)
+        {
+            m_state->SetDefaultHandler(handler, maxConcurrency);
+        }
+
+        void CommandDispatcher::SetRouter(const CommandRouter &router)
+        {
+            m_state->SetRouter(router);
+        }
+
+        void CommandDispatcher::SetErrorHandler(const CommandDispatcherErrorHandler &handler)
+        {
+            m_state->SetErrorHandler(handler);
+        }
+
+        bool CommandDispatcher::Start()
+        {
+            return m_state->Start();
+        }
+
+        void CommandDispatcher::Stop()
+        {
+            m_state->Stop();
+        }
+
+        size_t CommandDispatcher::GetActiveExecutionCount() const
+        {
+            return m_state->GetActiveExecutionCount();
+        }
+
+    } // namespace Iotcommands
+} // namespace Aws
@@ -5,6 +5,9 @@
  */
 #include <aws/iotcommands/CommandExecutionResult.h>
 
+#include <aws/iotcommands/Cbor.h>
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotcommands
@@ -51,6 +54,47 @@ namespace Aws
             }
         }
 
+        void CommandExecutionResult::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (S)
+            {
+                writer.WithString("s", *S);
+            }
+
+            if (B)
+            {
+                writer.WithBool("b", *B);
+            }
+
+            if (Bin)
+            {
+                writer.WithString("bin", Aws::Crt::Base64Encode(*Bin));
+            }
+        }
+
+        void CommandExecutionResult::SerializeTo(CborWriter &writer) const
+        {
+            writer.WriteMapStart(static_cast<size_t>(S.has_value()) + B.has_value() + Bin.has_value());
+
+            if (S)
+            {
+                writer.WithString("s", *S);
+            }
+
+            if (B)
+            {
+                writer.WithBool("b", *B);
+            }
+
+            if (Bin)
+            {
+                /* CBOR carries binary natively, so unlike JSON the result is not base64 encoded */
+                writer.WithBytes("bin", *Bin);
+            }
+        }
+
         CommandExecutionResult::CommandExecutionResult(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
@@ -0,0 +1,544 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotcommands/CommandExpiryScheduler.h>
+
+#include <aws/common/clock.h>
+#include <aws/crt/StringUtils.h>
+#include <aws/crt/io/EventLoopGroup.h>
+#include <aws/io/event_loop.h>
+
+#include <aws/iotcommands/BorrowedCommandExecutionEvent.h>
+#include <aws/iotcommands/CommandExecutionEvent.h>
+#include <aws/iotcommands/CommandStatusReporter.h>
+#include <aws/iotcommands/UpdateCommandExecutionRequest.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        CommandCancellationToken::CommandCancellationToken()
+            : m_cancelled(std::make_shared<std::atomic<bool>>(false))
+        {
+        }
+
+        CommandExpirySchedulerOptions &CommandExpirySchedulerOptions::WithTickInterval(
+            std::chrono::milliseconds tickInterval)
+        {
+            m_tickInterval = tickInterval;
+            return *this;
+        }
+
+        CommandExpirySchedulerOptions &CommandExpirySchedulerOptions::WithEventLoopGroup(
+            Aws::Crt::Io::EventLoopGroup &eventLoopGroup)
+        {
+            m_eventLoopGroup = &eventLoopGroup;
+            return *this;
+        }
+
+        CommandExpirySchedulerOptions &CommandExpirySchedulerOptions::WithStatusReporter(
+            std::shared_ptr<CommandStatusReporter> statusReporter)
+        {
+            m_statusReporter = std::move(statusReporter);
+            return *this;
+        }
+
+        CommandExpirySchedulerOptions &CommandExpirySchedulerOptions::WithClock(std::function<uint64_t()> clock)
+        {
+            m_clock = std::move(clock);
+            return *this;
+        }
+
+        static const size_t WHEEL_LEVEL_BITS = 6;
+        static const size_t WHEEL_LEVEL_SLOTS = static_cast<size_t>(1) << WHEEL_LEVEL_BITS;
+        static const size_t WHEEL_LEVEL_MASK = WHEEL_LEVEL_SLOTS - 1;
+        static const size_t WHEEL_LEVEL_COUNT = 4;
+
+        /* Number of ticks the wheel spans; later deadlines are filed at its far end and re-filed from there */
+        static const uint64_t WHEEL_RANGE = static_cast<uint64_t>(1) << (WHEEL_LEVEL_BITS * WHEEL_LEVEL_COUNT);
+
+        using ExecutionIdList = Aws::Crt::List<Aws::Crt::String>;
+
+        struct TrackedCommandExpiry
+        {
+            CommandCancellationToken token;
+            uint64_t expiryTick = 0;
+            size_t slot = 0;
+            ExecutionIdList::iterator position;
+        };
+
+        struct ExecutionIdHash
+        {
+            size_t operator()(const Aws::Crt::String &executionId) const
+            {
+                return Aws::Crt::HashString(executionId.c_str());
+            }
+        };
+
+        using TrackedCommandExpiryMap = std::unordered_map<
+            Aws::Crt::String,
+            TrackedCommandExpiry,
+            ExecutionIdHash,
+            std::equal_to<Aws::Crt::String>,
+            Aws::Crt::StlAllocator<std::pair<const Aws::Crt::String, TrackedCommandExpiry>>>;
+
+        class CommandExpirySchedulerState : public std::enable_shared_from_this<CommandExpirySchedulerState>
+        {
+          public:
+            CommandExpirySchedulerState(
+                std::shared_ptr<IClientV2> client,
+                DeviceType deviceType,
+                const Aws::Crt::String &deviceId,
+                const CommandExpirySchedulerOptions &options,
+                Aws::Crt::Allocator *allocator)
+                : m_allocator(allocator), m_reporter(options.GetStatusReporter()), m_deviceType(deviceType),
+                  m_deviceId(deviceId), m_tickInterval(options.GetTickInterval()), m_clock(options.GetClock()),
+                  m_eventLoop(nullptr), m_tickNs(0), m_epochNs(0), m_currentTick(0),
+                  m_tracked(
+                      0,
+                      ExecutionIdHash(),
+                      std::equal_to<Aws::Crt::String>(),
+                      Aws::Crt::StlAllocator<std::pair<const Aws::Crt::String, TrackedCommandExpiry>>(allocator)),
+                  m_wheelRunning(false), m_stopped(false)
+            {
+                if (!m_reporter && client)
+                {
+                    m_reporter = Aws::Crt::MakeShared<CommandStatusReporter>(
+                        allocator, std::move(client), CommandStatusReporterOptions(), allocator);
+                }
+
+                if (options.GetEventLoopGroup() != nullptr)
+                {
+                    m_eventLoop =
+                        aws_event_loop_group_get_next_loop(options.GetEventLoopGroup()->GetUnderlyingHandle());
+                }
+
+                if (m_tickInterval.count() > 0)
+                {
+                    m_tickNs = aws_timestamp_convert(
+                        static_cast<uint64_t>(m_tickInterval.count()),
+                        AWS_TIMESTAMP_MILLIS,
+                        AWS_TIMESTAMP_NANOS,
+                        nullptr);
+                }
+
+                m_slots.resize(WHEEL_LEVEL_SLOTS * WHEEL_LEVEL_COUNT);
+            }
+
+            bool IsValid() const { return m_reporter && (m_eventLoop != nullptr || m_clock) && m_tickNs > 0; }
+
+            bool Track(
+                const Aws::Crt::String &executionId,
+                std::chrono::milliseconds timeout,
+                const CommandCancellationToken &token);
+
+            bool Untrack(const Aws::Crt::String &executionId)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return Remove(executionId);
+            }
+
+            size_t GetTrackedCount() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_tracked.size();
+            }
+
+            void Stop()
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_stopped = true;
+            }
+
+            bool ExpireDue()
+            {
+                if (!IsValid() || m_eventLoop != nullptr)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                Turn();
+                return true;
+            }
+
+            void OnTick() { Turn(); }
+
+          private:
+            /* Must be called with the lock held */
+            bool GetTime(uint64_t &now) const;
+
+            /* Must be called with the lock held; expiryTick must not be behind the current tick */
+            size_t GetSlot(uint64_t expiryTick) const;
+
+            /* Must be called with the lock held */
+            bool Remove(const Aws::Crt::String &executionId);
+
+            /* Must be called with the lock held */
+            void Advance(Aws::Crt::Vector<Aws::Crt::String> &expired);
+
+            /* Must be called with the lock held */
+            void Cascade(size_t level);
+
+            /* Only called by whoever set m_wheelRunning */
+            void ScheduleTick(uint64_t runAtNs);
+
+            /* Catches the wheel up with the clock, then keeps it turning while it holds executions */
+            void Turn();
+
+            void ReportTimedOut(const Aws::Crt::String &executionId);
+
+            Aws::Crt::Allocator *m_allocator;
+            std::shared_ptr<CommandStatusReporter> m_reporter;
+            DeviceType m_deviceType;
+            Aws::Crt::String m_deviceId;
+            std::chrono::milliseconds m_tickInterval;
+            std::function<uint64_t()> m_clock;
+            struct aws_event_loop *m_eventLoop;
+            uint64_t m_tickNs;
+
+            mutable std::mutex m_lock;
+            /* Tick n is due at m_epochNs + n * m_tickNs; the epoch is reset whenever the wheel is started */
+            uint64_t m_epochNs;
+            uint64_t m_currentTick;
+            TrackedCommandExpiryMap m_tracked;
+            /* Execution ids per slot, level by level; each level's slots cover 64 times the span of the level below */
+            Aws::Crt::Vector<ExecutionIdList> m_slots;
+            /* Set while the wheel holds executions; on an event loop, a tick task is then pending */
+            bool m_wheelRunning;
+            bool m_stopped;
+        };
+
+        struct ExpiryTickTask
+        {
+            ExpiryTickTask(Aws::Crt::Allocator *allocator, std::weak_ptr<CommandExpirySchedulerState> state)
+                : allocator(allocator), state(std::move(state))
+            {
+                AWS_ZERO_STRUCT(task);
+            }
+
+            struct aws_task task;
+            Aws::Crt::Allocator *allocator;
+            std::weak_ptr<CommandExpirySchedulerState> state;
+        };
+
+        static void s_onExpiryTick(struct aws_task *task, void *arg, enum aws_task_status status)
+        {
+            (void)task;
+
+            auto *tickTask = static_cast<ExpiryTickTask *>(arg);
+            if (status == AWS_TASK_STATUS_RUN_READY)
+            {
+                if (auto state = tickTask->state.lock())
+                {
+                    state->OnTick();
+                }
+            }
+
+            Aws::Crt::Delete(tickTask, tickTask->allocator);
+        }
+
+        bool CommandExpirySchedulerState::Track(
+            const Aws::Crt::String &executionId,
+            std::chrono::milliseconds timeout,
+            const CommandCancellationToken &token)
+        {
+            if (!IsValid())
+            {
+                aws_raise_error(AWS_ERROR_INVALID_STATE);
+                return false;
+            }
+
+            uint64_t timeoutNs = 0;
+            if (timeout.count() > 0)
+            {
+                timeoutNs = aws_timestamp_convert(
+                    static_cast<uint64_t>(timeout.count()), AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, nullptr);
+            }
+
+            bool startTicking = false;
+            uint64_t nextTickNs = 0;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_stopped)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                /* Read under the lock, so that a concurrent start of the wheel cannot move the epoch past it */
+                uint64_t now = 0;
+                if (!GetTime(now))
+                {
+                    return false;
+                }
+
+                if (!m_wheelRunning)
+                {
+                    /* The wheel is empty, so it can be restarted from now */
+                    m_epochNs = now;
+                    m_currentTick = 0;
+                }
+
+                Remove(executionId);
+
+                /* Round up, so that an execution never expires before its deadline */
+                uint64_t deadlineNs = now + timeoutNs;
+                uint64_t expiryTick = (deadlineNs - m_epochNs + m_tickNs - 1) / m_tickNs;
+                if (expiryTick <= m_currentTick)
+                {
+                    expiryTick = m_currentTick + 1;
+                }
+
+                TrackedCommandExpiry &tracked = m_tracked[executionId];
+                tracked.token = token;
+                tracked.expiryTick = expiryTick;
+                tracked.slot = GetSlot(expiryTick);
+                ExecutionIdList &slot = m_slots[tracked.slot];
+                tracked.position = slot.insert(slot.end(), executionId);
+
+                startTicking = !m_wheelRunning && m_eventLoop != nullptr;
+                m_wheelRunning = true;
+                nextTickNs = m_epochNs + (m_currentTick + 1) * m_tickNs;
+            }
+
+            if (startTicking)
+            {
+                ScheduleTick(nextTickNs);
+            }
+
+            return true;
+        }
+
+        bool CommandExpirySchedulerState::GetTime(uint64_t &now) const
+        {
+            if (m_eventLoop != nullptr)
+            {
+                return aws_event_loop_current_clock_time(m_eventLoop, &now) == AWS_OP_SUCCESS;
+            }
+
+            now = m_clock();
+            return true;
+        }
+
+        size_t CommandExpirySchedulerState::GetSlot(uint64_t expiryTick) const
+        {
+            uint64_t delta = expiryTick - m_currentTick;
+            if (delta >= WHEEL_RANGE)
+            {
+                expiryTick = m_currentTick + WHEEL_RANGE - 1;
+                delta = WHEEL_RANGE - 1;
+            }
+
+            size_t level = 0;
+            while (level + 1 < WHEEL_LEVEL_COUNT && (delta >> ((level + 1) * WHEEL_LEVEL_BITS)) != 0)
+            {
+                ++level;
+            }
+
+            size_t index = static_cast<size_t>(expiryTick >> (level * WHEEL_LEVEL_BITS)) & WHEEL_LEVEL_MASK;
+            return level * WHEEL_LEVEL_SLOTS + index;
+        }
+
+        bool CommandExpirySchedulerState::Remove(const Aws::Crt::String &executionId)
+        {
+            auto iter = m_tracked.find(executionId);
+            if (iter == m_tracked.end())
+            {
+                return false;
+            }
+
+            m_slots[iter->second.slot].erase(iter->second.position);
+            m_tracked.erase(iter);
+            return true;
+        }
+
+        void CommandExpirySchedulerState::Cascade(size_t level)
+        {
+            size_t index = static_cast<size_t>(m_currentTick >> (level * WHEEL_LEVEL_BITS)) & WHEEL_LEVEL_MASK;
+            ExecutionIdList &source = m_slots[level * WHEEL_LEVEL_SLOTS + index];
+
+            /* Every entry lands on a lower level, or a different top-level slot if its deadline is beyond range */
+            while (!source.empty())
+            {
+                TrackedCommandExpiry &tracked = m_tracked.find(source.front())->second;
+                tracked.slot = GetSlot(tracked.expiryTick);
+                ExecutionIdList &target = m_slots[tracked.slot];
+                target.splice(target.end(), source, source.begin());
+            }
+        }
+
+        void CommandExpirySchedulerState::Advance(Aws::Crt::Vector<Aws::Crt::String> &expired)
+        {
+            ++m_currentTick;
+
+            /* Whenever a level wraps around, the next slot of the level above is due to be spread out below */
+            for (size_t level = 1; level < WHEEL_LEVEL_COUNT; ++level)
+            {
+                if (((m_currentTick >> ((level - 1) * WHEEL_LEVEL_BITS)) & WHEEL_LEVEL_MASK) != 0)
+                {
+                    break;
+                }
+                Cascade(level);
+            }
+
+            ExecutionIdList &due = m_slots[static_cast<size_t>(m_currentTick) & WHEEL_LEVEL_MASK];
+            for (const auto &executionId : due)
+            {
+                auto iter = m_tracked.find(executionId);
+                iter->second.token.Cancel();
+                expired.push_back(executionId);
+                m_tracked.erase(iter);
+            }
+            due.clear();
+        }
+
+        void CommandExpirySchedulerState::ScheduleTick(uint64_t runAtNs)
+        {
+            auto *tickTask = Aws::Crt::New<ExpiryTickTask>(m_allocator, m_allocator, shared_from_this());
+            aws_task_init(&tickTask->task, s_onExpiryTick, tickTask, "CommandExpiryTick");
+            aws_event_loop_schedule_task_future(m_eventLoop, &tickTask->task, runAtNs);
+        }
+
+        void CommandExpirySchedulerState::Turn()
+        {
+            Aws::Crt::Vector<Aws::Crt::String> expired;
+            bool keepTicking = false;
+            uint64_t nextTickNs = 0;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!m_stopped)
+                {
+                    /* Catch up on ticks missed while the event loop was busy, or since ExpireDue was last called */
+                    uint64_t now = 0;
+                    uint64_t dueTick = GetTime(now) && now > m_epochNs ? (now - m_epochNs) / m_tickNs : 0;
+                    while (m_currentTick < dueTick && !m_tracked.empty())
+                    {
+                        Advance(expired);
+                    }
+
+                    keepTicking = !m_tracked.empty();
+                    nextTickNs = m_epochNs + (m_currentTick + 1) * m_tickNs;
+                }
+
+                m_wheelRunning = keepTicking;
+            }
+
+            if (keepTicking && m_eventLoop != nullptr)
+            {
+                ScheduleTick(nextTickNs);
+            }
+
+            for (const auto &executionId : expired)
+            {
+                ReportTimedOut(executionId);
+            }
+        }
+
+        void CommandExpirySchedulerState::ReportTimedOut(const Aws::Crt::String &executionId)
+        {
+            StatusReason statusReason;
+            statusReason.ReasonCode = "COMMAND_TIMEOUT";
+            statusReason.ReasonDescription = "the command did not complete before its timeout";
+
+            UpdateCommandExecutionRequest request;
+            request.DeviceType = m_deviceType;
+            request.DeviceId = m_deviceId;
+            request.ExecutionId = executionId;
+            request.Status = CommandExecutionStatus::TIMED_OUT;
+            request.StatusReason = statusReason;
+
+            /* Refused if the handler has already queued a final status, which then stands */
+            m_reporter->UpdateCommandExecution(request);
+        }
+
+        CommandExpiryScheduler::CommandExpiryScheduler(
+            std::shared_ptr<IClientV2> client,
+            DeviceType deviceType,
+            const Aws::Crt::String &deviceId,
+            const CommandExpirySchedulerOptions &options,
+            Aws::Crt::Allocator *allocator)
+            : m_state(Aws::Crt::MakeShared<CommandExpirySchedulerState>(
+                  allocator,
+                  std::move(client),
+                  deviceType,
+                  deviceId,
+                  options,
+                  allocator))
+        {
+        }
+
+        CommandExpiryScheduler::~CommandExpiryScheduler()
+        {
+            m_state->Stop();
+        }
+
+        bool CommandExpiryScheduler::Track(
+            const Aws::Crt::String &executionId,
+            std::chrono::milliseconds timeout,
+            const CommandCancellationToken &token)
+        {
+            return m_state->Track(executionId, timeout, token);
+        }
+
+        bool CommandExpiryScheduler::Track(
+            const CommandExecutionEvent &execution,
+            const CommandCancellationToken &token)
+        {
+            if (!execution.ExecutionId.has_value())
+            {
+                aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                return false;
+            }
+
+            if (!execution.Timeout.has_value())
+            {
+                return true;
+            }
+
+            return m_state->Track(*execution.ExecutionId, std::chrono::seconds(*execution.Timeout), token);
+        }
+
+        bool CommandExpiryScheduler::Track(
+            const BorrowedCommandExecutionEvent &execution,
+            const CommandCancellationToken &token)
+        {
+            if (!execution.GetTimeout().has_value())
+            {
+                return true;
+            }
+
+            struct aws_byte_cursor executionId = execution.GetExecutionId();
+            return m_state->Track(
+                Aws::Crt::String(reinterpret_cast<const char *>(executionId.ptr), executionId.len),
+                std::chrono::seconds(*execution.GetTimeout()),
+                token);
+        }
+
+        bool CommandExpiryScheduler::Untrack(const Aws::Crt::String &executionId)
+        {
+            return m_state->Untrack(executionId);
+        }
+
+        bool CommandExpiryScheduler::ExpireDue()
+        {
+            return m_state->ExpireDue();
+        }
+
+        size_t CommandExpiryScheduler::GetTrackedCount() const
+        {
+            return m_state->GetTrackedCount();
+        }
+
+        CommandExpiryScheduler::operator bool() const noexcept
+        {
+            return m_state->IsValid();
+        }
+
+    } // namespace Iotcommands
+} // namespace Aws
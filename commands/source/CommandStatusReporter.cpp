@@ -0,0 +1,298 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotcommands/CommandStatusReporter.h>
+
+#include <aws/iotcommands/UpdateCommandExecutionRequest.h>
+#include <aws/iotcommands/UpdateCommandExecutionResponse.h>
+#include <aws/iotcommands/V2ErrorResponse.h>
+
+#include <mutex>
+
+namespace Aws
+{
+    namespace Iotcommands
+    {
+
+        CommandStatusReporterOptions &CommandStatusReporterOptions::WithMaxInFlightUpdates(size_t maxInFlightUpdates)
+        {
+            m_maxInFlightUpdates = maxInFlightUpdates;
+            return *this;
+        }
+
+        CommandStatusReporterOptions &CommandStatusReporterOptions::WithTerminalRetryLimit(uint32_t terminalRetryLimit)
+        {
+            m_terminalRetryLimit = terminalRetryLimit;
+            return *this;
+        }
+
+        CommandStatusReporterOptions &CommandStatusReporterOptions::WithCborEncoding(bool useCbor)
+        {
+            m_useCbor = useCbor;
+            return *this;
+        }
+
+        using UpdateCommandExecutionResultHandlerList = Aws::Crt::Vector<UpdateCommandExecutionResultHandler>;
+
+        /*
+         * Update of one execution that has not been sent yet, plus the state of the update in flight.
+         */
+        struct PendingCommandStatus
+        {
+            Aws::Crt::Optional<UpdateCommandExecutionRequest> request;
+            UpdateCommandExecutionResultHandlerList handlers;
+            bool inFlight = false;
+            bool queued = false;
+            bool terminal = false;
+        };
+
+        struct CommandStatusUpdate
+        {
+            Aws::Crt::String key;
+            UpdateCommandExecutionRequest request;
+            UpdateCommandExecutionResultHandlerList handlers;
+            uint32_t retries = 0;
+        };
+
+        static bool s_isTerminalStatus(CommandExecutionStatus status)
+        {
+            return status != CommandExecutionStatus::IN_PROGRESS;
+        }
+
+        class CommandStatusReporterState : public std::enable_shared_from_this<CommandStatusReporterState>
+        {
+          public:
+            CommandStatusReporterState(
+                std::shared_ptr<IClientV2> client,
+                const CommandStatusReporterOptions &options,
+                Aws::Crt::Allocator *allocator)
+                : m_allocator(allocator), m_client(std::move(client)), m_options(options), m_inFlightUpdates(0)
+            {
+            }
+
+            bool UpdateCommandExecution(
+                const UpdateCommandExecutionRequest &request,
+                const UpdateCommandExecutionResultHandler &handler);
+
+            size_t GetPendingExecutionCount() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_executions.size();
+            }
+
+          private:
+            /* Must be called with the lock held */
+            bool HasUpdateSlot() const
+            {
+                return m_options.GetMaxInFlightUpdates() == 0 ||
+                       m_inFlightUpdates < m_options.GetMaxInFlightUpdates();
+            }
+
+            /* Must be called with the lock held */
+            void TakeUpdate(const Aws::Crt::String &key, PendingCommandStatus &pending, CommandStatusUpdate &update);
+
+            void SendUpdate(std::shared_ptr<CommandStatusUpdate> update);
+
+            void OnUpdateComplete(
+                const std::shared_ptr<CommandStatusUpdate> &update,
+                const UpdateCommandExecutionResult &result);
+
+            Aws::Crt::Allocator *m_allocator;
+            std::shared_ptr<IClientV2> m_client;
+            CommandStatusReporterOptions m_options;
+
+            mutable std::mutex m_lock;
+            Aws::Crt::Map<Aws::Crt::String, PendingCommandStatus> m_executions;
+
+            /* Executions waiting for an update slot, in the order their first update arrived */
+            Aws::Crt::List<Aws::Crt::String> m_queue;
+            size_t m_inFlightUpdates;
+        };
+
+        static Aws::Crt::String s_makeExecutionKey(const UpdateCommandExecutionRequest &request)
+        {
+            /* Device ids and execution ids cannot contain '/', so keys of different executions never collide */
+            Aws::Crt::String key(DeviceTypeMarshaller::ToString(*request.DeviceType));
+            key.append("/");
+            key.append(*request.DeviceId);
+            key.append("/");
+            key.append(*request.ExecutionId);
+            return key;
+        }
+
+        bool CommandStatusReporterState::UpdateCommandExecution(
+            const UpdateCommandExecutionRequest &request,
+            const UpdateCommandExecutionResultHandler &handler)
+        {
+            if (!request.DeviceType.has_value() || !request.DeviceId.has_value() || !request.ExecutionId.has_value() ||
+                !request.Status.has_value())
+            {
+                aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                return false;
+            }
+
+            Aws::Crt::String key = s_makeExecutionKey(request);
+
+            auto update = Aws::Crt::MakeShared<CommandStatusUpdate>(m_allocator);
+            bool sendNow = false;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+
+                PendingCommandStatus &pending = m_executions[key];
+                if (pending.terminal)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                /* Only IN_PROGRESS updates can be waiting here, and the latest one supersedes them */
+                pending.request = request;
+                if (handler)
+                {
+                    pending.handlers.push_back(handler);
+                }
+                pending.terminal = s_isTerminalStatus(*request.Status);
+
+                if (!pending.inFlight && !pending.queued)
+                {
+                    if (HasUpdateSlot())
+                    {
+                        ++m_inFlightUpdates;
+                        TakeUpdate(key, pending, *update);
+                        sendNow = true;
+                    }
+                    else
+                    {
+                        pending.queued = true;
+                        m_queue.push_back(key);
+                    }
+                }
+            }
+
+            if (sendNow)
+            {
+                SendUpdate(std::move(update));
+            }
+
+            return true;
+        }
+
+        void CommandStatusReporterState::TakeUpdate(
+            const Aws::Crt::String &key,
+            PendingCommandStatus &pending,
+            CommandStatusUpdate &update)
+        {
+            update.key = key;
+            update.request = std::move(*pending.request);
+            update.handlers = std::move(pending.handlers);
+
+            pending.request.reset();
+            pending.handlers.clear();
+            pending.inFlight = true;
+        }
+
+        void CommandStatusReporterState::SendUpdate(std::shared_ptr<CommandStatusUpdate> update)
+        {
+            auto state = shared_from_this();
+            auto resultHandler = [state, update](UpdateCommandExecutionResult &&result)
+            { state->OnUpdateComplete(update, result); };
+
+            bool submitted = m_options.GetCborEncoding()
+                                 ? m_client->UpdateCommandExecutionCbor(update->request, resultHandler)
+                                 : m_client->UpdateCommandExecution(update->request, resultHandler);
+            if (!submitted)
+            {
+                int errorCode = aws_last_error();
+                UpdateCommandExecutionResult failure(
+                    ServiceErrorV2<V2ErrorResponse>(errorCode != AWS_ERROR_SUCCESS ? errorCode : AWS_ERROR_UNKNOWN));
+                OnUpdateComplete(update, failure);
+            }
+        }
+
+        void CommandStatusReporterState::OnUpdateComplete(
+            const std::shared_ptr<CommandStatusUpdate> &update,
+            const UpdateCommandExecutionResult &result)
+        {
+            /* A terminal status that never reached the service would leave the execution to time out */
+            if (!result.IsSuccess() && !result.GetError().HasModeledError() &&
+                s_isTerminalStatus(*update->request.Status) && update->retries < m_options.GetTerminalRetryLimit())
+            {
+                ++update->retries;
+                SendUpdate(update);
+                return;
+            }
+
+            for (const auto &handler : update->handlers)
+            {
+                UpdateCommandExecutionResult handlerResult(result);
+                handler(std::move(handlerResult));
+            }
+
+            Aws::Crt::Vector<std::shared_ptr<CommandStatusUpdate>> nextUpdates;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+
+                auto iter = m_executions.find(update->key);
+                if (iter != m_executions.end())
+                {
+                    PendingCommandStatus &pending = iter->second;
+                    pending.inFlight = false;
+                    if (pending.request.has_value())
+                    {
+                        /* The execution keeps its slot for the update that waited on this one */
+                        nextUpdates.push_back(Aws::Crt::MakeShared<CommandStatusUpdate>(m_allocator));
+                        TakeUpdate(update->key, pending, *nextUpdates.back());
+                    }
+                    else
+                    {
+                        m_executions.erase(iter);
+                    }
+                }
+
+                if (nextUpdates.empty())
+                {
+                    --m_inFlightUpdates;
+                    while (HasUpdateSlot() && !m_queue.empty())
+                    {
+                        Aws::Crt::String key = std::move(m_queue.front());
+                        m_queue.pop_front();
+
+                        PendingCommandStatus &pending = m_executions[key];
+                        pending.queued = false;
+                        ++m_inFlightUpdates;
+                        nextUpdates.push_back(Aws::Crt::MakeShared<CommandStatusUpdate>(m_allocator));
+                        TakeUpdate(key, pending, *nextUpdates.back());
+                    }
+                }
+            }
+
+            for (auto &nextUpdate : nextUpdates)
+            {
+                SendUpdate(std::move(nextUpdate));
+            }
+        }
+
+        CommandStatusReporter::CommandStatusReporter(
+            std::shared_ptr<IClientV2> client,
+            const CommandStatusReporterOptions &options,
+            Aws::Crt::Allocator *allocator)
+            : m_state(
+                  Aws::Crt::MakeShared<CommandStatusReporterState>(allocator, std::move(client), options, allocator))
+        {
+        }
+
+        bool CommandStatusReporter::UpdateCommandExecution(
+            const UpdateCommandExecutionRequest &request,
+            const UpdateCommandExecutionResultHandler &handler)
+        {
+            return m_state->UpdateCommandExecution(request, handler);
+        }
+
+        size_t CommandStatusReporter::GetPendingExecutionCount() const
+        {
+            return m_state->GetPendingExecutionCount();
+        }
+
+    } // namespace Iotcommands
+} // namespace Aws
@@ -6,7 +6,11 @@
 #include <aws/iotcommands/IotCommandsClientV2.h>
 
 #include <aws/crt/UUID.h>
+#include <aws/iotdevicecommon/JsonWriter.h>
+#include <aws/iotdevicecommon/TopicBuilder.h>
 
+#include <aws/iotcommands/BorrowedCommandExecutionEvent.h>
+#include <aws/iotcommands/Cbor.h>
 #include <aws/iotcommands/CommandExecutionEvent.h>
 #include <aws/iotcommands/CommandExecutionsSubscriptionRequest.h>
 #include <aws/iotcommands/UpdateCommandExecutionRequest.h>
@@ -23,13 +27,18 @@ namespace Aws
           public:
             ClientV2(
                 Aws::Crt::Allocator *allocator,
-                std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient);
+                std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+                const ClientV2Options &clientOptions);
             virtual ~ClientV2() = default;
 
             bool UpdateCommandExecution(
                 const UpdateCommandExecutionRequest &request,
                 const UpdateCommandExecutionResultHandler &handler) override;
 
+            bool UpdateCommandExecutionCbor(
+                const UpdateCommandExecutionRequest &request,
+                const UpdateCommandExecutionResultHandler &handler) override;
+
             std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsCborPayloadStream(
                 const CommandExecutionsSubscriptionRequest &request,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<CommandExecutionEvent> &options) override;
@@ -42,16 +51,46 @@ namespace Aws
                 const CommandExecutionsSubscriptionRequest &request,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<CommandExecutionEvent> &options) override;
 
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsCborPayloadStream(
+                const CommandExecutionsSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent> &options)
+                override;
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsGenericPayloadStream(
+                const CommandExecutionsSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent> &options)
+                override;
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsJsonPayloadStream(
+                const CommandExecutionsSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent> &options)
+                override;
+
           private:
+            bool SubmitUpdateCommandExecution(
+                const UpdateCommandExecutionRequest &request,
+                const UpdateCommandExecutionResultHandler &handler,
+                struct aws_byte_cursor serializedRequest,
+                bool isCbor);
+
             Aws::Crt::Allocator *m_allocator;
 
             std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> m_bindingClient;
+
+            ClientV2Options m_clientOptions;
         };
 
+        ClientV2Options &ClientV2Options::WithSharedResponseSubscription(bool sharedResponseSubscription)
+        {
+            m_sharedResponseSubscription = sharedResponseSubscription;
+            return *this;
+        }
+
         ClientV2::ClientV2(
             Aws::Crt::Allocator *allocator,
-            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient)
-            : m_allocator(allocator), m_bindingClient(std::move(bindingClient))
+            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+            const ClientV2Options &clientOptions)
+            : m_allocator(allocator), m_bindingClient(std::move(bindingClient)), m_clientOptions(clientOptions)
         {
             // It's simpler to do this than branch the codegen based on the presence of streaming operations
             (void)m_allocator;
@@ -88,7 +127,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -98,23 +147,95 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 UpdateCommandExecutionResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<UpdateCommandExecutionResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
+        }
+
+        static void s_loadFromCbor(UpdateCommandExecutionResponse &response, const CborView &doc)
+        {
+            auto executionId = doc.GetMember("executionId").AsString();
+            if (executionId.has_value())
+            {
+                response.ExecutionId = *executionId;
+            }
+        }
+
+        static void s_loadFromCbor(V2ErrorResponse &error, const CborView &doc)
+        {
+            auto errorCode = doc.GetMember("error").AsString();
+            if (errorCode.has_value())
+            {
+                error.Error = RejectedErrorCodeMarshaller::FromString(*errorCode);
+            }
+
+            auto errorMessage = doc.GetMember("errorMessage").AsString();
+            if (errorMessage.has_value())
+            {
+                error.ErrorMessage = *errorMessage;
+            }
+
+            auto executionId = doc.GetMember("executionId").AsString();
+            if (executionId.has_value())
+            {
+                error.ExecutionId = *executionId;
+            }
+        }
+
+        static void s_UpdateCommandExecutionCborResponseHandler(
+            Aws::Iot::RequestResponse::UnmodeledResult &&result,
+            const UpdateCommandExecutionResultHandler &handler,
+            const Aws::Crt::String &successPathTopic,
+            const Aws::Crt::String &failurePathTopic)
+        {
+            using E = V2ErrorResponse;
+            using R = Aws::Iot::RequestResponse::Result<UpdateCommandExecutionResponse, ServiceErrorV2<E>>;
+
+            if (!result.IsSuccess())
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, result.GetError());
+                return;
+            }
+
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
             {
                 s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
+            CborView document(response.GetPayload());
+            if (document.GetType() != CborType::Map)
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                return;
+            }
+
+            if (isSuccessPath)
+            {
+                UpdateCommandExecutionResponse modeledResponse;
+                s_loadFromCbor(modeledResponse, document);
+                R finalResult(std::move(modeledResponse));
+                handler(std::move(finalResult));
+            }
+            else
+            {
+                V2ErrorResponse modeledError;
+                s_loadFromCbor(modeledError, document);
+                s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
         }
 
@@ -122,39 +243,99 @@ namespace Aws
             const UpdateCommandExecutionRequest &request,
             const UpdateCommandExecutionResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/commands/" << DeviceTypeMarshaller::ToString(*request.DeviceType) << "/"
-                               << *request.DeviceId << "/executions/" << *request.ExecutionId << "/response/json";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
-
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/commands/" << DeviceTypeMarshaller::ToString(*request.DeviceType) << "/"
-                                     << *request.DeviceId << "/executions/" << *request.ExecutionId
-                                     << "/response/accepted/json";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
-
-            Aws::Crt::StringStream subscriptionTopicStream1;
-            subscriptionTopicStream1 << "$aws/commands/" << DeviceTypeMarshaller::ToString(*request.DeviceType) << "/"
-                                     << *request.DeviceId << "/executions/" << *request.ExecutionId
-                                     << "/response/rejected/json";
-            Aws::Crt::String subscriptionTopic1 = subscriptionTopicStream1.str();
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
+
+            return SubmitUpdateCommandExecution(request, handler, writer.ToCursor(), false);
+        }
+
+        bool ClientV2::UpdateCommandExecutionCbor(
+            const UpdateCommandExecutionRequest &request,
+            const UpdateCommandExecutionResultHandler &handler)
+        {
+            CborWriter writer(m_allocator);
+            request.SerializeTo(writer);
+            if (!writer)
+            {
+                return false;
+            }
+
+            return SubmitUpdateCommandExecution(request, handler, writer.ToCursor(), true);
+        }
+
+        bool ClientV2::SubmitUpdateCommandExecution(
+            const UpdateCommandExecutionRequest &request,
+            const UpdateCommandExecutionResultHandler &handler,
+            struct aws_byte_cursor serializedRequest,
+            bool isCbor)
+        {
+            const char *payloadFormat = isCbor ? "cbor" : "json";
+
+            Aws::Iotdevicecommon::TopicBuilder publishTopic(m_allocator);
+            publishTopic.Append(
+                "$aws/commands/",
+                DeviceTypeMarshaller::ToString(*request.DeviceType),
+                "/",
+                *request.DeviceId,
+                "/executions/",
+                *request.ExecutionId,
+                "/response/",
+                payloadFormat);
+
+            Aws::Iotdevicecommon::TopicBuilder responsePathAccepted(m_allocator);
+            responsePathAccepted.Append(
+                "$aws/commands/",
+                DeviceTypeMarshaller::ToString(*request.DeviceType),
+                "/",
+                *request.DeviceId,
+                "/executions/",
+                *request.ExecutionId,
+                "/response/accepted/",
+                payloadFormat);
+
+            Aws::Iotdevicecommon::TopicBuilder responsePathRejected(m_allocator);
+            responsePathRejected.Append(
+                "$aws/commands/",
+                DeviceTypeMarshaller::ToString(*request.DeviceType),
+                "/",
+                *request.DeviceId,
+                "/executions/",
+                *request.ExecutionId,
+                "/response/rejected/",
+                payloadFormat);
 
             struct aws_byte_cursor subscriptionTopicFilters[2] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
-                Aws::Crt::ByteCursorFromString(subscriptionTopic1),
+                responsePathAccepted.ToCursor(),
+                responsePathRejected.ToCursor(),
             };
+            size_t subscriptionTopicFilterCount = 2;
+
+            /*
+             * A shared response subscription replaces the execution's own response topics with one wildcard filter per
+             * device and payload format.  Responses are still told apart by their exact topic.
+             */
+            Aws::Iotdevicecommon::TopicBuilder sharedSubscriptionTopic(m_allocator);
+            if (m_clientOptions.GetSharedResponseSubscription())
+            {
+                sharedSubscriptionTopic.Append(
+                    "$aws/commands/",
+                    DeviceTypeMarshaller::ToString(*request.DeviceType),
+                    "/",
+                    *request.DeviceId,
+                    "/executions/+/response/+/",
+                    payloadFormat);
+                subscriptionTopicFilters[0] = sharedSubscriptionTopic.ToCursor();
+                subscriptionTopicFilterCount = 1;
+            }
 
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << "$aws/commands/" << DeviceTypeMarshaller::ToString(*request.DeviceType)
-                                            << "/" << *request.DeviceId << "/executions/" << *request.ExecutionId
-                                            << "/response/accepted/json";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << "$aws/commands/" << DeviceTypeMarshaller::ToString(*request.DeviceType)
-                                            << "/" << *request.DeviceId << "/executions/" << *request.ExecutionId
-                                            << "/response/rejected/json";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            Aws::Crt::String responsePathTopicAccepted = responsePathAccepted.ToString();
+            Aws::Crt::String responsePathTopicRejected = responsePathRejected.ToString();
 
             struct aws_mqtt_request_operation_response_path responsePaths[2];
             responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
@@ -162,26 +343,28 @@ namespace Aws
             AWS_ZERO_STRUCT(responsePaths[0].correlation_token_json_path);
             AWS_ZERO_STRUCT(responsePaths[1].correlation_token_json_path);
 
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
-
             struct aws_mqtt_request_operation_options options;
             AWS_ZERO_STRUCT(options);
             options.subscription_topic_filters = subscriptionTopicFilters;
-            options.subscription_topic_filter_count = 2;
+            options.subscription_topic_filter_count = subscriptionTopicFilterCount;
             options.response_paths = responsePaths;
             options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            options.publish_topic = publishTopic.ToCursor();
+            options.serialized_request = serializedRequest;
 
-            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
+            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected, isCbor](
                                      Aws::Iot::RequestResponse::UnmodeledResult &&result)
             {
-                s_UpdateCommandExecutionResponseHandler(
-                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                if (isCbor)
+                {
+                    s_UpdateCommandExecutionCborResponseHandler(
+                        std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                }
+                else
+                {
+                    s_UpdateCommandExecutionResponseHandler(
+                        std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                }
             };
 
             int submitResult = m_bindingClient->SubmitRequest(options, std::move(resultHandler));
@@ -229,6 +412,26 @@ namespace Aws
             return true;
         }
 
+        static bool s_initModeledEvent(
+            const Aws::Iot::RequestResponse::IncomingPublishEvent &publishEvent,
+            BorrowedCommandExecutionEvent &modeledEvent)
+        {
+            auto segmentExecutionId = s_getSegmentFromTopic(publishEvent.GetTopic(), 5);
+            if (segmentExecutionId.ptr == nullptr || segmentExecutionId.len == 0)
+            {
+                return false;
+            }
+            Aws::Crt::Optional<int32_t> timeout;
+            auto messageExpiryIntervalSeconds = publishEvent.GetMessageExpiryIntervalSeconds();
+            if (messageExpiryIntervalSeconds)
+            {
+                timeout = static_cast<int32_t>(*messageExpiryIntervalSeconds);
+            }
+            modeledEvent = BorrowedCommandExecutionEvent(
+                segmentExecutionId, publishEvent.GetPayload(), publishEvent.GetContentType(), timeout);
+            return true;
+        }
+
         template <typename T> class ServiceStreamingOperation : public Aws::Iot::RequestResponse::IStreamingOperation
         {
           public:
@@ -240,7 +443,7 @@ namespace Aws
             static std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> Create(
                 Aws::Crt::Allocator *allocator,
                 const std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> &bindingClient,
-                const Aws::Crt::String &subscriptionTopicFilter,
+                struct aws_byte_cursor subscriptionTopicFilter,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<T> &options)
             {
 
@@ -256,7 +459,7 @@ namespace Aws
                 };
 
                 Aws::Iot::RequestResponse::StreamingOperationOptionsInternal internalOptions;
-                internalOptions.subscriptionTopicFilter = Aws::Crt::ByteCursorFromString(subscriptionTopicFilter);
+                internalOptions.subscriptionTopicFilter = subscriptionTopicFilter;
                 internalOptions.subscriptionStatusEventHandler = options.GetSubscriptionStatusEventHandler();
                 internalOptions.incomingPublishEventHandler = unmodeledHandler;
 
@@ -280,13 +483,16 @@ namespace Aws
                 const CommandExecutionsSubscriptionRequest &request,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<CommandExecutionEvent> &options)
         {
-            Aws::Crt::StringStream topicStream;
-            topicStream << "$aws/commands/" << DeviceTypeMarshaller::ToString(*request.DeviceType) << "/"
-                        << *request.DeviceId << "/executions/+/request/cbor";
-            Aws::Crt::String topic = topicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append(
+                "$aws/commands/",
+                DeviceTypeMarshaller::ToString(*request.DeviceType),
+                "/",
+                *request.DeviceId,
+                "/executions/+/request/cbor");
 
             return ServiceStreamingOperation<CommandExecutionEvent>::Create(
-                m_allocator, m_bindingClient, topic, options);
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
         }
 
         std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::
@@ -294,13 +500,16 @@ namespace Aws
                 const CommandExecutionsSubscriptionRequest &request,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<CommandExecutionEvent> &options)
         {
-            Aws::Crt::StringStream topicStream;
-            topicStream << "$aws/commands/" << DeviceTypeMarshaller::ToString(*request.DeviceType) << "/"
-                        << *request.DeviceId << "/executions/+/request";
-            Aws::Crt::String topic = topicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append(
+                "$aws/commands/",
+                DeviceTypeMarshaller::ToString(*request.DeviceType),
+                "/",
+                *request.DeviceId,
+                "/executions/+/request");
 
             return ServiceStreamingOperation<CommandExecutionEvent>::Create(
-                m_allocator, m_bindingClient, topic, options);
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
         }
 
         std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::
@@ -308,13 +517,67 @@ namespace Aws
                 const CommandExecutionsSubscriptionRequest &request,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<CommandExecutionEvent> &options)
         {
-            Aws::Crt::StringStream topicStream;
-            topicStream << "$aws/commands/" << DeviceTypeMarshaller::ToString(*request.DeviceType) << "/"
-                        << *request.DeviceId << "/executions/+/request/json";
-            Aws::Crt::String topic = topicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append(
+                "$aws/commands/",
+                DeviceTypeMarshaller::ToString(*request.DeviceType),
+                "/",
+                *request.DeviceId,
+                "/executions/+/request/json");
 
             return ServiceStreamingOperation<CommandExecutionEvent>::Create(
-                m_allocator, m_bindingClient, topic, options);
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::
+            CreateCommandExecutionsCborPayloadStream(
+                const CommandExecutionsSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append(
+                "$aws/commands/",
+                DeviceTypeMarshaller::ToString(*request.DeviceType),
+                "/",
+                *request.DeviceId,
+                "/executions/+/request/cbor");
+
+            return ServiceStreamingOperation<BorrowedCommandExecutionEvent>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::
+            CreateCommandExecutionsGenericPayloadStream(
+                const CommandExecutionsSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append(
+                "$aws/commands/",
+                DeviceTypeMarshaller::ToString(*request.DeviceType),
+                "/",
+                *request.DeviceId,
+                "/executions/+/request");
+
+            return ServiceStreamingOperation<BorrowedCommandExecutionEvent>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::
+            CreateCommandExecutionsJsonPayloadStream(
+                const CommandExecutionsSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<BorrowedCommandExecutionEvent> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append(
+                "$aws/commands/",
+                DeviceTypeMarshaller::ToString(*request.DeviceType),
+                "/",
+                *request.DeviceId,
+                "/executions/+/request/json");
+
+            return ServiceStreamingOperation<BorrowedCommandExecutionEvent>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
         }
 
         std::shared_ptr<IClientV2> NewClientFrom5(
@@ -322,6 +585,15 @@ namespace Aws
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
             Aws::Crt::Allocator *allocator)
         {
+            return NewClientFrom5(protocolClient, options, ClientV2Options(), allocator);
+        }
+
+        std::shared_ptr<IClientV2> NewClientFrom5(
+            const Aws::Crt::Mqtt5::Mqtt5Client &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            const ClientV2Options &clientOptions,
+            Aws::Crt::Allocator *allocator)
+        {
 
             std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient =
                 Aws::Iot::RequestResponse::NewClientFrom5(protocolClient, options, allocator);
@@ -330,12 +602,21 @@ namespace Aws
                 return nullptr;
             }
 
-            return Aws::Crt::MakeShared<ClientV2>(allocator, allocator, bindingClient);
+            return Aws::Crt::MakeShared<ClientV2>(allocator, allocator, bindingClient, clientOptions);
+        }
+
+        std::shared_ptr<IClientV2> NewClientFrom311(
+            const Aws::Crt::Mqtt::MqttConnection &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            Aws::Crt::Allocator *allocator)
+        {
+            return NewClientFrom311(protocolClient, options, ClientV2Options(), allocator);
         }
 
         std::shared_ptr<IClientV2> NewClientFrom311(
             const Aws::Crt::Mqtt::MqttConnection &protocolClient,
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            const ClientV2Options &clientOptions,
             Aws::Crt::Allocator *allocator)
         {
 
@@ -346,7 +627,21 @@ namespace Aws
                 return nullptr;
             }
 
-            return Aws::Crt::MakeShared<ClientV2>(allocator, allocator, bindingClient);
+            return Aws::Crt::MakeShared<ClientV2>(allocator, allocator, bindingClient, clientOptions);
+        }
+
+        std::shared_ptr<IClientV2> NewClientFromRequestResponseClient(
+            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+            const ClientV2Options &clientOptions,
+            Aws::Crt::Allocator *allocator)
+        {
+            if (nullptr == bindingClient)
+            {
+                aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                return nullptr;
+            }
+
+            return Aws::Crt::MakeShared<ClientV2>(allocator, allocator, std::move(bindingClient), clientOptions);
         }
 
     } // namespace Iotcommands
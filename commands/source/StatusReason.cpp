@@ -5,6 +5,9 @@
  */
 #include <aws/iotcommands/StatusReason.h>
 
+#include <aws/iotcommands/Cbor.h>
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotcommands
@@ -41,6 +44,36 @@ namespace Aws
             }
         }
 
+        void StatusReason::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (ReasonCode)
+            {
+                writer.WithString("reasonCode", *ReasonCode);
+            }
+
+            if (ReasonDescription)
+            {
+                writer.WithString("reasonDescription", *ReasonDescription);
+            }
+        }
+
+        void StatusReason::SerializeTo(CborWriter &writer) const
+        {
+            writer.WriteMapStart(static_cast<size_t>(ReasonCode.has_value()) + ReasonDescription.has_value());
+
+            if (ReasonCode)
+            {
+                writer.WithString("reasonCode", *ReasonCode);
+            }
+
+            if (ReasonDescription)
+            {
+                writer.WithString("reasonDescription", *ReasonDescription);
+            }
+        }
+
         StatusReason::StatusReason(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
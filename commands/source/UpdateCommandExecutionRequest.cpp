@@ -5,6 +5,9 @@
  */
 #include <aws/iotcommands/UpdateCommandExecutionRequest.h>
 
+#include <aws/iotcommands/Cbor.h>
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotcommands
@@ -71,6 +74,62 @@ namespace Aws
             }
         }
 
+        void UpdateCommandExecutionRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (Status)
+            {
+                writer.WithString("status", CommandExecutionStatusMarshaller::ToString(*Status));
+            }
+
+            if (StatusReason)
+            {
+                writer.BeginObject("statusReason");
+                StatusReason->SerializeTo(writer);
+                writer.EndObject();
+            }
+
+            if (Result)
+            {
+                writer.BeginObject("result");
+                for (auto &resultMapMember : *Result)
+                {
+                    writer.BeginObject(resultMapMember.first);
+                    resultMapMember.second.SerializeTo(writer);
+                    writer.EndObject();
+                }
+                writer.EndObject();
+            }
+        }
+
+        void UpdateCommandExecutionRequest::SerializeTo(CborWriter &writer) const
+        {
+            writer.WriteMapStart(
+                static_cast<size_t>(Status.has_value()) + StatusReason.has_value() + Result.has_value());
+
+            if (Status)
+            {
+                writer.WithString("status", CommandExecutionStatusMarshaller::ToString(*Status));
+            }
+
+            if (StatusReason)
+            {
+                writer.WriteText("statusReason");
+                StatusReason->SerializeTo(writer);
+            }
+
+            if (Result)
+            {
+                writer.WithMapStart("result", Result->size());
+                for (auto &resultMapMember : *Result)
+                {
+                    writer.WriteText(resultMapMember.first);
+                    resultMapMember.second.SerializeTo(writer);
+                }
+            }
+        }
+
         UpdateCommandExecutionRequest::UpdateCommandExecutionRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
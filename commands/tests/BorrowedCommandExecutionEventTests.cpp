@@ -0,0 +1,62 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotcommands/BorrowedCommandExecutionEvent.h>
+#include <aws/iotcommands/CommandExecutionEvent.h>
+
+#include <cstring>
+
+using namespace Aws::Iotcommands;
+
+static int s_BorrowedCommandExecutionEventDetach(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        char executionId[] = "execution-1";
+        char payload[] = "\x01\x02\x03 config blob";
+        char contentType[] = "application/octet-stream";
+
+        BorrowedCommandExecutionEvent event(
+            aws_byte_cursor_from_c_str(executionId),
+            aws_byte_cursor_from_c_str(payload),
+            Aws::Crt::Optional<Aws::Crt::ByteCursor>(aws_byte_cursor_from_c_str(contentType)),
+            Aws::Crt::Optional<int32_t>(30));
+        ASSERT_FALSE(event.IsDetached());
+        ASSERT_TRUE(event.GetPayload().ptr == reinterpret_cast<uint8_t *>(payload));
+
+        ASSERT_TRUE(event.Detach(allocator));
+        ASSERT_TRUE(event.IsDetached());
+        ASSERT_TRUE(event.Detach(allocator));
+
+        BorrowedCommandExecutionEvent copy = event;
+
+        /* The MQTT message is gone once the handler returns */
+        memset(executionId, 0, sizeof(executionId));
+        memset(payload, 0, sizeof(payload));
+        memset(contentType, 0, sizeof(contentType));
+        event = BorrowedCommandExecutionEvent();
+
+        Aws::Crt::ByteCursor detachedExecutionId = copy.GetExecutionId();
+        Aws::Crt::ByteCursor detachedPayload = copy.GetPayload();
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&detachedExecutionId, "execution-1"));
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&detachedPayload, "\x01\x02\x03 config blob"));
+        ASSERT_TRUE(copy.GetContentType().has_value());
+        ASSERT_TRUE(aws_byte_cursor_eq_c_str(&*copy.GetContentType(), "application/octet-stream"));
+        ASSERT_INT_EQUALS(30, *copy.GetTimeout());
+
+        CommandExecutionEvent owned = copy.ToEvent();
+        ASSERT_TRUE(*owned.ExecutionId == "execution-1");
+        ASSERT_INT_EQUALS(copy.GetPayload().len, owned.Payload->size());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(BorrowedCommandExecutionEventDetach, s_BorrowedCommandExecutionEventDetach)
@@ -0,0 +1,130 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotcommands/Cbor.h>
+#include <aws/iotcommands/UpdateCommandExecutionRequest.h>
+
+using namespace Aws::Iotcommands;
+
+static int s_CborEncodeUpdateRequest(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        CommandExecutionResult result;
+        result.Bin = Aws::Crt::Vector<uint8_t>{0x01, 0x02, 0x03};
+
+        UpdateCommandExecutionRequest request;
+        request.Status = CommandExecutionStatus::SUCCEEDED;
+        request.Result = Aws::Crt::Map<Aws::Crt::String, CommandExecutionResult>();
+        request.Result->emplace("out", std::move(result));
+
+        CborWriter writer(allocator);
+        request.SerializeTo(writer);
+        ASSERT_TRUE(writer);
+
+        /* {"status": "SUCCEEDED", "result": {"out": {"bin": h'010203'}}} */
+        const uint8_t expected[] = {0xA2, 0x66, 's',  't',  'a',  't',  'u',  's',  0x69, 'S',  'U',  'C', 'C',
+                                    'E',  'E',  'D',  'E',  'D',  0x66, 'r',  'e',  's',  'u',  'l',  't', 0xA1,
+                                    0x63, 'o',  'u',  't',  0xA1, 0x63, 'b',  'i',  'n',  0x43, 0x01, 0x02, 0x03};
+        struct aws_byte_cursor encoded = writer.ToCursor();
+        ASSERT_BIN_ARRAYS_EQUALS(expected, sizeof(expected), encoded.ptr, encoded.len);
+
+        CborWriter scalars(allocator);
+        scalars.WriteInt64(-500).WriteDouble(1.5).WriteDouble(0.1).WriteUInt64(UINT64_MAX);
+        ASSERT_TRUE(scalars);
+
+        CborReader reader(scalars.ToCursor(), allocator);
+        int64_t negative = 0;
+        double single = 0;
+        double full = 0;
+        bool flag = false;
+        uint64_t largest = 0;
+        ASSERT_TRUE(reader.PeekType() == CborType::NegativeInteger);
+        ASSERT_TRUE(reader.ReadInt64(negative));
+        ASSERT_TRUE(reader.PeekType() == CborType::Float);
+        ASSERT_TRUE(reader.ReadDouble(single));
+        ASSERT_TRUE(reader.ReadDouble(full));
+
+        /* An item of another type is left in place */
+        ASSERT_FALSE(reader.ReadBool(flag));
+        ASSERT_FALSE(reader.IsDone());
+        ASSERT_TRUE(reader.ReadUInt64(largest));
+        ASSERT_TRUE(reader.IsDone());
+
+        ASSERT_INT_EQUALS(-500, negative);
+        ASSERT_TRUE(single == 1.5);
+        ASSERT_TRUE(full == 0.1);
+        ASSERT_TRUE(largest == UINT64_MAX);
+
+        /* An integer beyond the range of int64_t is consumed but not returned */
+        struct aws_byte_cursor scalarsEncoded = scalars.ToCursor();
+        CborReader outOfRange(aws_byte_cursor_from_array(scalarsEncoded.ptr + scalarsEncoded.len - 9, 9), allocator);
+        ASSERT_FALSE(outOfRange.ReadInt64(negative));
+        ASSERT_TRUE(outOfRange.IsDone());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CborEncodeUpdateRequest, s_CborEncodeUpdateRequest)
+
+static int s_CborViewCommandPayload(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        /* {_ "name": "flash", "size": 1000000, "ratio": 1.5, "chunks": [_ -5, 1(1600000000)], "blob": h'0102',
+         * "flag": true} */
+        const uint8_t payload[] = {0xBF, 0x64, 'n',  'a',  'm',  'e',  0x65, 'f',  'l',  'a',  's',  'h',  0x64,
+                                   's',  'i',  'z',  'e',  0x1A, 0x00, 0x0F, 0x42, 0x40, 0x65, 'r',  'a',  't',
+                                   'i',  'o',  0xF9, 0x3E, 0x00, 0x66, 'c',  'h',  'u',  'n',  'k',  's',  0x9F,
+                                   0x24, 0xC1, 0x1A, 0x5F, 0x5E, 0x10, 0x00, 0xFF, 0x64, 'b',  'l',  'o',  'b',
+                                   0x42, 0x01, 0x02, 0x64, 'f',  'l',  'a',  'g',  0xF5, 0xFF};
+
+        CborView view(aws_byte_cursor_from_array(payload, sizeof(payload)), allocator);
+        ASSERT_TRUE(view.IsValid());
+        ASSERT_TRUE(view.GetType() == CborType::Map);
+        ASSERT_INT_EQUALS(6, view.GetLength());
+
+        ASSERT_TRUE(*view.GetMember("name").AsString() == "flash");
+        ASSERT_INT_EQUALS(1000000, *view.GetMember("size").AsInt64());
+        ASSERT_TRUE(*view.GetMember("ratio").AsDouble() == 1.5);
+        ASSERT_TRUE(*view.GetMember("flag").AsBool());
+        ASSERT_FALSE(view.ValueExists("missing"));
+        ASSERT_FALSE(view.GetMember("name").AsInt64().has_value());
+
+        CborView chunks = view.GetMember("chunks");
+        ASSERT_INT_EQUALS(2, chunks.GetLength());
+        ASSERT_INT_EQUALS(-5, *chunks.GetElement(0).AsInt64());
+        ASSERT_TRUE(chunks.GetElement(1).GetType() == CborType::UnsignedInteger);
+        ASSERT_INT_EQUALS(1600000000, *chunks.GetElement(1).AsInt64());
+        ASSERT_FALSE(chunks.GetElement(2).IsValid());
+
+        /* Strings are cursors into the payload */
+        struct aws_byte_cursor blob = *view.GetMember("blob").AsBytes();
+        ASSERT_INT_EQUALS(2, blob.len);
+        ASSERT_TRUE(blob.ptr == payload + 53);
+
+        /* Truncated and malformed payloads are rejected up front */
+        ASSERT_FALSE(CborView(aws_byte_cursor_from_array(payload, sizeof(payload) - 1), allocator).IsValid());
+        const uint8_t oversizedMap[] = {0xBB, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+        ASSERT_FALSE(CborView(aws_byte_cursor_from_array(oversizedMap, sizeof(oversizedMap)), allocator).IsValid());
+
+        /* Indefinite-length strings would have to be reassembled and are not returned */
+        const uint8_t chunkedText[] = {0x7F, 0x61, 'a', 0x61, 'b', 0xFF};
+        CborView chunked(aws_byte_cursor_from_array(chunkedText, sizeof(chunkedText)), allocator);
+        ASSERT_TRUE(chunked.GetType() == CborType::TextString);
+        ASSERT_FALSE(chunked.AsText().has_value());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CborViewCommandPayload, s_CborViewCommandPayload)
@@ -0,0 +1,169 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotcommands/CommandDispatcher.h>
+
+#include "RecordingCommandsClient.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace Aws::Iotcommands;
+
+static int s_CommandDispatcherRoutingAndDedup(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingCommandsClient>();
+        CommandDispatcher dispatcher(
+            client,
+            DeviceType::THING,
+            "thing",
+            CommandDispatcherOptions().WithPayloadFormats({CommandPayloadFormat::Json}),
+            allocator);
+
+        std::mutex lock;
+        std::condition_variable started;
+        std::vector<Aws::Crt::String> executions;
+        std::vector<CommandCompletionCallback> completions;
+        dispatcher.RegisterHandler(
+            "application/json",
+            [&](const BorrowedCommandExecutionEvent &execution, const CommandCompletionCallback &complete)
+            {
+                struct aws_byte_cursor executionId = execution.GetExecutionId();
+                std::lock_guard<std::mutex> guard(lock);
+                executions.emplace_back(reinterpret_cast<const char *>(executionId.ptr), executionId.len);
+                completions.push_back(complete);
+                started.notify_all();
+            });
+
+        auto waitForExecutions = [&](size_t count)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            return started.wait_for(
+                guard, std::chrono::seconds(5), [&executions, count]() { return executions.size() >= count; });
+        };
+
+        ASSERT_TRUE(dispatcher.Start());
+        ASSERT_TRUE(client->stream->opened);
+
+        /* The redelivery of "a" is dropped; "b" waits for the handler's only slot; "c" has expired in transit */
+        client->Deliver("a", nullptr, Aws::Crt::Optional<int32_t>(30));
+        client->Deliver("a", nullptr, Aws::Crt::Optional<int32_t>(30));
+        client->Deliver("b", nullptr, Aws::Crt::Optional<int32_t>());
+        client->Deliver("c", nullptr, Aws::Crt::Optional<int32_t>(0));
+        ASSERT_TRUE(waitForExecutions(1));
+        ASSERT_INT_EQUALS(2, dispatcher.GetActiveExecutionCount());
+
+        /* No handler and no default handler */
+        client->Deliver("d", "application/x-unknown", Aws::Crt::Optional<int32_t>());
+        ASSERT_TRUE(client->WaitForUpdates(1));
+        {
+            std::lock_guard<std::mutex> guard(client->lock);
+            ASSERT_TRUE(*client->updateRequests[0].ExecutionId == "d");
+            ASSERT_TRUE(*client->updateRequests[0].Status == CommandExecutionStatus::REJECTED);
+            ASSERT_TRUE(*client->updateRequests[0].StatusReason->ReasonCode == "UNSUPPORTED_COMMAND");
+        }
+
+        CommandCompletionCallback completeA;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ASSERT_INT_EQUALS(1, executions.size());
+            ASSERT_TRUE(executions[0] == "a");
+            completeA = completions[0];
+        }
+
+        completeA(CommandExecutionStatus::SUCCEEDED, StatusReason(), {});
+        completeA(CommandExecutionStatus::FAILED, StatusReason(), {});
+        ASSERT_TRUE(waitForExecutions(2));
+        ASSERT_TRUE(client->WaitForUpdates(2));
+
+        /* "a" is remembered after it finished */
+        client->Deliver("a", nullptr, Aws::Crt::Optional<int32_t>(30));
+
+        CommandCompletionCallback completeB;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ASSERT_INT_EQUALS(2, executions.size());
+            ASSERT_TRUE(executions[1] == "b");
+            completeB = completions[1];
+        }
+        {
+            std::lock_guard<std::mutex> guard(client->lock);
+            ASSERT_INT_EQUALS(2, client->updateRequests.size());
+            ASSERT_TRUE(*client->updateRequests[1].ExecutionId == "a");
+            ASSERT_TRUE(*client->updateRequests[1].Status == CommandExecutionStatus::SUCCEEDED);
+            ASSERT_FALSE(client->updateRequests[1].StatusReason.has_value());
+            ASSERT_FALSE(client->updateRequests[1].Result.has_value());
+        }
+
+        completeB(CommandExecutionStatus::FAILED, StatusReason(), {});
+        ASSERT_TRUE(client->WaitForUpdates(3));
+        ASSERT_INT_EQUALS(0, dispatcher.GetActiveExecutionCount());
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ASSERT_INT_EQUALS(2, executions.size());
+        }
+
+        /* Unanswered updates keep the dispatcher's status reporter, and with it the client, alive */
+        std::lock_guard<std::mutex> guard(client->lock);
+        client->updateHandlers.clear();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CommandDispatcherRoutingAndDedup, s_CommandDispatcherRoutingAndDedup)
+
+static int s_CommandDispatcherStartStop(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingCommandsClient>();
+        CommandDispatcher dispatcher(
+            client,
+            DeviceType::THING,
+            "thing",
+            CommandDispatcherOptions().WithPayloadFormats({CommandPayloadFormat::Json}),
+            allocator);
+
+        ASSERT_TRUE(dispatcher.Start());
+        ASSERT_INT_EQUALS(1, client->streamCount);
+        ASSERT_TRUE(client->stream->opened);
+
+        /* A second start neither subscribes again nor reopens the stream */
+        client->stream->opened = false;
+        ASSERT_TRUE(dispatcher.Start());
+        ASSERT_INT_EQUALS(1, client->streamCount);
+        ASSERT_FALSE(client->stream->opened);
+
+        /* Stopping releases the stream, and a later start subscribes again */
+        dispatcher.Stop();
+        ASSERT_INT_EQUALS(1, client->stream.use_count());
+        ASSERT_TRUE(dispatcher.Start());
+        ASSERT_INT_EQUALS(2, client->streamCount);
+        ASSERT_TRUE(client->stream->opened);
+        dispatcher.Stop();
+
+        /* A stop while the streams are being created fails the start, which then releases them */
+        client->onCreateStream = [&dispatcher]() { dispatcher.Stop(); };
+        ASSERT_FALSE(dispatcher.Start());
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_STATE, aws_last_error());
+        ASSERT_INT_EQUALS(3, client->streamCount);
+        ASSERT_FALSE(client->stream->opened);
+        ASSERT_INT_EQUALS(1, client->stream.use_count());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CommandDispatcherStartStop, s_CommandDispatcherStartStop)
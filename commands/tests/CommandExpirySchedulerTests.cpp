@@ -0,0 +1,277 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/crt/io/EventLoopGroup.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotcommands/CommandExpiryScheduler.h>
+
+#include "RecordingCommandsClient.h"
+
+#include <chrono>
+#include <mutex>
+
+using namespace Aws::Iotcommands;
+
+static int s_CommandExpirySchedulerTimesOut(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        auto client = std::make_shared<RecordingCommandsClient>();
+        client->autoAccept = true;
+        CommandExpiryScheduler scheduler(
+            client,
+            DeviceType::THING,
+            "thing",
+            CommandExpirySchedulerOptions()
+                .WithTickInterval(std::chrono::milliseconds(10))
+                .WithEventLoopGroup(eventLoopGroup),
+            allocator);
+        ASSERT_TRUE(scheduler);
+
+        /* The event loop turns the wheel */
+        ASSERT_FALSE(scheduler.ExpireDue());
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_STATE, aws_last_error());
+
+        CommandCancellationToken expiring;
+        CommandCancellationToken finished;
+        CommandCancellationToken distant;
+        ASSERT_TRUE(scheduler.Track("expiring", std::chrono::milliseconds(50), expiring));
+        ASSERT_TRUE(scheduler.Track("finished", std::chrono::minutes(10), finished));
+        ASSERT_TRUE(scheduler.Track("distant", std::chrono::hours(1), distant));
+        ASSERT_INT_EQUALS(3, scheduler.GetTrackedCount());
+
+        /* Executions without a timeout are left alone */
+        CommandExecutionEvent untimed;
+        untimed.ExecutionId = "untimed";
+        ASSERT_TRUE(scheduler.Track(untimed, CommandCancellationToken()));
+        ASSERT_INT_EQUALS(3, scheduler.GetTrackedCount());
+
+        ASSERT_TRUE(scheduler.Untrack("finished"));
+
+        ASSERT_TRUE(client->WaitForUpdates(1));
+        ASSERT_TRUE(expiring.IsCancelled());
+        ASSERT_FALSE(scheduler.Untrack("expiring"));
+        {
+            std::lock_guard<std::mutex> guard(client->lock);
+            ASSERT_INT_EQUALS(1, client->updateRequests.size());
+            ASSERT_TRUE(*client->updateRequests[0].ExecutionId == "expiring");
+            ASSERT_TRUE(*client->updateRequests[0].Status == CommandExecutionStatus::TIMED_OUT);
+            ASSERT_TRUE(*client->updateRequests[0].StatusReason->ReasonCode == "COMMAND_TIMEOUT");
+        }
+
+        ASSERT_FALSE(finished.IsCancelled());
+        ASSERT_FALSE(distant.IsCancelled());
+        ASSERT_TRUE(scheduler.Untrack("distant"));
+        ASSERT_INT_EQUALS(0, scheduler.GetTrackedCount());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CommandExpirySchedulerTimesOut, s_CommandExpirySchedulerTimesOut)
+
+/* Tick interval of the schedulers that the tests turn by hand */
+static const uint64_t TEST_TICK_NS = 1000000;
+
+static CommandExpirySchedulerOptions s_manualOptions(const uint64_t &now)
+{
+    return CommandExpirySchedulerOptions()
+        .WithTickInterval(std::chrono::milliseconds(1))
+        .WithClock([&now]() { return now; });
+}
+
+static int s_CommandExpirySchedulerCascade(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        uint64_t now = 0;
+        auto client = std::make_shared<RecordingCommandsClient>();
+        client->autoAccept = true;
+        CommandExpiryScheduler scheduler(client, DeviceType::THING, "thing", s_manualOptions(now), allocator);
+        ASSERT_TRUE(scheduler);
+
+        /* One deadline per level of the wheel; the higher ones move down a level at a time */
+        struct
+        {
+            const char *executionId;
+            uint64_t expiryTick;
+            CommandCancellationToken token;
+        } executions[] = {
+            {"level0", 40, {}},
+            {"level1", 64 + 36, {}},
+            {"level2", 64 * 64 + 5, {}},
+            {"level3", 64 * 64 * 64 + 7, {}},
+        };
+        for (auto &execution : executions)
+        {
+            ASSERT_TRUE(scheduler.Track(
+                execution.executionId, std::chrono::milliseconds(execution.expiryTick), execution.token));
+        }
+        ASSERT_INT_EQUALS(4, scheduler.GetTrackedCount());
+
+        /* Each execution expires on its own tick, neither earlier nor later */
+        size_t expiredCount = 0;
+        for (auto &execution : executions)
+        {
+            now = (execution.expiryTick - 1) * TEST_TICK_NS;
+            ASSERT_TRUE(scheduler.ExpireDue());
+            ASSERT_FALSE(execution.token.IsCancelled());
+            ASSERT_INT_EQUALS(expiredCount, client->updateRequests.size());
+
+            now = execution.expiryTick * TEST_TICK_NS;
+            ASSERT_TRUE(scheduler.ExpireDue());
+            ASSERT_TRUE(execution.token.IsCancelled());
+            ++expiredCount;
+            ASSERT_INT_EQUALS(expiredCount, client->updateRequests.size());
+            ASSERT_TRUE(*client->updateRequests.back().ExecutionId == execution.executionId);
+            ASSERT_INT_EQUALS(4 - expiredCount, scheduler.GetTrackedCount());
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CommandExpirySchedulerCascade, s_CommandExpirySchedulerCascade)
+
+static int s_CommandExpirySchedulerBeyondRange(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        uint64_t now = 0;
+        auto client = std::make_shared<RecordingCommandsClient>();
+        client->autoAccept = true;
+        CommandExpiryScheduler scheduler(client, DeviceType::THING, "thing", s_manualOptions(now), allocator);
+        ASSERT_TRUE(scheduler);
+
+        /* Past the 64^4 ticks the wheel spans, so filed at its far end and re-filed when the top level comes round */
+        const uint64_t expiryTick = (static_cast<uint64_t>(1) << 24) + 100;
+        CommandCancellationToken distant;
+        ASSERT_TRUE(scheduler.Track("distant", std::chrono::milliseconds(expiryTick), distant));
+
+        now = ((static_cast<uint64_t>(1) << 24) - 1) * TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_FALSE(distant.IsCancelled());
+
+        now = (expiryTick - 1) * TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_FALSE(distant.IsCancelled());
+        ASSERT_INT_EQUALS(1, scheduler.GetTrackedCount());
+
+        now = expiryTick * TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_TRUE(distant.IsCancelled());
+        ASSERT_INT_EQUALS(0, scheduler.GetTrackedCount());
+        ASSERT_INT_EQUALS(1, client->updateRequests.size());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CommandExpirySchedulerBeyondRange, s_CommandExpirySchedulerBeyondRange)
+
+static int s_CommandExpirySchedulerCatchUp(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        uint64_t now = 0;
+        auto client = std::make_shared<RecordingCommandsClient>();
+        client->autoAccept = true;
+        CommandExpiryScheduler scheduler(client, DeviceType::THING, "thing", s_manualOptions(now), allocator);
+        ASSERT_TRUE(scheduler);
+
+        CommandCancellationToken later;
+        ASSERT_TRUE(scheduler.Track("c", std::chrono::milliseconds(20), CommandCancellationToken()));
+        ASSERT_TRUE(scheduler.Track("a", std::chrono::milliseconds(5), CommandCancellationToken()));
+        ASSERT_TRUE(scheduler.Track("later", std::chrono::milliseconds(200), later));
+        ASSERT_TRUE(scheduler.Track("b", std::chrono::milliseconds(10), CommandCancellationToken()));
+
+        /* Missed ticks are all turned at once, expiring their executions in deadline order */
+        now = 50 * TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_INT_EQUALS(3, client->updateRequests.size());
+        ASSERT_TRUE(*client->updateRequests[0].ExecutionId == "a");
+        ASSERT_TRUE(*client->updateRequests[1].ExecutionId == "b");
+        ASSERT_TRUE(*client->updateRequests[2].ExecutionId == "c");
+        ASSERT_FALSE(later.IsCancelled());
+        ASSERT_INT_EQUALS(1, scheduler.GetTrackedCount());
+
+        now = 1000 * TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_TRUE(later.IsCancelled());
+        ASSERT_INT_EQUALS(4, client->updateRequests.size());
+
+        /* Once empty, the wheel restarts from the next tracked execution rather than from its old epoch */
+        CommandCancellationToken restarted;
+        now += TEST_TICK_NS / 2;
+        ASSERT_TRUE(scheduler.Track("restarted", std::chrono::milliseconds(10), restarted));
+        now += 9 * TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_FALSE(restarted.IsCancelled());
+        now += TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_TRUE(restarted.IsCancelled());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CommandExpirySchedulerCatchUp, s_CommandExpirySchedulerCatchUp)
+
+static int s_CommandExpirySchedulerReplace(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        uint64_t now = 0;
+        auto client = std::make_shared<RecordingCommandsClient>();
+        client->autoAccept = true;
+        CommandExpiryScheduler scheduler(client, DeviceType::THING, "thing", s_manualOptions(now), allocator);
+        ASSERT_TRUE(scheduler);
+
+        /* A later deadline replaces the earlier one, along with its token */
+        CommandCancellationToken first;
+        CommandCancellationToken extended;
+        ASSERT_TRUE(scheduler.Track("a", std::chrono::milliseconds(10), first));
+        ASSERT_TRUE(scheduler.Track("a", std::chrono::milliseconds(100), extended));
+        ASSERT_INT_EQUALS(1, scheduler.GetTrackedCount());
+
+        now = 99 * TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_INT_EQUALS(0, client->updateRequests.size());
+
+        now = 100 * TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_FALSE(first.IsCancelled());
+        ASSERT_TRUE(extended.IsCancelled());
+        ASSERT_INT_EQUALS(1, client->updateRequests.size());
+
+        /* So does an earlier one */
+        CommandCancellationToken distant;
+        CommandCancellationToken shortened;
+        ASSERT_TRUE(scheduler.Track("b", std::chrono::hours(1), distant));
+        ASSERT_TRUE(scheduler.Track("b", std::chrono::milliseconds(20), shortened));
+        ASSERT_INT_EQUALS(1, scheduler.GetTrackedCount());
+
+        now = 120 * TEST_TICK_NS;
+        ASSERT_TRUE(scheduler.ExpireDue());
+        ASSERT_FALSE(distant.IsCancelled());
+        ASSERT_TRUE(shortened.IsCancelled());
+        ASSERT_INT_EQUALS(2, client->updateRequests.size());
+        ASSERT_INT_EQUALS(0, scheduler.GetTrackedCount());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CommandExpirySchedulerReplace, s_CommandExpirySchedulerReplace)
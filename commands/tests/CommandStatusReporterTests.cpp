@@ -0,0 +1,86 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotcommands/CommandStatusReporter.h>
+
+#include "RecordingCommandsClient.h"
+
+using namespace Aws::Iotcommands;
+
+static UpdateCommandExecutionRequest s_makeUpdate(const char *executionId, CommandExecutionStatus status)
+{
+    UpdateCommandExecutionRequest request;
+    request.DeviceType = DeviceType::THING;
+    request.DeviceId = "thing";
+    request.ExecutionId = executionId;
+    request.Status = status;
+    return request;
+}
+
+static int s_CommandStatusReporterPipelining(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingCommandsClient>();
+        CommandStatusReporter reporter(client, CommandStatusReporterOptions().WithMaxInFlightUpdates(1), allocator);
+
+        int progressCompleted = 0;
+        int finalCompleted = 0;
+        auto onProgress = [&progressCompleted](UpdateCommandExecutionResult &&) { ++progressCompleted; };
+        auto onFinal = [&finalCompleted](UpdateCommandExecutionResult &&result)
+        {
+            if (result.IsSuccess())
+            {
+                ++finalCompleted;
+            }
+        };
+
+        auto progress = s_makeUpdate("a", CommandExecutionStatus::IN_PROGRESS);
+        ASSERT_TRUE(reporter.UpdateCommandExecution(progress, onProgress));
+        ASSERT_INT_EQUALS(1, client->updateRequests.size());
+
+        /* Both progress updates wait for the first and are superseded by the final status */
+        ASSERT_TRUE(reporter.UpdateCommandExecution(s_makeUpdate("a", CommandExecutionStatus::IN_PROGRESS), onFinal));
+        ASSERT_TRUE(reporter.UpdateCommandExecution(s_makeUpdate("a", CommandExecutionStatus::IN_PROGRESS), onFinal));
+        ASSERT_TRUE(reporter.UpdateCommandExecution(s_makeUpdate("a", CommandExecutionStatus::SUCCEEDED), onFinal));
+        ASSERT_FALSE(reporter.UpdateCommandExecution(s_makeUpdate("a", CommandExecutionStatus::FAILED), onFinal));
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_STATE, aws_last_error());
+
+        /* "b" waits for the only update slot */
+        ASSERT_TRUE(reporter.UpdateCommandExecution(s_makeUpdate("b", CommandExecutionStatus::IN_PROGRESS)));
+        ASSERT_INT_EQUALS(1, client->updateRequests.size());
+        ASSERT_INT_EQUALS(2, reporter.GetPendingExecutionCount());
+
+        client->AnswerUpdate(AWS_ERROR_SUCCESS);
+        ASSERT_INT_EQUALS(1, progressCompleted);
+        ASSERT_INT_EQUALS(2, client->updateRequests.size());
+        ASSERT_TRUE(*client->updateRequests[1].ExecutionId == "a");
+        ASSERT_TRUE(*client->updateRequests[1].Status == CommandExecutionStatus::SUCCEEDED);
+
+        /* A terminal update that timed out is resent before any handler sees the failure */
+        client->AnswerUpdate(AWS_ERROR_MQTT_REQUEST_RESPONSE_TIMEOUT);
+        ASSERT_INT_EQUALS(3, client->updateRequests.size());
+        ASSERT_TRUE(*client->updateRequests[2].Status == CommandExecutionStatus::SUCCEEDED);
+        ASSERT_INT_EQUALS(0, finalCompleted);
+
+        client->AnswerUpdate(AWS_ERROR_SUCCESS);
+        ASSERT_INT_EQUALS(3, finalCompleted);
+        ASSERT_INT_EQUALS(4, client->updateRequests.size());
+        ASSERT_TRUE(*client->updateRequests[3].ExecutionId == "b");
+        ASSERT_INT_EQUALS(1, reporter.GetPendingExecutionCount());
+
+        client->AnswerUpdate(AWS_ERROR_SUCCESS);
+        ASSERT_INT_EQUALS(0, reporter.GetPendingExecutionCount());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CommandStatusReporterPipelining, s_CommandStatusReporterPipelining)
@@ -0,0 +1,174 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Types.h>
+
+#include <aws/iotcommands/BorrowedCommandExecutionEvent.h>
+#include <aws/iotcommands/CommandExecutionEvent.h>
+#include <aws/iotcommands/CommandExecutionsSubscriptionRequest.h>
+#include <aws/iotcommands/IotCommandsClientV2.h>
+#include <aws/iotcommands/UpdateCommandExecutionRequest.h>
+#include <aws/iotcommands/UpdateCommandExecutionResponse.h>
+#include <aws/iotcommands/V2ErrorResponse.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+class RecordingCommandsStream : public Aws::Iot::RequestResponse::IStreamingOperation
+{
+  public:
+    void Open() override { opened = true; }
+
+    bool opened = false;
+};
+
+/*
+ * Fake commands service client shared by the commands unit tests.  Captures the borrowed JSON execution stream and
+ * records status updates, which may arrive on worker or event loop threads.  Answers updates right away if
+ * autoAccept is set, otherwise the test decides when and how the service answers them.
+ */
+class RecordingCommandsClient : public Aws::Iotcommands::IClientV2
+{
+  public:
+    bool UpdateCommandExecution(
+        const Aws::Iotcommands::UpdateCommandExecutionRequest &request,
+        const Aws::Iotcommands::UpdateCommandExecutionResultHandler &handler) override
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            updateRequests.push_back(request);
+            if (!autoAccept)
+            {
+                updateHandlers.push_back(handler);
+            }
+            updated.notify_all();
+        }
+
+        if (autoAccept)
+        {
+            handler(Aws::Iotcommands::UpdateCommandExecutionResult(Aws::Iotcommands::UpdateCommandExecutionResponse()));
+        }
+
+        return true;
+    }
+
+    bool UpdateCommandExecutionCbor(
+        const Aws::Iotcommands::UpdateCommandExecutionRequest &,
+        const Aws::Iotcommands::UpdateCommandExecutionResultHandler &) override
+    {
+        return false;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsCborPayloadStream(
+        const Aws::Iotcommands::CommandExecutionsSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotcommands::CommandExecutionEvent> &) override
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsGenericPayloadStream(
+        const Aws::Iotcommands::CommandExecutionsSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotcommands::CommandExecutionEvent> &) override
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsJsonPayloadStream(
+        const Aws::Iotcommands::CommandExecutionsSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotcommands::CommandExecutionEvent> &) override
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsCborPayloadStream(
+        const Aws::Iotcommands::CommandExecutionsSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotcommands::BorrowedCommandExecutionEvent> &)
+        override
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsGenericPayloadStream(
+        const Aws::Iotcommands::CommandExecutionsSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotcommands::BorrowedCommandExecutionEvent> &)
+        override
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateCommandExecutionsJsonPayloadStream(
+        const Aws::Iotcommands::CommandExecutionsSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotcommands::BorrowedCommandExecutionEvent>
+            &options) override
+    {
+        ++streamCount;
+        executionHandler = options.GetStreamHandler();
+        stream = std::make_shared<RecordingCommandsStream>();
+        if (onCreateStream)
+        {
+            onCreateStream();
+        }
+        return stream;
+    }
+
+    /* Delivers an execution with an empty JSON payload on the captured stream */
+    void Deliver(const char *executionId, const char *contentType, Aws::Crt::Optional<int32_t> timeout)
+    {
+        Aws::Crt::Optional<struct aws_byte_cursor> contentTypeCursor;
+        if (contentType != nullptr)
+        {
+            contentTypeCursor = aws_byte_cursor_from_c_str(contentType);
+        }
+
+        executionHandler(Aws::Iotcommands::BorrowedCommandExecutionEvent(
+            aws_byte_cursor_from_c_str(executionId),
+            aws_byte_cursor_from_c_str("{}"),
+            contentTypeCursor,
+            timeout));
+    }
+
+    /* Answers the oldest unanswered update, successfully or with the given error */
+    void AnswerUpdate(int errorCode)
+    {
+        Aws::Iotcommands::UpdateCommandExecutionResultHandler handler;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            handler = std::move(updateHandlers.front());
+            updateHandlers.erase(updateHandlers.begin());
+        }
+
+        if (errorCode == AWS_ERROR_SUCCESS)
+        {
+            handler(Aws::Iotcommands::UpdateCommandExecutionResult(Aws::Iotcommands::UpdateCommandExecutionResponse()));
+        }
+        else
+        {
+            handler(Aws::Iotcommands::UpdateCommandExecutionResult(
+                Aws::Iotcommands::ServiceErrorV2<Aws::Iotcommands::V2ErrorResponse>(errorCode)));
+        }
+    }
+
+    bool WaitForUpdates(size_t count)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        return updated.wait_for(
+            guard, std::chrono::seconds(5), [this, count]() { return updateRequests.size() >= count; });
+    }
+
+    bool autoAccept = false;
+
+    std::mutex lock;
+    std::condition_variable updated;
+    std::vector<Aws::Iotcommands::UpdateCommandExecutionRequest> updateRequests;
+    std::vector<Aws::Iotcommands::UpdateCommandExecutionResultHandler> updateHandlers;
+
+    int streamCount = 0;
+    std::function<void()> onCreateStream;
+    std::function<void(Aws::Iotcommands::BorrowedCommandExecutionEvent &&)> executionHandler;
+    std::shared_ptr<RecordingCommandsStream> stream;
+};
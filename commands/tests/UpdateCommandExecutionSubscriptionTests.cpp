@@ -0,0 +1,248 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotcommands/IotCommandsClientV2.h>
+#include <aws/iotcommands/UpdateCommandExecutionRequest.h>
+#include <aws/iotcommands/UpdateCommandExecutionResponse.h>
+#include <aws/iotcommands/V2ErrorResponse.h>
+
+#include <vector>
+
+using namespace Aws::Iotcommands;
+
+/* Records the subscription filters and response paths of each submitted request */
+class RecordingRequestResponseClient : public Aws::Iot::RequestResponse::IMqttRequestResponseClient
+{
+  public:
+    struct RecordedRequest
+    {
+        std::vector<Aws::Crt::String> subscriptionTopicFilters;
+        std::vector<Aws::Crt::String> responsePaths;
+        Aws::Crt::String publishTopic;
+        Aws::Iot::RequestResponse::UnmodeledResultHandler handler;
+    };
+
+    int SubmitRequest(
+        const aws_mqtt_request_operation_options &requestOptions,
+        Aws::Iot::RequestResponse::UnmodeledResultHandler &&resultHandler) override
+    {
+        RecordedRequest request;
+        for (size_t i = 0; i < requestOptions.subscription_topic_filter_count; ++i)
+        {
+            request.subscriptionTopicFilters.push_back(s_toString(requestOptions.subscription_topic_filters[i]));
+        }
+        for (size_t i = 0; i < requestOptions.response_path_count; ++i)
+        {
+            request.responsePaths.push_back(s_toString(requestOptions.response_paths[i].topic));
+        }
+        request.publishTopic = s_toString(requestOptions.publish_topic);
+        request.handler = std::move(resultHandler);
+        requests.push_back(std::move(request));
+        return AWS_OP_SUCCESS;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateStream(
+        const Aws::Iot::RequestResponse::StreamingOperationOptionsInternal &) override
+    {
+        return nullptr;
+    }
+
+    /* Delivers a response to the request as if it had arrived on the given topic */
+    void Respond(size_t index, const char *topic, const char *payload)
+    {
+        Aws::Iot::RequestResponse::UnmodeledResponse response(
+            Aws::Crt::ByteCursorFromCString(topic), Aws::Crt::ByteCursorFromCString(payload));
+        requests[index].handler(Aws::Iot::RequestResponse::UnmodeledResult(std::move(response)));
+    }
+
+    std::vector<RecordedRequest> requests;
+
+  private:
+    static Aws::Crt::String s_toString(struct aws_byte_cursor cursor)
+    {
+        return Aws::Crt::String(reinterpret_cast<const char *>(cursor.ptr), cursor.len);
+    }
+};
+
+/* MQTT topic filter matching, with single-level (+) and multi-level (#) wildcards */
+static bool s_topicMatches(const Aws::Crt::String &filter, const Aws::Crt::String &topic)
+{
+    size_t filterPosition = 0;
+    size_t topicPosition = 0;
+    while (true)
+    {
+        size_t filterEnd = filter.find('/', filterPosition);
+        size_t topicEnd = topic.find('/', topicPosition);
+        Aws::Crt::String filterLevel = filter.substr(filterPosition, filterEnd - filterPosition);
+        Aws::Crt::String topicLevel = topic.substr(topicPosition, topicEnd - topicPosition);
+        if (filterLevel == "#")
+        {
+            return true;
+        }
+        if (filterLevel != "+" && filterLevel != topicLevel)
+        {
+            return false;
+        }
+        if (filterEnd == Aws::Crt::String::npos || topicEnd == Aws::Crt::String::npos)
+        {
+            return filterEnd == topicEnd;
+        }
+        filterPosition = filterEnd + 1;
+        topicPosition = topicEnd + 1;
+    }
+}
+
+static bool s_anyFilterMatches(const std::vector<Aws::Crt::String> &filters, const Aws::Crt::String &topic)
+{
+    for (const auto &filter : filters)
+    {
+        if (s_topicMatches(filter, topic))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static UpdateCommandExecutionRequest s_makeUpdate(const char *executionId)
+{
+    UpdateCommandExecutionRequest request;
+    request.DeviceType = DeviceType::THING;
+    request.DeviceId = "thing";
+    request.ExecutionId = executionId;
+    request.Status = CommandExecutionStatus::IN_PROGRESS;
+    return request;
+}
+
+static int s_UpdateCommandExecutionPerExecutionSubscription(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto bindingClient = std::make_shared<RecordingRequestResponseClient>();
+        auto client = NewClientFromRequestResponseClient(bindingClient, ClientV2Options(), allocator);
+        ASSERT_NOT_NULL(client.get());
+
+        int successes = 0;
+        int modeledErrors = 0;
+        int invalidPaths = 0;
+        auto onResult = [&](UpdateCommandExecutionResult &&result)
+        {
+            if (result.IsSuccess())
+            {
+                ++successes;
+            }
+            else if (result.GetError().GetErrorCode() == AWS_ERROR_MQTT_REQUEST_RESPONSE_MODELED_SERVICE_ERROR)
+            {
+                ++modeledErrors;
+            }
+            else if (result.GetError().GetErrorCode() == AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH)
+            {
+                ++invalidPaths;
+            }
+        };
+
+        ASSERT_TRUE(client->UpdateCommandExecution(s_makeUpdate("a"), onResult));
+        ASSERT_TRUE(client->UpdateCommandExecution(s_makeUpdate("b"), onResult));
+        ASSERT_INT_EQUALS(2, bindingClient->requests.size());
+
+        /* By default an update subscribes to exactly its own response topics */
+        const auto &request = bindingClient->requests[0];
+        ASSERT_TRUE(request.publishTopic == "$aws/commands/things/thing/executions/a/response/json");
+        ASSERT_INT_EQUALS(2, request.subscriptionTopicFilters.size());
+        ASSERT_TRUE(
+            request.subscriptionTopicFilters[0] == "$aws/commands/things/thing/executions/a/response/accepted/json");
+        ASSERT_TRUE(
+            request.subscriptionTopicFilters[1] == "$aws/commands/things/thing/executions/a/response/rejected/json");
+        for (const auto &responsePath : request.responsePaths)
+        {
+            ASSERT_TRUE(s_anyFilterMatches(request.subscriptionTopicFilters, responsePath));
+        }
+        ASSERT_FALSE(s_anyFilterMatches(
+            request.subscriptionTopicFilters, "$aws/commands/things/thing/executions/b/response/accepted/json"));
+
+        bindingClient->Respond(0, "$aws/commands/things/thing/executions/a/response/accepted/json", "{}");
+        bindingClient->Respond(1, "$aws/commands/things/thing/executions/b/response/rejected/json", "{}");
+        ASSERT_INT_EQUALS(1, successes);
+        ASSERT_INT_EQUALS(1, modeledErrors);
+        ASSERT_INT_EQUALS(0, invalidPaths);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(UpdateCommandExecutionPerExecutionSubscription, s_UpdateCommandExecutionPerExecutionSubscription)
+
+static int s_UpdateCommandExecutionSharedSubscription(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto bindingClient = std::make_shared<RecordingRequestResponseClient>();
+        auto client = NewClientFromRequestResponseClient(
+            bindingClient, ClientV2Options().WithSharedResponseSubscription(true), allocator);
+        ASSERT_NOT_NULL(client.get());
+
+        int successes = 0;
+        int invalidPaths = 0;
+        auto onResult = [&](UpdateCommandExecutionResult &&result)
+        {
+            if (result.IsSuccess())
+            {
+                ++successes;
+            }
+            else if (result.GetError().GetErrorCode() == AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH)
+            {
+                ++invalidPaths;
+            }
+        };
+
+        ASSERT_TRUE(client->UpdateCommandExecution(s_makeUpdate("a"), onResult));
+        ASSERT_TRUE(client->UpdateCommandExecution(s_makeUpdate("b"), onResult));
+        ASSERT_INT_EQUALS(2, bindingClient->requests.size());
+
+        /* Every execution of the device shares one wildcard filter per payload format */
+        for (const auto &request : bindingClient->requests)
+        {
+            ASSERT_INT_EQUALS(1, request.subscriptionTopicFilters.size());
+            ASSERT_TRUE(
+                request.subscriptionTopicFilters[0] == "$aws/commands/things/thing/executions/+/response/+/json");
+            for (const auto &responsePath : request.responsePaths)
+            {
+                ASSERT_TRUE(s_anyFilterMatches(request.subscriptionTopicFilters, responsePath));
+            }
+        }
+
+        const auto &filters = bindingClient->requests[0].subscriptionTopicFilters;
+        ASSERT_TRUE(s_anyFilterMatches(filters, "$aws/commands/things/thing/executions/b/response/accepted/json"));
+        ASSERT_FALSE(s_anyFilterMatches(filters, "$aws/commands/things/thing/executions/a/response/accepted/cbor"));
+        ASSERT_FALSE(s_anyFilterMatches(filters, "$aws/commands/things/other/executions/a/response/accepted/json"));
+        ASSERT_FALSE(s_anyFilterMatches(filters, "$aws/commands/things/thing/executions/a/request/json"));
+
+        /* Responses are still matched to their update by exact topic */
+        bindingClient->Respond(0, "$aws/commands/things/thing/executions/b/response/accepted/json", "{}");
+        ASSERT_INT_EQUALS(0, successes);
+        ASSERT_INT_EQUALS(1, invalidPaths);
+
+        bindingClient->Respond(1, "$aws/commands/things/thing/executions/b/response/accepted/json", "{}");
+        ASSERT_INT_EQUALS(1, successes);
+
+        /* CBOR updates use the filter of their own payload format */
+        ASSERT_TRUE(client->UpdateCommandExecutionCbor(s_makeUpdate("a"), onResult));
+        ASSERT_INT_EQUALS(3, bindingClient->requests.size());
+        ASSERT_TRUE(
+            bindingClient->requests[2].subscriptionTopicFilters[0] ==
+            "$aws/commands/things/thing/executions/+/response/+/cbor");
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(UpdateCommandExecutionSharedSubscription, s_UpdateCommandExecutionSharedSubscription)
@@ -13,6 +13,11 @@
 
 namespace Aws
 {
+    namespace Iotdevicecommon
+    {
+        class JsonWriter;
+    }
+
     namespace Iotidentity
     {
 
@@ -30,6 +35,8 @@ namespace Aws
 
             void SerializeToObject(Crt::JsonObject &doc) const;
 
+            void SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const;
+
           private:
             static void LoadFromObject(CreateKeysAndCertificateRequest &obj, const Crt::JsonView &doc);
         };
@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotidentity/IotIdentityClientV2.h>
+
+#include <aws/iotidentity/CreateCertificateFromCsrResponse.h>
+#include <aws/iotidentity/CreateKeysAndCertificateResponse.h>
+#include <aws/iotidentity/RegisterThingResponse.h>
+#include <aws/iotidentity/V2ErrorResponse.h>
+
+#include <aws/iotdevicecommon/RequestFuture.h>
+
+#include <memory>
+#include <utility>
+
+namespace Aws
+{
+    namespace Iotidentity
+    {
+
+        /**
+         * Future-based facade over the identity service client.  Each request operation returns a future for its
+         * result instead of taking a handler.  When compiled as C++20, the futures can be awaited directly:
+         *
+         *     RegisterThingResult result = co_await asyncClient.RegisterThing(request);
+         *
+         * Futures complete on the event loop thread that delivered the response; see
+         * Aws::Iotdevicecommon::RequestFuture for the threading rules.
+         */
+        class AsyncClientV2 final
+        {
+          public:
+            /**
+             * @param client service client to submit requests with
+             * @param allocator memory allocator for the state of each request
+             */
+            explicit AsyncClientV2(
+                std::shared_ptr<IClientV2> client,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator())
+                : m_client(std::move(client)), m_allocator(allocator)
+            {
+            }
+
+            /**
+             * Creates a certificate from a certificate signing request (CSR).
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<CreateCertificateFromCsrResult> CreateCertificateFromCsr(
+                const CreateCertificateFromCsrRequest &request)
+            {
+                return Submit<CreateCertificateFromCsrResult>(
+                    [this, &request](const CreateCertificateFromCsrResultHandler &handler)
+                    { return m_client->CreateCertificateFromCsr(request, handler); });
+            }
+
+            /**
+             * Creates new keys and a certificate.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<CreateKeysAndCertificateResult> CreateKeysAndCertificate(
+                const CreateKeysAndCertificateRequest &request)
+            {
+                return Submit<CreateKeysAndCertificateResult>(
+                    [this, &request](const CreateKeysAndCertificateResultHandler &handler)
+                    { return m_client->CreateKeysAndCertificate(request, handler); });
+            }
+
+            /**
+             * Provisions an AWS IoT thing using a pre-defined template.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<RegisterThingResult> RegisterThing(const RegisterThingRequest &request)
+            {
+                return Submit<RegisterThingResult>(
+                    [this, &request](const RegisterThingResultHandler &handler)
+                    { return m_client->RegisterThing(request, handler); });
+            }
+
+            /**
+             * @return the wrapped service client, e.g. for creating streaming operations
+             */
+            const std::shared_ptr<IClientV2> &GetClient() const { return m_client; }
+
+          private:
+            template <typename R, typename Submitter>
+            Aws::Iotdevicecommon::RequestFuture<R> Submit(Submitter &&submit)
+            {
+                return Aws::Iotdevicecommon::RequestFuture<R>::Start(
+                    m_allocator,
+                    std::forward<Submitter>(submit),
+                    [](int errorCode) { return R(ServiceErrorV2<V2ErrorResponse>(errorCode)); });
+            }
+
+            std::shared_ptr<IClientV2> m_client;
+            Aws::Crt::Allocator *m_allocator;
+        };
+
+    } // namespace Iotidentity
+} // namespace Aws
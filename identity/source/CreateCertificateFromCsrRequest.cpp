@@ -5,6 +5,8 @@
  */
 #include <aws/iotidentity/CreateCertificateFromCsrRequest.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotidentity
@@ -33,6 +35,16 @@ namespace Aws
             }
         }
 
+        void CreateCertificateFromCsrRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (CertificateSigningRequest)
+            {
+                writer.WithString("certificateSigningRequest", *CertificateSigningRequest);
+            }
+        }
+
         CreateCertificateFromCsrRequest::CreateCertificateFromCsrRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
@@ -5,6 +5,8 @@
  */
 #include <aws/iotidentity/CreateKeysAndCertificateRequest.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotidentity
@@ -23,6 +25,11 @@ namespace Aws
             (void)object;
         }
 
+        void CreateKeysAndCertificateRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+        }
+
         CreateKeysAndCertificateRequest::CreateKeysAndCertificateRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
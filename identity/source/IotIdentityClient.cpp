@@ -5,6 +5,9 @@
  */
 #include <aws/iotidentity/IotIdentityClient.h>
 
+#include <aws/iotdevicecommon/MqttSubscriptionRegistry.h>
+#include <aws/iotdevicecommon/TopicBuilder.h>
+
 #include <aws/iotidentity/CreateCertificateFromCsrRequest.h>
 #include <aws/iotidentity/CreateCertificateFromCsrResponse.h>
 #include <aws/iotidentity/CreateCertificateFromCsrSubscriptionRequest.h>
@@ -41,6 +44,11 @@ namespace Aws
             return aws_last_error();
         }
 
+        void IotIdentityClient::ReleaseSubscriptions()
+        {
+            Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection)->ReleaseOwner(this);
+        }
+
         bool IotIdentityClient::SubscribeToCreateCertificateFromCsrAccepted(
             const Aws::Iotidentity::CreateCertificateFromCsrSubscriptionRequest &request,
             Aws::Crt::Mqtt::QOS qos,
@@ -67,20 +75,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotidentity::CreateCertificateFromCsrResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotidentity::CreateCertificateFromCsrResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/certificates/create-from-csr/json/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/certificates/create-from-csr/json/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -112,20 +129,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotidentity::ErrorResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotidentity::ErrorResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/certificates/create-from-csr/json/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/certificates/create-from-csr/json/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -157,20 +183,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotidentity::CreateKeysAndCertificateResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotidentity::CreateKeysAndCertificateResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/certificates/create/json/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/certificates/create/json/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -202,20 +237,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotidentity::ErrorResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotidentity::ErrorResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/certificates/create/json/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/certificates/create/json/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -247,20 +291,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotidentity::RegisterThingResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotidentity::RegisterThingResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/provisioning-templates/" << *request.TemplateName << "/provision/json/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/provisioning-templates/", *request.TemplateName, "/provision/json/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -292,20 +345,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotidentity::ErrorResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotidentity::ErrorResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/provisioning-templates/" << *request.TemplateName << "/provision/json/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/provisioning-templates/", *request.TemplateName, "/provision/json/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -316,8 +378,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/certificates/create-from-csr/json";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/certificates/create-from-csr/json");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -332,7 +394,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotIdentityClient::PublishCreateKeysAndCertificate(
@@ -340,8 +402,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/certificates/create/json";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/certificates/create/json");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -356,7 +418,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotIdentityClient::PublishRegisterThing(
@@ -364,8 +426,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/provisioning-templates/" << *request.TemplateName << "/provision/json";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/provisioning-templates/", *request.TemplateName, "/provision/json");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -380,7 +442,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
     } // namespace Iotidentity
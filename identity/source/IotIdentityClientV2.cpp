@@ -6,6 +6,8 @@
 #include <aws/iotidentity/IotIdentityClientV2.h>
 
 #include <aws/crt/UUID.h>
+#include <aws/iotdevicecommon/JsonWriter.h>
+#include <aws/iotdevicecommon/TopicBuilder.h>
 
 #include <aws/iotidentity/CreateCertificateFromCsrRequest.h>
 #include <aws/iotidentity/CreateCertificateFromCsrResponse.h>
@@ -84,7 +86,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -94,54 +106,40 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 CreateCertificateFromCsrResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<CreateCertificateFromCsrResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::CreateCertificateFromCsr(
             const CreateCertificateFromCsrRequest &request,
             const CreateCertificateFromCsrResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/certificates/create-from-csr/json";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder publishTopic(m_allocator);
+            publishTopic.Append("$aws/certificates/create-from-csr/json");
 
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/certificates/create-from-csr/json/accepted";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic0(m_allocator);
+            subscriptionTopic0.Append("$aws/certificates/create-from-csr/json/accepted");
 
-            Aws::Crt::StringStream subscriptionTopicStream1;
-            subscriptionTopicStream1 << "$aws/certificates/create-from-csr/json/rejected";
-            Aws::Crt::String subscriptionTopic1 = subscriptionTopicStream1.str();
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic1(m_allocator);
+            subscriptionTopic1.Append("$aws/certificates/create-from-csr/json/rejected");
 
             struct aws_byte_cursor subscriptionTopicFilters[2] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
-                Aws::Crt::ByteCursorFromString(subscriptionTopic1),
+                subscriptionTopic0.ToCursor(),
+                subscriptionTopic1.ToCursor(),
             };
 
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            Aws::Crt::String responsePathTopicAccepted = publishTopic.ToString("/accepted");
+            Aws::Crt::String responsePathTopicRejected = publishTopic.ToString("/rejected");
 
             struct aws_mqtt_request_operation_response_path responsePaths[2];
             responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
@@ -149,10 +147,14 @@ namespace Aws
             AWS_ZERO_STRUCT(responsePaths[0].correlation_token_json_path);
             AWS_ZERO_STRUCT(responsePaths[1].correlation_token_json_path);
 
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
             struct aws_mqtt_request_operation_options options;
             AWS_ZERO_STRUCT(options);
@@ -160,9 +162,8 @@ namespace Aws
             options.subscription_topic_filter_count = 2;
             options.response_paths = responsePaths;
             options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            options.publish_topic = publishTopic.ToCursor();
+            options.serialized_request = writer.ToCursor();
 
             auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
                                      Aws::Iot::RequestResponse::UnmodeledResult &&result)
@@ -191,7 +192,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -201,54 +212,40 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 CreateKeysAndCertificateResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<CreateKeysAndCertificateResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::CreateKeysAndCertificate(
             const CreateKeysAndCertificateRequest &request,
             const CreateKeysAndCertificateResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/certificates/create/json";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder publishTopic(m_allocator);
+            publishTopic.Append("$aws/certificates/create/json");
 
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/certificates/create/json/accepted";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic0(m_allocator);
+            subscriptionTopic0.Append("$aws/certificates/create/json/accepted");
 
-            Aws::Crt::StringStream subscriptionTopicStream1;
-            subscriptionTopicStream1 << "$aws/certificates/create/json/rejected";
-            Aws::Crt::String subscriptionTopic1 = subscriptionTopicStream1.str();
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic1(m_allocator);
+            subscriptionTopic1.Append("$aws/certificates/create/json/rejected");
 
             struct aws_byte_cursor subscriptionTopicFilters[2] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
-                Aws::Crt::ByteCursorFromString(subscriptionTopic1),
+                subscriptionTopic0.ToCursor(),
+                subscriptionTopic1.ToCursor(),
             };
 
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            Aws::Crt::String responsePathTopicAccepted = publishTopic.ToString("/accepted");
+            Aws::Crt::String responsePathTopicRejected = publishTopic.ToString("/rejected");
 
             struct aws_mqtt_request_operation_response_path responsePaths[2];
             responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
@@ -256,10 +253,14 @@ namespace Aws
             AWS_ZERO_STRUCT(responsePaths[0].correlation_token_json_path);
             AWS_ZERO_STRUCT(responsePaths[1].correlation_token_json_path);
 
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
             struct aws_mqtt_request_operation_options options;
             AWS_ZERO_STRUCT(options);
@@ -267,9 +268,8 @@ namespace Aws
             options.subscription_topic_filter_count = 2;
             options.response_paths = responsePaths;
             options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            options.publish_topic = publishTopic.ToCursor();
+            options.serialized_request = writer.ToCursor();
 
             auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
                                      Aws::Iot::RequestResponse::UnmodeledResult &&result)
@@ -298,7 +298,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -308,54 +318,40 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 RegisterThingResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<RegisterThingResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::RegisterThing(const RegisterThingRequest &request, const RegisterThingResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/provisioning-templates/" << *request.TemplateName << "/provision/json";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder publishTopic(m_allocator);
+            publishTopic.Append("$aws/provisioning-templates/", *request.TemplateName, "/provision/json");
 
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/provisioning-templates/" << *request.TemplateName
-                                     << "/provision/json/accepted";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic0(m_allocator);
+            subscriptionTopic0.Append(
+                "$aws/provisioning-templates/", *request.TemplateName, "/provision/json/accepted");
 
-            Aws::Crt::StringStream subscriptionTopicStream1;
-            subscriptionTopicStream1 << "$aws/provisioning-templates/" << *request.TemplateName
-                                     << "/provision/json/rejected";
-            Aws::Crt::String subscriptionTopic1 = subscriptionTopicStream1.str();
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic1(m_allocator);
+            subscriptionTopic1.Append(
+                "$aws/provisioning-templates/", *request.TemplateName, "/provision/json/rejected");
 
             struct aws_byte_cursor subscriptionTopicFilters[2] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
-                Aws::Crt::ByteCursorFromString(subscriptionTopic1),
+                subscriptionTopic0.ToCursor(),
+                subscriptionTopic1.ToCursor(),
             };
 
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            Aws::Crt::String responsePathTopicAccepted = publishTopic.ToString("/accepted");
+            Aws::Crt::String responsePathTopicRejected = publishTopic.ToString("/rejected");
 
             struct aws_mqtt_request_operation_response_path responsePaths[2];
             responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
@@ -363,10 +359,14 @@ namespace Aws
             AWS_ZERO_STRUCT(responsePaths[0].correlation_token_json_path);
             AWS_ZERO_STRUCT(responsePaths[1].correlation_token_json_path);
 
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
             struct aws_mqtt_request_operation_options options;
             AWS_ZERO_STRUCT(options);
@@ -374,9 +374,8 @@ namespace Aws
             options.subscription_topic_filter_count = 2;
             options.response_paths = responsePaths;
             options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            options.publish_topic = publishTopic.ToCursor();
+            options.serialized_request = writer.ToCursor();
 
             auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
                                      Aws::Iot::RequestResponse::UnmodeledResult &&result) {
@@ -5,6 +5,8 @@
  */
 #include <aws/iotidentity/RegisterThingRequest.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotidentity
@@ -55,6 +57,26 @@ namespace Aws
             }
         }
 
+        void RegisterThingRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (CertificateOwnershipToken)
+            {
+                writer.WithString("certificateOwnershipToken", *CertificateOwnershipToken);
+            }
+
+            if (Parameters)
+            {
+                writer.BeginObject("parameters");
+                for (auto &parametersMapMember : *Parameters)
+                {
+                    writer.WithString(parametersMapMember.first, parametersMapMember.second);
+                }
+                writer.EndObject();
+            }
+        }
+
         RegisterThingRequest::RegisterThingRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
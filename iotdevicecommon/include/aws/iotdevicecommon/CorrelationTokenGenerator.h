@@ -0,0 +1,334 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/common/clock.h>
+#include <aws/common/uuid.h>
+#include <aws/crt/Types.h>
+#include <aws/crt/io/EventLoopGroup.h>
+#include <aws/io/event_loop.h>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace Aws
+{
+    namespace Iotdevicecommon
+    {
+        /**
+         * Fixed-capacity storage for a single correlation token, so that generating one never allocates.
+         */
+        struct CorrelationToken
+        {
+            static constexpr size_t MAX_LENGTH = 64;
+
+            CorrelationToken() noexcept : length(0) {}
+
+            struct aws_byte_cursor ToCursor() const noexcept
+            {
+                return aws_byte_cursor_from_array(data, length);
+            }
+
+            Crt::String ToString() const { return Crt::String(data, length); }
+
+            char data[MAX_LENGTH];
+            size_t length;
+        };
+
+        /**
+         * Source of the correlation tokens that request-response service clients attach to each request.
+         *
+         * Tokens must be unique among a client's in-flight requests and should only contain characters that can be
+         * written into a JSON string without escaping.  Generators are shared by every thread that submits requests
+         * and must be thread-safe.
+         */
+        class ICorrelationTokenGenerator
+        {
+          public:
+            virtual ~ICorrelationTokenGenerator() = default;
+
+            /**
+             * Writes a new token.
+             *
+             * @param token storage to write the token into
+             * @return success/failure.  On failure the AWS error code is set.
+             */
+            virtual bool Generate(CorrelationToken &token) = 0;
+        };
+
+        /**
+         * Formats a freshly generated UUID into the token buffer.  This is the default generator; every token reads
+         * from the system entropy source.
+         */
+        class UuidCorrelationTokenGenerator final : public ICorrelationTokenGenerator
+        {
+          public:
+            bool Generate(CorrelationToken &token) override
+            {
+                struct aws_uuid uuid;
+                if (aws_uuid_init(&uuid))
+                {
+                    return false;
+                }
+
+                return FormatUuid(uuid, token);
+            }
+
+            static bool FormatUuid(const struct aws_uuid &uuid, CorrelationToken &token)
+            {
+                struct aws_byte_buf buffer = aws_byte_buf_from_empty_array(token.data, CorrelationToken::MAX_LENGTH);
+                if (aws_uuid_to_str(&uuid, &buffer))
+                {
+                    return false;
+                }
+
+                token.length = buffer.len;
+                return true;
+            }
+        };
+
+        /**
+         * Produces tokens of the form <prefix>-<counter>, where the prefix is chosen randomly once per generator and
+         * the counter increases monotonically.  Generating a token is a single atomic increment and needs no system
+         * calls.
+         */
+        class CounterCorrelationTokenGenerator final : public ICorrelationTokenGenerator
+        {
+          public:
+            CounterCorrelationTokenGenerator() noexcept : m_prefixLength(0), m_counter(0)
+            {
+                struct aws_uuid uuid;
+                AWS_ZERO_STRUCT(uuid);
+                if (aws_uuid_init(&uuid))
+                {
+                    /* Uniqueness only matters across the client's own in-flight requests, so the clock will do */
+                    uint64_t ticks = 0;
+                    aws_high_res_clock_get_ticks(&ticks);
+                    memcpy(uuid.uuid_data, &ticks, sizeof(ticks));
+                }
+
+                for (size_t i = 0; i < PREFIX_BYTES; ++i)
+                {
+                    m_prefix[m_prefixLength++] = s_hexDigit(uuid.uuid_data[i] >> 4);
+                    m_prefix[m_prefixLength++] = s_hexDigit(uuid.uuid_data[i]);
+                }
+                m_prefix[m_prefixLength++] = '-';
+            }
+
+            bool Generate(CorrelationToken &token) override
+            {
+                uint64_t value = m_counter.fetch_add(1, std::memory_order_relaxed);
+
+                char digits[16];
+                size_t digitCount = 0;
+                do
+                {
+                    digits[digitCount++] = s_hexDigit(static_cast<uint8_t>(value));
+                    value >>= 4;
+                } while (value != 0);
+
+                memcpy(token.data, m_prefix, m_prefixLength);
+                for (size_t i = 0; i < digitCount; ++i)
+                {
+                    token.data[m_prefixLength + i] = digits[digitCount - 1 - i];
+                }
+                token.length = m_prefixLength + digitCount;
+                return true;
+            }
+
+          private:
+            static constexpr size_t PREFIX_BYTES = 8;
+
+            static char s_hexDigit(uint8_t value) { return "0123456789abcdef"[value & 0x0F]; }
+
+            char m_prefix[PREFIX_BYTES * 2 + 1];
+            size_t m_prefixLength;
+            std::atomic<uint64_t> m_counter;
+        };
+
+        /**
+         * Hands out UUID tokens from a pool of pre-generated ones.
+         *
+         * When the pool drops to half its size, a refill is scheduled on the event loop group so that request
+         * submission does not pay for entropy reads.  Without an event loop group, or if the pool runs dry before the
+         * refill ran, tokens are generated on the calling thread instead.
+         */
+        class UuidPoolCorrelationTokenGenerator final
+            : public ICorrelationTokenGenerator,
+              public std::enable_shared_from_this<UuidPoolCorrelationTokenGenerator>
+        {
+          public:
+            /**
+             * @param poolSize number of tokens kept ready
+             * @param eventLoopGroup event loop group to refill the pool on; must outlive the generator.  May be null.
+             * @param allocator memory allocator to use for the pool
+             *
+             * @return a new generator with a full pool
+             */
+            static std::shared_ptr<UuidPoolCorrelationTokenGenerator> Create(
+                size_t poolSize,
+                Crt::Io::EventLoopGroup *eventLoopGroup,
+                Crt::Allocator *allocator = Crt::ApiAllocator())
+            {
+                /* The constructor is private so that the generator is always owned by a shared_ptr */
+                auto *toSeat = static_cast<UuidPoolCorrelationTokenGenerator *>(
+                    aws_mem_acquire(allocator, sizeof(UuidPoolCorrelationTokenGenerator)));
+                toSeat = new (toSeat) UuidPoolCorrelationTokenGenerator(poolSize, eventLoopGroup, allocator);
+                std::shared_ptr<UuidPoolCorrelationTokenGenerator> generator(
+                    toSeat, [allocator](UuidPoolCorrelationTokenGenerator *pool) { Crt::Delete(pool, allocator); });
+
+                generator->Refill();
+                return generator;
+            }
+
+            bool Generate(CorrelationToken &token) override
+            {
+                bool scheduleRefill = false;
+                bool pooled = false;
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    if (!m_pool.empty())
+                    {
+                        token = m_pool.back();
+                        m_pool.pop_back();
+                        pooled = true;
+                    }
+
+                    if (m_pool.size() <= m_poolSize / 2 && !m_refillPending && m_eventLoopGroup != nullptr)
+                    {
+                        m_refillPending = true;
+                        scheduleRefill = true;
+                    }
+                }
+
+                if (scheduleRefill && !ScheduleRefill())
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_refillPending = false;
+                }
+
+                if (pooled)
+                {
+                    return true;
+                }
+
+                if (m_eventLoopGroup == nullptr)
+                {
+                    /* No background refill; pay for a whole batch at once */
+                    Refill();
+                }
+
+                UuidCorrelationTokenGenerator fallback;
+                return fallback.Generate(token);
+            }
+
+            /**
+             * Tops the pool up to its configured size on the calling thread.
+             */
+            void Refill()
+            {
+                size_t missing = 0;
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    missing = m_poolSize - m_pool.size();
+                }
+
+                Crt::Vector<CorrelationToken> tokens{Crt::StlAllocator<CorrelationToken>(m_allocator)};
+                tokens.reserve(missing);
+                for (size_t i = 0; i < missing; ++i)
+                {
+                    CorrelationToken token;
+                    struct aws_uuid uuid;
+                    if (aws_uuid_init(&uuid) || !UuidCorrelationTokenGenerator::FormatUuid(uuid, token))
+                    {
+                        break;
+                    }
+                    tokens.push_back(token);
+                }
+
+                std::lock_guard<std::mutex> guard(m_lock);
+                for (const auto &token : tokens)
+                {
+                    if (m_pool.size() >= m_poolSize)
+                    {
+                        break;
+                    }
+                    m_pool.push_back(token);
+                }
+            }
+
+          private:
+            UuidPoolCorrelationTokenGenerator(
+                size_t poolSize,
+                Crt::Io::EventLoopGroup *eventLoopGroup,
+                Crt::Allocator *allocator)
+                : m_allocator(allocator), m_eventLoopGroup(eventLoopGroup), m_poolSize(poolSize > 0 ? poolSize : 1),
+                  m_pool(Crt::StlAllocator<CorrelationToken>(allocator)), m_refillPending(false)
+            {
+                m_pool.reserve(m_poolSize);
+            }
+
+            struct RefillTask
+            {
+                RefillTask(Crt::Allocator *allocator, std::weak_ptr<UuidPoolCorrelationTokenGenerator> generator)
+                    : allocator(allocator), generator(std::move(generator))
+                {
+                    AWS_ZERO_STRUCT(task);
+                }
+
+                struct aws_task task;
+                Crt::Allocator *allocator;
+                std::weak_ptr<UuidPoolCorrelationTokenGenerator> generator;
+            };
+
+            static void s_onRefill(struct aws_task *task, void *arg, enum aws_task_status status)
+            {
+                (void)task;
+
+                auto *refillTask = static_cast<RefillTask *>(arg);
+                if (auto generator = refillTask->generator.lock())
+                {
+                    if (status == AWS_TASK_STATUS_RUN_READY)
+                    {
+                        generator->Refill();
+                    }
+
+                    std::lock_guard<std::mutex> guard(generator->m_lock);
+                    generator->m_refillPending = false;
+                }
+
+                Crt::Delete(refillTask, refillTask->allocator);
+            }
+
+            bool ScheduleRefill()
+            {
+                struct aws_event_loop *eventLoop =
+                    aws_event_loop_group_get_next_loop(m_eventLoopGroup->GetUnderlyingHandle());
+                if (eventLoop == nullptr)
+                {
+                    return false;
+                }
+
+                auto *refillTask = Crt::New<RefillTask>(m_allocator, m_allocator, shared_from_this());
+                aws_task_init(&refillTask->task, s_onRefill, refillTask, "CorrelationTokenPoolRefill");
+                aws_event_loop_schedule_task_now(eventLoop, &refillTask->task);
+
+                return true;
+            }
+
+            Crt::Allocator *m_allocator;
+            Crt::Io::EventLoopGroup *m_eventLoopGroup;
+            size_t m_poolSize;
+
+            std::mutex m_lock;
+            Crt::Vector<CorrelationToken> m_pool;
+            bool m_refillPending;
+        };
+
+    } // namespace Iotdevicecommon
+} // namespace Aws
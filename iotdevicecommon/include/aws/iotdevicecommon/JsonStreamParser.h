@@ -0,0 +1,570 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Types.h>
+
+#include <cstring>
+
+namespace Aws
+{
+    namespace Iotdevicecommon
+    {
+        /**
+         * Receives the tokens of a JSON document from a JsonStreamParser.  Every callback returns false to abort
+         * parsing.  Cursors are only valid for the duration of the callback.
+         */
+        class IJsonStreamHandler
+        {
+          public:
+            virtual ~IJsonStreamHandler() = default;
+
+            virtual bool OnBeginObject() { return true; }
+
+            virtual bool OnEndObject() { return true; }
+
+            virtual bool OnBeginArray() { return true; }
+
+            virtual bool OnEndArray() { return true; }
+
+            /**
+             * @param key unescaped member name
+             */
+            virtual bool OnKey(struct aws_byte_cursor key)
+            {
+                (void)key;
+                return true;
+            }
+
+            /**
+             * @param value unescaped string value, UTF-8 encoded
+             */
+            virtual bool OnString(struct aws_byte_cursor value)
+            {
+                (void)value;
+                return true;
+            }
+
+            /**
+             * @param text number as written in the document
+             */
+            virtual bool OnNumber(struct aws_byte_cursor text)
+            {
+                (void)text;
+                return true;
+            }
+
+            virtual bool OnBool(bool value)
+            {
+                (void)value;
+                return true;
+            }
+
+            virtual bool OnNull() { return true; }
+        };
+
+        /**
+         * Incremental (SAX-style) JSON parser.  The document is fed in chunks of any size and reported token by token,
+         * so memory use is bounded by the largest single string or number rather than by the document.
+         */
+        class JsonStreamParser final
+        {
+          public:
+            /**
+             * @param handler receives the tokens; must outlive the parser
+             * @param allocator memory allocator for the token buffer
+             */
+            explicit JsonStreamParser(IJsonStreamHandler &handler, Crt::Allocator *allocator = Crt::ApiAllocator())
+                : m_handler(handler)
+            {
+                AWS_ZERO_STRUCT(m_token);
+                m_failed = aws_byte_buf_init(&m_token, allocator, 64) != AWS_OP_SUCCESS;
+            }
+
+            ~JsonStreamParser() { aws_byte_buf_clean_up(&m_token); }
+
+            JsonStreamParser(const JsonStreamParser &) = delete;
+            JsonStreamParser(JsonStreamParser &&) = delete;
+            JsonStreamParser &operator=(const JsonStreamParser &) = delete;
+            JsonStreamParser &operator=(JsonStreamParser &&) = delete;
+
+            /**
+             * Parses the next chunk of the document.
+             *
+             * @param chunk bytes following the previously fed ones
+             * @return false if the document is malformed or the handler aborted
+             */
+            bool Feed(struct aws_byte_cursor chunk)
+            {
+                for (size_t i = 0; i < chunk.len && !m_failed; ++i, ++m_offset)
+                {
+                    m_failed = !Step(chunk.ptr[i]);
+                }
+
+                return !m_failed;
+            }
+
+            /**
+             * Signals the end of the document.
+             *
+             * @return true if a single complete JSON value was parsed
+             */
+            bool Finish()
+            {
+                if (!m_failed && m_state == State::Number)
+                {
+                    m_failed = !EndNumber();
+                }
+
+                return !m_failed && m_state == State::Done;
+            }
+
+            /**
+             * @return the offset of the byte being parsed; during a callback, the offset of the byte that completed
+             * the token
+             */
+            size_t GetOffset() const noexcept { return m_offset; }
+
+            /**
+             * @return the offset of the first byte of the token being reported
+             */
+            size_t GetTokenStart() const noexcept { return m_tokenStart; }
+
+          private:
+            static constexpr uint32_t MAX_DEPTH = 64;
+
+            enum class State
+            {
+                Value,
+                FirstValueOrEnd,
+                FirstKeyOrEnd,
+                Key,
+                Colon,
+                CommaOrEnd,
+                String,
+                Escape,
+                Unicode,
+                Number,
+                Literal,
+                Done,
+            };
+
+            bool Step(uint8_t c)
+            {
+                switch (m_state)
+                {
+                    case State::String:
+                        return StepString(c);
+                    case State::Escape:
+                        return StepEscape(c);
+                    case State::Unicode:
+                        return StepUnicode(c);
+                    case State::Number:
+                        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')
+                        {
+                            return Append(c);
+                        }
+                        /* The byte after a number belongs to the next token */
+                        return EndNumber() && Step(c);
+                    case State::Literal:
+                        if (c != static_cast<uint8_t>(m_literal[m_literalMatched]))
+                        {
+                            return false;
+                        }
+                        return ++m_literalMatched < m_literalLength || EndLiteral();
+                    default:
+                        break;
+                }
+
+                if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+                {
+                    return true;
+                }
+
+                switch (m_state)
+                {
+                    case State::FirstValueOrEnd:
+                        if (c == ']')
+                        {
+                            return EndContainer(false);
+                        }
+                        return BeginValue(c);
+                    case State::Value:
+                        return BeginValue(c);
+                    case State::FirstKeyOrEnd:
+                        if (c == '}')
+                        {
+                            return EndContainer(true);
+                        }
+                        return c == '"' && BeginString(true);
+                    case State::Key:
+                        return c == '"' && BeginString(true);
+                    case State::Colon:
+                        if (c != ':')
+                        {
+                            return false;
+                        }
+                        m_state = State::Value;
+                        return true;
+                    case State::CommaOrEnd:
+                        if (c == ',')
+                        {
+                            m_state = InObject() ? State::Key : State::Value;
+                            return true;
+                        }
+                        if (c == '}' || c == ']')
+                        {
+                            return EndContainer(c == '}');
+                        }
+                        return false;
+                    default:
+                        /* Only whitespace may follow the top-level value */
+                        return false;
+                }
+            }
+
+            bool BeginValue(uint8_t c)
+            {
+                m_tokenStart = m_offset;
+                switch (c)
+                {
+                    case '{':
+                        if (!Push(true))
+                        {
+                            return false;
+                        }
+                        m_state = State::FirstKeyOrEnd;
+                        return m_handler.OnBeginObject();
+                    case '[':
+                        if (!Push(false))
+                        {
+                            return false;
+                        }
+                        m_state = State::FirstValueOrEnd;
+                        return m_handler.OnBeginArray();
+                    case '"':
+                        return BeginString(false);
+                    case 't':
+                        return BeginLiteral("true");
+                    case 'f':
+                        return BeginLiteral("false");
+                    case 'n':
+                        return BeginLiteral("null");
+                    default:
+                        if (c == '-' || (c >= '0' && c <= '9'))
+                        {
+                            m_token.len = 0;
+                            m_state = State::Number;
+                            return Append(c);
+                        }
+                        return false;
+                }
+            }
+
+            bool BeginString(bool isKey)
+            {
+                m_tokenStart = m_offset;
+                m_token.len = 0;
+                m_isKey = isKey;
+                m_state = State::String;
+                return true;
+            }
+
+            bool StepString(uint8_t c)
+            {
+                if (m_highSurrogate != 0 && c != '\\')
+                {
+                    return false;
+                }
+
+                if (c == '\\')
+                {
+                    m_state = State::Escape;
+                    return true;
+                }
+
+                if (c < 0x20)
+                {
+                    return false;
+                }
+
+                if (c != '"')
+                {
+                    return Append(c);
+                }
+
+                struct aws_byte_cursor value = aws_byte_cursor_from_buf(&m_token);
+                if (m_isKey)
+                {
+                    m_state = State::Colon;
+                    return m_handler.OnKey(value);
+                }
+
+                EndValue();
+                return m_handler.OnString(value);
+            }
+
+            bool StepEscape(uint8_t c)
+            {
+                if (m_highSurrogate != 0 && c != 'u')
+                {
+                    return false;
+                }
+
+                m_state = State::String;
+                switch (c)
+                {
+                    case '"':
+                    case '\\':
+                    case '/':
+                        return Append(c);
+                    case 'b':
+                        return Append('\b');
+                    case 'f':
+                        return Append('\f');
+                    case 'n':
+                        return Append('\n');
+                    case 'r':
+                        return Append('\r');
+                    case 't':
+                        return Append('\t');
+                    case 'u':
+                        m_codeUnit = 0;
+                        m_codeUnitDigits = 0;
+                        m_state = State::Unicode;
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            bool StepUnicode(uint8_t c)
+            {
+                uint32_t digit = 0;
+                if (c >= '0' && c <= '9')
+                {
+                    digit = c - '0';
+                }
+                else if (c >= 'a' && c <= 'f')
+                {
+                    digit = c - 'a' + 10;
+                }
+                else if (c >= 'A' && c <= 'F')
+                {
+                    digit = c - 'A' + 10;
+                }
+                else
+                {
+                    return false;
+                }
+
+                m_codeUnit = (m_codeUnit << 4) | digit;
+                if (++m_codeUnitDigits < 4)
+                {
+                    return true;
+                }
+
+                m_state = State::String;
+                if (m_highSurrogate != 0)
+                {
+                    if (m_codeUnit < 0xDC00 || m_codeUnit > 0xDFFF)
+                    {
+                        return false;
+                    }
+
+                    uint32_t codePoint = 0x10000 + ((m_highSurrogate - 0xD800) << 10) + (m_codeUnit - 0xDC00);
+                    m_highSurrogate = 0;
+                    return AppendCodePoint(codePoint);
+                }
+
+                if (m_codeUnit >= 0xD800 && m_codeUnit <= 0xDBFF)
+                {
+                    /* Must be followed by an escaped low surrogate */
+                    m_highSurrogate = m_codeUnit;
+                    return true;
+                }
+
+                if (m_codeUnit >= 0xDC00 && m_codeUnit <= 0xDFFF)
+                {
+                    return false;
+                }
+
+                return AppendCodePoint(m_codeUnit);
+            }
+
+            bool EndNumber()
+            {
+                struct aws_byte_cursor text = aws_byte_cursor_from_buf(&m_token);
+                if (!IsValidNumber(text))
+                {
+                    return false;
+                }
+
+                EndValue();
+                return m_handler.OnNumber(text);
+            }
+
+            bool BeginLiteral(const char *literal)
+            {
+                m_literal = literal;
+                m_literalLength = strlen(literal);
+                m_literalMatched = 1;
+                m_state = State::Literal;
+                return true;
+            }
+
+            bool EndLiteral()
+            {
+                EndValue();
+                switch (m_literal[0])
+                {
+                    case 't':
+                        return m_handler.OnBool(true);
+                    case 'f':
+                        return m_handler.OnBool(false);
+                    default:
+                        return m_handler.OnNull();
+                }
+            }
+
+            bool Push(bool isObject)
+            {
+                if (m_depth >= MAX_DEPTH)
+                {
+                    return false;
+                }
+
+                uint64_t bit = static_cast<uint64_t>(1) << m_depth;
+                m_objects = isObject ? (m_objects | bit) : (m_objects & ~bit);
+                ++m_depth;
+                return true;
+            }
+
+            bool EndContainer(bool isObject)
+            {
+                if (m_depth == 0 || InObject() != isObject)
+                {
+                    return false;
+                }
+
+                --m_depth;
+                EndValue();
+                return isObject ? m_handler.OnEndObject() : m_handler.OnEndArray();
+            }
+
+            bool InObject() const noexcept
+            {
+                return m_depth > 0 && (m_objects & (static_cast<uint64_t>(1) << (m_depth - 1))) != 0;
+            }
+
+            void EndValue() { m_state = m_depth == 0 ? State::Done : State::CommaOrEnd; }
+
+            bool Append(uint8_t c) { return aws_byte_buf_append_byte_dynamic(&m_token, c) == AWS_OP_SUCCESS; }
+
+            bool AppendCodePoint(uint32_t codePoint)
+            {
+                if (codePoint < 0x80)
+                {
+                    return Append(static_cast<uint8_t>(codePoint));
+                }
+
+                if (codePoint < 0x800)
+                {
+                    return Append(static_cast<uint8_t>(0xC0 | (codePoint >> 6))) &&
+                           Append(static_cast<uint8_t>(0x80 | (codePoint & 0x3F)));
+                }
+
+                if (codePoint < 0x10000)
+                {
+                    return Append(static_cast<uint8_t>(0xE0 | (codePoint >> 12))) &&
+                           Append(static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F))) &&
+                           Append(static_cast<uint8_t>(0x80 | (codePoint & 0x3F)));
+                }
+
+                return Append(static_cast<uint8_t>(0xF0 | (codePoint >> 18))) &&
+                       Append(static_cast<uint8_t>(0x80 | ((codePoint >> 12) & 0x3F))) &&
+                       Append(static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F))) &&
+                       Append(static_cast<uint8_t>(0x80 | (codePoint & 0x3F)));
+            }
+
+            /* -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)? */
+            static bool IsValidNumber(struct aws_byte_cursor text)
+            {
+                size_t i = 0;
+                auto isDigit = [&text](size_t index)
+                { return index < text.len && text.ptr[index] >= '0' && text.ptr[index] <= '9'; };
+
+                if (i < text.len && text.ptr[i] == '-')
+                {
+                    ++i;
+                }
+
+                if (!isDigit(i))
+                {
+                    return false;
+                }
+                if (text.ptr[i++] != '0')
+                {
+                    while (isDigit(i))
+                    {
+                        ++i;
+                    }
+                }
+
+                if (i < text.len && text.ptr[i] == '.')
+                {
+                    if (!isDigit(++i))
+                    {
+                        return false;
+                    }
+                    while (isDigit(i))
+                    {
+                        ++i;
+                    }
+                }
+
+                if (i < text.len && (text.ptr[i] == 'e' || text.ptr[i] == 'E'))
+                {
+                    ++i;
+                    if (i < text.len && (text.ptr[i] == '+' || text.ptr[i] == '-'))
+                    {
+                        ++i;
+                    }
+                    if (!isDigit(i))
+                    {
+                        return false;
+                    }
+                    while (isDigit(i))
+                    {
+                        ++i;
+                    }
+                }
+
+                return i == text.len;
+            }
+
+            IJsonStreamHandler &m_handler;
+
+            struct aws_byte_buf m_token;
+            bool m_failed = false;
+            State m_state = State::Value;
+            size_t m_offset = 0;
+            size_t m_tokenStart = 0;
+
+            uint32_t m_depth = 0;
+            uint64_t m_objects = 0;
+
+            bool m_isKey = false;
+            uint32_t m_codeUnit = 0;
+            uint32_t m_codeUnitDigits = 0;
+            uint32_t m_highSurrogate = 0;
+
+            const char *m_literal = nullptr;
+            size_t m_literalLength = 0;
+            size_t m_literalMatched = 0;
+        };
+
+    } // namespace Iotdevicecommon
+} // namespace Aws
@@ -0,0 +1,327 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+
+#include <cstring>
+
+namespace Aws
+{
+    namespace Iotdevicecommon
+    {
+        /**
+         * Key of a JSON object member; constructible from either string type used by the service models.
+         */
+        struct JsonKey
+        {
+            JsonKey(const char *key) noexcept : cursor(aws_byte_cursor_from_c_str(key)) {}
+
+            JsonKey(const Crt::String &key) noexcept
+                : cursor(aws_byte_cursor_from_array(key.data(), key.length()))
+            {
+            }
+
+            struct aws_byte_cursor cursor;
+        };
+
+        /**
+         * Streaming writer that renders compact JSON directly into a byte buffer, without building a JsonObject
+         * tree first.  The member functions mirror the JsonObject builder interface.
+         */
+        class JsonWriter final
+        {
+          public:
+            /**
+             * Creates a writer that owns its output buffer.
+             *
+             * @param allocator memory allocator for the output buffer
+             * @param initialCapacity initial size of the output buffer
+             */
+            explicit JsonWriter(Crt::Allocator *allocator = Crt::ApiAllocator(), size_t initialCapacity = 256)
+                : m_buffer(&m_ownedBuffer), m_ownsBuffer(true), m_depth(0), m_hasMembers(0), m_failed(false)
+            {
+                AWS_ZERO_STRUCT(m_ownedBuffer);
+                m_failed = aws_byte_buf_init(&m_ownedBuffer, allocator, initialCapacity) != AWS_OP_SUCCESS;
+            }
+
+            /**
+             * Creates a writer that appends to a caller-owned buffer, which lets the caller reuse one buffer across
+             * many documents.  The buffer grows if it has an allocator.
+             *
+             * @param buffer buffer to append to
+             */
+            explicit JsonWriter(struct aws_byte_buf &buffer) noexcept
+                : m_buffer(&buffer), m_ownsBuffer(false), m_depth(0), m_hasMembers(0), m_failed(false)
+            {
+                AWS_ZERO_STRUCT(m_ownedBuffer);
+            }
+
+            ~JsonWriter()
+            {
+                if (m_ownsBuffer)
+                {
+                    aws_byte_buf_clean_up(&m_ownedBuffer);
+                }
+            }
+
+            JsonWriter(const JsonWriter &) = delete;
+            JsonWriter(JsonWriter &&) = delete;
+            JsonWriter &operator=(const JsonWriter &) = delete;
+            JsonWriter &operator=(JsonWriter &&) = delete;
+
+            /**
+             * Opens the top-level object.
+             */
+            JsonWriter &BeginObject()
+            {
+                AppendByte('{');
+                return Push();
+            }
+
+            /**
+             * Opens an object valued member of the current object.
+             */
+            JsonWriter &BeginObject(const JsonKey &key)
+            {
+                WriteKey(key);
+                AppendByte('{');
+                return Push();
+            }
+
+            JsonWriter &EndObject()
+            {
+                AppendByte('}');
+                if (m_depth == 0)
+                {
+                    m_failed = true;
+                    return *this;
+                }
+                --m_depth;
+                return *this;
+            }
+
+            JsonWriter &WithString(const JsonKey &key, const Crt::String &value)
+            {
+                return WithString(key, aws_byte_cursor_from_array(value.data(), value.length()));
+            }
+
+            JsonWriter &WithString(const JsonKey &key, const char *value)
+            {
+                return WithString(key, aws_byte_cursor_from_c_str(value));
+            }
+
+            JsonWriter &WithString(const JsonKey &key, struct aws_byte_cursor value)
+            {
+                if (!IsReserved(key))
+                {
+                    WriteKey(key);
+                    AppendEscapedString(value);
+                }
+                return *this;
+            }
+
+            JsonWriter &WithBool(const JsonKey &key, bool value)
+            {
+                if (!IsReserved(key))
+                {
+                    WriteKey(key);
+                    AppendCursor(aws_byte_cursor_from_c_str(value ? "true" : "false"));
+                }
+                return *this;
+            }
+
+            JsonWriter &WithInteger(const JsonKey &key, int value) { return WithInt64(key, value); }
+
+            JsonWriter &WithInt64(const JsonKey &key, int64_t value)
+            {
+                if (!IsReserved(key))
+                {
+                    WriteKey(key);
+
+                    char digits[20];
+                    size_t digitCount = 0;
+                    uint64_t magnitude = static_cast<uint64_t>(value);
+                    if (value < 0)
+                    {
+                        magnitude = static_cast<uint64_t>(0) - magnitude;
+                    }
+                    do
+                    {
+                        digits[digitCount++] = static_cast<char>('0' + magnitude % 10);
+                        magnitude /= 10;
+                    } while (magnitude != 0);
+
+                    if (value < 0)
+                    {
+                        AppendByte('-');
+                    }
+                    while (digitCount > 0)
+                    {
+                        AppendByte(static_cast<uint8_t>(digits[--digitCount]));
+                    }
+                }
+                return *this;
+            }
+
+            /**
+             * Writes an arbitrary JSON value.  The value is rendered by the JSON library, so this costs one
+             * temporary string; it is meant for free-form documents embedded in requests.
+             */
+            JsonWriter &WithJson(const JsonKey &key, const Crt::JsonView &value)
+            {
+                if (!IsReserved(key))
+                {
+                    WriteKey(key);
+                    Crt::String rendered = value.WriteCompact(true);
+                    AppendCursor(aws_byte_cursor_from_array(rendered.data(), rendered.length()));
+                }
+                return *this;
+            }
+
+            /**
+             * Members of the top-level object with this key are dropped from now on.  Service clients write their
+             * own correlation token first and reserve its key so that a token set on the request is not emitted a
+             * second time.
+             *
+             * @param key member key to drop; must outlive the writer
+             */
+            JsonWriter &ReserveKey(const char *key)
+            {
+                m_reservedKey = aws_byte_cursor_from_c_str(key);
+                return *this;
+            }
+
+            /**
+             * @return a cursor over the JSON written so far, valid until the writer or its buffer is modified
+             */
+            struct aws_byte_cursor ToCursor() const noexcept { return aws_byte_cursor_from_buf(m_buffer); }
+
+            /**
+             * @return false if the output is incomplete or malformed, e.g. after an unbalanced EndObject() or a failed
+             * buffer allocation
+             */
+            explicit operator bool() const noexcept { return !m_failed && m_depth == 0; }
+
+          private:
+            static constexpr uint32_t MAX_DEPTH = 64;
+
+            JsonWriter &Push()
+            {
+                if (m_depth >= MAX_DEPTH)
+                {
+                    m_failed = true;
+                    return *this;
+                }
+
+                m_hasMembers &= ~(static_cast<uint64_t>(1) << m_depth);
+                ++m_depth;
+                return *this;
+            }
+
+            bool IsReserved(const JsonKey &key) const
+            {
+                return m_depth == 1 && m_reservedKey.len > 0 && aws_byte_cursor_eq(&key.cursor, &m_reservedKey);
+            }
+
+            /**
+             * Writes the separator and key of a new member of the current object.
+             */
+            void WriteKey(const JsonKey &key)
+            {
+                uint64_t bit = static_cast<uint64_t>(1) << (m_depth > 0 ? m_depth - 1 : 0);
+                if (m_hasMembers & bit)
+                {
+                    AppendByte(',');
+                }
+                m_hasMembers |= bit;
+
+                AppendEscapedString(key.cursor);
+                AppendByte(':');
+            }
+
+            void AppendEscapedString(struct aws_byte_cursor value)
+            {
+                static const char HEX_DIGITS[] = "0123456789abcdef";
+
+                AppendByte('"');
+
+                size_t runStart = 0;
+                for (size_t i = 0; i < value.len; ++i)
+                {
+                    uint8_t c = value.ptr[i];
+                    if (c >= 0x20 && c != '"' && c != '\\')
+                    {
+                        continue;
+                    }
+
+                    AppendCursor(aws_byte_cursor_from_array(value.ptr + runStart, i - runStart));
+                    runStart = i + 1;
+
+                    AppendByte('\\');
+                    switch (c)
+                    {
+                        case '"':
+                        case '\\':
+                            AppendByte(c);
+                            break;
+                        case '\b':
+                            AppendByte('b');
+                            break;
+                        case '\f':
+                            AppendByte('f');
+                            break;
+                        case '\n':
+                            AppendByte('n');
+                            break;
+                        case '\r':
+                            AppendByte('r');
+                            break;
+                        case '\t':
+                            AppendByte('t');
+                            break;
+                        default:
+                        {
+                            char escaped[5] = {'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F]};
+                            AppendCursor(aws_byte_cursor_from_array(escaped, sizeof(escaped)));
+                            break;
+                        }
+                    }
+                }
+
+                AppendCursor(aws_byte_cursor_from_array(value.ptr + runStart, value.len - runStart));
+                AppendByte('"');
+            }
+
+            void AppendCursor(struct aws_byte_cursor cursor)
+            {
+                if (cursor.len > 0 && aws_byte_buf_append_dynamic(m_buffer, &cursor))
+                {
+                    m_failed = true;
+                }
+            }
+
+            void AppendByte(uint8_t value)
+            {
+                if (aws_byte_buf_append_byte_dynamic(m_buffer, value))
+                {
+                    m_failed = true;
+                }
+            }
+
+            struct aws_byte_buf m_ownedBuffer;
+            struct aws_byte_buf *m_buffer;
+            bool m_ownsBuffer;
+
+            uint32_t m_depth;
+            uint64_t m_hasMembers;
+            bool m_failed;
+
+            struct aws_byte_cursor m_reservedKey = {0, nullptr};
+        };
+
+    } // namespace Iotdevicecommon
+} // namespace Aws
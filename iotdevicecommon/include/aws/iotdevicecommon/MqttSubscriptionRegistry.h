@@ -0,0 +1,620 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+#include <aws/crt/mqtt/MqttClient.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Iotdevicecommon
+    {
+        /**
+         * Decoded forms of one incoming message, shared by all handlers the message is dispatched to so that the
+         * payload is only decoded once per model type.  Decoded objects are shared and therefore const; handlers
+         * that need a mutable object use DecodeJsonValue(), which copies it.
+         */
+        class MqttMessageCache final
+        {
+          public:
+            /**
+             * @param allocator memory allocator for decoded objects
+             * @param shared whether the message is dispatched to more than one handler.  If not, DecodeJsonValue()
+             * builds its object straight from the payload, without caching or copying it.
+             */
+            explicit MqttMessageCache(Crt::Allocator *allocator, bool shared = true) noexcept
+                : m_allocator(allocator), m_shared(shared), m_decoded(Crt::StlAllocator<Decoded>(allocator))
+            {
+            }
+
+            MqttMessageCache(const MqttMessageCache &) = delete;
+            MqttMessageCache &operator=(const MqttMessageCache &) = delete;
+
+            /**
+             * Parses the payload as JSON and builds a T from it, unless an earlier handler already did.
+             *
+             * @param payload message payload
+             * @return the decoded object, or null if the payload is not valid JSON
+             */
+            template <typename T> std::shared_ptr<const T> DecodeJson(const Crt::ByteBuf &payload)
+            {
+                const void *tag = s_typeTag<T>();
+                for (const auto &decoded : m_decoded)
+                {
+                    if (decoded.tag == tag)
+                    {
+                        return std::static_pointer_cast<const T>(decoded.value);
+                    }
+                }
+
+                Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
+                Crt::JsonObject jsonObject(objectStr);
+
+                std::shared_ptr<const T> value;
+                if (jsonObject.WasParseSuccessful())
+                {
+                    value = Crt::MakeShared<T>(m_allocator, jsonObject);
+                }
+
+                /* Parse failures are cached as well, so that every handler sees the same result */
+                m_decoded.push_back(Decoded{tag, value});
+                return value;
+            }
+
+            /**
+             * Decodes the payload into a T that the caller may modify.  The only handler of a message gets an object
+             * built from the payload directly; otherwise it is a copy of the object shared through DecodeJson().
+             *
+             * @param payload message payload
+             * @return the decoded object, or nothing if the payload is not valid JSON
+             */
+            template <typename T> Crt::Optional<T> DecodeJsonValue(const Crt::ByteBuf &payload)
+            {
+                Crt::Optional<T> value;
+                if (m_shared)
+                {
+                    if (std::shared_ptr<const T> decoded = DecodeJson<T>(payload))
+                    {
+                        value.emplace(*decoded);
+                    }
+                    return value;
+                }
+
+                Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
+                Crt::JsonObject jsonObject(objectStr);
+                if (jsonObject.WasParseSuccessful())
+                {
+                    value.emplace(jsonObject.View());
+                }
+                return value;
+            }
+
+          private:
+            struct Decoded
+            {
+                const void *tag;
+                std::shared_ptr<const void> value;
+            };
+
+            template <typename T> static const void *s_typeTag()
+            {
+                static const char tag = 0;
+                return &tag;
+            }
+
+            Crt::Allocator *m_allocator;
+            bool m_shared;
+
+            /* Handlers of one topic filter rarely decode more than one or two model types */
+            Crt::Vector<Decoded> m_decoded;
+        };
+
+        /**
+         * Reference-counted MQTT subscriptions shared by every service client on one connection.
+         *
+         * The first handler registered for a topic filter sends the SUBSCRIBE; later handlers for the same filter
+         * are added to an in-process fan-out and have their SUBACK callback invoked as soon as the original
+         * subscription is acknowledged.  Once the last handler of a filter is released, the filter is unsubscribed.
+         * A handler asking for a higher QoS than the current subscription re-subscribes the filter with that QoS.
+         * All handlers of an incoming message share one MqttMessageCache.
+         *
+         * Handlers may be registered on behalf of an owner, such as the service client they were subscribed
+         * through.  An owner has at most one handler per topic filter, so subscribing to a filter again replaces
+         * its handler, and ReleaseOwner() releases every handler of an owner at once.
+         *
+         * The registry only references its connection weakly, while the subscriptions made on the connection keep
+         * the registry alive.  Handlers that are never released therefore live as long as the connection, exactly
+         * like callbacks passed to MqttConnection::Subscribe.
+         *
+         * Each service library compiles its own copy of this header, so registries are only shared between clients
+         * of the same library.
+         *
+         * @tparam Connection connection type; Crt::Mqtt::MqttConnection except in tests
+         */
+        template <typename Connection>
+        class BasicMqttSubscriptionRegistry final
+            : public std::enable_shared_from_this<BasicMqttSubscriptionRegistry<Connection>>
+        {
+          public:
+            using PublishHandler = std::function<void(
+                Connection &connection,
+                const Crt::String &topic,
+                const Crt::ByteBuf &payload,
+                MqttMessageCache &cache)>;
+
+            using SubAckHandler = std::function<void(
+                Connection &connection,
+                uint16_t packetId,
+                const Crt::String &topic,
+                Crt::Mqtt::QOS qos,
+                int errorCode)>;
+
+            /**
+             * Returns the registry of a connection, creating it if needed.  Registries are looked up by the
+             * ownership of the connection rather than its address, so a connection allocated where a destroyed one
+             * used to be gets a registry of its own.
+             *
+             * @param connection connection to subscribe on
+             * @param allocator memory allocator for a new registry
+             *
+             * @return the registry for the connection
+             */
+            static std::shared_ptr<BasicMqttSubscriptionRegistry> ForConnection(
+                const std::shared_ptr<Connection> &connection,
+                Crt::Allocator *allocator = Crt::ApiAllocator())
+            {
+                std::weak_ptr<Connection> key = connection;
+                std::lock_guard<std::mutex> guard(s_registryLock());
+
+                auto &registries = s_registries();
+                for (auto iter = registries.begin(); iter != registries.end();)
+                {
+                    if (iter->first.expired() || iter->second.expired())
+                    {
+                        iter = registries.erase(iter);
+                    }
+                    else
+                    {
+                        ++iter;
+                    }
+                }
+
+                auto existing = registries.find(key);
+                if (existing != registries.end())
+                {
+                    /* The last reference may have been dropped since the sweep above */
+                    if (auto registry = existing->second.lock())
+                    {
+                        return registry;
+                    }
+                }
+
+                auto registry = Crt::MakeShared<BasicMqttSubscriptionRegistry>(allocator, connection, allocator);
+                if (connection)
+                {
+                    registries[key] = registry;
+                }
+
+                return registry;
+            }
+
+            BasicMqttSubscriptionRegistry(const std::shared_ptr<Connection> &connection, Crt::Allocator *allocator)
+                : m_allocator(allocator), m_connection(connection), m_nextId(0)
+            {
+            }
+
+            /**
+             * Registers a handler for a topic filter, subscribing to the filter if this is its first handler.
+             *
+             * @param topicFilter topic filter to subscribe to
+             * @param qos requested QoS
+             * @param onPublish function object to invoke with messages received on the filter
+             * @param onSubAck function object to invoke once the subscription is acknowledged or failed.  On failure
+             * the handler is no longer registered.
+             *
+             * @return id of the registered handler, or 0 if the subscribe could not be queued
+             */
+            uint64_t Subscribe(
+                const char *topicFilter,
+                Crt::Mqtt::QOS qos,
+                PublishHandler &&onPublish,
+                SubAckHandler &&onSubAck)
+            {
+                return Subscribe(nullptr, topicFilter, qos, std::move(onPublish), std::move(onSubAck));
+            }
+
+            /**
+             * Registers the handler of an owner for a topic filter, replacing any handler the owner already has for
+             * the filter, and subscribing to the filter if this is its first handler.
+             *
+             * @param owner owner of the handler, or null for a handler that is only released by its id.  Only used as
+             * a key, never dereferenced.
+             * @param topicFilter topic filter to subscribe to
+             * @param qos requested QoS
+             * @param onPublish function object to invoke with messages received on the filter
+             * @param onSubAck function object to invoke once the subscription is acknowledged or failed.  On failure
+             * the handler is no longer registered.
+             *
+             * @return id of the registered handler, or 0 if the subscribe could not be queued
+             */
+            uint64_t Subscribe(
+                const void *owner,
+                const char *topicFilter,
+                Crt::Mqtt::QOS qos,
+                PublishHandler &&onPublish,
+                SubAckHandler &&onSubAck)
+            {
+                std::shared_ptr<Connection> connection = m_connection.lock();
+                if (!connection)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return 0;
+                }
+
+                Crt::String topic(topicFilter, Crt::StlAllocator<char>(m_allocator));
+
+                bool subscribe = false;
+                bool ackNow = false;
+                uint64_t entryId = 0;
+                uint64_t handlerId = 0;
+                Crt::Mqtt::QOS grantedQos = qos;
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+
+                    handlerId = ++m_nextId;
+                    auto iter = m_entries.find(topic);
+                    if (iter == m_entries.end())
+                    {
+                        Entry entry;
+                        entry.id = ++m_nextId;
+                        entry.qos = qos;
+                        entry.handlers = Crt::MakeShared<HandlerList>(m_allocator);
+                        iter = m_entries.emplace(topic, std::move(entry)).first;
+                        subscribe = true;
+                    }
+                    else if (qos > iter->second.qos)
+                    {
+                        iter->second.qos = qos;
+                        subscribe = true;
+                    }
+
+                    Entry &entry = iter->second;
+                    auto handlers = Crt::MakeShared<HandlerList>(m_allocator, *entry.handlers);
+                    if (owner != nullptr)
+                    {
+                        /* Swapped in the same step, so the filter never runs out of handlers in between */
+                        for (auto handler = handlers->begin(); handler != handlers->end(); ++handler)
+                        {
+                            if (handler->owner == owner)
+                            {
+                                ErasePendingAck(entry, handler->id);
+                                handlers->erase(handler);
+                                break;
+                            }
+                        }
+                    }
+                    handlers->push_back(Handler{handlerId, owner, std::move(onPublish)});
+                    entry.handlers = std::move(handlers);
+
+                    if (entry.acked && !subscribe)
+                    {
+                        ackNow = true;
+                        grantedQos = entry.grantedQos;
+                    }
+                    else
+                    {
+                        entry.pendingAcks.push_back(PendingAck{handlerId, std::move(onSubAck)});
+                    }
+                    entryId = entry.id;
+                }
+
+                if (ackNow)
+                {
+                    if (onSubAck)
+                    {
+                        onSubAck(*connection, 0, topic, grantedQos, AWS_ERROR_SUCCESS);
+                    }
+                    return handlerId;
+                }
+
+                if (subscribe && !SendSubscribe(*connection, topic, qos, entryId))
+                {
+                    int errorCode = aws_last_error();
+                    RemoveHandler(topic, handlerId, false);
+                    aws_raise_error(errorCode != AWS_ERROR_SUCCESS ? errorCode : AWS_ERROR_UNKNOWN);
+                    return 0;
+                }
+
+                return handlerId;
+            }
+
+            /**
+             * Removes a handler, unsubscribing from the topic filter if it was the last one.
+             *
+             * @param topicFilter topic filter the handler was registered for
+             * @param handlerId id returned by Subscribe()
+             */
+            void Release(const Crt::String &topicFilter, uint64_t handlerId)
+            {
+                RemoveHandler(topicFilter, handlerId, true);
+            }
+
+            /**
+             * Removes every handler of an owner, unsubscribing from each topic filter that is left without handlers.
+             *
+             * @param owner owner passed to Subscribe()
+             */
+            void ReleaseOwner(const void *owner)
+            {
+                if (owner == nullptr)
+                {
+                    return;
+                }
+
+                Crt::Vector<Crt::String> unused{Crt::StlAllocator<Crt::String>(m_allocator)};
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    for (auto iter = m_entries.begin(); iter != m_entries.end();)
+                    {
+                        Entry &entry = iter->second;
+                        auto handlers = Crt::MakeShared<HandlerList>(m_allocator);
+                        for (const auto &handler : *entry.handlers)
+                        {
+                            if (handler.owner == owner)
+                            {
+                                ErasePendingAck(entry, handler.id);
+                            }
+                            else
+                            {
+                                handlers->push_back(handler);
+                            }
+                        }
+
+                        if (handlers->empty())
+                        {
+                            unused.push_back(iter->first);
+                            iter = m_entries.erase(iter);
+                        }
+                        else
+                        {
+                            entry.handlers = std::move(handlers);
+                            ++iter;
+                        }
+                    }
+                }
+
+                for (const auto &topicFilter : unused)
+                {
+                    Unsubscribe(topicFilter);
+                }
+            }
+
+          private:
+            struct Handler
+            {
+                uint64_t id;
+                const void *owner;
+                PublishHandler onPublish;
+            };
+
+            using HandlerList = Crt::Vector<Handler>;
+
+            struct PendingAck
+            {
+                uint64_t handlerId;
+                SubAckHandler onSubAck;
+            };
+
+            struct Entry
+            {
+                uint64_t id = 0;
+                Crt::Mqtt::QOS qos = AWS_MQTT_QOS_AT_MOST_ONCE;
+                Crt::Mqtt::QOS grantedQos = AWS_MQTT_QOS_AT_MOST_ONCE;
+                bool acked = false;
+
+                /* Copied on write so that message dispatch only needs to take a reference under the lock */
+                std::shared_ptr<const HandlerList> handlers;
+                Crt::Vector<PendingAck> pendingAcks;
+            };
+
+            using RegistryMap = std::map<
+                std::weak_ptr<Connection>,
+                std::weak_ptr<BasicMqttSubscriptionRegistry>,
+                std::owner_less<std::weak_ptr<Connection>>,
+                Crt::StlAllocator<
+                    std::pair<const std::weak_ptr<Connection>, std::weak_ptr<BasicMqttSubscriptionRegistry>>>>;
+
+            static std::mutex &s_registryLock()
+            {
+                static std::mutex lock;
+                return lock;
+            }
+
+            static RegistryMap &s_registries()
+            {
+                static RegistryMap registries;
+                return registries;
+            }
+
+            bool SendSubscribe(Connection &connection, const Crt::String &topic, Crt::Mqtt::QOS qos, uint64_t entryId)
+            {
+                /* Held by the connection until the filter is unsubscribed or the connection is destroyed */
+                std::shared_ptr<BasicMqttSubscriptionRegistry> registry = this->shared_from_this();
+
+                auto onPublish = [registry, topic](
+                                     Connection &publishConnection,
+                                     const Crt::String &publishTopic,
+                                     const Crt::ByteBuf &payload)
+                { registry->Dispatch(topic, publishConnection, publishTopic, payload); };
+
+                auto onSubAck = [registry, topic, entryId](
+                                    Connection &ackConnection,
+                                    uint16_t packetId,
+                                    const Crt::String &ackTopic,
+                                    Crt::Mqtt::QOS grantedQos,
+                                    int errorCode)
+                { registry->OnSubAck(topic, entryId, ackConnection, packetId, ackTopic, grantedQos, errorCode); };
+
+                return connection.Subscribe(topic.c_str(), qos, std::move(onPublish), std::move(onSubAck)) != 0;
+            }
+
+            void Dispatch(
+                const Crt::String &topicFilter,
+                Connection &connection,
+                const Crt::String &topic,
+                const Crt::ByteBuf &payload)
+            {
+                std::shared_ptr<const HandlerList> handlers;
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    auto iter = m_entries.find(topicFilter);
+                    if (iter == m_entries.end())
+                    {
+                        return;
+                    }
+                    handlers = iter->second.handlers;
+                }
+
+                MqttMessageCache cache(m_allocator, handlers->size() > 1);
+                for (const auto &handler : *handlers)
+                {
+                    handler.onPublish(connection, topic, payload, cache);
+                }
+            }
+
+            void OnSubAck(
+                const Crt::String &topicFilter,
+                uint64_t entryId,
+                Connection &connection,
+                uint16_t packetId,
+                const Crt::String &ackTopic,
+                Crt::Mqtt::QOS grantedQos,
+                int errorCode)
+            {
+                Crt::Vector<PendingAck> pendingAcks;
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    auto iter = m_entries.find(topicFilter);
+                    if (iter == m_entries.end() || iter->second.id != entryId)
+                    {
+                        /* Acknowledges a subscription that has since been released */
+                        return;
+                    }
+
+                    Entry &entry = iter->second;
+                    pendingAcks = std::move(entry.pendingAcks);
+                    entry.pendingAcks.clear();
+                    if (errorCode == AWS_ERROR_SUCCESS)
+                    {
+                        entry.acked = true;
+                        entry.grantedQos = grantedQos;
+                    }
+                    else if (!entry.acked)
+                    {
+                        /* Nobody is subscribed; the waiting handlers learn about it from their SUBACK callback */
+                        m_entries.erase(iter);
+                    }
+                    else
+                    {
+                        /* A failed QoS upgrade leaves the existing subscription and its handlers in place */
+                        auto handlers = Crt::MakeShared<HandlerList>(m_allocator, *entry.handlers);
+                        for (const auto &pendingAck : pendingAcks)
+                        {
+                            EraseHandler(*handlers, pendingAck.handlerId);
+                        }
+                        entry.handlers = std::move(handlers);
+                    }
+                }
+
+                for (const auto &pendingAck : pendingAcks)
+                {
+                    if (pendingAck.onSubAck)
+                    {
+                        pendingAck.onSubAck(connection, packetId, ackTopic, grantedQos, errorCode);
+                    }
+                }
+            }
+
+            void RemoveHandler(const Crt::String &topicFilter, uint64_t handlerId, bool unsubscribeIfUnused)
+            {
+                bool unsubscribe = false;
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    auto iter = m_entries.find(topicFilter);
+                    if (iter == m_entries.end())
+                    {
+                        return;
+                    }
+
+                    Entry &entry = iter->second;
+                    auto handlers = Crt::MakeShared<HandlerList>(m_allocator, *entry.handlers);
+                    EraseHandler(*handlers, handlerId);
+                    entry.handlers = std::move(handlers);
+                    ErasePendingAck(entry, handlerId);
+
+                    if (entry.handlers->empty())
+                    {
+                        /* Also sent while the SUBSCRIBE is in flight; the connection keeps the two in order */
+                        unsubscribe = unsubscribeIfUnused;
+                        m_entries.erase(iter);
+                    }
+                }
+
+                if (unsubscribe)
+                {
+                    Unsubscribe(topicFilter);
+                }
+            }
+
+            void Unsubscribe(const Crt::String &topicFilter)
+            {
+                if (std::shared_ptr<Connection> connection = m_connection.lock())
+                {
+                    connection->Unsubscribe(topicFilter.c_str(), [](Connection &, uint16_t, int) {});
+                }
+            }
+
+            static void ErasePendingAck(Entry &entry, uint64_t handlerId)
+            {
+                for (auto ack = entry.pendingAcks.begin(); ack != entry.pendingAcks.end(); ++ack)
+                {
+                    if (ack->handlerId == handlerId)
+                    {
+                        entry.pendingAcks.erase(ack);
+                        return;
+                    }
+                }
+            }
+
+            static void EraseHandler(HandlerList &handlers, uint64_t handlerId)
+            {
+                for (auto handler = handlers.begin(); handler != handlers.end(); ++handler)
+                {
+                    if (handler->id == handlerId)
+                    {
+                        handlers.erase(handler);
+                        return;
+                    }
+                }
+            }
+
+            Crt::Allocator *m_allocator;
+            std::weak_ptr<Connection> m_connection;
+
+            std::mutex m_lock;
+            Crt::Map<Crt::String, Entry> m_entries;
+            uint64_t m_nextId;
+        };
+
+        using MqttSubscriptionRegistry = BasicMqttSubscriptionRegistry<Crt::Mqtt::MqttConnection>;
+
+    } // namespace Iotdevicecommon
+} // namespace Aws
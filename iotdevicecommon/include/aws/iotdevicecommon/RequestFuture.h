@@ -0,0 +1,250 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/common/assert.h>
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#if defined(__has_include)
+#    if __has_include(<coroutine>) && defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#        include <coroutine>
+#        define AWS_IOTDEVICECOMMON_HAS_COROUTINES 1
+#    endif
+#endif
+
+namespace Aws
+{
+    namespace Iotdevicecommon
+    {
+        /**
+         * Eventual result of a request made through a V2 service client.
+         *
+         * A future completes on the thread that delivers the service response, which for the MQTT request-response
+         * clients is a CRT event loop thread.  Continuations registered with Then() and coroutines suspended on the
+         * future (C++20 only) are resumed inline on that thread, without being handed to another thread first; they
+         * must therefore not block.  Get() and Wait() block the calling thread and must not be used from an event
+         * loop thread.
+         *
+         * A future is move-only and its result can only be consumed once, by exactly one of Get(), Then() or
+         * co_await.  Consuming it a second time is a fatal error.
+         *
+         * Each request allocates one shared state that holds the result, its synchronization primitives and the
+         * handler passed to the service client.
+         *
+         * @tparam R result type of the request, e.g. Aws::Iotshadow::UpdateShadowResult
+         */
+        template <typename R> class RequestFuture
+        {
+          public:
+            /**
+             * Submits a request with a handler that completes the returned future.
+             *
+             * @param allocator memory allocator for the shared state
+             * @param submit function object taking the result handler and returning success/failure of the submission
+             * @param makeFailure function object creating a result from an AWS error code, used if the submission
+             * fails synchronously
+             *
+             * @return a future for the result of the request
+             */
+            template <typename Submit, typename MakeFailure>
+            static RequestFuture Start(Crt::Allocator *allocator, Submit &&submit, MakeFailure &&makeFailure)
+            {
+                auto state = Crt::MakeShared<State>(allocator);
+
+                std::function<void(R &&)> handler = [state](R &&result) { state->Complete(std::move(result)); };
+                if (!submit(handler))
+                {
+                    int errorCode = aws_last_error();
+                    state->Complete(makeFailure(errorCode != AWS_ERROR_SUCCESS ? errorCode : AWS_ERROR_UNKNOWN));
+                }
+
+                return RequestFuture(std::move(state));
+            }
+
+            RequestFuture(RequestFuture &&) = default;
+            RequestFuture &operator=(RequestFuture &&) = default;
+            RequestFuture(const RequestFuture &) = delete;
+            RequestFuture &operator=(const RequestFuture &) = delete;
+
+            /**
+             * @return true if the result is available
+             */
+            bool IsReady() const
+            {
+                std::lock_guard<std::mutex> guard(m_state->lock);
+                return m_state->ready;
+            }
+
+            /**
+             * Blocks until the result is available.
+             */
+            void Wait() const
+            {
+                std::unique_lock<std::mutex> guard(m_state->lock);
+                m_state->signal.wait(guard, [this]() { return m_state->ready; });
+            }
+
+            /**
+             * Blocks until the result is available or the timeout elapses.
+             *
+             * @param timeout maximum time to wait
+             * @return true if the result is available
+             */
+            template <typename Rep, typename Period>
+            bool WaitFor(const std::chrono::duration<Rep, Period> &timeout) const
+            {
+                std::unique_lock<std::mutex> guard(m_state->lock);
+                return m_state->signal.wait_for(guard, timeout, [this]() { return m_state->ready; });
+            }
+
+            /**
+             * Blocks until the result is available and moves it out of the future.
+             */
+            R Get()
+            {
+                std::unique_lock<std::mutex> guard(m_state->lock);
+                m_state->Consume();
+                m_state->signal.wait(guard, [this]() { return m_state->ready; });
+                return m_state->Take();
+            }
+
+            /**
+             * Registers a continuation for the result.  If the result is already available, the continuation is
+             * invoked immediately on the calling thread; otherwise it is invoked on the thread completing the request.
+             *
+             * @param continuation function object to invoke with the result
+             */
+            void Then(std::function<void(R &&)> continuation)
+            {
+                std::unique_lock<std::mutex> guard(m_state->lock);
+                m_state->Consume();
+                if (!m_state->ready)
+                {
+                    m_state->continuation = std::move(continuation);
+                    return;
+                }
+
+                R result = m_state->Take();
+                guard.unlock();
+                continuation(std::move(result));
+            }
+
+#ifdef AWS_IOTDEVICECOMMON_HAS_COROUTINES
+            bool await_ready() const { return IsReady(); }
+
+            bool await_suspend(std::coroutine_handle<> waiter)
+            {
+                std::lock_guard<std::mutex> guard(m_state->lock);
+                if (m_state->ready)
+                {
+                    return false;
+                }
+
+                m_state->Consume();
+                m_state->waiter = waiter;
+                m_state->suspended = true;
+                return true;
+            }
+
+            R await_resume()
+            {
+                std::lock_guard<std::mutex> guard(m_state->lock);
+                if (m_state->suspended)
+                {
+                    /* Claimed by await_suspend() */
+                    m_state->suspended = false;
+                }
+                else
+                {
+                    m_state->Consume();
+                }
+                return m_state->Take();
+            }
+#endif
+
+          private:
+            struct State
+            {
+                void Complete(R &&value)
+                {
+                    std::function<void(R &&)> pendingContinuation;
+#ifdef AWS_IOTDEVICECOMMON_HAS_COROUTINES
+                    std::coroutine_handle<> pendingWaiter;
+#endif
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        ready = true;
+                        if (continuation)
+                        {
+                            pendingContinuation = std::move(continuation);
+                        }
+                        else
+                        {
+                            result = std::move(value);
+#ifdef AWS_IOTDEVICECOMMON_HAS_COROUTINES
+                            pendingWaiter = waiter;
+                            waiter = nullptr;
+#endif
+                        }
+                    }
+
+                    if (pendingContinuation)
+                    {
+                        pendingContinuation(std::move(value));
+                        return;
+                    }
+
+#ifdef AWS_IOTDEVICECOMMON_HAS_COROUTINES
+                    if (pendingWaiter)
+                    {
+                        pendingWaiter.resume();
+                        return;
+                    }
+#endif
+
+                    signal.notify_all();
+                }
+
+                /* Requires the lock */
+                void Consume()
+                {
+                    AWS_FATAL_ASSERT(!consumed && "RequestFuture result consumed more than once");
+                    consumed = true;
+                }
+
+                /* Requires the lock and a result that is ready and was claimed with Consume() */
+                R Take()
+                {
+                    R value = std::move(*result);
+                    result.reset();
+                    return value;
+                }
+
+                std::mutex lock;
+                std::condition_variable signal;
+                bool ready = false;
+                bool consumed = false;
+                Crt::Optional<R> result;
+                std::function<void(R &&)> continuation;
+#ifdef AWS_IOTDEVICECOMMON_HAS_COROUTINES
+                std::coroutine_handle<> waiter;
+                bool suspended = false;
+#endif
+            };
+
+            explicit RequestFuture(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+
+            std::shared_ptr<State> m_state;
+        };
+
+    } // namespace Iotdevicecommon
+} // namespace Aws
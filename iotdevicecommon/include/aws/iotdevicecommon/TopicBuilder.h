@@ -0,0 +1,149 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Types.h>
+
+#include <cstring>
+
+namespace Aws
+{
+    namespace Iotdevicecommon
+    {
+        /**
+         * Assembles an MQTT topic or topic filter from string segments.
+         *
+         * Topics that fit into the inline buffer are built without touching the heap; longer ones move to a buffer
+         * acquired from the builder's allocator.  The contents are always null-terminated.
+         */
+        class TopicBuilder final
+        {
+          public:
+            /**
+             * Size of the inline buffer, including the null terminator.  Large enough for every topic the AWS IoT
+             * service APIs produce from maximum-length thing, shadow and job identifiers.
+             */
+            static constexpr size_t INLINE_CAPACITY = 256;
+
+            explicit TopicBuilder(Crt::Allocator *allocator = Crt::ApiAllocator()) noexcept
+                : m_allocator(allocator), m_data(m_inline), m_length(0), m_capacity(INLINE_CAPACITY)
+            {
+                m_inline[0] = '\0';
+            }
+
+            ~TopicBuilder()
+            {
+                if (m_data != m_inline)
+                {
+                    aws_mem_release(m_allocator, m_data);
+                }
+            }
+
+            TopicBuilder(const TopicBuilder &) = delete;
+            TopicBuilder(TopicBuilder &&) = delete;
+            TopicBuilder &operator=(const TopicBuilder &) = delete;
+            TopicBuilder &operator=(TopicBuilder &&) = delete;
+
+            TopicBuilder &Append(const char *segment) { return AppendBytes(segment, strlen(segment)); }
+
+            TopicBuilder &Append(const Crt::String &segment) { return AppendBytes(segment.data(), segment.length()); }
+
+            TopicBuilder &Append(struct aws_byte_cursor segment)
+            {
+                return AppendBytes(reinterpret_cast<const char *>(segment.ptr), segment.len);
+            }
+
+            /**
+             * Appends several segments in order.
+             */
+            template <typename First, typename Second, typename... Rest>
+            TopicBuilder &Append(const First &first, const Second &second, const Rest &...rest)
+            {
+                Append(first);
+                return Append(second, rest...);
+            }
+
+            /**
+             * @return a cursor over the topic, valid until the builder is modified or destroyed
+             */
+            struct aws_byte_cursor ToCursor() const noexcept
+            {
+                return aws_byte_cursor_from_array(m_data, m_length);
+            }
+
+            /**
+             * @return the null-terminated topic, valid until the builder is modified or destroyed
+             */
+            const char *c_str() const noexcept { return m_data; }
+
+            size_t Length() const noexcept { return m_length; }
+
+            /**
+             * @return a copy of the topic, allocated from the builder's allocator
+             */
+            Crt::String ToString() const { return Crt::String(m_data, m_length, Crt::StlAllocator<char>(m_allocator)); }
+
+            /**
+             * @param suffix text to append to the copy
+             * @return a copy of the topic followed by suffix, made with a single allocation
+             */
+            Crt::String ToString(const char *suffix) const
+            {
+                size_t suffixLength = strlen(suffix);
+                Crt::String topic{Crt::StlAllocator<char>(m_allocator)};
+                topic.reserve(m_length + suffixLength);
+                topic.append(m_data, m_length).append(suffix, suffixLength);
+                return topic;
+            }
+
+          private:
+            TopicBuilder &AppendBytes(const char *bytes, size_t length)
+            {
+                if (length == 0)
+                {
+                    return *this;
+                }
+
+                size_t required = m_length + length + 1;
+                if (required > m_capacity)
+                {
+                    Grow(required);
+                }
+
+                memcpy(m_data + m_length, bytes, length);
+                m_length += length;
+                m_data[m_length] = '\0';
+                return *this;
+            }
+
+            void Grow(size_t required)
+            {
+                size_t capacity = m_capacity * 2;
+                while (capacity < required)
+                {
+                    capacity *= 2;
+                }
+
+                /* aws_mem_acquire() aborts rather than returning null */
+                char *data = static_cast<char *>(aws_mem_acquire(m_allocator, capacity));
+                memcpy(data, m_data, m_length + 1);
+                if (m_data != m_inline)
+                {
+                    aws_mem_release(m_allocator, m_data);
+                }
+
+                m_data = data;
+                m_capacity = capacity;
+            }
+
+            Crt::Allocator *m_allocator;
+            char *m_data;
+            size_t m_length;
+            size_t m_capacity;
+            char m_inline[INLINE_CAPACITY];
+        };
+
+    } // namespace Iotdevicecommon
+} // namespace Aws
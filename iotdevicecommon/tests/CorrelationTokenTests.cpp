@@ -0,0 +1,65 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotdevicecommon/CorrelationTokenGenerator.h>
+
+static int s_CorrelationTokenCounterGenerator(Aws::Crt::Allocator *allocator, void *)
+{
+    (void)allocator;
+    {
+        Aws::Crt::ApiHandle handle;
+
+        Aws::Iotdevicecommon::CounterCorrelationTokenGenerator generator;
+
+        Aws::Iotdevicecommon::CorrelationToken first;
+        Aws::Iotdevicecommon::CorrelationToken second;
+        ASSERT_TRUE(generator.Generate(first));
+        ASSERT_TRUE(generator.Generate(second));
+
+        /* 16 hex prefix characters, a dash and the counter */
+        ASSERT_UINT_EQUALS(18, first.length);
+        ASSERT_TRUE(first.data[16] == '-');
+        ASSERT_TRUE(first.data[17] == '0');
+        ASSERT_TRUE(second.data[17] == '1');
+        ASSERT_BIN_ARRAYS_EQUALS(first.data, 17, second.data, 17);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CorrelationTokenCounterGenerator, s_CorrelationTokenCounterGenerator)
+
+static int s_CorrelationTokenUuidPoolGenerator(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        /* Without an event loop group the pool is refilled on the calling thread once it runs dry */
+        auto generator = Aws::Iotdevicecommon::UuidPoolCorrelationTokenGenerator::Create(4, nullptr, allocator);
+        ASSERT_NOT_NULL(generator.get());
+
+        Aws::Crt::Vector<Aws::Crt::String> tokens;
+        for (size_t i = 0; i < 10; ++i)
+        {
+            Aws::Iotdevicecommon::CorrelationToken token;
+            ASSERT_TRUE(generator->Generate(token));
+            ASSERT_UINT_EQUALS(36, token.length);
+            Aws::Crt::String value(token.data, token.length);
+            for (const auto &previous : tokens)
+            {
+                ASSERT_FALSE(previous == value);
+            }
+            tokens.push_back(value);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(CorrelationTokenUuidPoolGenerator, s_CorrelationTokenUuidPoolGenerator)
@@ -0,0 +1,265 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotdevicecommon/JsonStreamParser.h>
+
+#include <cstring>
+
+using namespace Aws::Iotdevicecommon;
+
+/* Records every token as a line of text, and aborts on the token numbered abortAt if set */
+class TokenRecorder : public IJsonStreamHandler
+{
+  public:
+    bool OnBeginObject() override { return Record("{"); }
+
+    bool OnEndObject() override { return Record("}"); }
+
+    bool OnBeginArray() override { return Record("["); }
+
+    bool OnEndArray() override { return Record("]"); }
+
+    bool OnKey(struct aws_byte_cursor key) override { return Record("key:", key); }
+
+    bool OnString(struct aws_byte_cursor value) override { return Record("string:", value); }
+
+    bool OnNumber(struct aws_byte_cursor text) override { return Record("number:", text); }
+
+    bool OnBool(bool value) override { return Record(value ? "true" : "false"); }
+
+    bool OnNull() override { return Record("null"); }
+
+    Aws::Crt::String tokens;
+    size_t tokenCount = 0;
+    size_t abortAt = 0;
+
+  private:
+    bool Record(const char *token, struct aws_byte_cursor text = {0, nullptr})
+    {
+        tokens.append(token);
+        tokens.append(reinterpret_cast<const char *>(text.ptr), text.len);
+        tokens.append("\n");
+        return ++tokenCount != abortAt;
+    }
+};
+
+/* Parses a document fed in chunks of the given size; returns whether it was a single complete JSON value */
+static bool s_parse(Aws::Crt::Allocator *allocator, const char *json, size_t chunkSize, TokenRecorder &recorder)
+{
+    JsonStreamParser parser(recorder, allocator);
+    size_t length = strlen(json);
+    for (size_t offset = 0; offset < length; offset += chunkSize)
+    {
+        size_t chunkLength = length - offset < chunkSize ? length - offset : chunkSize;
+        if (!parser.Feed(aws_byte_cursor_from_array(json + offset, chunkLength)))
+        {
+            return false;
+        }
+    }
+
+    return parser.Finish();
+}
+
+/* Parses a document whole and byte by byte, which must agree, and returns its tokens or "error" */
+static Aws::Crt::String s_tokens(Aws::Crt::Allocator *allocator, const char *json)
+{
+    TokenRecorder whole;
+    bool wholeParsed = s_parse(allocator, json, strlen(json) + 1, whole);
+
+    TokenRecorder byByte;
+    bool byByteParsed = s_parse(allocator, json, 1, byByte);
+
+    if (wholeParsed != byByteParsed || whole.tokens != byByte.tokens)
+    {
+        return "mismatch";
+    }
+
+    return wholeParsed ? whole.tokens : "error";
+}
+
+static int s_JsonStreamParserEscapes(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        ASSERT_TRUE(s_tokens(allocator, "\"q\\\" b\\\\ s\\/\"") == "string:q\" b\\ s/\n");
+        ASSERT_TRUE(s_tokens(allocator, "\"\\b\\f\\n\\r\\t\"") == "string:\b\f\n\r\t\n");
+        ASSERT_TRUE(s_tokens(allocator, "{\"k\\u0065y\":\"\"}") == "{\nkey:key\nstring:\n}\n");
+
+        /* \u escapes are encoded as UTF-8 of one to four bytes; surrogate pairs combine into one code point */
+        ASSERT_TRUE(s_tokens(allocator, "\"\\u0041\\u00E9\\u20ac\"") == "string:A\xC3\xA9\xE2\x82\xAC\n");
+        ASSERT_TRUE(s_tokens(allocator, "\"\\ud83d\\ude00\"") == "string:\xF0\x9F\x98\x80\n");
+        ASSERT_TRUE(s_tokens(allocator, "\"\\uDBFF\\uDFFF\"") == "string:\xF4\x8F\xBF\xBF\n");
+
+        /* Unescaped UTF-8 passes through untouched */
+        ASSERT_TRUE(s_tokens(allocator, "\"\xC3\xA9\"") == "string:\xC3\xA9\n");
+
+        /* Unpaired surrogates, unknown escapes, bad hex digits and raw control characters are rejected */
+        ASSERT_TRUE(s_tokens(allocator, "\"\\ud83d\"") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "\"\\ud83dx\"") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "\"\\ud83d\\n\"") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "\"\\ud83d\\u0041\"") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "\"\\ude00\"") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "\"\\x41\"") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "\"\\u00g1\"") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "\"a\nb\"") == "error");
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JsonStreamParserEscapes, s_JsonStreamParserEscapes)
+
+static int s_JsonStreamParserNumbers(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        /* A top-level number only ends at Finish */
+        ASSERT_TRUE(s_tokens(allocator, "0") == "number:0\n");
+        ASSERT_TRUE(s_tokens(allocator, "-0") == "number:-0\n");
+        ASSERT_TRUE(s_tokens(allocator, "1234567890") == "number:1234567890\n");
+        ASSERT_TRUE(s_tokens(allocator, "-12.5") == "number:-12.5\n");
+        ASSERT_TRUE(s_tokens(allocator, "1e10") == "number:1e10\n");
+        ASSERT_TRUE(s_tokens(allocator, "1E+2") == "number:1E+2\n");
+        ASSERT_TRUE(s_tokens(allocator, "-2.5e-3") == "number:-2.5e-3\n");
+
+        /* Inside a container the next byte ends the number, whether a delimiter or whitespace */
+        ASSERT_TRUE(s_tokens(allocator, "[1,2.0 ,3e1]") == "[\nnumber:1\nnumber:2.0\nnumber:3e1\n]\n");
+        ASSERT_TRUE(s_tokens(allocator, "{\"n\":-1}") == "{\nkey:n\nnumber:-1\n}\n");
+
+        ASSERT_TRUE(s_tokens(allocator, "01") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "-") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "+1") == "error");
+        ASSERT_TRUE(s_tokens(allocator, ".5") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "1.") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "1.e2") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "1e") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "1e+") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "--1") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "1-2") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "[1x]") == "error");
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JsonStreamParserNumbers, s_JsonStreamParserNumbers)
+
+static int s_JsonStreamParserNesting(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        ASSERT_TRUE(
+            s_tokens(allocator, " { \"a\" : [ {} , [ ] , true , false , null ] } \r\n") ==
+            "{\nkey:a\n[\n{\n}\n[\n]\ntrue\nfalse\nnull\n]\n}\n");
+
+        /* Objects and arrays nest up to 64 levels deep */
+        Aws::Crt::String deepest;
+        for (int i = 0; i < 64; ++i)
+        {
+            deepest.append(i % 2 == 0 ? "[" : "{\"k\":");
+        }
+        deepest.append("1");
+        for (int i = 63; i >= 0; --i)
+        {
+            deepest.append(i % 2 == 0 ? "]" : "}");
+        }
+        ASSERT_FALSE(s_tokens(allocator, deepest.c_str()) == "error");
+
+        Aws::Crt::String tooDeep(65, '[');
+        tooDeep.append(65, ']');
+        ASSERT_TRUE(s_tokens(allocator, tooDeep.c_str()) == "error");
+
+        /* Containers must close with their own bracket */
+        ASSERT_TRUE(s_tokens(allocator, "[}") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "{\"a\":[1}]") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "]") == "error");
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JsonStreamParserNesting, s_JsonStreamParserNesting)
+
+static int s_JsonStreamParserTruncated(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        /* Every prefix of a document parses without error, but only the whole document is complete */
+        const char *document = "{\"a\":[\"x\\u00e9\",-1.5e3,true,null],\"b\":{}}";
+        size_t length = strlen(document);
+        for (size_t prefix = 0; prefix < length; ++prefix)
+        {
+            TokenRecorder recorder;
+            JsonStreamParser parser(recorder, allocator);
+            ASSERT_TRUE(parser.Feed(aws_byte_cursor_from_array(document, prefix)));
+            ASSERT_FALSE(parser.Finish());
+        }
+
+        TokenRecorder recorder;
+        JsonStreamParser parser(recorder, allocator);
+        ASSERT_TRUE(parser.Feed(aws_byte_cursor_from_array(document, length)));
+        ASSERT_TRUE(parser.Finish());
+        ASSERT_INT_EQUALS(length, parser.GetOffset());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JsonStreamParserTruncated, s_JsonStreamParserTruncated)
+
+static int s_JsonStreamParserMalformed(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        ASSERT_TRUE(s_tokens(allocator, "") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "  ") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "[1,]") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "[,1]") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "{\"a\":1,}") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "{\"a\" 1}") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "{\"a\":}") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "{a:1}") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "{1:1}") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "[1 2]") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "[tru]") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "nul") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "True") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "'a'") == "error");
+
+        /* Only whitespace may follow the top-level value */
+        ASSERT_TRUE(s_tokens(allocator, "{} {}") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "1 2") == "error");
+        ASSERT_TRUE(s_tokens(allocator, "null,") == "error");
+
+        /* Once failed, the parser rejects everything fed after */
+        TokenRecorder recorder;
+        JsonStreamParser parser(recorder, allocator);
+        ASSERT_FALSE(parser.Feed(aws_byte_cursor_from_c_str("[1,]")));
+        ASSERT_FALSE(parser.Feed(aws_byte_cursor_from_c_str("]")));
+        ASSERT_FALSE(parser.Finish());
+
+        /* A handler that returns false aborts parsing at that token */
+        TokenRecorder aborting;
+        aborting.abortAt = 3;
+        JsonStreamParser abortedParser(aborting, allocator);
+        ASSERT_FALSE(abortedParser.Feed(aws_byte_cursor_from_c_str("[1, \"two\", 3]")));
+        ASSERT_TRUE(aborting.tokens == "[\nnumber:1\nstring:two\n");
+        ASSERT_INT_EQUALS(4, abortedParser.GetTokenStart());
+        ASSERT_FALSE(abortedParser.Finish());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JsonStreamParserMalformed, s_JsonStreamParserMalformed)
@@ -0,0 +1,74 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotdevicecommon/JsonWriter.h>
+
+#include <cstring>
+
+static int s_JsonWriterEscaping(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        struct aws_byte_buf buffer;
+        ASSERT_SUCCESS(aws_byte_buf_init(&buffer, allocator, 4));
+
+        /* A caller-owned buffer is appended to and grows as needed */
+        {
+            Aws::Iotdevicecommon::JsonWriter writer(buffer);
+            writer.BeginObject();
+            writer.WithString("text", "quote\" slash\\ line\n tab\t bell\x07");
+            writer.WithInt64("min", INT64_MIN);
+            writer.WithBool("flag", false);
+            writer.BeginObject("nested");
+            writer.WithInteger("zero", 0);
+            writer.EndObject();
+            writer.EndObject();
+            ASSERT_TRUE(static_cast<bool>(writer));
+        }
+
+        const char *expected = "{\"text\":\"quote\\\" slash\\\\ line\\n tab\\t bell\\u0007\","
+                               "\"min\":-9223372036854775808,\"flag\":false,\"nested\":{\"zero\":0}}";
+        ASSERT_BIN_ARRAYS_EQUALS(expected, strlen(expected), buffer.buffer, buffer.len);
+
+        Aws::Crt::JsonObject parsed(Aws::Crt::String(reinterpret_cast<const char *>(buffer.buffer), buffer.len));
+        ASSERT_TRUE(parsed.WasParseSuccessful());
+        ASSERT_TRUE(parsed.View().GetString("text") == "quote\" slash\\ line\n tab\t bell\x07");
+
+        aws_byte_buf_clean_up(&buffer);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JsonWriterEscaping, s_JsonWriterEscaping)
+
+static int s_JsonWriterUnbalanced(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        Aws::Iotdevicecommon::JsonWriter unclosed(allocator);
+        unclosed.BeginObject();
+        unclosed.BeginObject("nested");
+        unclosed.EndObject();
+        ASSERT_FALSE(static_cast<bool>(unclosed));
+
+        Aws::Iotdevicecommon::JsonWriter overclosed(allocator);
+        overclosed.BeginObject();
+        overclosed.EndObject();
+        overclosed.EndObject();
+        ASSERT_FALSE(static_cast<bool>(overclosed));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JsonWriterUnbalanced, s_JsonWriterUnbalanced)
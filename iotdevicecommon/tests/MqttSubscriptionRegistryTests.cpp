@@ -0,0 +1,405 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotdevicecommon/MqttSubscriptionRegistry.h>
+
+/* Records subscribe and unsubscribe calls, and lets the test acknowledge subscriptions and deliver messages */
+class FakeMqttConnection
+{
+  public:
+    using OnMessageReceivedHandler =
+        std::function<void(FakeMqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &)>;
+    using OnSubAckHandler = std::function<
+        void(FakeMqttConnection &, uint16_t, const Aws::Crt::String &, Aws::Crt::Mqtt::QOS, int)>;
+    using OnOperationCompleteHandler = std::function<void(FakeMqttConnection &, uint16_t, int)>;
+
+    struct SentSubscribe
+    {
+        Aws::Crt::String topicFilter;
+        Aws::Crt::Mqtt::QOS qos;
+        OnSubAckHandler onSubAck;
+    };
+
+    uint16_t Subscribe(
+        const char *topicFilter,
+        Aws::Crt::Mqtt::QOS qos,
+        OnMessageReceivedHandler &&onMessage,
+        OnSubAckHandler &&onSubAck)
+    {
+        subscribes.push_back(SentSubscribe{topicFilter, qos, std::move(onSubAck)});
+
+        /* Like the real connection, subscribing to a filter again replaces its message callback */
+        messageHandlers[topicFilter] = std::move(onMessage);
+        return static_cast<uint16_t>(subscribes.size());
+    }
+
+    uint16_t Unsubscribe(const char *topicFilter, OnOperationCompleteHandler &&)
+    {
+        unsubscribes.push_back(topicFilter);
+        messageHandlers.erase(topicFilter);
+        return static_cast<uint16_t>(unsubscribes.size());
+    }
+
+    void AckSubscribe(size_t index, int errorCode)
+    {
+        SentSubscribe &subscribe = subscribes[index];
+        OnSubAckHandler onSubAck = std::move(subscribe.onSubAck);
+        onSubAck(*this, static_cast<uint16_t>(index + 1), subscribe.topicFilter, subscribe.qos, errorCode);
+    }
+
+    bool Publish(const char *topic, const char *payload)
+    {
+        auto handler = messageHandlers.find(topic);
+        if (handler == messageHandlers.end())
+        {
+            return false;
+        }
+
+        OnMessageReceivedHandler onMessage = handler->second;
+        Aws::Crt::ByteBuf buffer = Aws::Crt::ByteBufFromCString(payload);
+        onMessage(*this, topic, buffer);
+        return true;
+    }
+
+    Aws::Crt::Vector<SentSubscribe> subscribes;
+    Aws::Crt::Vector<Aws::Crt::String> unsubscribes;
+    Aws::Crt::Map<Aws::Crt::String, OnMessageReceivedHandler> messageHandlers;
+};
+
+using FakeRegistry = Aws::Iotdevicecommon::BasicMqttSubscriptionRegistry<FakeMqttConnection>;
+
+/* Counts the messages and acknowledgements delivered to one registered handler */
+struct HandlerCalls
+{
+    FakeRegistry::PublishHandler OnPublish()
+    {
+        return [this](
+                   FakeMqttConnection &,
+                   const Aws::Crt::String &,
+                   const Aws::Crt::ByteBuf &,
+                   Aws::Iotdevicecommon::MqttMessageCache &) { ++messages; };
+    }
+
+    FakeRegistry::SubAckHandler OnSubAck()
+    {
+        return [this](FakeMqttConnection &, uint16_t, const Aws::Crt::String &, Aws::Crt::Mqtt::QOS, int errorCode)
+        {
+            ++acks;
+            lastAckError = errorCode;
+        };
+    }
+
+    int messages = 0;
+    int acks = 0;
+    int lastAckError = AWS_ERROR_SUCCESS;
+};
+
+static int s_MqttSubscriptionRegistrySharedSubscription(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto connection = std::make_shared<FakeMqttConnection>();
+        auto registry = FakeRegistry::ForConnection(connection, allocator);
+        ASSERT_TRUE(registry == FakeRegistry::ForConnection(connection, allocator));
+
+        HandlerCalls first;
+        HandlerCalls second;
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, first.OnPublish(), first.OnSubAck()) != 0);
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, second.OnPublish(), second.OnSubAck()) != 0);
+        ASSERT_UINT_EQUALS(1, connection->subscribes.size());
+        ASSERT_INT_EQUALS(0, first.acks);
+        ASSERT_INT_EQUALS(0, second.acks);
+
+        /* Both handlers learn about the one SUBACK */
+        connection->AckSubscribe(0, AWS_ERROR_SUCCESS);
+        ASSERT_INT_EQUALS(1, first.acks);
+        ASSERT_INT_EQUALS(1, second.acks);
+        ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, second.lastAckError);
+
+        /* Joining an acknowledged subscription is acknowledged right away */
+        HandlerCalls third;
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, third.OnPublish(), third.OnSubAck()) != 0);
+        ASSERT_UINT_EQUALS(1, connection->subscribes.size());
+        ASSERT_INT_EQUALS(1, third.acks);
+
+        ASSERT_TRUE(connection->Publish("a/b", "{}"));
+        ASSERT_INT_EQUALS(1, first.messages);
+        ASSERT_INT_EQUALS(1, second.messages);
+        ASSERT_INT_EQUALS(1, third.messages);
+
+        /* A higher QoS re-subscribes the filter */
+        HandlerCalls upgraded;
+        ASSERT_TRUE(
+            registry->Subscribe("a/b", AWS_MQTT_QOS_AT_LEAST_ONCE, upgraded.OnPublish(), upgraded.OnSubAck()) != 0);
+        ASSERT_UINT_EQUALS(2, connection->subscribes.size());
+        ASSERT_INT_EQUALS(AWS_MQTT_QOS_AT_LEAST_ONCE, connection->subscribes[1].qos);
+        connection->AckSubscribe(1, AWS_ERROR_SUCCESS);
+        ASSERT_INT_EQUALS(1, upgraded.acks);
+
+        ASSERT_TRUE(connection->Publish("a/b", "{}"));
+        ASSERT_INT_EQUALS(2, first.messages);
+        ASSERT_INT_EQUALS(1, upgraded.messages);
+        ASSERT_UINT_EQUALS(0, connection->unsubscribes.size());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(MqttSubscriptionRegistrySharedSubscription, s_MqttSubscriptionRegistrySharedSubscription)
+
+static int s_MqttSubscriptionRegistryLastRelease(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto connection = std::make_shared<FakeMqttConnection>();
+        auto registry = FakeRegistry::ForConnection(connection, allocator);
+
+        HandlerCalls first;
+        HandlerCalls second;
+        HandlerCalls kept;
+        uint64_t firstId = registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, first.OnPublish(), first.OnSubAck());
+        uint64_t secondId =
+            registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, second.OnPublish(), second.OnSubAck());
+        ASSERT_TRUE(registry->Subscribe("c/d", AWS_MQTT_QOS_AT_MOST_ONCE, kept.OnPublish(), kept.OnSubAck()) != 0);
+        connection->AckSubscribe(0, AWS_ERROR_SUCCESS);
+        connection->AckSubscribe(1, AWS_ERROR_SUCCESS);
+
+        registry->Release("a/b", firstId);
+        ASSERT_UINT_EQUALS(0, connection->unsubscribes.size());
+        ASSERT_TRUE(connection->Publish("a/b", "{}"));
+        ASSERT_INT_EQUALS(0, first.messages);
+        ASSERT_INT_EQUALS(1, second.messages);
+
+        registry->Release("a/b", secondId);
+        ASSERT_UINT_EQUALS(1, connection->unsubscribes.size());
+        ASSERT_TRUE(connection->unsubscribes[0] == "a/b");
+        ASSERT_FALSE(connection->Publish("a/b", "{}"));
+
+        /* Handlers that are never released stay registered for as long as the connection lives */
+        std::weak_ptr<FakeRegistry> weakRegistry = registry;
+        registry.reset();
+        ASSERT_FALSE(weakRegistry.expired());
+        ASSERT_TRUE(connection->Publish("c/d", "{}"));
+        ASSERT_INT_EQUALS(1, kept.messages);
+
+        connection.reset();
+        ASSERT_TRUE(weakRegistry.expired());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(MqttSubscriptionRegistryLastRelease, s_MqttSubscriptionRegistryLastRelease)
+
+static int s_MqttSubscriptionRegistryConnectionReuse(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto connection = std::make_shared<FakeMqttConnection>();
+        auto staleRegistry = FakeRegistry::ForConnection(connection, allocator);
+        HandlerCalls stale;
+        ASSERT_TRUE(
+            staleRegistry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, stale.OnPublish(), stale.OnSubAck()) != 0);
+        connection->AckSubscribe(0, AWS_ERROR_SUCCESS);
+        connection.reset();
+
+        /* The old registry may still be referenced, but a new connection never gets it, nor its subscriptions */
+        auto newConnection = std::make_shared<FakeMqttConnection>();
+        auto registry = FakeRegistry::ForConnection(newConnection, allocator);
+        ASSERT_FALSE(registry == staleRegistry);
+
+        HandlerCalls fresh;
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, fresh.OnPublish(), fresh.OnSubAck()) != 0);
+        ASSERT_UINT_EQUALS(1, newConnection->subscribes.size());
+        ASSERT_INT_EQUALS(0, fresh.acks);
+
+        /* A registry whose connection is gone refuses new subscriptions */
+        HandlerCalls late;
+        ASSERT_TRUE(staleRegistry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, late.OnPublish(), late.OnSubAck()) == 0);
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_STATE, aws_last_error());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(MqttSubscriptionRegistryConnectionReuse, s_MqttSubscriptionRegistryConnectionReuse)
+
+static int s_MqttSubscriptionRegistryOwnerResubscribe(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto connection = std::make_shared<FakeMqttConnection>();
+        auto registry = FakeRegistry::ForConnection(connection, allocator);
+
+        int owner = 0;
+        int otherOwner = 0;
+        HandlerCalls first;
+        HandlerCalls second;
+        HandlerCalls other;
+        ASSERT_TRUE(
+            registry->Subscribe(&owner, "a/b", AWS_MQTT_QOS_AT_MOST_ONCE, first.OnPublish(), first.OnSubAck()) != 0);
+        ASSERT_TRUE(
+            registry->Subscribe(&owner, "a/b", AWS_MQTT_QOS_AT_MOST_ONCE, second.OnPublish(), second.OnSubAck()) != 0);
+        ASSERT_TRUE(
+            registry->Subscribe(&otherOwner, "a/b", AWS_MQTT_QOS_AT_MOST_ONCE, other.OnPublish(), other.OnSubAck()) !=
+            0);
+        ASSERT_UINT_EQUALS(1, connection->subscribes.size());
+
+        /* Subscribing again through the same owner replaced its handler instead of adding another */
+        connection->AckSubscribe(0, AWS_ERROR_SUCCESS);
+        ASSERT_INT_EQUALS(0, first.acks);
+        ASSERT_INT_EQUALS(1, second.acks);
+        ASSERT_TRUE(connection->Publish("a/b", "{}"));
+        ASSERT_INT_EQUALS(0, first.messages);
+        ASSERT_INT_EQUALS(1, second.messages);
+        ASSERT_INT_EQUALS(1, other.messages);
+
+        /* Releasing an owner only unsubscribes the filters nobody else has a handler for */
+        HandlerCalls only;
+        ASSERT_TRUE(
+            registry->Subscribe(&owner, "c/d", AWS_MQTT_QOS_AT_MOST_ONCE, only.OnPublish(), only.OnSubAck()) != 0);
+        registry->ReleaseOwner(&owner);
+        ASSERT_UINT_EQUALS(1, connection->unsubscribes.size());
+        ASSERT_TRUE(connection->unsubscribes[0] == "c/d");
+        ASSERT_TRUE(connection->Publish("a/b", "{}"));
+        ASSERT_INT_EQUALS(1, second.messages);
+        ASSERT_INT_EQUALS(2, other.messages);
+
+        registry->ReleaseOwner(&otherOwner);
+        ASSERT_UINT_EQUALS(2, connection->unsubscribes.size());
+        ASSERT_TRUE(connection->unsubscribes[1] == "a/b");
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(MqttSubscriptionRegistryOwnerResubscribe, s_MqttSubscriptionRegistryOwnerResubscribe)
+
+/* Stands in for a generated service model and counts how often it is built and copied */
+template <int Id> struct CountingModel
+{
+    explicit CountingModel(const Aws::Crt::JsonView &doc) : value(doc.GetInteger("value")) { ++constructed; }
+    CountingModel(const CountingModel &other) : value(other.value) { ++copied; }
+
+    int value;
+    static int constructed;
+    static int copied;
+};
+
+template <int Id> int CountingModel<Id>::constructed = 0;
+template <int Id> int CountingModel<Id>::copied = 0;
+
+static int s_MqttMessageCacheSharedDecode(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto connection = std::make_shared<FakeMqttConnection>();
+        auto registry = FakeRegistry::ForConnection(connection, allocator);
+
+        Aws::Crt::Vector<std::shared_ptr<const CountingModel<0>>> decodedFirst;
+        Aws::Crt::Vector<std::shared_ptr<const CountingModel<1>>> decodedSecond;
+        auto decodeFirst = [&decodedFirst](
+                               FakeMqttConnection &,
+                               const Aws::Crt::String &,
+                               const Aws::Crt::ByteBuf &payload,
+                               Aws::Iotdevicecommon::MqttMessageCache &cache)
+        { decodedFirst.push_back(cache.DecodeJson<CountingModel<0>>(payload)); };
+        auto decodeSecond = [&decodedSecond](
+                                FakeMqttConnection &,
+                                const Aws::Crt::String &,
+                                const Aws::Crt::ByteBuf &payload,
+                                Aws::Iotdevicecommon::MqttMessageCache &cache)
+        { decodedSecond.push_back(cache.DecodeJson<CountingModel<1>>(payload)); };
+
+        /* Handlers decoding different models are interleaved; each model is still built once per message */
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, decodeFirst, nullptr) != 0);
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, decodeSecond, nullptr) != 0);
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, decodeFirst, nullptr) != 0);
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, decodeSecond, nullptr) != 0);
+
+        ASSERT_TRUE(connection->Publish("a/b", "{\"value\":7}"));
+        ASSERT_INT_EQUALS(1, CountingModel<0>::constructed);
+        ASSERT_INT_EQUALS(1, CountingModel<1>::constructed);
+        ASSERT_UINT_EQUALS(2, decodedFirst.size());
+        ASSERT_UINT_EQUALS(2, decodedSecond.size());
+        ASSERT_TRUE(decodedFirst[0] == decodedFirst[1]);
+        ASSERT_TRUE(decodedSecond[0] == decodedSecond[1]);
+        ASSERT_INT_EQUALS(7, decodedFirst[0]->value);
+
+        /* The next message is decoded afresh */
+        ASSERT_TRUE(connection->Publish("a/b", "{\"value\":8}"));
+        ASSERT_INT_EQUALS(2, CountingModel<0>::constructed);
+        ASSERT_INT_EQUALS(8, decodedFirst[2]->value);
+
+        /* Every handler sees the same parse failure */
+        ASSERT_TRUE(connection->Publish("a/b", "{"));
+        ASSERT_INT_EQUALS(2, CountingModel<0>::constructed);
+        ASSERT_NULL(decodedFirst[4].get());
+        ASSERT_NULL(decodedFirst[5].get());
+        ASSERT_NULL(decodedSecond[4].get());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(MqttMessageCacheSharedDecode, s_MqttMessageCacheSharedDecode)
+
+static int s_MqttMessageCacheSingleHandler(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto connection = std::make_shared<FakeMqttConnection>();
+        auto registry = FakeRegistry::ForConnection(connection, allocator);
+
+        Aws::Crt::Vector<int> values;
+        int parseErrors = 0;
+        auto decode = [&values, &parseErrors](
+                          FakeMqttConnection &,
+                          const Aws::Crt::String &,
+                          const Aws::Crt::ByteBuf &payload,
+                          Aws::Iotdevicecommon::MqttMessageCache &cache)
+        {
+            auto decoded = cache.DecodeJsonValue<CountingModel<2>>(payload);
+            if (!decoded.has_value())
+            {
+                ++parseErrors;
+                return;
+            }
+            values.push_back(decoded.value().value);
+        };
+
+        /* The only handler of a topic gets its model built in place, without a shared copy */
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, decode, nullptr) != 0);
+        ASSERT_TRUE(connection->Publish("a/b", "{\"value\":7}"));
+        ASSERT_UINT_EQUALS(1, values.size());
+        ASSERT_INT_EQUALS(7, values[0]);
+        ASSERT_INT_EQUALS(1, CountingModel<2>::constructed);
+        ASSERT_INT_EQUALS(0, CountingModel<2>::copied);
+
+        ASSERT_TRUE(connection->Publish("a/b", "{"));
+        ASSERT_INT_EQUALS(1, parseErrors);
+
+        /* With a second handler the model is decoded once and copied for each of them */
+        ASSERT_TRUE(registry->Subscribe("a/b", AWS_MQTT_QOS_AT_MOST_ONCE, decode, nullptr) != 0);
+        ASSERT_TRUE(connection->Publish("a/b", "{\"value\":8}"));
+        ASSERT_UINT_EQUALS(3, values.size());
+        ASSERT_INT_EQUALS(2, CountingModel<2>::constructed);
+        ASSERT_INT_EQUALS(2, CountingModel<2>::copied);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(MqttMessageCacheSingleHandler, s_MqttMessageCacheSingleHandler)
@@ -0,0 +1,106 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotdevicecommon/RequestFuture.h>
+
+#include <thread>
+#include <type_traits>
+
+struct TestResult
+{
+    explicit TestResult(int value) : value(value) {}
+
+    int value;
+};
+
+using TestHandler = std::function<void(TestResult &&)>;
+
+/* Copies would let two owners consume the same result */
+static_assert(
+    !std::is_copy_constructible<Aws::Iotdevicecommon::RequestFuture<TestResult>>::value,
+    "RequestFuture must be move-only");
+
+static TestResult s_makeFailure(int errorCode)
+{
+    return TestResult(-errorCode);
+}
+
+static int s_RequestFutureCompletion(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        /* Completed from another thread while the caller blocks */
+        TestHandler pending;
+        auto future = Aws::Iotdevicecommon::RequestFuture<TestResult>::Start(
+            allocator,
+            [&pending](const TestHandler &handler)
+            {
+                pending = handler;
+                return true;
+            },
+            s_makeFailure);
+        ASSERT_FALSE(future.IsReady());
+
+        /* Ownership of the result moves with the future */
+        auto moved = std::move(future);
+        std::thread completer([&pending]() { pending(TestResult(7)); });
+        ASSERT_INT_EQUALS(7, moved.Get().value);
+        completer.join();
+
+        /* A continuation registered before completion runs on the completing thread */
+        auto chained = Aws::Iotdevicecommon::RequestFuture<TestResult>::Start(
+            allocator,
+            [&pending](const TestHandler &handler)
+            {
+                pending = handler;
+                return true;
+            },
+            s_makeFailure);
+
+        int continued = 0;
+        chained.Then([&continued](TestResult &&result) { continued = result.value; });
+        ASSERT_INT_EQUALS(0, continued);
+        pending(TestResult(11));
+        ASSERT_INT_EQUALS(11, continued);
+        ASSERT_TRUE(chained.IsReady());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(RequestFutureCompletion, s_RequestFutureCompletion)
+
+static int s_RequestFutureSubmitFailure(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto future = Aws::Iotdevicecommon::RequestFuture<TestResult>::Start(
+            allocator,
+            [](const TestHandler &)
+            {
+                aws_raise_error(AWS_ERROR_INVALID_STATE);
+                return false;
+            },
+            s_makeFailure);
+
+        /* A synchronous submission failure completes the future immediately */
+        ASSERT_TRUE(future.IsReady());
+        ASSERT_TRUE(future.WaitFor(std::chrono::milliseconds(0)));
+
+        int continued = 0;
+        future.Then([&continued](TestResult &&result) { continued = result.value; });
+        ASSERT_INT_EQUALS(-AWS_ERROR_INVALID_STATE, continued);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(RequestFutureSubmitFailure, s_RequestFutureSubmitFailure)
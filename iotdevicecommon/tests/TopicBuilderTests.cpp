@@ -0,0 +1,78 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotdevicecommon/TopicBuilder.h>
+
+#include <cstring>
+
+static int s_TopicBuilderSegments(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        Aws::Iotdevicecommon::TopicBuilder empty(allocator);
+        ASSERT_UINT_EQUALS(0, empty.Length());
+        ASSERT_STR_EQUALS("", empty.c_str());
+
+        Aws::Crt::String thingName("thing");
+        Aws::Iotdevicecommon::TopicBuilder builder(allocator);
+        builder.Append("$aws/things/", thingName, "/shadow/name/", aws_byte_cursor_from_c_str("named"), "", "/get");
+
+        const char *expected = "$aws/things/thing/shadow/name/named/get";
+        ASSERT_UINT_EQUALS(strlen(expected), builder.Length());
+        ASSERT_STR_EQUALS(expected, builder.c_str());
+
+        struct aws_byte_cursor cursor = builder.ToCursor();
+        ASSERT_BIN_ARRAYS_EQUALS(expected, strlen(expected), cursor.ptr, cursor.len);
+
+        ASSERT_TRUE(builder.ToString() == expected);
+        ASSERT_TRUE(builder.ToString("/accepted") == "$aws/things/thing/shadow/name/named/get/accepted");
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(TopicBuilderSegments, s_TopicBuilderSegments)
+
+static int s_TopicBuilderGrowth(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        /* Segments are appended across the boundary of the inline buffer and the contents survive the move */
+        Aws::Crt::String segment(100, 'a');
+        Aws::Iotdevicecommon::TopicBuilder builder(allocator);
+        for (size_t i = 0; i < 10; ++i)
+        {
+            builder.Append(segment).Append("/");
+        }
+
+        ASSERT_UINT_EQUALS(1010, builder.Length());
+        ASSERT_UINT_EQUALS(1010, strlen(builder.c_str()));
+        for (size_t i = 0; i < 10; ++i)
+        {
+            ASSERT_INT_EQUALS('a', builder.c_str()[i * 101]);
+            ASSERT_INT_EQUALS('/', builder.c_str()[i * 101 + 100]);
+        }
+
+        /* Exactly filling the inline buffer leaves room for the terminator */
+        Aws::Crt::String inlineSized(Aws::Iotdevicecommon::TopicBuilder::INLINE_CAPACITY - 1, 'b');
+        Aws::Iotdevicecommon::TopicBuilder full(allocator);
+        full.Append(inlineSized);
+        ASSERT_TRUE(full.ToString() == inlineSized);
+        full.Append("c");
+        ASSERT_UINT_EQUALS(Aws::Iotdevicecommon::TopicBuilder::INLINE_CAPACITY, full.Length());
+        ASSERT_INT_EQUALS('c', full.c_str()[full.Length() - 1]);
+        ASSERT_INT_EQUALS('\0', full.c_str()[full.Length()]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(TopicBuilderGrowth, s_TopicBuilderGrowth)
@@ -4,6 +4,10 @@ include(CMakeFindDependencyMacro)
 
 find_dependency(aws-crt-cpp)
 
+if (@IOTDEVICECOMMON_DEPENDENCY@)
+    find_dependency(IotDeviceCommon-cpp)
+endif()
+
 macro(aws_load_targets type)
     include(${CMAKE_CURRENT_LIST_DIR}/${type}/@PROJECT_NAME@-targets.cmake)
 endmacro()
@@ -0,0 +1,129 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotjobs/IotJobsClientV2.h>
+
+#include <aws/iotjobs/DescribeJobExecutionResponse.h>
+#include <aws/iotjobs/GetPendingJobExecutionsResponse.h>
+#include <aws/iotjobs/StartNextJobExecutionResponse.h>
+#include <aws/iotjobs/UpdateJobExecutionResponse.h>
+#include <aws/iotjobs/V2ErrorResponse.h>
+
+#include <aws/iotdevicecommon/RequestFuture.h>
+
+#include <memory>
+#include <utility>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        /**
+         * Future-based facade over the jobs service client.  Each request operation returns a future for its
+         * result instead of taking a handler.  When compiled as C++20, the futures can be awaited directly:
+         *
+         *     UpdateJobExecutionResult result = co_await asyncClient.UpdateJobExecution(request);
+         *
+         * Futures complete on the event loop thread that delivered the response; see
+         * Aws::Iotdevicecommon::RequestFuture for the threading rules.
+         */
+        class AsyncClientV2 final
+        {
+          public:
+            /**
+             * @param client service client to submit requests with
+             * @param allocator memory allocator for the state of each request
+             */
+            explicit AsyncClientV2(
+                std::shared_ptr<IClientV2> client,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator())
+                : m_client(std::move(client)), m_allocator(allocator)
+            {
+            }
+
+            /**
+             * Gets detailed information about a job execution.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<DescribeJobExecutionResult> DescribeJobExecution(
+                const DescribeJobExecutionRequest &request)
+            {
+                return Submit<DescribeJobExecutionResult>(
+                    [this, &request](const DescribeJobExecutionResultHandler &handler)
+                    { return m_client->DescribeJobExecution(request, handler); });
+            }
+
+            /**
+             * Gets the list of all jobs for a thing that are not in a terminal state.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<GetPendingJobExecutionsResult> GetPendingJobExecutions(
+                const GetPendingJobExecutionsRequest &request)
+            {
+                return Submit<GetPendingJobExecutionsResult>(
+                    [this, &request](const GetPendingJobExecutionsResultHandler &handler)
+                    { return m_client->GetPendingJobExecutions(request, handler); });
+            }
+
+            /**
+             * Gets and starts the next pending job execution for a thing (status IN_PROGRESS or QUEUED).
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<StartNextPendingJobExecutionResult> StartNextPendingJobExecution(
+                const StartNextPendingJobExecutionRequest &request)
+            {
+                return Submit<StartNextPendingJobExecutionResult>(
+                    [this, &request](const StartNextPendingJobExecutionResultHandler &handler)
+                    { return m_client->StartNextPendingJobExecution(request, handler); });
+            }
+
+            /**
+             * Updates the status of a job execution.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<UpdateJobExecutionResult> UpdateJobExecution(
+                const UpdateJobExecutionRequest &request)
+            {
+                return Submit<UpdateJobExecutionResult>(
+                    [this, &request](const UpdateJobExecutionResultHandler &handler)
+                    { return m_client->UpdateJobExecution(request, handler); });
+            }
+
+            /**
+             * @return the wrapped service client, e.g. for creating streaming operations
+             */
+            const std::shared_ptr<IClientV2> &GetClient() const { return m_client; }
+
+          private:
+            template <typename R, typename Submitter>
+            Aws::Iotdevicecommon::RequestFuture<R> Submit(Submitter &&submit)
+            {
+                return Aws::Iotdevicecommon::RequestFuture<R>::Start(
+                    m_allocator,
+                    std::forward<Submitter>(submit),
+                    [](int errorCode) { return R(ServiceErrorV2<V2ErrorResponse>(errorCode)); });
+            }
+
+            std::shared_ptr<IClientV2> m_client;
+            Aws::Crt::Allocator *m_allocator;
+        };
+
+    } // namespace Iotjobs
+} // namespace Aws
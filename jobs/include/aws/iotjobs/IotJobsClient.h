@@ -86,6 +86,14 @@ namespace Aws
             operator bool() const noexcept;
             int GetLastError() const noexcept;
 
+            /**
+             * Releases the handlers of every subscription made through this client object.  Subscriptions are shared
+             * by all clients on the same connection; a topic is unsubscribed once no client has a handler for it any
+             * more.  Subscribing to a topic again through the same client object replaces its handler, while copies
+             * of a client subscribe and release independently.
+             */
+            void ReleaseSubscriptions();
+
             /**
              * Subscribes to the accepted topic for the DescribeJobExecution operation
              *
@@ -13,6 +13,7 @@
 #include <aws/iot/MqttRequestResponseClient.h>
 
 #include <functional>
+#include <memory>
 
 namespace Aws
 {
@@ -27,6 +28,11 @@ namespace Aws
             class Mqtt5Client;
         }
     } // namespace Crt
+
+    namespace Iotdevicecommon
+    {
+        class ICorrelationTokenGenerator;
+    }
 } // namespace Aws
 
 namespace Aws
@@ -74,14 +80,21 @@ namespace Aws
         class NextJobExecutionChangedSubscriptionRequest;
         class StartNextJobExecutionResponse;
         class StartNextPendingJobExecutionRequest;
+        class StatusDetailsBuilder;
         class UpdateJobExecutionRequest;
         class UpdateJobExecutionResponse;
         class V2ErrorResponse;
 
+        template <typename T> struct RawJobDocumentMessage;
+
         using DescribeJobExecutionResult =
             Aws::Iot::RequestResponse::Result<DescribeJobExecutionResponse, ServiceErrorV2<V2ErrorResponse>>;
         using DescribeJobExecutionResultHandler = std::function<void(DescribeJobExecutionResult &&)>;
 
+        using DescribeJobExecutionRawResult = Aws::Iot::RequestResponse::
+            Result<RawJobDocumentMessage<DescribeJobExecutionResponse>, ServiceErrorV2<V2ErrorResponse>>;
+        using DescribeJobExecutionRawResultHandler = std::function<void(DescribeJobExecutionRawResult &&)>;
+
         using GetPendingJobExecutionsResult =
             Aws::Iot::RequestResponse::Result<GetPendingJobExecutionsResponse, ServiceErrorV2<V2ErrorResponse>>;
         using GetPendingJobExecutionsResultHandler = std::function<void(GetPendingJobExecutionsResult &&)>;
@@ -90,6 +103,11 @@ namespace Aws
             Aws::Iot::RequestResponse::Result<StartNextJobExecutionResponse, ServiceErrorV2<V2ErrorResponse>>;
         using StartNextPendingJobExecutionResultHandler = std::function<void(StartNextPendingJobExecutionResult &&)>;
 
+        using StartNextPendingJobExecutionRawResult = Aws::Iot::RequestResponse::
+            Result<RawJobDocumentMessage<StartNextJobExecutionResponse>, ServiceErrorV2<V2ErrorResponse>>;
+        using StartNextPendingJobExecutionRawResultHandler =
+            std::function<void(StartNextPendingJobExecutionRawResult &&)>;
+
         using UpdateJobExecutionResult =
             Aws::Iot::RequestResponse::Result<UpdateJobExecutionResponse, ServiceErrorV2<V2ErrorResponse>>;
         using UpdateJobExecutionResultHandler = std::function<void(UpdateJobExecutionResult &&)>;
@@ -205,6 +223,93 @@ namespace Aws
             virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateNextJobExecutionChangedStream(
                 const NextJobExecutionChangedSubscriptionRequest &request,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<NextJobExecutionChangedEvent> &options) = 0;
+
+            /*
+             * The operations below were added after IClientV2 was first released.  Their default implementations
+             * fail with AWS_ERROR_UNSUPPORTED_OPERATION so that existing implementations keep compiling.
+             */
+
+            /**
+             * Gets detailed information about a job execution, with the execution's job document cut out of the
+             * response and delivered unparsed.  See RawJobDocumentMessage.
+             *
+             * @param request operation to perform
+             * @param handler function object to invoke upon operation completion
+             *
+             * @return success/failure
+             */
+            virtual bool DescribeJobExecutionRaw(
+                const DescribeJobExecutionRequest &request,
+                const DescribeJobExecutionRawResultHandler &handler)
+            {
+                (void)request;
+                (void)handler;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return false;
+            }
+
+            /**
+             * Gets and starts the next pending job execution for a thing, with the execution's job document cut out
+             * of the response and delivered unparsed.  See RawJobDocumentMessage.
+             *
+             * @param request operation to perform
+             * @param handler function object to invoke upon operation completion
+             *
+             * @return success/failure
+             */
+            virtual bool StartNextPendingJobExecutionRaw(
+                const StartNextPendingJobExecutionRequest &request,
+                const StartNextPendingJobExecutionRawResultHandler &handler)
+            {
+                (void)request;
+                (void)handler;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return false;
+            }
+
+            /**
+             * Creates a stream of NextJobExecutionChanged notifications for a given IoT thing, with each execution's
+             * job document cut out of the event and delivered unparsed.  See RawJobDocumentMessage.
+             *
+             * @param request Modeled streaming operation subscription configuration.
+             * @param options Configuration options for the streaming operation.
+             *
+             * @return A streaming operation which will emit an event every time a message is received on the
+             * associated MQTT topic.
+             */
+            virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>
+                CreateNextJobExecutionChangedRawStream(
+                    const NextJobExecutionChangedSubscriptionRequest &request,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<
+                        RawJobDocumentMessage<NextJobExecutionChangedEvent>> &options)
+            {
+                (void)request;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
+
+            /**
+             * Updates the status of a job execution, taking its status details from a builder instead of the
+             * request's StatusDetails map, which must be unset.
+             *
+             * @param request operation to perform
+             * @param statusDetails status details of the update; only read during the call
+             * @param handler function object to invoke upon operation completion
+             *
+             * @return success/failure
+             */
+            virtual bool UpdateJobExecutionWithStatusDetails(
+                const UpdateJobExecutionRequest &request,
+                const StatusDetailsBuilder &statusDetails,
+                const UpdateJobExecutionResultHandler &handler)
+            {
+                (void)request;
+                (void)statusDetails;
+                (void)handler;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return false;
+            }
         };
 
         /**
@@ -221,6 +326,24 @@ namespace Aws
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
             Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
 
+        /**
+         * Creates a new service client that uses an SDK MQTT5 client for transport and a custom source of
+         * correlation tokens.
+         *
+         * @param protocolClient MQTT client to use as transport
+         * @param options request-response MQTT client configuration options
+         * @param correlationTokenGenerator generator for request correlation tokens.  If null, each request gets a
+         * freshly generated UUID.
+         * @param allocator memory allocator to use for all client functionality
+         *
+         * @return a new service client
+         */
+        AWS_IOTJOBS_API std::shared_ptr<IClientV2> NewClientFrom5(
+            const Aws::Crt::Mqtt5::Mqtt5Client &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
+            Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
         /**
          * Creates a new service client that uses an SDK MQTT311 client for transport.
          *
@@ -235,5 +358,39 @@ namespace Aws
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
             Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
 
+        /**
+         * Creates a new service client that uses an SDK MQTT311 client for transport and a custom source of
+         * correlation tokens.
+         *
+         * @param protocolClient MQTT client to use as transport
+         * @param options request-response MQTT client configuration options
+         * @param correlationTokenGenerator generator for request correlation tokens.  If null, each request gets a
+         * freshly generated UUID.
+         * @param allocator memory allocator to use for all client functionality
+         *
+         * @return a new service client
+         */
+        AWS_IOTJOBS_API std::shared_ptr<IClientV2> NewClientFrom311(
+            const Aws::Crt::Mqtt::MqttConnection &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
+            Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+        /**
+         * Creates a new service client on top of an existing request-response MQTT client, e.g. one shared with other
+         * service clients.
+         *
+         * @param bindingClient request-response MQTT client to use as transport
+         * @param correlationTokenGenerator generator for request correlation tokens.  If null, each request gets a
+         * freshly generated UUID.
+         * @param allocator memory allocator to use for all client functionality
+         *
+         * @return a new service client
+         */
+        AWS_IOTJOBS_API std::shared_ptr<IClientV2> NewClientFromRequestResponseClient(
+            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator = nullptr,
+            Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
     } // namespace Iotjobs
 } // namespace Aws
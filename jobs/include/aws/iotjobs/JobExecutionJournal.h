@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotjobs/Exports.h>
+#include <aws/iotjobs/JobStatus.h>
+
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <cstdio>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        /**
+         * State of a job execution as recorded in a JobExecutionJournal.
+         */
+        struct JournaledJobExecution
+        {
+            Aws::Crt::String JobId;
+
+            JobStatus Status = JobStatus::QUEUED;
+
+            Aws::Crt::Optional<int32_t> VersionNumber;
+
+            Aws::Crt::Optional<int64_t> ExecutionNumber;
+
+            Aws::Crt::Optional<Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String>> StatusDetails;
+        };
+
+        /**
+         * Append-only on-disk record of job execution state transitions, so that an agent restarting in the middle of
+         * a job knows where it was without asking the service.
+         *
+         * Every transition is appended to the file as one line of JSON and synced to disk, which makes the journal
+         * durable against process crashes and power loss.  Open() replays the file; an execution reaching a terminal
+         * status is forgotten, and an unterminated last line, left by a crash in the middle of an append, is dropped.
+         * The file is then atomically replaced by one holding the live executions only, and its directory synced, so
+         * it never grows beyond one line per transition since the last start.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTJOBS_API JobExecutionJournal final
+        {
+          public:
+            /**
+             * @param path path of the journal file; created if missing
+             * @param allocator memory allocator to use for journal state
+             */
+            JobExecutionJournal(
+                const Aws::Crt::String &path,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * Closes the journal file.
+             */
+            ~JobExecutionJournal();
+
+            JobExecutionJournal(const JobExecutionJournal &) = delete;
+            JobExecutionJournal &operator=(const JobExecutionJournal &) = delete;
+
+            /**
+             * Replays and compacts the journal file and opens it for appending.  A missing file is an empty
+             * journal; a file that exists but cannot be read fails the call and is left untouched.
+             *
+             * @return success/failure
+             */
+            bool Open();
+
+            /**
+             * Appends a state transition.  A terminal status removes the execution from the journal.  If the append
+             * fails, whatever part of it reached the file is cut off again.
+             *
+             * @param execution new state of the job execution
+             *
+             * @return success/failure
+             */
+            bool Record(const JournaledJobExecution &execution);
+
+            /**
+             * @return the state of every execution that has not reached a terminal status, ordered by job id
+             */
+            Aws::Crt::Vector<JournaledJobExecution> GetExecutions() const;
+
+            /**
+             * @param jobId id of the job
+             * @return the state of the job's execution, if it has not reached a terminal status
+             */
+            Aws::Crt::Optional<JournaledJobExecution> GetExecution(const Aws::Crt::String &jobId) const;
+
+          private:
+            bool Append(FILE *file, const JournaledJobExecution &execution);
+
+            bool Compact();
+
+            Aws::Crt::Allocator *m_allocator;
+            Aws::Crt::String m_path;
+
+            mutable std::mutex m_lock;
+            FILE *m_file;
+            Aws::Crt::Map<Aws::Crt::String, JournaledJobExecution> m_executions;
+        };
+
+    } // namespace Iotjobs
+} // namespace Aws
@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotjobs/Exports.h>
+
+#include <aws/crt/Types.h>
+
+#include <functional>
+#include <memory>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        class JobExecutorState;
+
+        /**
+         * What JobExecutor::Submit() does when the queue is full.
+         */
+        enum class JobExecutorOverflowPolicy
+        {
+            /**
+             * Fail the submission with AWS_ERROR_LIST_EXCEEDS_MAX_SIZE.  Suitable for submissions from CRT event
+             * loop threads, which must not block.
+             */
+            Reject,
+
+            /**
+             * Block the submitting thread until a task has been taken off the queue.  Propagates the backpressure to
+             * the producer, e.g. to the MQTT connection if tasks are submitted from its event loop thread.
+             */
+            Block,
+        };
+
+        /**
+         * Bounded thread pool that runs job handlers and stream handlers off the CRT event loop, so that a slow job
+         * does not stall the other MQTT traffic sharing the connection.
+         *
+         * Every task is submitted with a key.  Tasks with the same key, e.g. the same job id, run one at a time and in
+         * submission order; tasks with different keys run concurrently on up to the configured number of threads.
+         *
+         * The destructor runs all queued tasks before joining the worker threads.  If it runs on one of the worker
+         * threads, i.e. a task drops the last reference to the executor, queued tasks are dropped instead and that
+         * thread is detached.  All functions are thread-safe.
+         */
+        class AWS_IOTJOBS_API JobExecutor final
+        {
+          public:
+            /**
+             * @param threadCount number of worker threads; at least one is started
+             * @param maxQueuedTasks maximum number of tasks waiting to run, excluding running ones
+             * @param overflowPolicy behavior of Submit() when the queue is full
+             * @param allocator memory allocator to use for executor state
+             */
+            JobExecutor(
+                size_t threadCount,
+                size_t maxQueuedTasks,
+                JobExecutorOverflowPolicy overflowPolicy = JobExecutorOverflowPolicy::Reject,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            ~JobExecutor();
+
+            JobExecutor(const JobExecutor &) = delete;
+            JobExecutor &operator=(const JobExecutor &) = delete;
+
+            /**
+             * Queues a task.  Must not be called with the Block policy from one of the executor's own threads.
+             *
+             * @param key serialization key of the task
+             * @param task function object to run
+             *
+             * @return success/failure.  Fails if the queue is full under the Reject policy, or if the executor is
+             * shutting down.
+             */
+            bool Submit(const Aws::Crt::String &key, std::function<void()> task);
+
+            /**
+             * Wraps a streaming operation handler so that each event is handled on the executor.  Events of the
+             * stream are handled in arrival order; events rejected by a full queue are dropped.
+             *
+             * @param key serialization key for the events of the stream
+             * @param handler function object handling an event
+             *
+             * @return a handler suitable for StreamingOperationOptions::WithStreamHandler()
+             */
+            template <typename E>
+            std::function<void(E &&)> Bind(const Aws::Crt::String &key, std::function<void(E &&)> handler)
+            {
+                std::weak_ptr<JobExecutorState> weakState = m_state;
+                Aws::Crt::Allocator *allocator = m_allocator;
+                return [weakState, allocator, key, handler](E &&event)
+                {
+                    auto shared = Aws::Crt::MakeShared<E>(allocator, std::move(event));
+                    JobExecutor::Submit(weakState, key, [handler, shared]() { handler(std::move(*shared)); });
+                };
+            }
+
+            /**
+             * @return the number of tasks waiting to run
+             */
+            size_t GetQueuedTaskCount() const;
+
+          private:
+            static bool Submit(
+                const std::weak_ptr<JobExecutorState> &weakState,
+                const Aws::Crt::String &key,
+                std::function<void()> task);
+
+            Aws::Crt::Allocator *m_allocator;
+            std::shared_ptr<JobExecutorState> m_state;
+        };
+
+    } // namespace Iotjobs
+} // namespace Aws
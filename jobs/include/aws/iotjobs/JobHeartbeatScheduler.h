@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotjobs/Exports.h>
+#include <aws/iotjobs/IotJobsClientV2.h>
+
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <chrono>
+#include <memory>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Io
+        {
+            class EventLoopGroup;
+        }
+    } // namespace Crt
+
+    namespace Iotjobs
+    {
+
+        class JobHeartbeatSchedulerState;
+
+        /**
+         * Configuration options for a JobHeartbeatScheduler.
+         */
+        class AWS_IOTJOBS_API JobHeartbeatSchedulerOptions final
+        {
+          public:
+            JobHeartbeatSchedulerOptions() = default;
+
+            /**
+             * Sets the step timeout sent with every heartbeat.  A job execution that receives no update within its
+             * step timeout is timed out by the service.
+             *
+             * @param stepTimeout step timeout; at least one minute
+             * @return reference to this options object
+             */
+            JobHeartbeatSchedulerOptions &WithStepTimeout(std::chrono::minutes stepTimeout);
+
+            /**
+             * Sets how often each tracked execution is sent a heartbeat.  Defaults to half the step timeout.
+             *
+             * @param interval heartbeat interval; must be shorter than the step timeout
+             * @return reference to this options object
+             */
+            JobHeartbeatSchedulerOptions &WithHeartbeatInterval(std::chrono::milliseconds interval);
+
+            /**
+             * Sets the resolution of the timer wheel.  Heartbeats of executions tracked within the same tick are sent
+             * together.  Defaults to one second.
+             *
+             * @param tickInterval time between two turns of the wheel
+             * @return reference to this options object
+             */
+            JobHeartbeatSchedulerOptions &WithTickInterval(std::chrono::milliseconds tickInterval);
+
+            /**
+             * Sets the event loop group whose next event loop runs the timer wheel.  The group must outlive the
+             * scheduler.
+             *
+             * @param eventLoopGroup event loop group to schedule the wheel on
+             * @return reference to this options object
+             */
+            JobHeartbeatSchedulerOptions &WithEventLoopGroup(Aws::Crt::Io::EventLoopGroup &eventLoopGroup);
+
+            std::chrono::minutes GetStepTimeout() const { return m_stepTimeout; }
+
+            std::chrono::milliseconds GetHeartbeatInterval() const;
+
+            std::chrono::milliseconds GetTickInterval() const { return m_tickInterval; }
+
+            Aws::Crt::Io::EventLoopGroup *GetEventLoopGroup() const { return m_eventLoopGroup; }
+
+          private:
+            std::chrono::minutes m_stepTimeout{0};
+            std::chrono::milliseconds m_heartbeatInterval{0};
+            std::chrono::milliseconds m_tickInterval{1000};
+            Aws::Crt::Io::EventLoopGroup *m_eventLoopGroup = nullptr;
+        };
+
+        /**
+         * Keeps long-running job executions alive by periodically updating them to IN_PROGRESS with a fresh step
+         * timeout.
+         *
+         * Tracked executions are spread over the slots of a single timer wheel, which turns on one CRT event loop;
+         * every tick sends the heartbeats of the executions in the current slot.  Hundreds of executions therefore
+         * cost one scheduled task rather than a timer or thread each.
+         *
+         * If an execution's version number is tracked, heartbeats carry it as the expected version and the version is
+         * refreshed from each response.  Executions the service reports as finished or unknown are untracked
+         * automatically.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTJOBS_API JobHeartbeatScheduler final
+        {
+          public:
+            /**
+             * @param client service client used to send heartbeats
+             * @param thingName name of the thing owning the tracked executions
+             * @param options heartbeat configuration
+             * @param allocator memory allocator to use for scheduler state
+             */
+            JobHeartbeatScheduler(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                const JobHeartbeatSchedulerOptions &options,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * Stops sending heartbeats.  Heartbeats in flight complete normally.
+             */
+            ~JobHeartbeatScheduler();
+
+            JobHeartbeatScheduler(const JobHeartbeatScheduler &) = delete;
+            JobHeartbeatScheduler &operator=(const JobHeartbeatScheduler &) = delete;
+
+            /**
+             * Starts sending heartbeats for a job execution, the first one a heartbeat interval from now.  Tracking
+             * an execution that is already tracked updates its execution and version numbers.
+             *
+             * @param jobId id of the job
+             * @param executionNumber execution number of the job execution, if known
+             * @param versionNumber current version of the job execution, if known
+             *
+             * @return success/failure
+             */
+            bool Track(
+                const Aws::Crt::String &jobId,
+                const Aws::Crt::Optional<int64_t> &executionNumber = {},
+                const Aws::Crt::Optional<int32_t> &versionNumber = {});
+
+            /**
+             * Stops sending heartbeats for a job execution.  Must be called before the execution's final update so
+             * that no heartbeat is sent after it.
+             *
+             * @param jobId id of the job
+             */
+            void Untrack(const Aws::Crt::String &jobId);
+
+            /**
+             * @return the number of tracked job executions
+             */
+            size_t GetTrackedCount() const;
+
+            /**
+             * @return the step timeout sent with heartbeats, in minutes
+             */
+            int64_t GetStepTimeoutInMinutes() const;
+
+            /**
+             * @return true if the scheduler was configured successfully, false otherwise
+             */
+            explicit operator bool() const noexcept;
+
+          private:
+            std::shared_ptr<JobHeartbeatSchedulerState> m_state;
+        };
+
+    } // namespace Iotjobs
+} // namespace Aws
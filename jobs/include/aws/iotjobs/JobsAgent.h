@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotjobs/Exports.h>
+#include <aws/iotjobs/IotJobsClientV2.h>
+#include <aws/iotjobs/JobStatus.h>
+
+#include <aws/crt/Types.h>
+
+#include <functional>
+#include <memory>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        class JobExecutionData;
+        class JobExecutor;
+        class JobExecutionJournal;
+        class JobHeartbeatScheduler;
+        class JobsAgentState;
+
+        /**
+         * Reports the final status of a job execution to the agent.  Must be invoked once per job, from any thread,
+         * with a terminal status (SUCCEEDED, FAILED or REJECTED); further invocations are ignored.
+         */
+        using JobCompletionCallback = std::function<
+            void(JobStatus status, const Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> &statusDetails)>;
+
+        /**
+         * Executes a job.  Without an executor, the handler is invoked on the thread that delivered the job execution,
+         * usually a CRT event loop thread, so long-running work should be moved elsewhere and completed
+         * asynchronously.  The agent starts no other job until the completion callback has been invoked.
+         */
+        using JobHandler =
+            std::function<void(const JobExecutionData &execution, const JobCompletionCallback &complete)>;
+
+        /**
+         * Receives the error code of a failed jobs service request made by the agent.
+         */
+        using JobsAgentErrorHandler = std::function<void(int errorCode)>;
+
+        /**
+         * Runs the pending jobs of a thing one after another, dispatching each job document to a handler chosen by
+         * the document's operation field.
+         *
+         * The agent is event driven: it starts the next pending job when started, whenever the service announces a
+         * new next job on the next-job-execution-changed stream, and whenever a job completes.  It does not poll.
+         * The final UpdateJobExecution of a job and the StartNextPendingJobExecution for the following job are sent
+         * back to back without waiting for the update's response, so draining a queue of jobs costs roughly one
+         * round trip per job instead of two.  If the service answers the start request with the job whose update is
+         * still in flight, the agent starts the next job again once that update completes.
+         *
+         * Jobs whose operation has no registered handler go to the default handler, or are rejected if there is
+         * none.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTJOBS_API JobsAgent final
+        {
+          public:
+            /**
+             * @param client service client used for all jobs operations
+             * @param thingName name of the thing whose jobs are run
+             * @param operationKey name of the job document field that selects the handler
+             * @param allocator memory allocator to use for agent state
+             */
+            JobsAgent(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::String &operationKey = "operation",
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * Stops the agent.  Jobs that are still running can still be completed and are reported to the service.
+             */
+            ~JobsAgent();
+
+            JobsAgent(const JobsAgent &) = delete;
+            JobsAgent &operator=(const JobsAgent &) = delete;
+
+            /**
+             * Registers the handler for jobs with the given operation, replacing any previous one.
+             *
+             * @param operation value of the job document's operation field
+             * @param handler function object executing the job
+             */
+            void RegisterHandler(const Aws::Crt::String &operation, const JobHandler &handler);
+
+            /**
+             * Sets the handler for jobs without a registered operation.
+             *
+             * @param handler function object executing the job
+             */
+            void SetDefaultHandler(const JobHandler &handler);
+
+            /**
+             * Sets the function object invoked when a service request made by the agent fails.
+             *
+             * @param handler function object receiving the error code
+             */
+            void SetErrorHandler(const JobsAgentErrorHandler &handler);
+
+            /**
+             * Runs job handlers on an executor instead of the thread delivering the job, keyed by job id.  A job
+             * rejected by a full executor queue is reported as FAILED.
+             *
+             * @param executor executor to run handlers on; handlers run inline if null
+             */
+            void SetExecutor(std::shared_ptr<JobExecutor> executor);
+
+            /**
+             * Keeps running jobs alive with heartbeats.  Jobs are started with the scheduler's step timeout, tracked
+             * while their handler runs and untracked before their final update.
+             *
+             * @param heartbeatScheduler scheduler to track running jobs with; no heartbeats are sent if null
+             */
+            void SetHeartbeatScheduler(std::shared_ptr<JobHeartbeatScheduler> heartbeatScheduler);
+
+            /**
+             * Records job state transitions in a journal: a job is recorded as IN_PROGRESS when its handler starts and
+             * with its final status once the service has accepted it.  After a restart, the journal's remaining
+             * executions are the jobs that were interrupted.
+             *
+             * @param journal opened journal to record jobs in; nothing is recorded if null
+             */
+            void SetJournal(std::shared_ptr<JobExecutionJournal> journal);
+
+            /**
+             * Opens the next-job-execution-changed stream and starts the next pending job, if any.
+             *
+             * @return success/failure
+             */
+            bool Start();
+
+            /**
+             * Closes the stream and stops starting new jobs.
+             */
+            void Stop();
+
+          private:
+            std::shared_ptr<JobsAgentState> m_state;
+        };
+
+    } // namespace Iotjobs
+} // namespace Aws
@@ -0,0 +1,153 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotjobs/Exports.h>
+#include <aws/iotjobs/IotJobsClientV2.h>
+#include <aws/iotjobs/JobExecutionSummary.h>
+#include <aws/iotjobs/JobStatus.h>
+
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <functional>
+#include <memory>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        class JobsStateIndexState;
+
+        /**
+         * Kind of change to a pending job execution.
+         */
+        enum class JobsStateChangeType
+        {
+            /**
+             * The execution became pending.
+             */
+            Added,
+
+            /**
+             * The status, version or execution number of a pending execution changed.
+             */
+            Changed,
+
+            /**
+             * The execution is no longer pending, usually because it reached a terminal status.
+             */
+            Removed,
+        };
+
+        /**
+         * A change to a single pending job execution.
+         */
+        struct JobsStateChange
+        {
+            JobsStateChangeType Type;
+
+            /**
+             * Status of the execution; for removed executions, the last status seen.
+             */
+            JobStatus Status;
+
+            /**
+             * Summary of the execution; for removed executions, the last summary seen.
+             */
+            JobExecutionSummary Execution;
+        };
+
+        /**
+         * Receives the changes caused by one snapshot.  Invoked only if there are changes.
+         */
+        using JobsStateChangeHandler = std::function<void(const Aws::Crt::Vector<JobsStateChange> &changes)>;
+
+        /**
+         * Incrementally maintained view of a thing's pending job executions.
+         *
+         * Every JobExecutionsChanged event and GetPendingJobExecutions response is a full snapshot of the pending
+         * executions.  The index keeps the last snapshot in a hash table keyed by job id, compares each incoming
+         * execution against its entry by status, version number and execution number, and reports only the executions
+         * that were added, changed or removed.  Snapshots older than the last one applied are ignored.
+         *
+         * All functions are thread-safe.  Change handlers are invoked in snapshot order and must not apply snapshots
+         * themselves.
+         */
+        class AWS_IOTJOBS_API JobsStateIndex final
+        {
+          public:
+            /**
+             * @param client service client used by Start(); may be null if snapshots are only applied by the caller
+             * @param thingName name of the thing whose job executions are indexed
+             * @param allocator memory allocator to use for index state
+             */
+            JobsStateIndex(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            ~JobsStateIndex();
+
+            JobsStateIndex(const JobsStateIndex &) = delete;
+            JobsStateIndex &operator=(const JobsStateIndex &) = delete;
+
+            /**
+             * Opens the job-executions-changed stream and fetches the current pending executions.  Starting an index
+             * that is already started does nothing.
+             *
+             * @return success/failure
+             */
+            bool Start();
+
+            /**
+             * Applies a snapshot received on the job-executions-changed stream.
+             *
+             * @param event stream event
+             */
+            void Apply(const JobExecutionsChangedEvent &event);
+
+            /**
+             * Applies the snapshot from a GetPendingJobExecutions response.
+             *
+             * @param response service response
+             */
+            void Apply(const GetPendingJobExecutionsResponse &response);
+
+            /**
+             * Registers a change handler.
+             *
+             * @param handler function object to invoke with the changes of each snapshot
+             *
+             * @return id for Unsubscribe()
+             */
+            uint64_t Subscribe(const JobsStateChangeHandler &handler);
+
+            /**
+             * Removes a change handler.
+             *
+             * @param subscriptionId id returned by Subscribe()
+             */
+            void Unsubscribe(uint64_t subscriptionId);
+
+            /**
+             * @param jobId id of the job
+             * @return the status of the pending execution of the job, if any
+             */
+            Aws::Crt::Optional<JobStatus> GetStatus(const Aws::Crt::String &jobId) const;
+
+            /**
+             * @return the number of pending executions
+             */
+            size_t GetJobCount() const;
+
+          private:
+            std::shared_ptr<JobsStateIndexState> m_state;
+        };
+
+    } // namespace Iotjobs
+} // namespace Aws
@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotjobs/Exports.h>
+
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <memory>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Iotdevicecommon
+    {
+        class IJsonStreamHandler;
+    }
+
+    namespace Iotjobs
+    {
+
+        /**
+         * A job document kept as the JSON text it was received as.
+         *
+         * The document is only parsed on demand: either fully, into a cached JSON object, or token by token through a
+         * streaming parser that never holds more than one string or number in memory.  Large documents can be moved
+         * out of memory into a file, after which both forms of access read the file.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTJOBS_API RawJobDocument final
+        {
+          public:
+            /**
+             * @param json JSON text of the document; copied
+             * @param allocator memory allocator to use for the document
+             */
+            RawJobDocument(struct aws_byte_cursor json, Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            ~RawJobDocument();
+
+            RawJobDocument(const RawJobDocument &) = delete;
+            RawJobDocument &operator=(const RawJobDocument &) = delete;
+
+            /**
+             * Splits the execution's job document out of a job execution payload.
+             *
+             * @param payload JSON payload whose "execution" member may contain a "jobDocument" member
+             * @param remainder set to the payload with the job document replaced by null
+             * @param allocator memory allocator to use for the document
+             *
+             * @return the job document, or null if the payload has none
+             */
+            static std::shared_ptr<RawJobDocument> ExtractFromExecution(
+                struct aws_byte_cursor payload,
+                Aws::Crt::String &remainder,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * @return the size of the document's JSON text in bytes
+             */
+            size_t GetSize() const;
+
+            /**
+             * @return the document's JSON text; empty once the document has been spilled to a file
+             */
+            struct aws_byte_cursor GetBytes() const;
+
+            /**
+             * Parses the document on first use and returns a view of the result.  The view remains valid until the
+             * document is spilled or destroyed.
+             *
+             * @return view of the parsed document; not an object if the document could not be read or parsed
+             */
+            Aws::Crt::JsonView View() const;
+
+            /**
+             * Parses the document token by token, without building a JSON object.  The handler must not call back
+             * into this document.
+             *
+             * @param handler receives the tokens of the document
+             * @param chunkSize number of bytes read from the file at a time, if the document was spilled
+             *
+             * @return true if the whole document was parsed, false if it is malformed, could not be read or the handler
+             * aborted
+             */
+            bool Stream(Aws::Iotdevicecommon::IJsonStreamHandler &handler, size_t chunkSize = 4096) const;
+
+            /**
+             * Writes the document to a file and releases its memory, including any cached JSON object.  The file
+             * must not be modified or removed while the document is in use.
+             *
+             * @param path path of the file to create or overwrite
+             *
+             * @return success/failure
+             */
+            bool SpillToFile(const Aws::Crt::String &path);
+
+            /**
+             * @return true if the document has been spilled to a file
+             */
+            bool IsSpilled() const;
+
+          private:
+            Aws::Crt::Allocator *m_allocator;
+
+            mutable std::mutex m_lock;
+            struct aws_byte_buf m_bytes;
+            size_t m_size;
+            Aws::Crt::String m_path;
+            mutable Aws::Crt::Optional<Aws::Crt::JsonObject> m_json;
+        };
+
+        /**
+         * A job execution message whose job document was split off before parsing.  The execution in Message has no
+         * JobDocument; the document travels unparsed in Document instead.
+         *
+         * @tparam T DescribeJobExecutionResponse, StartNextJobExecutionResponse or NextJobExecutionChangedEvent
+         */
+        template <typename T> struct RawJobDocumentMessage
+        {
+            /**
+             * The message, parsed without its execution's job document.
+             */
+            T Message;
+
+            /**
+             * The execution's job document, or null if the message carries none.
+             */
+            std::shared_ptr<RawJobDocument> Document;
+        };
+
+    } // namespace Iotjobs
+} // namespace Aws
@@ -0,0 +1,173 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotjobs/Exports.h>
+
+#include <aws/crt/StlAllocator.h>
+#include <aws/crt/Types.h>
+
+#include <mutex>
+#include <set>
+
+namespace Aws
+{
+    namespace Iotdevicecommon
+    {
+        class JsonWriter;
+    }
+
+    namespace Iotjobs
+    {
+
+        /**
+         * A status details key interned by a StatusDetailsKeyTable.  Keys interned by the same table are equal if and
+         * only if they are the same object, so they compare in constant time.
+         */
+        class AWS_IOTJOBS_API StatusDetailKey final
+        {
+          public:
+            StatusDetailKey() = default;
+
+            /**
+             * @return the key's name; empty for a default-constructed key
+             */
+            const Aws::Crt::String &GetName() const;
+
+            bool operator==(const StatusDetailKey &other) const { return m_name == other.m_name; }
+
+            bool operator!=(const StatusDetailKey &other) const { return m_name != other.m_name; }
+
+          private:
+            friend class StatusDetailsKeyTable;
+            friend class StatusDetailsBuilder;
+
+            explicit StatusDetailKey(const Aws::Crt::String *name) : m_name(name) {}
+
+            const Aws::Crt::String *m_name = nullptr;
+        };
+
+        /**
+         * Interns status details keys.  Keys stay valid for the lifetime of the table, which is typically created once
+         * per agent.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTJOBS_API StatusDetailsKeyTable final
+        {
+          public:
+            /**
+             * @param allocator memory allocator to use for the interned keys
+             */
+            explicit StatusDetailsKeyTable(Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            StatusDetailsKeyTable(const StatusDetailsKeyTable &) = delete;
+            StatusDetailsKeyTable &operator=(const StatusDetailsKeyTable &) = delete;
+
+            /**
+             * @param name name of the key
+             * @return the interned key; the same key for every call with the same name
+             */
+            StatusDetailKey Intern(const Aws::Crt::String &name);
+
+          private:
+            using KeySet =
+                std::set<Aws::Crt::String, std::less<Aws::Crt::String>, Aws::Crt::StlAllocator<Aws::Crt::String>>;
+
+            std::mutex m_lock;
+            KeySet m_keys;
+        };
+
+        /**
+         * Flat, reusable set of status details for IClientV2::UpdateJobExecutionWithStatusDetails().
+         *
+         * Entries are kept in insertion order in a vector of (key, value range) pairs and all values share one byte
+         * buffer, so an update with dozens of details costs no per-entry allocations.  A value that outgrows its
+         * range is appended anew, and the buffer is compacted once such abandoned ranges outweigh the live values.
+         * Clear() keeps both buffers for the next update.
+         *
+         * Not thread-safe.
+         */
+        class AWS_IOTJOBS_API StatusDetailsBuilder final
+        {
+          public:
+            /**
+             * @param allocator memory allocator to use for entries and values
+             */
+            explicit StatusDetailsBuilder(Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            StatusDetailsBuilder(const StatusDetailsBuilder &other);
+            StatusDetailsBuilder(StatusDetailsBuilder &&other) noexcept;
+
+            ~StatusDetailsBuilder();
+
+            StatusDetailsBuilder &operator=(const StatusDetailsBuilder &other);
+            StatusDetailsBuilder &operator=(StatusDetailsBuilder &&other) noexcept;
+
+            /**
+             * Sets the value of a key, replacing any previous value.
+             *
+             * @param key interned key
+             * @param value value of the key
+             * @return reference to this builder
+             */
+            StatusDetailsBuilder &Set(const StatusDetailKey &key, struct aws_byte_cursor value);
+
+            StatusDetailsBuilder &Set(const StatusDetailKey &key, const Aws::Crt::String &value);
+
+            StatusDetailsBuilder &Set(const StatusDetailKey &key, const char *value);
+
+            /**
+             * Sets the value of a key to the decimal representation of a number, e.g. a progress counter.
+             */
+            StatusDetailsBuilder &SetInt64(const StatusDetailKey &key, int64_t value);
+
+            /**
+             * Removes all entries, keeping the memory for reuse.
+             */
+            void Clear();
+
+            /**
+             * @return the number of entries
+             */
+            size_t GetSize() const { return m_entries.size(); }
+
+            /**
+             * Writes the entries as members of the writer's current object.
+             *
+             * @param writer JSON writer
+             */
+            void SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const;
+
+            /**
+             * @return the entries as a map, e.g. for UpdateJobExecutionRequest::StatusDetails
+             */
+            Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> ToMap() const;
+
+          private:
+            struct Entry
+            {
+                const Aws::Crt::String *key;
+                size_t offset;
+                size_t length;
+            };
+
+            struct aws_byte_cursor GetValue(const Entry &entry) const;
+
+            void CopyFrom(const StatusDetailsBuilder &other);
+
+            void Compact();
+
+            Aws::Crt::Allocator *m_allocator;
+            Aws::Crt::Vector<Entry> m_entries;
+            struct aws_byte_buf m_values;
+
+            /* Bytes of m_values referenced by entries; the rest were abandoned by values that grew */
+            size_t m_liveLength;
+        };
+
+    } // namespace Iotjobs
+} // namespace Aws
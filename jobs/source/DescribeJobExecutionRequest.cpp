@@ -5,6 +5,8 @@
  */
 #include <aws/iotjobs/DescribeJobExecutionRequest.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotjobs
@@ -53,6 +55,26 @@ namespace Aws
             }
         }
 
+        void DescribeJobExecutionRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (ClientToken)
+            {
+                writer.WithString("clientToken", *ClientToken);
+            }
+
+            if (ExecutionNumber)
+            {
+                writer.WithInt64("executionNumber", *ExecutionNumber);
+            }
+
+            if (IncludeJobDocument)
+            {
+                writer.WithBool("includeJobDocument", *IncludeJobDocument);
+            }
+        }
+
         DescribeJobExecutionRequest::DescribeJobExecutionRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
@@ -5,6 +5,8 @@
  */
 #include <aws/iotjobs/GetPendingJobExecutionsRequest.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotjobs
@@ -33,6 +35,16 @@ namespace Aws
             }
         }
 
+        void GetPendingJobExecutionsRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (ClientToken)
+            {
+                writer.WithString("clientToken", *ClientToken);
+            }
+        }
+
         GetPendingJobExecutionsRequest::GetPendingJobExecutionsRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
@@ -5,6 +5,9 @@
  */
 #include <aws/iotjobs/IotJobsClient.h>
 
+#include <aws/iotdevicecommon/MqttSubscriptionRegistry.h>
+#include <aws/iotdevicecommon/TopicBuilder.h>
+
 #include <aws/iotjobs/DescribeJobExecutionRequest.h>
 #include <aws/iotjobs/DescribeJobExecutionResponse.h>
 #include <aws/iotjobs/DescribeJobExecutionSubscriptionRequest.h>
@@ -48,6 +51,11 @@ namespace Aws
             return aws_last_error();
         }
 
+        void IotJobsClient::ReleaseSubscriptions()
+        {
+            Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection)->ReleaseOwner(this);
+        }
+
         bool IotJobsClient::SubscribeToDescribeJobExecutionAccepted(
             const Aws::Iotjobs::DescribeJobExecutionSubscriptionRequest &request,
             Aws::Crt::Mqtt::QOS qos,
@@ -74,20 +82,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::DescribeJobExecutionResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::DescribeJobExecutionResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId << "/get/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/get/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -119,20 +136,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::RejectedError response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::RejectedError>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId << "/get/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/get/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -164,20 +190,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::GetPendingJobExecutionsResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::GetPendingJobExecutionsResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/get/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/get/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -209,20 +244,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::RejectedError response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::RejectedError>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/get/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/get/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -254,20 +298,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::JobExecutionsChangedEvent response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::JobExecutionsChangedEvent>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/notify";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/notify");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -299,20 +352,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::NextJobExecutionChangedEvent response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::NextJobExecutionChangedEvent>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/notify-next";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/notify-next");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -344,20 +406,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::StartNextJobExecutionResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::StartNextJobExecutionResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/start-next/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/start-next/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -389,20 +460,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::RejectedError response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::RejectedError>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/start-next/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/start-next/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -434,21 +514,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::UpdateJobExecutionResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::UpdateJobExecutionResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId
-                               << "/update/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/update/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -480,21 +568,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotjobs::RejectedError response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotjobs::RejectedError>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId
-                               << "/update/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/update/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -505,8 +601,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId << "/get";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/get");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -521,7 +617,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotJobsClient::PublishGetPendingJobExecutions(
@@ -529,8 +625,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/get";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/jobs/get");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -545,7 +641,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotJobsClient::PublishStartNextPendingJobExecution(
@@ -553,8 +649,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/start-next";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/jobs/start-next");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -569,7 +665,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotJobsClient::PublishUpdateJobExecution(
@@ -577,8 +673,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId << "/update";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/update");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -593,7 +689,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
     } // namespace Iotjobs
@@ -5,7 +5,9 @@
  */
 #include <aws/iotjobs/IotJobsClientV2.h>
 
-#include <aws/crt/UUID.h>
+#include <aws/iotdevicecommon/CorrelationTokenGenerator.h>
+#include <aws/iotdevicecommon/JsonWriter.h>
+#include <aws/iotdevicecommon/TopicBuilder.h>
 
 #include <aws/iotjobs/DescribeJobExecutionRequest.h>
 #include <aws/iotjobs/DescribeJobExecutionResponse.h>
@@ -15,12 +17,16 @@
 #include <aws/iotjobs/JobExecutionsChangedSubscriptionRequest.h>
 #include <aws/iotjobs/NextJobExecutionChangedEvent.h>
 #include <aws/iotjobs/NextJobExecutionChangedSubscriptionRequest.h>
+#include <aws/iotjobs/RawJobDocument.h>
 #include <aws/iotjobs/StartNextJobExecutionResponse.h>
 #include <aws/iotjobs/StartNextPendingJobExecutionRequest.h>
+#include <aws/iotjobs/StatusDetailsBuilder.h>
 #include <aws/iotjobs/UpdateJobExecutionRequest.h>
 #include <aws/iotjobs/UpdateJobExecutionResponse.h>
 #include <aws/iotjobs/V2ErrorResponse.h>
 
+#include <type_traits>
+
 namespace Aws
 {
     namespace Iotjobs
@@ -31,7 +37,8 @@ namespace Aws
           public:
             ClientV2(
                 Aws::Crt::Allocator *allocator,
-                std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient);
+                std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+                std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator);
             virtual ~ClientV2() = default;
 
             bool DescribeJobExecution(
@@ -60,17 +67,62 @@ namespace Aws
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<NextJobExecutionChangedEvent> &options)
                 override;
 
+            bool DescribeJobExecutionRaw(
+                const DescribeJobExecutionRequest &request,
+                const DescribeJobExecutionRawResultHandler &handler) override;
+
+            bool StartNextPendingJobExecutionRaw(
+                const StartNextPendingJobExecutionRequest &request,
+                const StartNextPendingJobExecutionRawResultHandler &handler) override;
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateNextJobExecutionChangedRawStream(
+                const NextJobExecutionChangedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<
+                    RawJobDocumentMessage<NextJobExecutionChangedEvent>> &options) override;
+
+            bool UpdateJobExecutionWithStatusDetails(
+                const UpdateJobExecutionRequest &request,
+                const StatusDetailsBuilder &statusDetails,
+                const UpdateJobExecutionResultHandler &handler) override;
+
           private:
+            template <typename M>
+            bool SubmitDescribeJobExecution(
+                const DescribeJobExecutionRequest &request,
+                const std::function<void(Aws::Iot::RequestResponse::Result<M, ServiceErrorV2<V2ErrorResponse>> &&)>
+                    &handler);
+
+            template <typename M>
+            bool SubmitStartNextPendingJobExecution(
+                const StartNextPendingJobExecutionRequest &request,
+                const std::function<void(Aws::Iot::RequestResponse::Result<M, ServiceErrorV2<V2ErrorResponse>> &&)>
+                    &handler);
+
+            bool SubmitUpdateJobExecution(
+                const UpdateJobExecutionRequest &request,
+                const StatusDetailsBuilder *statusDetails,
+                const UpdateJobExecutionResultHandler &handler);
+
             Aws::Crt::Allocator *m_allocator;
 
             std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> m_bindingClient;
+
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> m_correlationTokenGenerator;
         };
 
         ClientV2::ClientV2(
             Aws::Crt::Allocator *allocator,
-            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient)
-            : m_allocator(allocator), m_bindingClient(std::move(bindingClient))
+            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator)
+            : m_allocator(allocator), m_bindingClient(std::move(bindingClient)),
+              m_correlationTokenGenerator(std::move(correlationTokenGenerator))
         {
+            if (!m_correlationTokenGenerator)
+            {
+                m_correlationTokenGenerator =
+                    Aws::Crt::MakeShared<Aws::Iotdevicecommon::UuidCorrelationTokenGenerator>(allocator);
+            }
+
             // It's simpler to do this than branch the codegen based on the presence of streaming operations
             (void)m_allocator;
         }
@@ -91,14 +143,67 @@ namespace Aws
             handler(std::move(finalResult));
         }
 
+        template <typename M> struct IsRawJobDocumentMessage : std::false_type
+        {
+        };
+
+        template <typename T> struct IsRawJobDocumentMessage<RawJobDocumentMessage<T>> : std::true_type
+        {
+        };
+
+        /*
+         * Parses a payload carrying a job execution.  With raw job documents, the execution's job document is cut out
+         * of the payload before parsing and returned separately, so it is neither parsed nor copied into the model.
+         */
+        static Aws::Crt::JsonObject s_parseExecutionPayload(
+            struct aws_byte_cursor payload,
+            bool rawJobDocuments,
+            Aws::Crt::Allocator *allocator,
+            std::shared_ptr<RawJobDocument> &rawDocument)
+        {
+            Aws::Crt::String objectStr;
+            if (rawJobDocuments)
+            {
+                rawDocument = RawJobDocument::ExtractFromExecution(payload, objectStr, allocator);
+            }
+            if (!rawDocument)
+            {
+                objectStr.assign(reinterpret_cast<char *>(payload.ptr), payload.len);
+            }
+
+            return Aws::Crt::JsonObject(objectStr);
+        }
+
+        template <typename T>
+        static void s_initExecutionMessage(
+            T &message,
+            const Aws::Crt::JsonObject &jsonObject,
+            std::shared_ptr<RawJobDocument> && /*rawDocument*/)
+        {
+            message = T(jsonObject);
+        }
+
+        template <typename T>
+        static void s_initExecutionMessage(
+            RawJobDocumentMessage<T> &message,
+            const Aws::Crt::JsonObject &jsonObject,
+            std::shared_ptr<RawJobDocument> &&rawDocument)
+        {
+            message.Message = T(jsonObject);
+            message.Document = std::move(rawDocument);
+        }
+
+        template <typename M>
         static void s_DescribeJobExecutionResponseHandler(
             Aws::Iot::RequestResponse::UnmodeledResult &&result,
-            const DescribeJobExecutionResultHandler &handler,
+            const std::function<void(Aws::Iot::RequestResponse::Result<M, ServiceErrorV2<V2ErrorResponse>> &&)>
+                &handler,
             const Aws::Crt::String &successPathTopic,
-            const Aws::Crt::String &failurePathTopic)
+            const Aws::Crt::String &failurePathTopic,
+            Aws::Crt::Allocator *allocator)
         {
             using E = V2ErrorResponse;
-            using R = Aws::Iot::RequestResponse::Result<DescribeJobExecutionResponse, ServiceErrorV2<E>>;
+            using R = Aws::Iot::RequestResponse::Result<M, ServiceErrorV2<E>>;
 
             if (!result.IsSuccess())
             {
@@ -106,59 +211,72 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
-            const auto &payload = response.GetPayload();
-            Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
-            Aws::Crt::JsonObject jsonObject(objectStr);
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
+            std::shared_ptr<RawJobDocument> rawDocument;
+            Aws::Crt::JsonObject jsonObject = s_parseExecutionPayload(
+                response.GetPayload(), IsRawJobDocumentMessage<M>::value, allocator, rawDocument);
             if (!jsonObject.WasParseSuccessful())
             {
                 s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
-                DescribeJobExecutionResponse modeledResponse(jsonObject);
-                Aws::Iot::RequestResponse::Result<DescribeJobExecutionResponse, ServiceErrorV2<E>> finalResult(
-                    std::move(modeledResponse));
+                M modeledResponse;
+                s_initExecutionMessage(modeledResponse, jsonObject, std::move(rawDocument));
+                R finalResult(std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::DescribeJobExecution(
             const DescribeJobExecutionRequest &request,
             const DescribeJobExecutionResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId << "/get";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
+            return SubmitDescribeJobExecution<DescribeJobExecutionResponse>(request, handler);
+        }
 
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId << "/get/+";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
+        bool ClientV2::DescribeJobExecutionRaw(
+            const DescribeJobExecutionRequest &request,
+            const DescribeJobExecutionRawResultHandler &handler)
+        {
+            return SubmitDescribeJobExecution<RawJobDocumentMessage<DescribeJobExecutionResponse>>(request, handler);
+        }
+
+        template <typename M>
+        bool ClientV2::SubmitDescribeJobExecution(
+            const DescribeJobExecutionRequest &request,
+            const std::function<void(Aws::Iot::RequestResponse::Result<M, ServiceErrorV2<V2ErrorResponse>> &&)>
+                &handler)
+        {
+            Aws::Iotdevicecommon::TopicBuilder publishTopic(m_allocator);
+            publishTopic.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/get");
+
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic0(m_allocator);
+            subscriptionTopic0.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/get/+");
 
             struct aws_byte_cursor subscriptionTopicFilters[1] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
+                subscriptionTopic0.ToCursor(),
             };
 
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            Aws::Crt::String responsePathTopicAccepted = publishTopic.ToString("/accepted");
+            Aws::Crt::String responsePathTopicRejected = publishTopic.ToString("/rejected");
 
             struct aws_mqtt_request_operation_response_path responsePaths[2];
             responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
@@ -166,13 +284,22 @@ namespace Aws
             responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
             responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
 
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
             struct aws_mqtt_request_operation_options options;
             AWS_ZERO_STRUCT(options);
@@ -180,17 +307,17 @@ namespace Aws
             options.subscription_topic_filter_count = 1;
             options.response_paths = responsePaths;
             options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            options.publish_topic = publishTopic.ToCursor();
+            options.serialized_request = writer.ToCursor();
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+            options.correlation_token = correlationToken.ToCursor();
 
-            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
+            Aws::Crt::Allocator *allocator = m_allocator;
+            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected, allocator](
                                      Aws::Iot::RequestResponse::UnmodeledResult &&result)
             {
-                s_DescribeJobExecutionResponseHandler(
-                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                s_DescribeJobExecutionResponseHandler<M>(
+                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected, allocator);
             };
 
             int submitResult = m_bindingClient->SubmitRequest(options, std::move(resultHandler));
@@ -213,7 +340,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -223,49 +360,36 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 GetPendingJobExecutionsResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<GetPendingJobExecutionsResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::GetPendingJobExecutions(
             const GetPendingJobExecutionsRequest &request,
             const GetPendingJobExecutionsResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/jobs/get";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder publishTopic(m_allocator);
+            publishTopic.Append("$aws/things/", *request.ThingName, "/jobs/get");
 
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/jobs/get/+";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic0(m_allocator);
+            subscriptionTopic0.Append("$aws/things/", *request.ThingName, "/jobs/get/+");
 
             struct aws_byte_cursor subscriptionTopicFilters[1] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
+                subscriptionTopic0.ToCursor(),
             };
 
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            Aws::Crt::String responsePathTopicAccepted = publishTopic.ToString("/accepted");
+            Aws::Crt::String responsePathTopicRejected = publishTopic.ToString("/rejected");
 
             struct aws_mqtt_request_operation_response_path responsePaths[2];
             responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
@@ -273,13 +397,22 @@ namespace Aws
             responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
             responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
 
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
             struct aws_mqtt_request_operation_options options;
             AWS_ZERO_STRUCT(options);
@@ -287,11 +420,10 @@ namespace Aws
             options.subscription_topic_filter_count = 1;
             options.response_paths = responsePaths;
             options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            options.publish_topic = publishTopic.ToCursor();
+            options.serialized_request = writer.ToCursor();
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+            options.correlation_token = correlationToken.ToCursor();
 
             auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
                                      Aws::Iot::RequestResponse::UnmodeledResult &&result)
@@ -305,14 +437,17 @@ namespace Aws
             return submitResult == AWS_OP_SUCCESS;
         }
 
+        template <typename M>
         static void s_StartNextPendingJobExecutionResponseHandler(
             Aws::Iot::RequestResponse::UnmodeledResult &&result,
-            const StartNextPendingJobExecutionResultHandler &handler,
+            const std::function<void(Aws::Iot::RequestResponse::Result<M, ServiceErrorV2<V2ErrorResponse>> &&)>
+                &handler,
             const Aws::Crt::String &successPathTopic,
-            const Aws::Crt::String &failurePathTopic)
+            const Aws::Crt::String &failurePathTopic,
+            Aws::Crt::Allocator *allocator)
         {
             using E = V2ErrorResponse;
-            using R = Aws::Iot::RequestResponse::Result<StartNextJobExecutionResponse, ServiceErrorV2<E>>;
+            using R = Aws::Iot::RequestResponse::Result<M, ServiceErrorV2<E>>;
 
             if (!result.IsSuccess())
             {
@@ -320,59 +455,73 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
-            const auto &payload = response.GetPayload();
-            Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
-            Aws::Crt::JsonObject jsonObject(objectStr);
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
+            std::shared_ptr<RawJobDocument> rawDocument;
+            Aws::Crt::JsonObject jsonObject = s_parseExecutionPayload(
+                response.GetPayload(), IsRawJobDocumentMessage<M>::value, allocator, rawDocument);
             if (!jsonObject.WasParseSuccessful())
             {
                 s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
-                StartNextJobExecutionResponse modeledResponse(jsonObject);
-                Aws::Iot::RequestResponse::Result<StartNextJobExecutionResponse, ServiceErrorV2<E>> finalResult(
-                    std::move(modeledResponse));
+                M modeledResponse;
+                s_initExecutionMessage(modeledResponse, jsonObject, std::move(rawDocument));
+                R finalResult(std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::StartNextPendingJobExecution(
             const StartNextPendingJobExecutionRequest &request,
             const StartNextPendingJobExecutionResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/jobs/start-next";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
+            return SubmitStartNextPendingJobExecution<StartNextJobExecutionResponse>(request, handler);
+        }
+
+        bool ClientV2::StartNextPendingJobExecutionRaw(
+            const StartNextPendingJobExecutionRequest &request,
+            const StartNextPendingJobExecutionRawResultHandler &handler)
+        {
+            return SubmitStartNextPendingJobExecution<RawJobDocumentMessage<StartNextJobExecutionResponse>>(
+                request, handler);
+        }
+
+        template <typename M>
+        bool ClientV2::SubmitStartNextPendingJobExecution(
+            const StartNextPendingJobExecutionRequest &request,
+            const std::function<void(Aws::Iot::RequestResponse::Result<M, ServiceErrorV2<V2ErrorResponse>> &&)>
+                &handler)
+        {
+            Aws::Iotdevicecommon::TopicBuilder publishTopic(m_allocator);
+            publishTopic.Append("$aws/things/", *request.ThingName, "/jobs/start-next");
 
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/jobs/start-next/+";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic0(m_allocator);
+            subscriptionTopic0.Append("$aws/things/", *request.ThingName, "/jobs/start-next/+");
 
             struct aws_byte_cursor subscriptionTopicFilters[1] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
+                subscriptionTopic0.ToCursor(),
             };
 
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            Aws::Crt::String responsePathTopicAccepted = publishTopic.ToString("/accepted");
+            Aws::Crt::String responsePathTopicRejected = publishTopic.ToString("/rejected");
 
             struct aws_mqtt_request_operation_response_path responsePaths[2];
             responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
@@ -380,13 +529,22 @@ namespace Aws
             responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
             responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
 
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
             struct aws_mqtt_request_operation_options options;
             AWS_ZERO_STRUCT(options);
@@ -394,17 +552,17 @@ namespace Aws
             options.subscription_topic_filter_count = 1;
             options.response_paths = responsePaths;
             options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            options.publish_topic = publishTopic.ToCursor();
+            options.serialized_request = writer.ToCursor();
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+            options.correlation_token = correlationToken.ToCursor();
 
-            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
+            Aws::Crt::Allocator *allocator = m_allocator;
+            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected, allocator](
                                      Aws::Iot::RequestResponse::UnmodeledResult &&result)
             {
-                s_StartNextPendingJobExecutionResponseHandler(
-                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                s_StartNextPendingJobExecutionResponseHandler<M>(
+                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected, allocator);
             };
 
             int submitResult = m_bindingClient->SubmitRequest(options, std::move(resultHandler));
@@ -427,7 +585,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -437,50 +605,59 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 UpdateJobExecutionResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<UpdateJobExecutionResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
+        }
+
+        bool ClientV2::UpdateJobExecution(
+            const UpdateJobExecutionRequest &request,
+            const UpdateJobExecutionResultHandler &handler)
+        {
+            return SubmitUpdateJobExecution(request, nullptr, handler);
+        }
+
+        bool ClientV2::UpdateJobExecutionWithStatusDetails(
+            const UpdateJobExecutionRequest &request,
+            const StatusDetailsBuilder &statusDetails,
+            const UpdateJobExecutionResultHandler &handler)
+        {
+            /* The builder replaces the request's own map; accepting both would write the member twice */
+            if (request.StatusDetails)
             {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                return false;
             }
+
+            return SubmitUpdateJobExecution(request, &statusDetails, handler);
         }
 
-        bool ClientV2::UpdateJobExecution(
+        bool ClientV2::SubmitUpdateJobExecution(
             const UpdateJobExecutionRequest &request,
+            const StatusDetailsBuilder *statusDetails,
             const UpdateJobExecutionResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId << "/update";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder publishTopic(m_allocator);
+            publishTopic.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/update");
 
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/jobs/" << *request.JobId
-                                     << "/update/+";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
+            Aws::Iotdevicecommon::TopicBuilder subscriptionTopic0(m_allocator);
+            subscriptionTopic0.Append("$aws/things/", *request.ThingName, "/jobs/", *request.JobId, "/update/+");
 
             struct aws_byte_cursor subscriptionTopicFilters[1] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
+                subscriptionTopic0.ToCursor(),
             };
 
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            Aws::Crt::String responsePathTopicAccepted = publishTopic.ToString("/accepted");
+            Aws::Crt::String responsePathTopicRejected = publishTopic.ToString("/rejected");
 
             struct aws_mqtt_request_operation_response_path responsePaths[2];
             responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
@@ -488,13 +665,28 @@ namespace Aws
             responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
             responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
 
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            if (statusDetails != nullptr)
+            {
+                writer.BeginObject("statusDetails");
+                statusDetails->SerializeTo(writer);
+                writer.EndObject();
+            }
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
             struct aws_mqtt_request_operation_options options;
             AWS_ZERO_STRUCT(options);
@@ -502,11 +694,10 @@ namespace Aws
             options.subscription_topic_filter_count = 1;
             options.response_paths = responsePaths;
             options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            options.publish_topic = publishTopic.ToCursor();
+            options.serialized_request = writer.ToCursor();
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+            options.correlation_token = correlationToken.ToCursor();
 
             auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
                                      Aws::Iot::RequestResponse::UnmodeledResult &&result)
@@ -520,25 +711,28 @@ namespace Aws
             return submitResult == AWS_OP_SUCCESS;
         }
 
+        template <typename M>
         static bool s_initModeledEvent(
             const Aws::Iot::RequestResponse::IncomingPublishEvent &publishEvent,
-            NextJobExecutionChangedEvent &modeledEvent)
+            M &modeledEvent,
+            Aws::Crt::Allocator *allocator)
         {
-            const auto &payload = publishEvent.GetPayload();
-            Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
-            Aws::Crt::JsonObject jsonObject(objectStr);
+            std::shared_ptr<RawJobDocument> rawDocument;
+            Aws::Crt::JsonObject jsonObject = s_parseExecutionPayload(
+                publishEvent.GetPayload(), IsRawJobDocumentMessage<M>::value, allocator, rawDocument);
             if (!jsonObject.WasParseSuccessful())
             {
                 return false;
             }
 
-            modeledEvent = NextJobExecutionChangedEvent(jsonObject);
+            s_initExecutionMessage(modeledEvent, jsonObject, std::move(rawDocument));
             return true;
         }
 
         static bool s_initModeledEvent(
             const Aws::Iot::RequestResponse::IncomingPublishEvent &publishEvent,
-            JobExecutionsChangedEvent &modeledEvent)
+            JobExecutionsChangedEvent &modeledEvent,
+            Aws::Crt::Allocator * /*allocator*/)
         {
             const auto &payload = publishEvent.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
@@ -563,15 +757,15 @@ namespace Aws
             static std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> Create(
                 Aws::Crt::Allocator *allocator,
                 const std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> &bindingClient,
-                const Aws::Crt::String &subscriptionTopicFilter,
+                struct aws_byte_cursor subscriptionTopicFilter,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<T> &options)
             {
 
                 std::function<void(Aws::Iot::RequestResponse::IncomingPublishEvent &&)> unmodeledHandler =
-                    [options](Aws::Iot::RequestResponse::IncomingPublishEvent &&publishEvent)
+                    [options, allocator](Aws::Iot::RequestResponse::IncomingPublishEvent &&publishEvent)
                 {
                     T modeledEvent;
-                    if (!s_initModeledEvent(publishEvent, modeledEvent))
+                    if (!s_initModeledEvent(publishEvent, modeledEvent, allocator))
                     {
                         return;
                     }
@@ -579,7 +773,7 @@ namespace Aws
                 };
 
                 Aws::Iot::RequestResponse::StreamingOperationOptionsInternal internalOptions;
-                internalOptions.subscriptionTopicFilter = Aws::Crt::ByteCursorFromString(subscriptionTopicFilter);
+                internalOptions.subscriptionTopicFilter = subscriptionTopicFilter;
                 internalOptions.subscriptionStatusEventHandler = options.GetSubscriptionStatusEventHandler();
                 internalOptions.incomingPublishEventHandler = unmodeledHandler;
 
@@ -602,29 +796,49 @@ namespace Aws
             const JobExecutionsChangedSubscriptionRequest &request,
             const Aws::Iot::RequestResponse::StreamingOperationOptions<JobExecutionsChangedEvent> &options)
         {
-            Aws::Crt::StringStream topicStream;
-            topicStream << "$aws/things/" << *request.ThingName << "/jobs/notify";
-            Aws::Crt::String topic = topicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/jobs/notify");
 
             return ServiceStreamingOperation<JobExecutionsChangedEvent>::Create(
-                m_allocator, m_bindingClient, topic, options);
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
         }
 
         std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::CreateNextJobExecutionChangedStream(
             const NextJobExecutionChangedSubscriptionRequest &request,
             const Aws::Iot::RequestResponse::StreamingOperationOptions<NextJobExecutionChangedEvent> &options)
         {
-            Aws::Crt::StringStream topicStream;
-            topicStream << "$aws/things/" << *request.ThingName << "/jobs/notify-next";
-            Aws::Crt::String topic = topicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/jobs/notify-next");
 
             return ServiceStreamingOperation<NextJobExecutionChangedEvent>::Create(
-                m_allocator, m_bindingClient, topic, options);
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::
+            CreateNextJobExecutionChangedRawStream(
+                const NextJobExecutionChangedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<
+                    RawJobDocumentMessage<NextJobExecutionChangedEvent>> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/jobs/notify-next");
+
+            return ServiceStreamingOperation<RawJobDocumentMessage<NextJobExecutionChangedEvent>>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<IClientV2> NewClientFrom5(
+            const Aws::Crt::Mqtt5::Mqtt5Client &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            Aws::Crt::Allocator *allocator)
+        {
+            return NewClientFrom5(protocolClient, options, {}, allocator);
         }
 
         std::shared_ptr<IClientV2> NewClientFrom5(
             const Aws::Crt::Mqtt5::Mqtt5Client &protocolClient,
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
             Aws::Crt::Allocator *allocator)
         {
 
@@ -635,12 +849,22 @@ namespace Aws
                 return nullptr;
             }
 
-            return Aws::Crt::MakeShared<ClientV2>(allocator, allocator, bindingClient);
+            return Aws::Crt::MakeShared<ClientV2>(
+                allocator, allocator, bindingClient, std::move(correlationTokenGenerator));
+        }
+
+        std::shared_ptr<IClientV2> NewClientFrom311(
+            const Aws::Crt::Mqtt::MqttConnection &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            Aws::Crt::Allocator *allocator)
+        {
+            return NewClientFrom311(protocolClient, options, {}, allocator);
         }
 
         std::shared_ptr<IClientV2> NewClientFrom311(
             const Aws::Crt::Mqtt::MqttConnection &protocolClient,
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
             Aws::Crt::Allocator *allocator)
         {
 
@@ -651,7 +875,23 @@ namespace Aws
                 return nullptr;
             }
 
-            return Aws::Crt::MakeShared<ClientV2>(allocator, allocator, bindingClient);
+            return Aws::Crt::MakeShared<ClientV2>(
+                allocator, allocator, bindingClient, std::move(correlationTokenGenerator));
+        }
+
+        std::shared_ptr<IClientV2> NewClientFromRequestResponseClient(
+            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
+            Aws::Crt::Allocator *allocator)
+        {
+            if (nullptr == bindingClient)
+            {
+                aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                return nullptr;
+            }
+
+            return Aws::Crt::MakeShared<ClientV2>(
+                allocator, allocator, std::move(bindingClient), std::move(correlationTokenGenerator));
         }
 
     } // namespace Iotjobs
@@ -0,0 +1,384 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotjobs/JobExecutionJournal.h>
+
+#include <aws/common/file.h>
+#include <aws/common/string.h>
+
+#include <aws/crt/JsonObject.h>
+#include <aws/iotdevicecommon/JsonWriter.h>
+
+#include <cerrno>
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <io.h>
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        static bool s_isLive(JobStatus status)
+        {
+            return status == JobStatus::QUEUED || status == JobStatus::IN_PROGRESS;
+        }
+
+        /* Writes buffered data through to the disk, so that a recorded transition survives a power loss */
+        static bool s_syncFile(FILE *file)
+        {
+#ifdef _WIN32
+            if (fflush(file) != 0 || _commit(_fileno(file)) != 0)
+#else
+            if (fflush(file) != 0 || fsync(fileno(file)) != 0)
+#endif
+            {
+                aws_translate_and_raise_io_error(errno);
+                return false;
+            }
+
+            return true;
+        }
+
+        /* Cuts the file back to the given length, dropping the part of a line that a failed append left behind */
+        static void s_truncateFile(FILE *file, int64_t length)
+        {
+#ifdef _WIN32
+            (void)_chsize_s(_fileno(file), length);
+#else
+            (void)ftruncate(fileno(file), static_cast<off_t>(length));
+#endif
+        }
+
+        /*
+         * Syncs the directory holding the file.  On POSIX systems a rename is only durable once the directory entry
+         * it changed is on disk; on Windows, MOVEFILE_WRITE_THROUGH already waits for that.
+         */
+        static bool s_syncDirectoryOf(const Aws::Crt::String &path)
+        {
+#ifdef _WIN32
+            (void)path;
+            return true;
+#else
+            size_t separator = path.find_last_of('/');
+            Aws::Crt::String directory =
+                separator == Aws::Crt::String::npos ? "." : path.substr(0, separator == 0 ? 1 : separator);
+
+            int fd = open(directory.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                aws_translate_and_raise_io_error(errno);
+                return false;
+            }
+
+            /* Some file systems cannot sync directories and report EINVAL; their renames need no sync */
+            bool synced = fsync(fd) == 0 || errno == EINVAL;
+            int syncError = errno;
+            close(fd);
+            if (!synced)
+            {
+                aws_translate_and_raise_io_error(syncError);
+            }
+
+            return synced;
+#endif
+        }
+
+        /* Replaces the destination atomically; it is either the old or the new file after a crash */
+        static bool s_replaceFile(const char *source, const char *destination)
+        {
+#ifdef _WIN32
+            if (!MoveFileExA(source, destination, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+            {
+                aws_raise_error(AWS_ERROR_SYS_CALL_FAILURE);
+                return false;
+            }
+#else
+            if (std::rename(source, destination) != 0)
+            {
+                aws_translate_and_raise_io_error(errno);
+                return false;
+            }
+#endif
+            return true;
+        }
+
+        /* Parses one journal line; false for lines torn by a crash */
+        static bool s_parseEntry(struct aws_byte_cursor line, JournaledJobExecution &execution)
+        {
+            Aws::Crt::String text(reinterpret_cast<const char *>(line.ptr), line.len);
+            Aws::Crt::JsonObject object(text);
+            if (!object.WasParseSuccessful())
+            {
+                return false;
+            }
+
+            Aws::Crt::JsonView doc = object.View();
+            if (!doc.ValueExists("jobId") || !doc.ValueExists("status"))
+            {
+                return false;
+            }
+
+            execution.JobId = doc.GetString("jobId");
+            execution.Status = JobStatusMarshaller::FromString(doc.GetString("status"));
+            if (doc.ValueExists("versionNumber"))
+            {
+                execution.VersionNumber = doc.GetInteger("versionNumber");
+            }
+            if (doc.ValueExists("executionNumber"))
+            {
+                execution.ExecutionNumber = doc.GetInt64("executionNumber");
+            }
+            if (doc.ValueExists("statusDetails"))
+            {
+                Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> statusDetails;
+                for (auto &member : doc.GetJsonObject("statusDetails").GetAllObjects())
+                {
+                    statusDetails[member.first] = member.second.AsString();
+                }
+                execution.StatusDetails = std::move(statusDetails);
+            }
+
+            return true;
+        }
+
+        JobExecutionJournal::JobExecutionJournal(const Aws::Crt::String &path, Aws::Crt::Allocator *allocator)
+            : m_allocator(allocator), m_path(path), m_file(nullptr)
+        {
+        }
+
+        JobExecutionJournal::~JobExecutionJournal()
+        {
+            if (m_file != nullptr)
+            {
+                fclose(m_file);
+            }
+        }
+
+        bool JobExecutionJournal::Open()
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (m_file != nullptr)
+            {
+                aws_raise_error(AWS_ERROR_INVALID_STATE);
+                return false;
+            }
+
+            m_executions.clear();
+
+            struct aws_byte_buf contents;
+            AWS_ZERO_STRUCT(contents);
+            if (aws_byte_buf_init_from_file(&contents, m_allocator, m_path.c_str()) != AWS_OP_SUCCESS)
+            {
+                /* Only a missing file is an empty journal; compacting after any other failure would wipe it */
+                int errorCode = aws_last_error();
+                struct aws_string *path = aws_string_new_from_c_str(m_allocator, m_path.c_str());
+                bool exists = path == nullptr || aws_path_exists(path);
+                aws_string_destroy(path);
+                if (exists)
+                {
+                    aws_raise_error(errorCode);
+                    return false;
+                }
+            }
+            else
+            {
+                /*
+                 * Every append ends its line with a newline, so anything after the last one is an append that never
+                 * completed.  It is dropped rather than replayed, and compaction removes it from the file.
+                 */
+                size_t completeLength = contents.len;
+                while (completeLength > 0 && contents.buffer[completeLength - 1] != '\n')
+                {
+                    --completeLength;
+                }
+
+                struct aws_byte_cursor remaining = aws_byte_cursor_from_array(contents.buffer, completeLength);
+                struct aws_byte_cursor line;
+                AWS_ZERO_STRUCT(line);
+                while (aws_byte_cursor_next_split(&remaining, '\n', &line))
+                {
+                    JournaledJobExecution execution;
+                    if (line.len == 0 || !s_parseEntry(line, execution))
+                    {
+                        continue;
+                    }
+
+                    if (s_isLive(execution.Status))
+                    {
+                        m_executions[execution.JobId] = std::move(execution);
+                    }
+                    else
+                    {
+                        m_executions.erase(execution.JobId);
+                    }
+                }
+                aws_byte_buf_clean_up(&contents);
+            }
+
+            if (!Compact())
+            {
+                return false;
+            }
+
+            /* Append mode: every write lands at the end of the file, even if another handle has extended it */
+            m_file = aws_fopen(m_path.c_str(), "ab");
+            if (m_file == nullptr)
+            {
+                return false;
+            }
+
+            /* Unbuffered, so a failed append leaves nothing behind in the stream that a later flush could write */
+            setvbuf(m_file, nullptr, _IONBF, 0);
+            return true;
+        }
+
+        bool JobExecutionJournal::Record(const JournaledJobExecution &execution)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (m_file == nullptr)
+            {
+                aws_raise_error(AWS_ERROR_INVALID_STATE);
+                return false;
+            }
+
+            int64_t length = 0;
+            if (aws_file_get_length(m_file, &length) != AWS_OP_SUCCESS)
+            {
+                return false;
+            }
+
+            if (!Append(m_file, execution) || !s_syncFile(m_file))
+            {
+                /* The next transition must start on a line of its own rather than extend a torn one */
+                s_truncateFile(m_file, length);
+                return false;
+            }
+
+            if (s_isLive(execution.Status))
+            {
+                m_executions[execution.JobId] = execution;
+            }
+            else
+            {
+                m_executions.erase(execution.JobId);
+            }
+
+            return true;
+        }
+
+        Aws::Crt::Vector<JournaledJobExecution> JobExecutionJournal::GetExecutions() const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            Aws::Crt::Vector<JournaledJobExecution> executions;
+            executions.reserve(m_executions.size());
+            for (const auto &execution : m_executions)
+            {
+                executions.push_back(execution.second);
+            }
+
+            return executions;
+        }
+
+        Aws::Crt::Optional<JournaledJobExecution> JobExecutionJournal::GetExecution(
+            const Aws::Crt::String &jobId) const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            auto iter = m_executions.find(jobId);
+            if (iter == m_executions.end())
+            {
+                return {};
+            }
+
+            return iter->second;
+        }
+
+        bool JobExecutionJournal::Append(FILE *file, const JournaledJobExecution &execution)
+        {
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("jobId", execution.JobId);
+            writer.WithString("status", JobStatusMarshaller::ToString(execution.Status));
+            if (execution.VersionNumber.has_value())
+            {
+                writer.WithInteger("versionNumber", *execution.VersionNumber);
+            }
+            if (execution.ExecutionNumber.has_value())
+            {
+                writer.WithInt64("executionNumber", *execution.ExecutionNumber);
+            }
+            if (execution.StatusDetails.has_value())
+            {
+                writer.BeginObject("statusDetails");
+                for (const auto &statusDetail : *execution.StatusDetails)
+                {
+                    writer.WithString(statusDetail.first, statusDetail.second);
+                }
+                writer.EndObject();
+            }
+            writer.EndObject();
+            if (!writer)
+            {
+                /* The entry is a flat object, so the writer can only have failed to grow its buffer */
+                aws_raise_error(AWS_ERROR_OOM);
+                return false;
+            }
+
+            struct aws_byte_cursor line = writer.ToCursor();
+            if (fwrite(line.ptr, 1, line.len, file) != line.len || fputc('\n', file) == EOF)
+            {
+                aws_translate_and_raise_io_error(errno);
+                return false;
+            }
+
+            return true;
+        }
+
+        /* Requires the lock.  Replaces the file with the live executions via a temporary file. */
+        bool JobExecutionJournal::Compact()
+        {
+            Aws::Crt::String temporaryPath = m_path + ".tmp";
+            FILE *file = aws_fopen(temporaryPath.c_str(), "wb");
+            if (file == nullptr)
+            {
+                return false;
+            }
+
+            bool written = true;
+            for (const auto &execution : m_executions)
+            {
+                if (!Append(file, execution.second))
+                {
+                    written = false;
+                    break;
+                }
+            }
+
+            /* The new contents must be on disk before they replace the old file */
+            written = written && s_syncFile(file);
+            if (fclose(file) != 0 && written)
+            {
+                aws_translate_and_raise_io_error(errno);
+                written = false;
+            }
+
+            if (!written || !s_replaceFile(temporaryPath.c_str(), m_path.c_str()))
+            {
+                std::remove(temporaryPath.c_str());
+                return false;
+            }
+
+            return s_syncDirectoryOf(m_path);
+        }
+
+    } // namespace Iotjobs
+} // namespace Aws
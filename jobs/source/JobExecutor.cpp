@@ -0,0 +1,243 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotjobs/JobExecutor.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        /* Tasks of one key; the key is in the ready list or running whenever tasks is not empty */
+        struct JobExecutorKeyQueue
+        {
+            Aws::Crt::List<std::function<void()>> tasks;
+            bool running = false;
+        };
+
+        class JobExecutorState : public std::enable_shared_from_this<JobExecutorState>
+        {
+          public:
+            JobExecutorState(size_t maxQueuedTasks, JobExecutorOverflowPolicy overflowPolicy)
+                : m_maxQueuedTasks(maxQueuedTasks), m_overflowPolicy(overflowPolicy), m_queuedTasks(0),
+                  m_stopping(false)
+            {
+            }
+
+            void StartWorkers(size_t threadCount)
+            {
+                /* Workers keep the state alive in case one of them is detached by Shutdown() */
+                auto state = shared_from_this();
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    m_workers.emplace_back([state]() { state->RunWorker(); });
+                }
+            }
+
+            bool Submit(const Aws::Crt::String &key, std::function<void()> &&task)
+            {
+                std::unique_lock<std::mutex> guard(m_lock);
+                if (m_overflowPolicy == JobExecutorOverflowPolicy::Block)
+                {
+                    m_spaceAvailable.wait(guard, [this]() { return m_stopping || m_queuedTasks < m_maxQueuedTasks; });
+                }
+
+                if (m_stopping)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                if (m_queuedTasks >= m_maxQueuedTasks)
+                {
+                    aws_raise_error(AWS_ERROR_LIST_EXCEEDS_MAX_SIZE);
+                    return false;
+                }
+
+                JobExecutorKeyQueue &queue = m_queues[key];
+                bool wasIdle = queue.tasks.empty() && !queue.running;
+                queue.tasks.push_back(std::move(task));
+                ++m_queuedTasks;
+
+                if (wasIdle)
+                {
+                    m_ready.push_back(key);
+                    m_workAvailable.notify_one();
+                }
+
+                return true;
+            }
+
+            /*
+             * Runs the remaining tasks and joins the workers.  When called from a worker, e.g. by a task dropping the
+             * last reference to the executor, the remaining tasks are dropped instead: the tasks queued behind the
+             * caller's own key could never run.
+             */
+            void Shutdown()
+            {
+                bool onWorker = false;
+                for (const auto &worker : m_workers)
+                {
+                    onWorker = onWorker || worker.get_id() == std::this_thread::get_id();
+                }
+
+                /* Dropped tasks are released outside the lock */
+                Aws::Crt::List<std::function<void()>> dropped;
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_stopping = true;
+                    if (onWorker)
+                    {
+                        for (auto iter = m_queues.begin(); iter != m_queues.end();)
+                        {
+                            dropped.splice(dropped.end(), iter->second.tasks);
+                            if (iter->second.running)
+                            {
+                                ++iter;
+                            }
+                            else
+                            {
+                                iter = m_queues.erase(iter);
+                            }
+                        }
+                        m_ready.clear();
+                        m_queuedTasks = 0;
+                    }
+                }
+                m_workAvailable.notify_all();
+                m_spaceAvailable.notify_all();
+                dropped.clear();
+
+                for (auto &worker : m_workers)
+                {
+                    /* The last reference may be dropped by one of our own tasks */
+                    if (worker.get_id() == std::this_thread::get_id())
+                    {
+                        worker.detach();
+                    }
+                    else
+                    {
+                        worker.join();
+                    }
+                }
+                m_workers.clear();
+            }
+
+            size_t GetQueuedTaskCount() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_queuedTasks;
+            }
+
+          private:
+            void RunWorker()
+            {
+                std::unique_lock<std::mutex> guard(m_lock);
+                while (true)
+                {
+                    m_workAvailable.wait(
+                        guard, [this]() { return !m_ready.empty() || (m_stopping && m_queuedTasks == 0); });
+                    if (m_ready.empty())
+                    {
+                        return;
+                    }
+
+                    Aws::Crt::String key = std::move(m_ready.front());
+                    m_ready.pop_front();
+
+                    JobExecutorKeyQueue &queue = m_queues[key];
+                    std::function<void()> task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                    queue.running = true;
+                    --m_queuedTasks;
+
+                    m_spaceAvailable.notify_one();
+                    if (m_stopping && m_queuedTasks == 0)
+                    {
+                        m_workAvailable.notify_all();
+                    }
+
+                    guard.unlock();
+                    task();
+                    task = nullptr;
+                    guard.lock();
+
+                    /* The map node is stable, but may have been refilled while the task ran */
+                    JobExecutorKeyQueue &finished = m_queues[key];
+                    finished.running = false;
+                    if (finished.tasks.empty())
+                    {
+                        m_queues.erase(key);
+                    }
+                    else
+                    {
+                        m_ready.push_back(key);
+                        m_workAvailable.notify_one();
+                    }
+                }
+            }
+
+            size_t m_maxQueuedTasks;
+            JobExecutorOverflowPolicy m_overflowPolicy;
+
+            mutable std::mutex m_lock;
+            std::condition_variable m_workAvailable;
+            std::condition_variable m_spaceAvailable;
+
+            Aws::Crt::Map<Aws::Crt::String, JobExecutorKeyQueue> m_queues;
+            /* Keys with queued tasks and no running task, in the order they became runnable */
+            Aws::Crt::List<Aws::Crt::String> m_ready;
+            size_t m_queuedTasks;
+            bool m_stopping;
+
+            Aws::Crt::Vector<std::thread> m_workers;
+        };
+
+        JobExecutor::JobExecutor(
+            size_t threadCount,
+            size_t maxQueuedTasks,
+            JobExecutorOverflowPolicy overflowPolicy,
+            Aws::Crt::Allocator *allocator)
+            : m_allocator(allocator),
+              m_state(Aws::Crt::MakeShared<JobExecutorState>(allocator, maxQueuedTasks, overflowPolicy))
+        {
+            m_state->StartWorkers(threadCount > 0 ? threadCount : 1);
+        }
+
+        JobExecutor::~JobExecutor()
+        {
+            m_state->Shutdown();
+        }
+
+        bool JobExecutor::Submit(const Aws::Crt::String &key, std::function<void()> task)
+        {
+            return m_state->Submit(key, std::move(task));
+        }
+
+        bool JobExecutor::Submit(
+            const std::weak_ptr<JobExecutorState> &weakState,
+            const Aws::Crt::String &key,
+            std::function<void()> task)
+        {
+            auto state = weakState.lock();
+            if (!state)
+            {
+                aws_raise_error(AWS_ERROR_INVALID_STATE);
+                return false;
+            }
+
+            return state->Submit(key, std::move(task));
+        }
+
+        size_t JobExecutor::GetQueuedTaskCount() const
+        {
+            return m_state->GetQueuedTaskCount();
+        }
+
+    } // namespace Iotjobs
+} // namespace Aws
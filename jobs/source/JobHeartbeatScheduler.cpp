@@ -0,0 +1,482 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotjobs/JobHeartbeatScheduler.h>
+
+#include <aws/common/clock.h>
+#include <aws/crt/io/EventLoopGroup.h>
+#include <aws/io/event_loop.h>
+
+#include <aws/iotjobs/JobExecutionState.h>
+#include <aws/iotjobs/RejectedErrorCode.h>
+#include <aws/iotjobs/UpdateJobExecutionRequest.h>
+#include <aws/iotjobs/UpdateJobExecutionResponse.h>
+#include <aws/iotjobs/V2ErrorResponse.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        JobHeartbeatSchedulerOptions &JobHeartbeatSchedulerOptions::WithStepTimeout(std::chrono::minutes stepTimeout)
+        {
+            m_stepTimeout = stepTimeout;
+            return *this;
+        }
+
+        JobHeartbeatSchedulerOptions &JobHeartbeatSchedulerOptions::WithHeartbeatInterval(
+            std::chrono::milliseconds interval)
+        {
+            m_heartbeatInterval = interval;
+            return *this;
+        }
+
+        JobHeartbeatSchedulerOptions &JobHeartbeatSchedulerOptions::WithTickInterval(
+            std::chrono::milliseconds tickInterval)
+        {
+            m_tickInterval = tickInterval;
+            return *this;
+        }
+
+        JobHeartbeatSchedulerOptions &JobHeartbeatSchedulerOptions::WithEventLoopGroup(
+            Aws::Crt::Io::EventLoopGroup &eventLoopGroup)
+        {
+            m_eventLoopGroup = &eventLoopGroup;
+            return *this;
+        }
+
+        std::chrono::milliseconds JobHeartbeatSchedulerOptions::GetHeartbeatInterval() const
+        {
+            if (m_heartbeatInterval.count() > 0)
+            {
+                return m_heartbeatInterval;
+            }
+
+            return std::chrono::duration_cast<std::chrono::milliseconds>(m_stepTimeout) / 2;
+        }
+
+        struct TrackedJobExecution
+        {
+            Aws::Crt::Optional<int64_t> executionNumber;
+            Aws::Crt::Optional<int32_t> versionNumber;
+            size_t slot = 0;
+            bool heartbeatInFlight = false;
+        };
+
+        struct JobHeartbeat
+        {
+            Aws::Crt::String jobId;
+            Aws::Crt::Optional<int64_t> executionNumber;
+            Aws::Crt::Optional<int32_t> versionNumber;
+        };
+
+        class JobHeartbeatSchedulerState : public std::enable_shared_from_this<JobHeartbeatSchedulerState>
+        {
+          public:
+            JobHeartbeatSchedulerState(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                const JobHeartbeatSchedulerOptions &options,
+                Aws::Crt::Allocator *allocator)
+                : m_allocator(allocator), m_client(std::move(client)), m_thingName(thingName),
+                  m_stepTimeout(options.GetStepTimeout()), m_heartbeatInterval(options.GetHeartbeatInterval()),
+                  m_tickInterval(options.GetTickInterval()), m_eventLoop(nullptr), m_nextTickNs(0), m_cursor(0),
+                  m_tickScheduled(false), m_stopped(false)
+            {
+                if (options.GetEventLoopGroup() != nullptr)
+                {
+                    m_eventLoop =
+                        aws_event_loop_group_get_next_loop(options.GetEventLoopGroup()->GetUnderlyingHandle());
+                }
+
+                size_t slotCount = 1;
+                if (m_tickInterval.count() > 0 && m_heartbeatInterval > m_tickInterval)
+                {
+                    slotCount = static_cast<size_t>(m_heartbeatInterval.count() / m_tickInterval.count());
+                }
+                m_slots.resize(slotCount);
+            }
+
+            bool IsValid() const
+            {
+                return m_client && m_eventLoop != nullptr && m_stepTimeout.count() > 0 &&
+                       m_tickInterval.count() > 0 && m_heartbeatInterval.count() > 0 &&
+                       m_heartbeatInterval < m_stepTimeout;
+            }
+
+            bool Track(
+                const Aws::Crt::String &jobId,
+                const Aws::Crt::Optional<int64_t> &executionNumber,
+                const Aws::Crt::Optional<int32_t> &versionNumber);
+
+            void Untrack(const Aws::Crt::String &jobId)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                Remove(jobId);
+            }
+
+            size_t GetTrackedCount() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_tracked.size();
+            }
+
+            int64_t GetStepTimeoutInMinutes() const { return static_cast<int64_t>(m_stepTimeout.count()); }
+
+            void Stop()
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_stopped = true;
+            }
+
+            void OnTick();
+
+          private:
+            /* Must be called with the lock held */
+            void Remove(const Aws::Crt::String &jobId);
+
+            /* Only called by whoever set m_tickScheduled */
+            bool ScheduleTick();
+
+            void SendHeartbeat(const JobHeartbeat &heartbeat);
+
+            void OnHeartbeatResult(const Aws::Crt::String &jobId, const UpdateJobExecutionResult &result);
+
+            Aws::Crt::Allocator *m_allocator;
+            std::shared_ptr<IClientV2> m_client;
+            Aws::Crt::String m_thingName;
+            std::chrono::minutes m_stepTimeout;
+            std::chrono::milliseconds m_heartbeatInterval;
+            std::chrono::milliseconds m_tickInterval;
+            struct aws_event_loop *m_eventLoop;
+            uint64_t m_nextTickNs;
+
+            mutable std::mutex m_lock;
+            Aws::Crt::Map<Aws::Crt::String, TrackedJobExecution> m_tracked;
+            /* Job ids per wheel slot; the slot under the cursor is due on the next tick */
+            Aws::Crt::Vector<Aws::Crt::Vector<Aws::Crt::String>> m_slots;
+            size_t m_cursor;
+            bool m_tickScheduled;
+            bool m_stopped;
+        };
+
+        struct HeartbeatTickTask
+        {
+            HeartbeatTickTask(Aws::Crt::Allocator *allocator, std::weak_ptr<JobHeartbeatSchedulerState> state)
+                : allocator(allocator), state(std::move(state))
+            {
+                AWS_ZERO_STRUCT(task);
+            }
+
+            struct aws_task task;
+            Aws::Crt::Allocator *allocator;
+            std::weak_ptr<JobHeartbeatSchedulerState> state;
+        };
+
+        static void s_onHeartbeatTick(struct aws_task *task, void *arg, enum aws_task_status status)
+        {
+            (void)task;
+
+            auto *tickTask = static_cast<HeartbeatTickTask *>(arg);
+            if (status == AWS_TASK_STATUS_RUN_READY)
+            {
+                if (auto state = tickTask->state.lock())
+                {
+                    state->OnTick();
+                }
+            }
+
+            Aws::Crt::Delete(tickTask, tickTask->allocator);
+        }
+
+        static bool s_isFinalRejection(const ServiceErrorV2<V2ErrorResponse> &error)
+        {
+            if (!error.HasModeledError() || !error.GetModeledError().Code.has_value())
+            {
+                return false;
+            }
+
+            switch (*error.GetModeledError().Code)
+            {
+                case RejectedErrorCode::TerminalStateReached:
+                case RejectedErrorCode::InvalidStateTransition:
+                case RejectedErrorCode::ResourceNotFound:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        bool JobHeartbeatSchedulerState::Track(
+            const Aws::Crt::String &jobId,
+            const Aws::Crt::Optional<int64_t> &executionNumber,
+            const Aws::Crt::Optional<int32_t> &versionNumber)
+        {
+            if (!IsValid())
+            {
+                aws_raise_error(AWS_ERROR_INVALID_STATE);
+                return false;
+            }
+
+            bool startTicking = false;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_stopped)
+                {
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                auto iter = m_tracked.find(jobId);
+                if (iter == m_tracked.end())
+                {
+                    /* The slot behind the cursor comes up last, one full turn of the wheel from now */
+                    TrackedJobExecution &tracked = m_tracked[jobId];
+                    tracked.slot = (m_cursor + m_slots.size() - 1) % m_slots.size();
+                    m_slots[tracked.slot].push_back(jobId);
+                    iter = m_tracked.find(jobId);
+                }
+
+                iter->second.executionNumber = executionNumber;
+                iter->second.versionNumber = versionNumber;
+
+                startTicking = !m_tickScheduled;
+                m_tickScheduled = true;
+            }
+
+            if (startTicking && !ScheduleTick())
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_tickScheduled = false;
+                Remove(jobId);
+                return false;
+            }
+
+            return true;
+        }
+
+        void JobHeartbeatSchedulerState::Remove(const Aws::Crt::String &jobId)
+        {
+            auto iter = m_tracked.find(jobId);
+            if (iter == m_tracked.end())
+            {
+                return;
+            }
+
+            auto &slot = m_slots[iter->second.slot];
+            slot.erase(std::find(slot.begin(), slot.end(), jobId));
+            m_tracked.erase(iter);
+        }
+
+        bool JobHeartbeatSchedulerState::ScheduleTick()
+        {
+            uint64_t now = 0;
+            if (aws_event_loop_current_clock_time(m_eventLoop, &now))
+            {
+                return false;
+            }
+
+            /* Advance from the previous tick so that the wheel does not drift, unless it fell behind */
+            uint64_t tickNs = aws_timestamp_convert(
+                static_cast<uint64_t>(m_tickInterval.count()), AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, nullptr);
+            m_nextTickNs += tickNs;
+            if (m_nextTickNs < now)
+            {
+                m_nextTickNs = now + tickNs;
+            }
+
+            auto *tickTask = Aws::Crt::New<HeartbeatTickTask>(m_allocator, m_allocator, shared_from_this());
+            aws_task_init(&tickTask->task, s_onHeartbeatTick, tickTask, "JobHeartbeatTick");
+            aws_event_loop_schedule_task_future(m_eventLoop, &tickTask->task, m_nextTickNs);
+
+            return true;
+        }
+
+        void JobHeartbeatSchedulerState::OnTick()
+        {
+            Aws::Crt::Vector<JobHeartbeat> due;
+            bool keepTicking = false;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!m_stopped)
+                {
+                    for (const auto &jobId : m_slots[m_cursor])
+                    {
+                        TrackedJobExecution &tracked = m_tracked[jobId];
+                        if (tracked.heartbeatInFlight)
+                        {
+                            continue;
+                        }
+
+                        tracked.heartbeatInFlight = true;
+                        JobHeartbeat heartbeat;
+                        heartbeat.jobId = jobId;
+                        if (tracked.executionNumber.has_value())
+                        {
+                            heartbeat.executionNumber = *tracked.executionNumber;
+                        }
+                        if (tracked.versionNumber.has_value())
+                        {
+                            heartbeat.versionNumber = *tracked.versionNumber;
+                        }
+                        due.push_back(std::move(heartbeat));
+                    }
+
+                    m_cursor = (m_cursor + 1) % m_slots.size();
+                    keepTicking = !m_tracked.empty();
+                }
+
+                m_tickScheduled = keepTicking;
+            }
+
+            if (keepTicking && !ScheduleTick())
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_tickScheduled = false;
+            }
+
+            for (const auto &heartbeat : due)
+            {
+                SendHeartbeat(heartbeat);
+            }
+        }
+
+        void JobHeartbeatSchedulerState::SendHeartbeat(const JobHeartbeat &heartbeat)
+        {
+            UpdateJobExecutionRequest request;
+            request.ThingName = m_thingName;
+            request.JobId = heartbeat.jobId;
+            request.Status = JobStatus::IN_PROGRESS;
+            request.StepTimeoutInMinutes = GetStepTimeoutInMinutes();
+            if (heartbeat.executionNumber.has_value())
+            {
+                request.ExecutionNumber = *heartbeat.executionNumber;
+            }
+            if (heartbeat.versionNumber.has_value())
+            {
+                request.ExpectedVersion = *heartbeat.versionNumber;
+                request.IncludeJobExecutionState = true;
+            }
+
+            std::weak_ptr<JobHeartbeatSchedulerState> weakState = shared_from_this();
+            Aws::Crt::String jobId = heartbeat.jobId;
+            if (!m_client->UpdateJobExecution(
+                    request,
+                    [weakState, jobId](UpdateJobExecutionResult &&result)
+                    {
+                        if (auto state = weakState.lock())
+                        {
+                            state->OnHeartbeatResult(jobId, result);
+                        }
+                    }))
+            {
+                int errorCode = aws_last_error();
+                OnHeartbeatResult(
+                    jobId,
+                    UpdateJobExecutionResult(ServiceErrorV2<V2ErrorResponse>(
+                        errorCode != AWS_ERROR_SUCCESS ? errorCode : AWS_ERROR_UNKNOWN)));
+            }
+        }
+
+        void JobHeartbeatSchedulerState::OnHeartbeatResult(
+            const Aws::Crt::String &jobId,
+            const UpdateJobExecutionResult &result)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            auto iter = m_tracked.find(jobId);
+            if (iter == m_tracked.end())
+            {
+                return;
+            }
+
+            TrackedJobExecution &tracked = iter->second;
+            tracked.heartbeatInFlight = false;
+
+            if (result.IsSuccess())
+            {
+                const auto &executionState = result.GetResponse().ExecutionState;
+                if (tracked.versionNumber.has_value() && executionState.has_value() &&
+                    executionState->VersionNumber.has_value())
+                {
+                    tracked.versionNumber = *executionState->VersionNumber;
+                }
+                return;
+            }
+
+            const auto &error = result.GetError();
+            if (s_isFinalRejection(error))
+            {
+                Remove(jobId);
+                return;
+            }
+
+            if (error.HasModeledError() && error.GetModeledError().Code.has_value() &&
+                *error.GetModeledError().Code == RejectedErrorCode::VersionMismatch)
+            {
+                /* Someone else updated the execution; adopt the current version if the service sent it */
+                const auto &executionState = error.GetModeledError().ExecutionState;
+                if (executionState.has_value() && executionState->VersionNumber.has_value())
+                {
+                    tracked.versionNumber = *executionState->VersionNumber;
+                }
+                else
+                {
+                    tracked.versionNumber.reset();
+                }
+            }
+        }
+
+        JobHeartbeatScheduler::JobHeartbeatScheduler(
+            std::shared_ptr<IClientV2> client,
+            const Aws::Crt::String &thingName,
+            const JobHeartbeatSchedulerOptions &options,
+            Aws::Crt::Allocator *allocator)
+            : m_state(Aws::Crt::MakeShared<JobHeartbeatSchedulerState>(
+                  allocator,
+                  std::move(client),
+                  thingName,
+                  options,
+                  allocator))
+        {
+        }
+
+        JobHeartbeatScheduler::~JobHeartbeatScheduler()
+        {
+            m_state->Stop();
+        }
+
+        bool JobHeartbeatScheduler::Track(
+            const Aws::Crt::String &jobId,
+            const Aws::Crt::Optional<int64_t> &executionNumber,
+            const Aws::Crt::Optional<int32_t> &versionNumber)
+        {
+            return m_state->Track(jobId, executionNumber, versionNumber);
+        }
+
+        void JobHeartbeatScheduler::Untrack(const Aws::Crt::String &jobId)
+        {
+            m_state->Untrack(jobId);
+        }
+
+        size_t JobHeartbeatScheduler::GetTrackedCount() const
+        {
+            return m_state->GetTrackedCount();
+        }
+
+        int64_t JobHeartbeatScheduler::GetStepTimeoutInMinutes() const
+        {
+            return m_state->GetStepTimeoutInMinutes();
+        }
+
+        JobHeartbeatScheduler::operator bool() const noexcept
+        {
+            return m_state->IsValid();
+        }
+
+    } // namespace Iotjobs
+} // namespace Aws
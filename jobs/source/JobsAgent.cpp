@@ -0,0 +1,601 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotjobs/JobsAgent.h>
+
+#include <aws/iotjobs/JobExecutionData.h>
+#include <aws/iotjobs/JobExecutionJournal.h>
+#include <aws/iotjobs/JobExecutor.h>
+#include <aws/iotjobs/JobHeartbeatScheduler.h>
+#include <aws/iotjobs/NextJobExecutionChangedEvent.h>
+#include <aws/iotjobs/NextJobExecutionChangedSubscriptionRequest.h>
+#include <aws/iotjobs/StartNextJobExecutionResponse.h>
+#include <aws/iotjobs/StartNextPendingJobExecutionRequest.h>
+#include <aws/iotjobs/UpdateJobExecutionRequest.h>
+#include <aws/iotjobs/UpdateJobExecutionResponse.h>
+#include <aws/iotjobs/V2ErrorResponse.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        static bool s_sameExecutionNumber(
+            const Aws::Crt::Optional<int64_t> &lhs,
+            const Aws::Crt::Optional<int64_t> &rhs)
+        {
+            if (lhs.has_value() != rhs.has_value())
+            {
+                return false;
+            }
+
+            return !lhs.has_value() || *lhs == *rhs;
+        }
+
+        class JobsAgentState : public std::enable_shared_from_this<JobsAgentState>
+        {
+          public:
+            JobsAgentState(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::String &operationKey,
+                Aws::Crt::Allocator *allocator)
+                : m_allocator(allocator), m_client(std::move(client)), m_thingName(thingName),
+                  m_operationKey(operationKey), m_running(false), m_startInFlight(false), m_startPending(false),
+                  m_executing(false), m_restartAfterUpdate(false)
+            {
+            }
+
+            void RegisterHandler(const Aws::Crt::String &operation, const JobHandler &handler)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_handlers[operation] = handler;
+            }
+
+            void SetDefaultHandler(const JobHandler &handler)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_defaultHandler = handler;
+            }
+
+            void SetErrorHandler(const JobsAgentErrorHandler &handler)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_errorHandler = handler;
+            }
+
+            void SetExecutor(std::shared_ptr<JobExecutor> executor)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_executor = std::move(executor);
+            }
+
+            void SetHeartbeatScheduler(std::shared_ptr<JobHeartbeatScheduler> heartbeatScheduler)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_heartbeatScheduler = std::move(heartbeatScheduler);
+            }
+
+            void SetJournal(std::shared_ptr<JobExecutionJournal> journal)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_journal = std::move(journal);
+            }
+
+            bool Start();
+
+            void Stop();
+
+          private:
+            void RequestNext();
+
+            void OnStartNextResult(StartNextPendingJobExecutionResult &&result);
+
+            void Dispatch(const JobExecutionData &execution);
+
+            void Finish(
+                const Aws::Crt::String &jobId,
+                const Aws::Crt::Optional<int64_t> &executionNumber,
+                JobStatus status,
+                const Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> &statusDetails);
+
+            void OnUpdateResult(
+                const Aws::Crt::String &jobId,
+                const Aws::Crt::Optional<int64_t> &executionNumber,
+                JobStatus status,
+                UpdateJobExecutionResult &&result);
+
+            void Journal(
+                const Aws::Crt::String &jobId,
+                const Aws::Crt::Optional<int64_t> &executionNumber,
+                JobStatus status,
+                const Aws::Crt::Optional<int32_t> &versionNumber,
+                const Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> &statusDetails);
+
+            void ReportError(int errorCode);
+
+            /* Requires the lock */
+            bool IsFinalizing(const Aws::Crt::String &jobId) const
+            {
+                return std::find(m_finalizing.begin(), m_finalizing.end(), jobId) != m_finalizing.end();
+            }
+
+            Aws::Crt::Allocator *m_allocator;
+            std::shared_ptr<IClientV2> m_client;
+            Aws::Crt::String m_thingName;
+            Aws::Crt::String m_operationKey;
+
+            std::mutex m_lock;
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> m_nextJobStream;
+            Aws::Crt::Map<Aws::Crt::String, JobHandler> m_handlers;
+            JobHandler m_defaultHandler;
+            JobsAgentErrorHandler m_errorHandler;
+            std::shared_ptr<JobExecutor> m_executor;
+            std::shared_ptr<JobHeartbeatScheduler> m_heartbeatScheduler;
+            std::shared_ptr<JobExecutionJournal> m_journal;
+
+            bool m_running;
+            /* A StartNextPendingJobExecution request is outstanding */
+            bool m_startInFlight;
+            /* The next job changed while a start request was outstanding; start again once it completes */
+            bool m_startPending;
+            /* A handler owns the current job */
+            bool m_executing;
+            /* The service returned a job whose final update is in flight; start again once the update completes */
+            bool m_restartAfterUpdate;
+            /* Jobs whose final update has been sent but not answered */
+            Aws::Crt::Vector<Aws::Crt::String> m_finalizing;
+            /* Most recent job whose final update was accepted */
+            Aws::Crt::String m_lastFinishedJobId;
+            Aws::Crt::Optional<int64_t> m_lastFinishedExecutionNumber;
+        };
+
+        bool JobsAgentState::Start()
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_running)
+                {
+                    return true;
+                }
+                m_running = true;
+            }
+
+            std::weak_ptr<JobsAgentState> weakState = shared_from_this();
+
+            Aws::Iot::RequestResponse::StreamingOperationOptions<NextJobExecutionChangedEvent> streamOptions;
+            streamOptions.WithStreamHandler(
+                [weakState](NextJobExecutionChangedEvent &&event)
+                {
+                    /* An event without an execution means the queue is empty */
+                    if (!event.Execution.has_value())
+                    {
+                        return;
+                    }
+
+                    if (auto state = weakState.lock())
+                    {
+                        state->RequestNext();
+                    }
+                });
+
+            NextJobExecutionChangedSubscriptionRequest request;
+            request.ThingName = m_thingName;
+            auto nextJobStream = m_client->CreateNextJobExecutionChangedStream(request, streamOptions);
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!nextJobStream)
+                {
+                    m_running = false;
+                    return false;
+                }
+
+                if (!m_running)
+                {
+                    /* Stopped while the stream was being created; the stream is released after the lock */
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                m_nextJobStream = nextJobStream;
+            }
+
+            nextJobStream->Open();
+            RequestNext();
+            return true;
+        }
+
+        void JobsAgentState::Stop()
+        {
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> nextJobStream;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_running = false;
+                nextJobStream = std::move(m_nextJobStream);
+            }
+
+            /* The stream is closed here, outside the lock */
+        }
+
+        void JobsAgentState::RequestNext()
+        {
+            std::shared_ptr<JobHeartbeatScheduler> heartbeatScheduler;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!m_running || m_executing)
+                {
+                    return;
+                }
+
+                if (m_startInFlight)
+                {
+                    m_startPending = true;
+                    return;
+                }
+
+                m_startInFlight = true;
+                m_startPending = false;
+                heartbeatScheduler = m_heartbeatScheduler;
+            }
+
+            StartNextPendingJobExecutionRequest request;
+            request.ThingName = m_thingName;
+            if (heartbeatScheduler)
+            {
+                request.StepTimeoutInMinutes = heartbeatScheduler->GetStepTimeoutInMinutes();
+            }
+
+            auto state = shared_from_this();
+            if (!m_client->StartNextPendingJobExecution(
+                    request,
+                    [state](StartNextPendingJobExecutionResult &&result)
+                    { state->OnStartNextResult(std::move(result)); }))
+            {
+                int errorCode = aws_last_error();
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_startInFlight = false;
+                }
+                ReportError(errorCode);
+            }
+        }
+
+        void JobsAgentState::OnStartNextResult(StartNextPendingJobExecutionResult &&result)
+        {
+            bool dispatch = false;
+            bool startAgain = false;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_startInFlight = false;
+                startAgain = m_startPending;
+                m_startPending = false;
+
+                if (result.IsSuccess() && m_running)
+                {
+                    const auto &execution = result.GetResponse().Execution;
+                    if (execution.has_value() && execution->JobId.has_value())
+                    {
+                        startAgain = false;
+                        if (IsFinalizing(*execution->JobId))
+                        {
+                            /* The service has not processed our update yet and handed the same job out again */
+                            m_restartAfterUpdate = true;
+                        }
+                        else if (
+                            *execution->JobId == m_lastFinishedJobId &&
+                            s_sameExecutionNumber(execution->ExecutionNumber, m_lastFinishedExecutionNumber))
+                        {
+                            /* Same race, but the update's response overtook this one; the update has landed now */
+                            startAgain = true;
+                        }
+                        else
+                        {
+                            m_executing = true;
+                            dispatch = true;
+                        }
+                    }
+                }
+            }
+
+            if (!result.IsSuccess())
+            {
+                ReportError(result.GetError().GetErrorCode());
+            }
+
+            if (dispatch)
+            {
+                Dispatch(*result.GetResponse().Execution);
+            }
+            else if (startAgain)
+            {
+                RequestNext();
+            }
+        }
+
+        void JobsAgentState::Dispatch(const JobExecutionData &execution)
+        {
+            Aws::Crt::String operation;
+            if (execution.JobDocument.has_value())
+            {
+                Aws::Crt::JsonView document = execution.JobDocument->View();
+                if (document.ValueExists(m_operationKey))
+                {
+                    operation = document.GetString(m_operationKey);
+                }
+            }
+
+            JobHandler handler;
+            std::shared_ptr<JobExecutor> executor;
+            std::shared_ptr<JobHeartbeatScheduler> heartbeatScheduler;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                auto iter = m_handlers.find(operation);
+                handler = iter != m_handlers.end() ? iter->second : m_defaultHandler;
+                executor = m_executor;
+                heartbeatScheduler = m_heartbeatScheduler;
+            }
+
+            auto state = shared_from_this();
+            auto completed = Aws::Crt::MakeShared<std::atomic<bool>>(m_allocator, false);
+            Aws::Crt::String jobId = *execution.JobId;
+            Aws::Crt::Optional<int64_t> executionNumber = execution.ExecutionNumber;
+            JobCompletionCallback complete =
+                [state, completed, jobId, executionNumber](
+                    JobStatus status, const Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> &statusDetails)
+            {
+                if (completed->exchange(true))
+                {
+                    return;
+                }
+
+                state->Finish(jobId, executionNumber, status, statusDetails);
+            };
+
+            if (!handler)
+            {
+                Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> statusDetails;
+                statusDetails["reason"] = "unsupported operation";
+                complete(JobStatus::REJECTED, statusDetails);
+                return;
+            }
+
+            if (heartbeatScheduler)
+            {
+                heartbeatScheduler->Track(jobId, executionNumber, execution.VersionNumber);
+            }
+
+            Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> statusDetails;
+            if (execution.StatusDetails.has_value())
+            {
+                statusDetails = *execution.StatusDetails;
+            }
+            Journal(jobId, executionNumber, JobStatus::IN_PROGRESS, execution.VersionNumber, statusDetails);
+
+            if (!executor)
+            {
+                handler(execution, complete);
+                return;
+            }
+
+            auto queued = Aws::Crt::MakeShared<JobExecutionData>(m_allocator, execution);
+            if (!executor->Submit(jobId, [handler, queued, complete]() { handler(*queued, complete); }))
+            {
+                ReportError(aws_last_error());
+
+                Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> statusDetails;
+                statusDetails["reason"] = "executor unavailable";
+                complete(JobStatus::FAILED, statusDetails);
+            }
+        }
+
+        void JobsAgentState::Finish(
+            const Aws::Crt::String &jobId,
+            const Aws::Crt::Optional<int64_t> &executionNumber,
+            JobStatus status,
+            const Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> &statusDetails)
+        {
+            std::shared_ptr<JobHeartbeatScheduler> heartbeatScheduler;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_executing = false;
+                m_finalizing.push_back(jobId);
+                heartbeatScheduler = m_heartbeatScheduler;
+            }
+
+            if (heartbeatScheduler)
+            {
+                heartbeatScheduler->Untrack(jobId);
+            }
+
+            UpdateJobExecutionRequest request;
+            request.ThingName = m_thingName;
+            request.JobId = jobId;
+            request.Status = status;
+            if (!statusDetails.empty())
+            {
+                request.StatusDetails = statusDetails;
+            }
+            if (executionNumber.has_value())
+            {
+                request.ExecutionNumber = *executionNumber;
+            }
+
+            auto state = shared_from_this();
+            if (!m_client->UpdateJobExecution(
+                    request,
+                    [state, jobId, executionNumber, status](UpdateJobExecutionResult &&result)
+                    { state->OnUpdateResult(jobId, executionNumber, status, std::move(result)); }))
+            {
+                int errorCode = aws_last_error();
+                OnUpdateResult(
+                    jobId,
+                    executionNumber,
+                    status,
+                    UpdateJobExecutionResult(ServiceErrorV2<V2ErrorResponse>(
+                        errorCode != AWS_ERROR_SUCCESS ? errorCode : AWS_ERROR_UNKNOWN)));
+            }
+
+            /* Pipelined: ask for the next job without waiting for the update to be acknowledged */
+            RequestNext();
+        }
+
+        void JobsAgentState::OnUpdateResult(
+            const Aws::Crt::String &jobId,
+            const Aws::Crt::Optional<int64_t> &executionNumber,
+            JobStatus status,
+            UpdateJobExecutionResult &&result)
+        {
+            bool restart = false;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                auto iter = std::find(m_finalizing.begin(), m_finalizing.end(), jobId);
+                if (iter != m_finalizing.end())
+                {
+                    m_finalizing.erase(iter);
+                }
+
+                if (result.IsSuccess())
+                {
+                    m_lastFinishedJobId = jobId;
+                    m_lastFinishedExecutionNumber = executionNumber;
+                }
+
+                restart = m_restartAfterUpdate;
+                m_restartAfterUpdate = false;
+            }
+
+            if (result.IsSuccess())
+            {
+                Journal(jobId, executionNumber, status, {}, {});
+            }
+            else
+            {
+                ReportError(result.GetError().GetErrorCode());
+            }
+
+            if (restart)
+            {
+                RequestNext();
+            }
+        }
+
+        void JobsAgentState::Journal(
+            const Aws::Crt::String &jobId,
+            const Aws::Crt::Optional<int64_t> &executionNumber,
+            JobStatus status,
+            const Aws::Crt::Optional<int32_t> &versionNumber,
+            const Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> &statusDetails)
+        {
+            std::shared_ptr<JobExecutionJournal> journal;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                journal = m_journal;
+            }
+
+            if (!journal)
+            {
+                return;
+            }
+
+            JournaledJobExecution execution;
+            execution.JobId = jobId;
+            execution.Status = status;
+            if (versionNumber.has_value())
+            {
+                execution.VersionNumber = *versionNumber;
+            }
+            if (executionNumber.has_value())
+            {
+                execution.ExecutionNumber = *executionNumber;
+            }
+            if (!statusDetails.empty())
+            {
+                execution.StatusDetails = statusDetails;
+            }
+
+            if (!journal->Record(execution))
+            {
+                ReportError(aws_last_error());
+            }
+        }
+
+        void JobsAgentState::ReportError(int errorCode)
+        {
+            JobsAgentErrorHandler errorHandler;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                errorHandler = m_errorHandler;
+            }
+
+            if (errorHandler)
+            {
+                errorHandler(errorCode);
+            }
+        }
+
+        JobsAgent::JobsAgent(
+            std::shared_ptr<IClientV2> client,
+            const Aws::Crt::String &thingName,
+            const Aws::Crt::String &operationKey,
+            Aws::Crt::Allocator *allocator)
+            : m_state(Aws::Crt::MakeShared<JobsAgentState>(
+                  allocator,
+                  std::move(client),
+                  thingName,
+                  operationKey,
+                  allocator))
+        {
+        }
+
+        JobsAgent::~JobsAgent()
+        {
+            m_state->Stop();
+        }
+
+        void JobsAgent::RegisterHandler(const Aws::Crt::String &operation, const JobHandler &handler)
+        {
+            m_state->RegisterHandler(operation, handler);
+        }
+
+        void JobsAgent::SetDefaultHandler(const JobHandler &handler)
+        {
+            m_state->SetDefaultHandler(handler);
+        }
+
+        void JobsAgent::SetErrorHandler(const JobsAgentErrorHandler &handler)
+        {
+            m_state->SetErrorHandler(handler);
+        }
+
+        void JobsAgent::SetExecutor(std::shared_ptr<JobExecutor> executor)
+        {
+            m_state->SetExecutor(std::move(executor));
+        }
+
+        void JobsAgent::SetHeartbeatScheduler(std::shared_ptr<JobHeartbeatScheduler> heartbeatScheduler)
+        {
+            m_state->SetHeartbeatScheduler(std::move(heartbeatScheduler));
+        }
+
+        void JobsAgent::SetJournal(std::shared_ptr<JobExecutionJournal> journal)
+        {
+            m_state->SetJournal(std::move(journal));
+        }
+
+        bool JobsAgent::Start()
+        {
+            return m_state->Start();
+        }
+
+        void JobsAgent::Stop()
+        {
+            m_state->Stop();
+        }
+
+    } // namespace Iotjobs
+} // namespace Aws
@@ -0,0 +1,394 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotjobs/JobsStateIndex.h>
+
+#include <aws/common/hash_table.h>
+
+#include <aws/iotjobs/GetPendingJobExecutionsRequest.h>
+#include <aws/iotjobs/GetPendingJobExecutionsResponse.h>
+#include <aws/iotjobs/JobExecutionsChangedEvent.h>
+#include <aws/iotjobs/JobExecutionsChangedSubscriptionRequest.h>
+#include <aws/iotjobs/V2ErrorResponse.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        template <typename T>
+        static bool s_sameValue(const Aws::Crt::Optional<T> &lhs, const Aws::Crt::Optional<T> &rhs)
+        {
+            if (lhs.has_value() != rhs.has_value())
+            {
+                return false;
+            }
+
+            return !lhs.has_value() || *lhs == *rhs;
+        }
+
+        struct JobIdHash
+        {
+            size_t operator()(const Aws::Crt::String &jobId) const
+            {
+                struct aws_byte_cursor cursor = aws_byte_cursor_from_array(jobId.data(), jobId.length());
+                return static_cast<size_t>(aws_hash_byte_cursor_ptr(&cursor));
+            }
+        };
+
+        struct IndexedJobExecution
+        {
+            JobStatus status;
+            JobExecutionSummary summary;
+            /* Snapshot that last contained the execution */
+            uint64_t generation;
+        };
+
+        /* A pending execution as listed by a snapshot */
+        struct SnapshotEntry
+        {
+            JobStatus status;
+            const JobExecutionSummary *summary;
+        };
+
+        using JobExecutionIndex = std::unordered_map<
+            Aws::Crt::String,
+            IndexedJobExecution,
+            JobIdHash,
+            std::equal_to<Aws::Crt::String>,
+            Aws::Crt::StlAllocator<std::pair<const Aws::Crt::String, IndexedJobExecution>>>;
+
+        class JobsStateIndexState : public std::enable_shared_from_this<JobsStateIndexState>
+        {
+          public:
+            JobsStateIndexState(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                Aws::Crt::Allocator *allocator)
+                : m_allocator(allocator), m_client(std::move(client)), m_thingName(thingName),
+                  m_index(
+                      0,
+                      JobIdHash(),
+                      std::equal_to<Aws::Crt::String>(),
+                      JobExecutionIndex::allocator_type(allocator)),
+                  m_running(false), m_generation(0), m_nextSubscriptionId(1)
+            {
+            }
+
+            bool Start();
+
+            void Stop();
+
+            void Apply(const JobExecutionsChangedEvent &event);
+
+            void Apply(const GetPendingJobExecutionsResponse &response);
+
+            uint64_t Subscribe(const JobsStateChangeHandler &handler)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                uint64_t subscriptionId = m_nextSubscriptionId++;
+                m_handlers[subscriptionId] = handler;
+                return subscriptionId;
+            }
+
+            void Unsubscribe(uint64_t subscriptionId)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_handlers.erase(subscriptionId);
+            }
+
+            Aws::Crt::Optional<JobStatus> GetStatus(const Aws::Crt::String &jobId) const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                auto iter = m_index.find(jobId);
+                if (iter == m_index.end())
+                {
+                    return {};
+                }
+
+                return iter->second.status;
+            }
+
+            size_t GetJobCount() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_index.size();
+            }
+
+          private:
+            void ApplySnapshot(
+                const Aws::Crt::Optional<Aws::Crt::DateTime> &timestamp,
+                const Aws::Crt::Vector<SnapshotEntry> &snapshot);
+
+            Aws::Crt::Allocator *m_allocator;
+            std::shared_ptr<IClientV2> m_client;
+            Aws::Crt::String m_thingName;
+
+            /* Serializes snapshots and the delivery of their changes */
+            std::mutex m_applyLock;
+            Aws::Crt::Optional<uint64_t> m_lastTimestampMillis;
+
+            mutable std::mutex m_lock;
+            bool m_running;
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> m_changesStream;
+            JobExecutionIndex m_index;
+            uint64_t m_generation;
+            Aws::Crt::Map<uint64_t, JobsStateChangeHandler> m_handlers;
+            uint64_t m_nextSubscriptionId;
+        };
+
+        bool JobsStateIndexState::Start()
+        {
+            if (!m_client)
+            {
+                aws_raise_error(AWS_ERROR_INVALID_STATE);
+                return false;
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (m_running)
+                {
+                    return true;
+                }
+                m_running = true;
+            }
+
+            std::weak_ptr<JobsStateIndexState> weakState = shared_from_this();
+
+            Aws::Iot::RequestResponse::StreamingOperationOptions<JobExecutionsChangedEvent> streamOptions;
+            streamOptions.WithStreamHandler(
+                [weakState](JobExecutionsChangedEvent &&event)
+                {
+                    if (auto state = weakState.lock())
+                    {
+                        state->Apply(event);
+                    }
+                });
+
+            JobExecutionsChangedSubscriptionRequest streamRequest;
+            streamRequest.ThingName = m_thingName;
+            auto changesStream = m_client->CreateJobExecutionsChangedStream(streamRequest, streamOptions);
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!changesStream)
+                {
+                    m_running = false;
+                    return false;
+                }
+
+                if (!m_running)
+                {
+                    /* Stopped while the stream was being created; the stream is released after the lock */
+                    aws_raise_error(AWS_ERROR_INVALID_STATE);
+                    return false;
+                }
+
+                m_changesStream = changesStream;
+            }
+
+            changesStream->Open();
+
+            GetPendingJobExecutionsRequest request;
+            request.ThingName = m_thingName;
+            return m_client->GetPendingJobExecutions(
+                request,
+                [weakState](GetPendingJobExecutionsResult &&result)
+                {
+                    auto state = weakState.lock();
+                    if (state && result.IsSuccess())
+                    {
+                        state->Apply(result.GetResponse());
+                    }
+                });
+        }
+
+        void JobsStateIndexState::Stop()
+        {
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> changesStream;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_running = false;
+                changesStream = std::move(m_changesStream);
+            }
+
+            /* The stream is closed here, outside the lock */
+        }
+
+        void JobsStateIndexState::Apply(const JobExecutionsChangedEvent &event)
+        {
+            Aws::Crt::Vector<SnapshotEntry> snapshot{Aws::Crt::StlAllocator<SnapshotEntry>(m_allocator)};
+            if (event.Jobs.has_value())
+            {
+                for (const auto &statusJobs : *event.Jobs)
+                {
+                    for (const auto &summary : statusJobs.second)
+                    {
+                        snapshot.push_back({statusJobs.first, &summary});
+                    }
+                }
+            }
+
+            ApplySnapshot(event.Timestamp, snapshot);
+        }
+
+        void JobsStateIndexState::Apply(const GetPendingJobExecutionsResponse &response)
+        {
+            Aws::Crt::Vector<SnapshotEntry> snapshot{Aws::Crt::StlAllocator<SnapshotEntry>(m_allocator)};
+            if (response.InProgressJobs.has_value())
+            {
+                for (const auto &summary : *response.InProgressJobs)
+                {
+                    snapshot.push_back({JobStatus::IN_PROGRESS, &summary});
+                }
+            }
+            if (response.QueuedJobs.has_value())
+            {
+                for (const auto &summary : *response.QueuedJobs)
+                {
+                    snapshot.push_back({JobStatus::QUEUED, &summary});
+                }
+            }
+
+            ApplySnapshot(response.Timestamp, snapshot);
+        }
+
+        void JobsStateIndexState::ApplySnapshot(
+            const Aws::Crt::Optional<Aws::Crt::DateTime> &timestamp,
+            const Aws::Crt::Vector<SnapshotEntry> &snapshot)
+        {
+            std::lock_guard<std::mutex> applyGuard(m_applyLock);
+
+            if (timestamp.has_value())
+            {
+                uint64_t timestampMillis = timestamp->Millis();
+                if (m_lastTimestampMillis.has_value() && timestampMillis < *m_lastTimestampMillis)
+                {
+                    return;
+                }
+                m_lastTimestampMillis = timestampMillis;
+            }
+
+            Aws::Crt::Vector<JobsStateChange> changes{Aws::Crt::StlAllocator<JobsStateChange>(m_allocator)};
+            Aws::Crt::Vector<JobsStateChangeHandler> handlers;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                uint64_t generation = ++m_generation;
+
+                for (const auto &entry : snapshot)
+                {
+                    if (!entry.summary->JobId.has_value())
+                    {
+                        continue;
+                    }
+
+                    const JobExecutionSummary &summary = *entry.summary;
+                    auto iter = m_index.find(*summary.JobId);
+                    if (iter == m_index.end())
+                    {
+                        IndexedJobExecution &indexed = m_index[*summary.JobId];
+                        indexed.status = entry.status;
+                        indexed.summary = summary;
+                        indexed.generation = generation;
+                        changes.push_back({JobsStateChangeType::Added, entry.status, summary});
+                        continue;
+                    }
+
+                    IndexedJobExecution &indexed = iter->second;
+                    indexed.generation = generation;
+                    if (indexed.status == entry.status &&
+                        s_sameValue(indexed.summary.VersionNumber, summary.VersionNumber) &&
+                        s_sameValue(indexed.summary.ExecutionNumber, summary.ExecutionNumber))
+                    {
+                        continue;
+                    }
+
+                    indexed.status = entry.status;
+                    indexed.summary = summary;
+                    changes.push_back({JobsStateChangeType::Changed, entry.status, summary});
+                }
+
+                /* Whatever this snapshot did not list is no longer pending */
+                for (auto iter = m_index.begin(); iter != m_index.end();)
+                {
+                    if (iter->second.generation == generation)
+                    {
+                        ++iter;
+                        continue;
+                    }
+
+                    changes.push_back({JobsStateChangeType::Removed, iter->second.status, iter->second.summary});
+                    iter = m_index.erase(iter);
+                }
+
+                if (changes.empty())
+                {
+                    return;
+                }
+
+                for (const auto &handler : m_handlers)
+                {
+                    handlers.push_back(handler.second);
+                }
+            }
+
+            for (const auto &handler : handlers)
+            {
+                handler(changes);
+            }
+        }
+
+        JobsStateIndex::JobsStateIndex(
+            std::shared_ptr<IClientV2> client,
+            const Aws::Crt::String &thingName,
+            Aws::Crt::Allocator *allocator)
+            : m_state(Aws::Crt::MakeShared<JobsStateIndexState>(allocator, std::move(client), thingName, allocator))
+        {
+        }
+
+        JobsStateIndex::~JobsStateIndex()
+        {
+            m_state->Stop();
+        }
+
+        bool JobsStateIndex::Start()
+        {
+            return m_state->Start();
+        }
+
+        void JobsStateIndex::Apply(const JobExecutionsChangedEvent &event)
+        {
+            m_state->Apply(event);
+        }
+
+        void JobsStateIndex::Apply(const GetPendingJobExecutionsResponse &response)
+        {
+            m_state->Apply(response);
+        }
+
+        uint64_t JobsStateIndex::Subscribe(const JobsStateChangeHandler &handler)
+        {
+            return m_state->Subscribe(handler);
+        }
+
+        void JobsStateIndex::Unsubscribe(uint64_t subscriptionId)
+        {
+            m_state->Unsubscribe(subscriptionId);
+        }
+
+        Aws::Crt::Optional<JobStatus> JobsStateIndex::GetStatus(const Aws::Crt::String &jobId) const
+        {
+            return m_state->GetStatus(jobId);
+        }
+
+        size_t JobsStateIndex::GetJobCount() const
+        {
+            return m_state->GetJobCount();
+        }
+
+    } // namespace Iotjobs
+} // namespace Aws
@@ -0,0 +1,292 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotjobs/RawJobDocument.h>
+
+#include <aws/common/file.h>
+
+#include <aws/iotdevicecommon/JsonStreamParser.h>
+
+#include <cerrno>
+#include <cstdio>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        /*
+         * Finds the byte range of the "jobDocument" member of the top-level "execution" object.  Parsing is aborted
+         * as soon as the range is known or known to be absent.
+         */
+        class JobDocumentLocator : public Aws::Iotdevicecommon::IJsonStreamHandler
+        {
+          public:
+            JobDocumentLocator() = default;
+
+            void SetParser(const Aws::Iotdevicecommon::JsonStreamParser *parser) { m_parser = parser; }
+
+            bool IsFound() const { return m_stage == Stage::Found; }
+
+            size_t GetStart() const { return m_start; }
+
+            size_t GetEnd() const { return m_end; }
+
+            bool OnBeginObject() override { return BeginContainer(true); }
+
+            bool OnEndObject() override { return EndContainer(); }
+
+            bool OnBeginArray() override { return BeginContainer(false); }
+
+            bool OnEndArray() override { return EndContainer(); }
+
+            bool OnKey(struct aws_byte_cursor key) override
+            {
+                if (m_stage == Stage::Root && m_depth == 1 && aws_byte_cursor_eq_c_str(&key, "execution"))
+                {
+                    m_stage = Stage::ExecutionKey;
+                }
+                else if (m_stage == Stage::Execution && m_depth == 2 && aws_byte_cursor_eq_c_str(&key, "jobDocument"))
+                {
+                    m_stage = Stage::DocumentKey;
+                }
+
+                return true;
+            }
+
+            bool OnString(struct aws_byte_cursor) override { return Scalar(); }
+
+            bool OnNumber(struct aws_byte_cursor) override { return Scalar(); }
+
+            bool OnBool(bool) override { return Scalar(); }
+
+            bool OnNull() override { return Scalar(); }
+
+          private:
+            enum class Stage
+            {
+                Root,
+                ExecutionKey,
+                Execution,
+                DocumentKey,
+                Document,
+                Found,
+            };
+
+            bool BeginContainer(bool isObject)
+            {
+                if (m_stage == Stage::ExecutionKey || m_stage == Stage::DocumentKey)
+                {
+                    if (!isObject)
+                    {
+                        return false;
+                    }
+
+                    if (m_stage == Stage::DocumentKey)
+                    {
+                        m_start = m_parser->GetTokenStart();
+                        m_documentDepth = m_depth;
+                    }
+                    m_stage = m_stage == Stage::ExecutionKey ? Stage::Execution : Stage::Document;
+                }
+
+                ++m_depth;
+                return true;
+            }
+
+            bool EndContainer()
+            {
+                --m_depth;
+                if (m_stage == Stage::Document && m_depth == m_documentDepth)
+                {
+                    m_end = m_parser->GetOffset() + 1;
+                    m_stage = Stage::Found;
+                    return false;
+                }
+
+                /* The execution ended without a job document */
+                return !(m_stage == Stage::Execution && m_depth == 1);
+            }
+
+            bool Scalar() { return m_stage != Stage::ExecutionKey && m_stage != Stage::DocumentKey; }
+
+            const Aws::Iotdevicecommon::JsonStreamParser *m_parser = nullptr;
+            Stage m_stage = Stage::Root;
+            size_t m_depth = 0;
+            size_t m_documentDepth = 0;
+            size_t m_start = 0;
+            size_t m_end = 0;
+        };
+
+        RawJobDocument::RawJobDocument(struct aws_byte_cursor json, Aws::Crt::Allocator *allocator)
+            : m_allocator(allocator)
+        {
+            AWS_ZERO_STRUCT(m_bytes);
+            aws_byte_buf_init_copy_from_cursor(&m_bytes, allocator, json);
+            m_size = m_bytes.len;
+        }
+
+        RawJobDocument::~RawJobDocument()
+        {
+            aws_byte_buf_clean_up(&m_bytes);
+        }
+
+        std::shared_ptr<RawJobDocument> RawJobDocument::ExtractFromExecution(
+            struct aws_byte_cursor payload,
+            Aws::Crt::String &remainder,
+            Aws::Crt::Allocator *allocator)
+        {
+            JobDocumentLocator locator;
+            Aws::Iotdevicecommon::JsonStreamParser parser(locator, allocator);
+            locator.SetParser(&parser);
+
+            /* Stops early once the document is located; the remainder is validated by whoever parses it */
+            parser.Feed(payload);
+            if (!locator.IsFound())
+            {
+                return nullptr;
+            }
+
+            size_t start = locator.GetStart();
+            size_t end = locator.GetEnd();
+            const char *text = reinterpret_cast<const char *>(payload.ptr);
+
+            remainder.clear();
+            remainder.reserve(payload.len - (end - start) + 4);
+            remainder.append(text, start);
+            remainder.append("null");
+            remainder.append(text + end, payload.len - end);
+
+            return Aws::Crt::MakeShared<RawJobDocument>(
+                allocator, aws_byte_cursor_from_array(payload.ptr + start, end - start), allocator);
+        }
+
+        size_t RawJobDocument::GetSize() const
+        {
+            return m_size;
+        }
+
+        struct aws_byte_cursor RawJobDocument::GetBytes() const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return aws_byte_cursor_from_buf(&m_bytes);
+        }
+
+        Aws::Crt::JsonView RawJobDocument::View() const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (m_json.has_value())
+            {
+                return m_json->View();
+            }
+
+            if (m_path.empty())
+            {
+                Aws::Crt::String text(reinterpret_cast<const char *>(m_bytes.buffer), m_bytes.len);
+                m_json = Aws::Crt::JsonObject(text);
+                return m_json->View();
+            }
+
+            struct aws_byte_buf contents;
+            AWS_ZERO_STRUCT(contents);
+            if (aws_byte_buf_init_from_file(&contents, m_allocator, m_path.c_str()) == AWS_OP_SUCCESS)
+            {
+                Aws::Crt::String text(reinterpret_cast<const char *>(contents.buffer), contents.len);
+                m_json = Aws::Crt::JsonObject(text);
+            }
+            else
+            {
+                m_json = Aws::Crt::JsonObject();
+            }
+            aws_byte_buf_clean_up(&contents);
+
+            return m_json->View();
+        }
+
+        bool RawJobDocument::Stream(Aws::Iotdevicecommon::IJsonStreamHandler &handler, size_t chunkSize) const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            Aws::Iotdevicecommon::JsonStreamParser parser(handler, m_allocator);
+            if (m_path.empty())
+            {
+                return parser.Feed(aws_byte_cursor_from_buf(&m_bytes)) && parser.Finish();
+            }
+
+            FILE *file = aws_fopen(m_path.c_str(), "rb");
+            if (file == nullptr)
+            {
+                return false;
+            }
+
+            struct aws_byte_buf chunk;
+            if (aws_byte_buf_init(&chunk, m_allocator, chunkSize > 0 ? chunkSize : 1) != AWS_OP_SUCCESS)
+            {
+                fclose(file);
+                return false;
+            }
+
+            bool success = true;
+            while (success)
+            {
+                size_t bytesRead = fread(chunk.buffer, 1, chunk.capacity, file);
+                if (bytesRead == 0)
+                {
+                    if (ferror(file))
+                    {
+                        aws_translate_and_raise_io_error(errno);
+                        success = false;
+                    }
+                    break;
+                }
+
+                success = parser.Feed(aws_byte_cursor_from_array(chunk.buffer, bytesRead));
+            }
+
+            fclose(file);
+            aws_byte_buf_clean_up(&chunk);
+
+            return success && parser.Finish();
+        }
+
+        bool RawJobDocument::SpillToFile(const Aws::Crt::String &path)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (!m_path.empty())
+            {
+                aws_raise_error(AWS_ERROR_INVALID_STATE);
+                return false;
+            }
+
+            FILE *file = aws_fopen(path.c_str(), "wb");
+            if (file == nullptr)
+            {
+                return false;
+            }
+
+            bool written = m_bytes.len == 0 || fwrite(m_bytes.buffer, 1, m_bytes.len, file) == m_bytes.len;
+            if (fclose(file) != 0)
+            {
+                written = false;
+            }
+
+            if (!written)
+            {
+                aws_translate_and_raise_io_error(errno);
+                return false;
+            }
+
+            aws_byte_buf_clean_up(&m_bytes);
+            m_path = path;
+            m_json.reset();
+            return true;
+        }
+
+        bool RawJobDocument::IsSpilled() const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return !m_path.empty();
+        }
+
+    } // namespace Iotjobs
+} // namespace Aws
@@ -5,6 +5,8 @@
  */
 #include <aws/iotjobs/StartNextPendingJobExecutionRequest.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotjobs
@@ -67,6 +69,31 @@ namespace Aws
             }
         }
 
+        void StartNextPendingJobExecutionRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (ClientToken)
+            {
+                writer.WithString("clientToken", *ClientToken);
+            }
+
+            if (StepTimeoutInMinutes)
+            {
+                writer.WithInt64("stepTimeoutInMinutes", *StepTimeoutInMinutes);
+            }
+
+            if (StatusDetails)
+            {
+                writer.BeginObject("statusDetails");
+                for (auto &statusDetailsMapMember : *StatusDetails)
+                {
+                    writer.WithString(statusDetailsMapMember.first, statusDetailsMapMember.second);
+                }
+                writer.EndObject();
+            }
+        }
+
         StartNextPendingJobExecutionRequest::StartNextPendingJobExecutionRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
@@ -0,0 +1,264 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotjobs/StatusDetailsBuilder.h>
+
+#include <aws/crt/JsonObject.h>
+#include <aws/iotdevicecommon/JsonWriter.h>
+
+#include <cstring>
+
+namespace Aws
+{
+    namespace Iotjobs
+    {
+
+        const Aws::Crt::String &StatusDetailKey::GetName() const
+        {
+            static const Aws::Crt::String s_empty;
+            return m_name != nullptr ? *m_name : s_empty;
+        }
+
+        StatusDetailsKeyTable::StatusDetailsKeyTable(Aws::Crt::Allocator *allocator)
+            : m_keys(std::less<Aws::Crt::String>(), Aws::Crt::StlAllocator<Aws::Crt::String>(allocator))
+        {
+        }
+
+        StatusDetailKey StatusDetailsKeyTable::Intern(const Aws::Crt::String &name)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            /* Set nodes never move, so the address of the name identifies the key */
+            return StatusDetailKey(&*m_keys.insert(name).first);
+        }
+
+        StatusDetailsBuilder::StatusDetailsBuilder(Aws::Crt::Allocator *allocator)
+            : m_allocator(allocator), m_entries(Aws::Crt::StlAllocator<Entry>(allocator)), m_liveLength(0)
+        {
+            AWS_ZERO_STRUCT(m_values);
+        }
+
+        StatusDetailsBuilder::StatusDetailsBuilder(const StatusDetailsBuilder &other)
+            : m_allocator(other.m_allocator), m_entries(Aws::Crt::StlAllocator<Entry>(other.m_allocator)),
+              m_liveLength(0)
+        {
+            AWS_ZERO_STRUCT(m_values);
+            CopyFrom(other);
+        }
+
+        StatusDetailsBuilder::StatusDetailsBuilder(StatusDetailsBuilder &&other) noexcept
+            : m_allocator(other.m_allocator), m_entries(std::move(other.m_entries)), m_values(other.m_values),
+              m_liveLength(other.m_liveLength)
+        {
+            AWS_ZERO_STRUCT(other.m_values);
+            other.m_entries.clear();
+            other.m_liveLength = 0;
+        }
+
+        StatusDetailsBuilder::~StatusDetailsBuilder()
+        {
+            aws_byte_buf_clean_up(&m_values);
+        }
+
+        StatusDetailsBuilder &StatusDetailsBuilder::operator=(const StatusDetailsBuilder &other)
+        {
+            if (this != &other)
+            {
+                CopyFrom(other);
+            }
+            return *this;
+        }
+
+        StatusDetailsBuilder &StatusDetailsBuilder::operator=(StatusDetailsBuilder &&other) noexcept
+        {
+            if (this != &other)
+            {
+                aws_byte_buf_clean_up(&m_values);
+                m_allocator = other.m_allocator;
+                m_entries = std::move(other.m_entries);
+                m_values = other.m_values;
+                m_liveLength = other.m_liveLength;
+                AWS_ZERO_STRUCT(other.m_values);
+                other.m_entries.clear();
+                other.m_liveLength = 0;
+            }
+            return *this;
+        }
+
+        StatusDetailsBuilder &StatusDetailsBuilder::Set(const StatusDetailKey &key, struct aws_byte_cursor value)
+        {
+            if (key.m_name == nullptr)
+            {
+                return *this;
+            }
+
+            if (m_values.buffer == nullptr && aws_byte_buf_init(&m_values, m_allocator, 256) != AWS_OP_SUCCESS)
+            {
+                return *this;
+            }
+
+            Entry *entry = nullptr;
+            for (auto &candidate : m_entries)
+            {
+                if (candidate.key == key.m_name)
+                {
+                    entry = &candidate;
+                    break;
+                }
+            }
+
+            /* A value that fits where the previous one was is overwritten in place */
+            if (entry != nullptr && value.len <= entry->length)
+            {
+                if (value.len > 0)
+                {
+                    memcpy(m_values.buffer + entry->offset, value.ptr, value.len);
+                }
+                m_liveLength -= entry->length - value.len;
+                entry->length = value.len;
+                return *this;
+            }
+
+            size_t offset = m_values.len;
+            if (aws_byte_buf_append_dynamic(&m_values, &value) != AWS_OP_SUCCESS)
+            {
+                return *this;
+            }
+
+            m_liveLength += value.len;
+            if (entry != nullptr)
+            {
+                m_liveLength -= entry->length;
+                entry->offset = offset;
+                entry->length = value.len;
+            }
+            else
+            {
+                m_entries.push_back({key.m_name, offset, value.len});
+            }
+
+            /* Values that keep growing abandon their old ranges; reclaim them once they outweigh the live values */
+            if (m_values.len - m_liveLength > m_liveLength)
+            {
+                Compact();
+            }
+
+            return *this;
+        }
+
+        StatusDetailsBuilder &StatusDetailsBuilder::Set(const StatusDetailKey &key, const Aws::Crt::String &value)
+        {
+            return Set(key, aws_byte_cursor_from_array(value.data(), value.length()));
+        }
+
+        StatusDetailsBuilder &StatusDetailsBuilder::Set(const StatusDetailKey &key, const char *value)
+        {
+            return Set(key, aws_byte_cursor_from_c_str(value));
+        }
+
+        StatusDetailsBuilder &StatusDetailsBuilder::SetInt64(const StatusDetailKey &key, int64_t value)
+        {
+            char digits[21];
+            size_t start = sizeof(digits);
+            uint64_t magnitude = static_cast<uint64_t>(value);
+            if (value < 0)
+            {
+                magnitude = static_cast<uint64_t>(0) - magnitude;
+            }
+            do
+            {
+                digits[--start] = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0);
+
+            if (value < 0)
+            {
+                digits[--start] = '-';
+            }
+
+            return Set(key, aws_byte_cursor_from_array(digits + start, sizeof(digits) - start));
+        }
+
+        void StatusDetailsBuilder::Clear()
+        {
+            m_entries.clear();
+            m_values.len = 0;
+            m_liveLength = 0;
+        }
+
+        void StatusDetailsBuilder::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            for (const auto &entry : m_entries)
+            {
+                writer.WithString(*entry.key, GetValue(entry));
+            }
+        }
+
+        Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> StatusDetailsBuilder::ToMap() const
+        {
+            Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> statusDetails;
+            for (const auto &entry : m_entries)
+            {
+                struct aws_byte_cursor value = GetValue(entry);
+                statusDetails[*entry.key] = Aws::Crt::String(reinterpret_cast<const char *>(value.ptr), value.len);
+            }
+
+            return statusDetails;
+        }
+
+        struct aws_byte_cursor StatusDetailsBuilder::GetValue(const Entry &entry) const
+        {
+            return aws_byte_cursor_from_array(m_values.buffer + entry.offset, entry.length);
+        }
+
+        /* Copies only the live values, so the copy starts without abandoned ranges.  Left empty on failure. */
+        void StatusDetailsBuilder::CopyFrom(const StatusDetailsBuilder &other)
+        {
+            Clear();
+            if (other.m_entries.empty())
+            {
+                return;
+            }
+
+            if (m_values.buffer == nullptr &&
+                aws_byte_buf_init(&m_values, m_allocator, other.m_liveLength) != AWS_OP_SUCCESS)
+            {
+                return;
+            }
+
+            for (const auto &entry : other.m_entries)
+            {
+                struct aws_byte_cursor value = other.GetValue(entry);
+                if (aws_byte_buf_append_dynamic(&m_values, &value) != AWS_OP_SUCCESS)
+                {
+                    Clear();
+                    return;
+                }
+                m_entries.push_back({entry.key, m_values.len - value.len, value.len});
+            }
+
+            m_liveLength = other.m_liveLength;
+        }
+
+        /* Moves the live values into a fresh buffer of the same capacity; keeps the current one on failure */
+        void StatusDetailsBuilder::Compact()
+        {
+            struct aws_byte_buf values;
+            if (aws_byte_buf_init(&values, m_allocator, m_values.capacity) != AWS_OP_SUCCESS)
+            {
+                return;
+            }
+
+            for (auto &entry : m_entries)
+            {
+                struct aws_byte_cursor value = GetValue(entry);
+                entry.offset = values.len;
+                aws_byte_buf_append(&values, &value);
+            }
+
+            aws_byte_buf_clean_up(&m_values);
+            m_values = values;
+        }
+
+    } // namespace Iotjobs
+} // namespace Aws
@@ -5,6 +5,8 @@
  */
 #include <aws/iotjobs/UpdateJobExecutionRequest.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotjobs
@@ -115,6 +117,56 @@ namespace Aws
             }
         }
 
+        void UpdateJobExecutionRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (Status)
+            {
+                writer.WithString("status", JobStatusMarshaller::ToString(*Status));
+            }
+
+            if (ClientToken)
+            {
+                writer.WithString("clientToken", *ClientToken);
+            }
+
+            if (StatusDetails)
+            {
+                writer.BeginObject("statusDetails");
+                for (auto &statusDetailsMapMember : *StatusDetails)
+                {
+                    writer.WithString(statusDetailsMapMember.first, statusDetailsMapMember.second);
+                }
+                writer.EndObject();
+            }
+
+            if (ExpectedVersion)
+            {
+                writer.WithInteger("expectedVersion", *ExpectedVersion);
+            }
+
+            if (ExecutionNumber)
+            {
+                writer.WithInt64("executionNumber", *ExecutionNumber);
+            }
+
+            if (IncludeJobExecutionState)
+            {
+                writer.WithBool("includeJobExecutionState", *IncludeJobExecutionState);
+            }
+
+            if (IncludeJobDocument)
+            {
+                writer.WithBool("includeJobDocument", *IncludeJobDocument);
+            }
+
+            if (StepTimeoutInMinutes)
+            {
+                writer.WithInt64("stepTimeoutInMinutes", *StepTimeoutInMinutes);
+            }
+        }
+
         UpdateJobExecutionRequest::UpdateJobExecutionRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
@@ -0,0 +1,160 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/common/file.h>
+#include <aws/common/string.h>
+
+#include <aws/iotjobs/JobExecutionJournal.h>
+
+#include <cstdio>
+
+using namespace Aws::Iotjobs;
+
+static JournaledJobExecution s_makeExecution(const char *jobId, JobStatus status, int32_t versionNumber)
+{
+    JournaledJobExecution execution;
+    execution.JobId = jobId;
+    execution.Status = status;
+    execution.VersionNumber = versionNumber;
+    execution.ExecutionNumber = 1;
+    return execution;
+}
+
+static int s_JobExecutionJournalReplay(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        const char *path = "job_execution_journal_test.log";
+        std::remove(path);
+
+        {
+            JobExecutionJournal journal(path, allocator);
+            ASSERT_TRUE(journal.Open());
+            ASSERT_TRUE(journal.Record(s_makeExecution("job-1", JobStatus::IN_PROGRESS, 2)));
+
+            JournaledJobExecution progress = s_makeExecution("job-2", JobStatus::IN_PROGRESS, 5);
+            Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String> statusDetails;
+            statusDetails["step"] = "3";
+            progress.StatusDetails = statusDetails;
+            ASSERT_TRUE(journal.Record(progress));
+
+            ASSERT_TRUE(journal.Record(s_makeExecution("job-1", JobStatus::SUCCEEDED, 3)));
+            ASSERT_INT_EQUALS(1, journal.GetExecutions().size());
+        }
+
+        /* A crash in the middle of a write leaves a torn line behind */
+        FILE *file = fopen(path, "ab");
+        ASSERT_NOT_NULL(file);
+        fputs("{\"jobId\":\"job-3\",\"sta", file);
+        fclose(file);
+
+        {
+            JobExecutionJournal journal(path, allocator);
+            ASSERT_TRUE(journal.Open());
+
+            auto executions = journal.GetExecutions();
+            ASSERT_INT_EQUALS(1, executions.size());
+            ASSERT_TRUE(executions[0].JobId == "job-2");
+            ASSERT_TRUE(executions[0].Status == JobStatus::IN_PROGRESS);
+            ASSERT_INT_EQUALS(5, *executions[0].VersionNumber);
+            ASSERT_INT_EQUALS(1, *executions[0].ExecutionNumber);
+            ASSERT_TRUE((*executions[0].StatusDetails)["step"] == "3");
+            ASSERT_FALSE(journal.GetExecution("job-1").has_value());
+
+            ASSERT_TRUE(journal.Record(s_makeExecution("job-2", JobStatus::FAILED, 6)));
+        }
+
+        JobExecutionJournal journal(path, allocator);
+        ASSERT_TRUE(journal.Open());
+        ASSERT_INT_EQUALS(0, journal.GetExecutions().size());
+    }
+
+    std::remove("job_execution_journal_test.log");
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobExecutionJournalReplay, s_JobExecutionJournalReplay)
+
+static int s_JobExecutionJournalTornTail(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        const char *path = "job_execution_journal_torn_test.log";
+        std::remove(path);
+
+        {
+            JobExecutionJournal journal(path, allocator);
+            ASSERT_TRUE(journal.Open());
+            ASSERT_TRUE(journal.Record(s_makeExecution("job-1", JobStatus::IN_PROGRESS, 1)));
+        }
+
+        /* An append that never got its newline is dropped, even when the JSON itself is complete */
+        FILE *file = fopen(path, "ab");
+        ASSERT_NOT_NULL(file);
+        fputs("{\"jobId\":\"job-2\",\"status\":\"IN_PROGRESS\"}", file);
+        fclose(file);
+
+        {
+            JobExecutionJournal journal(path, allocator);
+            ASSERT_TRUE(journal.Open());
+            ASSERT_INT_EQUALS(1, journal.GetExecutions().size());
+            ASSERT_FALSE(journal.GetExecution("job-2").has_value());
+
+            /* The tail is gone from the file, so the next transition is not glued onto it */
+            struct aws_byte_buf contents;
+            ASSERT_SUCCESS(aws_byte_buf_init_from_file(&contents, allocator, path));
+            ASSERT_TRUE(contents.len > 0);
+            ASSERT_UINT_EQUALS('\n', contents.buffer[contents.len - 1]);
+            aws_byte_buf_clean_up(&contents);
+
+            ASSERT_TRUE(journal.Record(s_makeExecution("job-3", JobStatus::IN_PROGRESS, 1)));
+        }
+
+        JobExecutionJournal journal(path, allocator);
+        ASSERT_TRUE(journal.Open());
+        ASSERT_INT_EQUALS(2, journal.GetExecutions().size());
+        ASSERT_TRUE(journal.GetExecution("job-1").has_value());
+        ASSERT_TRUE(journal.GetExecution("job-3").has_value());
+    }
+
+    std::remove("job_execution_journal_torn_test.log");
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobExecutionJournalTornTail, s_JobExecutionJournalTornTail)
+
+static int s_JobExecutionJournalUnreadable(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        /* A directory stands in for a journal that exists but cannot be read */
+        struct aws_string *path = aws_string_new_from_c_str(allocator, "job_execution_journal_unreadable");
+        ASSERT_NOT_NULL(path);
+        ASSERT_SUCCESS(aws_directory_create(path));
+
+        {
+            JobExecutionJournal journal(aws_string_c_str(path), allocator);
+            ASSERT_FALSE(journal.Open());
+            ASSERT_FALSE(journal.Record(s_makeExecution("job-1", JobStatus::IN_PROGRESS, 1)));
+        }
+
+        /* Compacting would have replaced it with an empty journal */
+        ASSERT_TRUE(aws_directory_exists(path));
+
+        aws_directory_delete(path, true);
+        aws_string_destroy(path);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobExecutionJournalUnreadable, s_JobExecutionJournalUnreadable)
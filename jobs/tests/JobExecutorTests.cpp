@@ -0,0 +1,121 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotjobs/JobExecutor.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+
+using namespace Aws::Iotjobs;
+
+static int s_JobExecutorKeySerialization(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        std::mutex logLock;
+        std::vector<int> jobLog;
+        auto record = [&logLock, &jobLog](int step)
+        {
+            std::lock_guard<std::mutex> guard(logLock);
+            jobLog.push_back(step);
+        };
+
+        std::promise<void> gate;
+        std::shared_future<void> released = gate.get_future().share();
+        std::promise<void> firstStarted;
+        std::promise<void> secondStarted;
+
+        {
+            JobExecutor executor(2, 4, JobExecutorOverflowPolicy::Reject, allocator);
+
+            /* Occupy both workers with different keys, proving they run concurrently */
+            ASSERT_TRUE(executor.Submit(
+                "job-1",
+                [&]()
+                {
+                    firstStarted.set_value();
+                    released.wait();
+                    record(1);
+                }));
+            ASSERT_TRUE(executor.Submit(
+                "job-2",
+                [&]()
+                {
+                    secondStarted.set_value();
+                    released.wait();
+                }));
+            firstStarted.get_future().wait();
+            secondStarted.get_future().wait();
+
+            /* Further steps of job-1 wait for the running one; the queue holds four tasks */
+            ASSERT_TRUE(executor.Submit("job-1", [&]() { record(2); }));
+            ASSERT_TRUE(executor.Submit("job-1", [&]() { record(3); }));
+            ASSERT_TRUE(executor.Submit("job-3", []() {}));
+            ASSERT_TRUE(executor.Submit("job-3", []() {}));
+            ASSERT_INT_EQUALS(4, executor.GetQueuedTaskCount());
+
+            ASSERT_FALSE(executor.Submit("job-4", []() {}));
+            ASSERT_INT_EQUALS(AWS_ERROR_LIST_EXCEEDS_MAX_SIZE, aws_last_error());
+
+            gate.set_value();
+        }
+
+        /* Destruction drains the queue */
+        ASSERT_INT_EQUALS(3, jobLog.size());
+        ASSERT_INT_EQUALS(1, jobLog[0]);
+        ASSERT_INT_EQUALS(2, jobLog[1]);
+        ASSERT_INT_EQUALS(3, jobLog[2]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobExecutorKeySerialization, s_JobExecutorKeySerialization)
+
+static int s_JobExecutorShutdownFromWorker(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto executor = std::make_shared<JobExecutor>(2, 4, JobExecutorOverflowPolicy::Reject, allocator);
+
+        std::promise<void> gate;
+        std::shared_future<void> released = gate.get_future().share();
+        std::promise<void> destroyed;
+        std::atomic<bool> droppedTaskRan(false);
+        auto droppedTaskCapture = std::make_shared<int>(0);
+
+        /*
+         * The running task drops the last reference while another task of its own key is queued behind it.  The
+         * other worker could not run that task, so draining the queue would never finish.
+         */
+        ASSERT_TRUE(executor->Submit(
+            "job-1",
+            [&executor, &destroyed, released]()
+            {
+                released.wait();
+                executor.reset();
+                destroyed.set_value();
+            }));
+        ASSERT_TRUE(executor->Submit("job-1", [&droppedTaskRan, droppedTaskCapture]() { droppedTaskRan = true; }));
+        gate.set_value();
+
+        std::future<void> done = destroyed.get_future();
+        ASSERT_TRUE(done.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        ASSERT_FALSE(droppedTaskRan);
+        ASSERT_INT_EQUALS(1, droppedTaskCapture.use_count());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobExecutorShutdownFromWorker, s_JobExecutorShutdownFromWorker)
@@ -0,0 +1,164 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/crt/io/EventLoopGroup.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotjobs/JobHeartbeatScheduler.h>
+#include <aws/iotjobs/RejectedErrorCode.h>
+
+#include "RecordingJobsClient.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace Aws::Iotjobs;
+
+static JobHeartbeatSchedulerOptions s_heartbeatOptions(Aws::Crt::Io::EventLoopGroup &eventLoopGroup)
+{
+    /* Five wheel slots of 20ms */
+    return JobHeartbeatSchedulerOptions()
+        .WithStepTimeout(std::chrono::minutes(1))
+        .WithHeartbeatInterval(std::chrono::milliseconds(100))
+        .WithTickInterval(std::chrono::milliseconds(20))
+        .WithEventLoopGroup(eventLoopGroup);
+}
+
+static int s_JobHeartbeatSchedulerCadence(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        auto client = std::make_shared<RecordingJobsClient>();
+        client->autoAccept = true;
+        JobHeartbeatScheduler scheduler(client, "thing", s_heartbeatOptions(eventLoopGroup), allocator);
+        ASSERT_TRUE(scheduler);
+
+        ASSERT_TRUE(scheduler.Track("versioned", 7, 1));
+        ASSERT_TRUE(scheduler.Track("unversioned"));
+        ASSERT_INT_EQUALS(2, scheduler.GetTrackedCount());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(550));
+        scheduler.Untrack("versioned");
+        scheduler.Untrack("unversioned");
+        ASSERT_INT_EQUALS(0, scheduler.GetTrackedCount());
+
+        /* Roughly one heartbeat per execution and interval, never more than one per tick */
+        size_t heartbeats = client->GetUpdateCount();
+        ASSERT_TRUE(heartbeats >= 6);
+        ASSERT_TRUE(heartbeats <= 12);
+
+        int32_t expectedVersion = 1;
+        for (size_t i = 0; i < heartbeats; ++i)
+        {
+            UpdateJobExecutionRequest request = client->GetUpdate(i);
+            ASSERT_TRUE(*request.ThingName == "thing");
+            ASSERT_TRUE(*request.Status == JobStatus::IN_PROGRESS);
+            ASSERT_INT_EQUALS(1, *request.StepTimeoutInMinutes);
+            if (*request.JobId == "versioned")
+            {
+                /* Each heartbeat expects the version the previous response reported */
+                ASSERT_INT_EQUALS(7, *request.ExecutionNumber);
+                ASSERT_INT_EQUALS(expectedVersion, *request.ExpectedVersion);
+                ++expectedVersion;
+            }
+            else
+            {
+                ASSERT_FALSE(request.ExecutionNumber.has_value());
+                ASSERT_FALSE(request.ExpectedVersion.has_value());
+            }
+        }
+        ASSERT_TRUE(expectedVersion > 3);
+
+        /* Untracked executions get no further heartbeats */
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        ASSERT_INT_EQUALS(heartbeats, client->GetUpdateCount());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobHeartbeatSchedulerCadence, s_JobHeartbeatSchedulerCadence)
+
+static int s_JobHeartbeatSchedulerVersionMismatch(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        auto client = std::make_shared<RecordingJobsClient>();
+        JobHeartbeatScheduler scheduler(client, "thing", s_heartbeatOptions(eventLoopGroup), allocator);
+        ASSERT_TRUE(scheduler);
+        ASSERT_TRUE(scheduler.Track("job", 1, 5));
+
+        /* No second heartbeat while the first one is unanswered */
+        ASSERT_TRUE(client->WaitForUpdates(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        ASSERT_INT_EQUALS(1, client->GetUpdateCount());
+        ASSERT_INT_EQUALS(5, *client->GetUpdate(0).ExpectedVersion);
+
+        /* The service reports the current version; the next heartbeat expects it */
+        client->RejectUpdate(0, RejectedErrorCode::VersionMismatch, 9);
+        ASSERT_TRUE(client->WaitForUpdates(2));
+        ASSERT_INT_EQUALS(9, *client->GetUpdate(1).ExpectedVersion);
+
+        /* Without the current version, heartbeats stop checking it */
+        client->RejectUpdate(1, RejectedErrorCode::VersionMismatch);
+        ASSERT_TRUE(client->WaitForUpdates(3));
+        ASSERT_FALSE(client->GetUpdate(2).ExpectedVersion.has_value());
+        ASSERT_INT_EQUALS(1, scheduler.GetTrackedCount());
+
+        scheduler.Untrack("job");
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobHeartbeatSchedulerVersionMismatch, s_JobHeartbeatSchedulerVersionMismatch)
+
+static int s_JobHeartbeatSchedulerTerminalStatus(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        auto client = std::make_shared<RecordingJobsClient>();
+        JobHeartbeatScheduler scheduler(client, "thing", s_heartbeatOptions(eventLoopGroup), allocator);
+        ASSERT_TRUE(scheduler);
+        ASSERT_TRUE(scheduler.Track("finished"));
+        ASSERT_TRUE(scheduler.Track("throttled"));
+        ASSERT_TRUE(client->WaitForUpdates(2));
+
+        size_t finishedIndex = *client->GetUpdate(0).JobId == "finished" ? 0 : 1;
+        size_t throttledIndex = 1 - finishedIndex;
+
+        /* An execution the service reports as finished is no longer tracked */
+        client->RejectUpdate(finishedIndex, RejectedErrorCode::TerminalStateReached);
+        ASSERT_INT_EQUALS(1, scheduler.GetTrackedCount());
+
+        /* Other failures keep the heartbeats going */
+        client->RejectUpdate(throttledIndex, RejectedErrorCode::RequestThrottled);
+        ASSERT_TRUE(client->WaitForUpdates(3));
+        ASSERT_TRUE(*client->GetUpdate(2).JobId == "throttled");
+        ASSERT_INT_EQUALS(1, scheduler.GetTrackedCount());
+
+        /* Unknown executions are dropped as well */
+        client->RejectUpdate(2, RejectedErrorCode::ResourceNotFound);
+        ASSERT_INT_EQUALS(0, scheduler.GetTrackedCount());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        ASSERT_INT_EQUALS(3, client->GetUpdateCount());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobHeartbeatSchedulerTerminalStatus, s_JobHeartbeatSchedulerTerminalStatus)
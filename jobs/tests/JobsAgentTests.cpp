@@ -0,0 +1,94 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotjobs/JobExecutionData.h>
+#include <aws/iotjobs/JobsAgent.h>
+#include <aws/iotjobs/NextJobExecutionChangedEvent.h>
+
+#include "RecordingJobsClient.h"
+
+using namespace Aws::Iotjobs;
+
+static JobExecutionData s_makeExecution(const char *jobId, const char *operation)
+{
+    Aws::Crt::JsonObject document;
+    document.WithString("operation", operation);
+
+    JobExecutionData execution;
+    execution.JobId = jobId;
+    execution.ExecutionNumber = 1;
+    execution.JobDocument = document;
+    return execution;
+}
+
+static int s_JobsAgentPipelinedDrain(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingJobsClient>();
+        JobsAgent agent(client, "thing", "operation", allocator);
+
+        int rebooted = 0;
+        agent.RegisterHandler(
+            "reboot",
+            [&rebooted](const JobExecutionData &, const JobCompletionCallback &complete)
+            {
+                ++rebooted;
+                complete(JobStatus::SUCCEEDED, {});
+            });
+
+        ASSERT_TRUE(agent.Start());
+        ASSERT_INT_EQUALS(1, client->nextJobStream->openCount);
+        ASSERT_INT_EQUALS(1, client->startHandlers.size());
+
+        /* The final update and the next start go out together */
+        client->AnswerStart(s_makeExecution("job-1", "reboot"));
+        ASSERT_INT_EQUALS(1, rebooted);
+        ASSERT_INT_EQUALS(1, client->updateHandlers.size());
+        ASSERT_INT_EQUALS(1, client->startHandlers.size());
+        ASSERT_TRUE(*client->updateRequests[0].Status == JobStatus::SUCCEEDED);
+
+        /* The service has not seen the update yet and hands out the same job; it must not run twice */
+        client->AnswerStart(s_makeExecution("job-1", "reboot"));
+        ASSERT_INT_EQUALS(1, rebooted);
+        ASSERT_INT_EQUALS(0, client->startHandlers.size());
+
+        client->AnswerUpdate();
+        ASSERT_INT_EQUALS(1, client->startHandlers.size());
+
+        /* Jobs without a handler are rejected */
+        client->AnswerStart(s_makeExecution("job-2", "format"));
+        ASSERT_INT_EQUALS(2, client->updateRequests.size());
+        ASSERT_TRUE(*client->updateRequests[1].Status == JobStatus::REJECTED);
+        client->AnswerUpdate();
+
+        /* Queue drained; the agent idles until the stream announces a new job */
+        client->AnswerStart(Aws::Crt::Optional<JobExecutionData>());
+        ASSERT_INT_EQUALS(0, client->startHandlers.size());
+
+        NextJobExecutionChangedEvent event;
+        event.Execution = s_makeExecution("job-3", "reboot");
+        client->nextJobHandler(std::move(event));
+        ASSERT_INT_EQUALS(1, client->startHandlers.size());
+
+        client->AnswerStart(s_makeExecution("job-3", "reboot"));
+        ASSERT_INT_EQUALS(2, rebooted);
+
+        agent.Stop();
+        client->AnswerUpdate();
+        client->AnswerStart(s_makeExecution("job-4", "reboot"));
+        ASSERT_INT_EQUALS(2, rebooted);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobsAgentPipelinedDrain, s_JobsAgentPipelinedDrain)
@@ -0,0 +1,137 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotjobs/GetPendingJobExecutionsResponse.h>
+#include <aws/iotjobs/JobExecutionsChangedEvent.h>
+#include <aws/iotjobs/JobsStateIndex.h>
+#include <aws/iotjobs/V2ErrorResponse.h>
+
+#include "RecordingJobsClient.h"
+
+using namespace Aws::Iotjobs;
+
+static JobExecutionSummary s_makeSummary(const char *jobId, int32_t versionNumber)
+{
+    JobExecutionSummary summary;
+    summary.JobId = jobId;
+    summary.ExecutionNumber = 1;
+    summary.VersionNumber = versionNumber;
+    return summary;
+}
+
+static int s_JobsStateIndexDiff(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        JobsStateIndex index(nullptr, "thing", allocator);
+
+        Aws::Crt::Vector<JobsStateChange> received;
+        size_t notifications = 0;
+        uint64_t subscriptionId = index.Subscribe(
+            [&received, &notifications](const Aws::Crt::Vector<JobsStateChange> &changes)
+            {
+                received = changes;
+                ++notifications;
+            });
+
+        /* Initial fetch: everything is new */
+        GetPendingJobExecutionsResponse pending;
+        pending.QueuedJobs = Aws::Crt::Vector<JobExecutionSummary>{s_makeSummary("job-1", 1)};
+        pending.InProgressJobs = Aws::Crt::Vector<JobExecutionSummary>{s_makeSummary("job-2", 3)};
+        pending.Timestamp = Aws::Crt::DateTime(static_cast<uint64_t>(1000));
+        index.Apply(pending);
+        ASSERT_INT_EQUALS(1, notifications);
+        ASSERT_INT_EQUALS(2, received.size());
+        ASSERT_TRUE(received[0].Type == JobsStateChangeType::Added);
+        ASSERT_INT_EQUALS(2, index.GetJobCount());
+        ASSERT_TRUE(*index.GetStatus("job-2") == JobStatus::IN_PROGRESS);
+
+        /* The same executions again: nothing to report */
+        Aws::Crt::Map<JobStatus, Aws::Crt::Vector<JobExecutionSummary>> jobs;
+        jobs[JobStatus::QUEUED].push_back(s_makeSummary("job-1", 1));
+        jobs[JobStatus::IN_PROGRESS].push_back(s_makeSummary("job-2", 3));
+
+        JobExecutionsChangedEvent unchanged;
+        unchanged.Jobs = jobs;
+        unchanged.Timestamp = Aws::Crt::DateTime(static_cast<uint64_t>(2000));
+        index.Apply(unchanged);
+        ASSERT_INT_EQUALS(1, notifications);
+
+        /* job-1 started, job-2 finished */
+        jobs.clear();
+        jobs[JobStatus::IN_PROGRESS].push_back(s_makeSummary("job-1", 2));
+
+        JobExecutionsChangedEvent changed;
+        changed.Jobs = jobs;
+        changed.Timestamp = Aws::Crt::DateTime(static_cast<uint64_t>(3000));
+        index.Apply(changed);
+        ASSERT_INT_EQUALS(2, notifications);
+        ASSERT_INT_EQUALS(2, received.size());
+        ASSERT_TRUE(received[0].Type == JobsStateChangeType::Changed);
+        ASSERT_TRUE(*received[0].Execution.JobId == "job-1");
+        ASSERT_TRUE(received[0].Status == JobStatus::IN_PROGRESS);
+        ASSERT_TRUE(received[1].Type == JobsStateChangeType::Removed);
+        ASSERT_TRUE(*received[1].Execution.JobId == "job-2");
+        ASSERT_FALSE(index.GetStatus("job-2").has_value());
+
+        /* A snapshot older than the last one applied is stale */
+        index.Apply(pending);
+        ASSERT_INT_EQUALS(2, notifications);
+        ASSERT_INT_EQUALS(1, index.GetJobCount());
+
+        /* An empty snapshot means nothing is pending any more */
+        index.Unsubscribe(subscriptionId);
+        JobExecutionsChangedEvent drained;
+        drained.Jobs = Aws::Crt::Map<JobStatus, Aws::Crt::Vector<JobExecutionSummary>>();
+        index.Apply(drained);
+        ASSERT_INT_EQUALS(2, notifications);
+        ASSERT_INT_EQUALS(0, index.GetJobCount());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobsStateIndexDiff, s_JobsStateIndexDiff)
+
+static int s_JobsStateIndexStartOnce(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingJobsClient>();
+        {
+            JobsStateIndex index(client, "thing", allocator);
+            ASSERT_TRUE(index.Start());
+            ASSERT_INT_EQUALS(1, client->streamCount);
+            ASSERT_INT_EQUALS(1, client->changesStream->openCount);
+            ASSERT_INT_EQUALS(1, client->pendingHandlers.size());
+
+            /* A second start neither subscribes again nor fetches another snapshot */
+            ASSERT_TRUE(index.Start());
+            ASSERT_INT_EQUALS(1, client->streamCount);
+            ASSERT_INT_EQUALS(1, client->changesStream->openCount);
+            ASSERT_INT_EQUALS(1, client->pendingHandlers.size());
+
+            ASSERT_TRUE(client->changesStream.use_count() > 1);
+        }
+
+        /* Destroying the index releases its stream */
+        ASSERT_INT_EQUALS(1, client->changesStream.use_count());
+
+        /* An index without a client cannot start */
+        JobsStateIndex detached(nullptr, "thing", allocator);
+        ASSERT_FALSE(detached.Start());
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_STATE, aws_last_error());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JobsStateIndexStartOnce, s_JobsStateIndexStartOnce)
@@ -0,0 +1,247 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotdevicecommon/JsonStreamParser.h>
+#include <aws/iotjobs/DescribeJobExecutionRequest.h>
+#include <aws/iotjobs/DescribeJobExecutionResponse.h>
+#include <aws/iotjobs/IotJobsClientV2.h>
+#include <aws/iotjobs/NextJobExecutionChangedEvent.h>
+#include <aws/iotjobs/NextJobExecutionChangedSubscriptionRequest.h>
+#include <aws/iotjobs/RawJobDocument.h>
+#include <aws/iotjobs/V2ErrorResponse.h>
+
+#include <cstdio>
+
+using namespace Aws::Iotjobs;
+
+/* Records every token as a line of text */
+class RecordingJsonHandler : public Aws::Iotdevicecommon::IJsonStreamHandler
+{
+  public:
+    bool OnBeginObject() override { return Record("{"); }
+
+    bool OnEndObject() override { return Record("}"); }
+
+    bool OnBeginArray() override { return Record("["); }
+
+    bool OnEndArray() override { return Record("]"); }
+
+    bool OnKey(struct aws_byte_cursor key) override { return Record("key:", key); }
+
+    bool OnString(struct aws_byte_cursor value) override { return Record("string:", value); }
+
+    bool OnNumber(struct aws_byte_cursor text) override { return Record("number:", text); }
+
+    bool OnBool(bool value) override { return Record(value ? "true" : "false"); }
+
+    bool OnNull() override { return Record("null"); }
+
+    Aws::Crt::String tokens;
+
+  private:
+    bool Record(const char *token, struct aws_byte_cursor text = {0, nullptr})
+    {
+        tokens.append(token);
+        tokens.append(reinterpret_cast<const char *>(text.ptr), text.len);
+        tokens.append("\n");
+        return true;
+    }
+};
+
+static const char *s_expectedTokens = "{\n"
+                                      "key:operation\n"
+                                      "string:install\n"
+                                      "key:files\n"
+                                      "[\n"
+                                      "string:a\xC3\xA9\xF0\x9F\x98\x80\n"
+                                      "number:-1.5e3\n"
+                                      "true\n"
+                                      "null\n"
+                                      "]\n"
+                                      "}\n";
+
+static int s_RawJobDocumentExtractAndSpill(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        const char *document = "{\"operation\":\"install\",\"files\":[\"a\\u00e9\\ud83d\\ude00\",-1.5e3,true,null]}";
+        Aws::Crt::String payload("{\"clientToken\":\"token\",\"execution\":{\"jobId\":\"job-1\",\"jobDocument\":");
+        payload.append(document);
+        payload.append(",\"status\":\"QUEUED\"},\"timestamp\":1}");
+
+        Aws::Crt::String remainder;
+        auto rawDocument = RawJobDocument::ExtractFromExecution(Aws::Crt::ByteCursorFromString(payload), remainder);
+        ASSERT_NOT_NULL(rawDocument.get());
+        ASSERT_TRUE(
+            remainder ==
+            "{\"clientToken\":\"token\",\"execution\":{\"jobId\":\"job-1\",\"jobDocument\":null,\"status\":\"QUEUED\"},"
+            "\"timestamp\":1}");
+
+        struct aws_byte_cursor bytes = rawDocument->GetBytes();
+        ASSERT_BIN_ARRAYS_EQUALS(document, strlen(document), bytes.ptr, bytes.len);
+        ASSERT_INT_EQUALS(strlen(document), rawDocument->GetSize());
+        ASSERT_TRUE(rawDocument->View().GetString("operation") == "install");
+
+        RecordingJsonHandler inMemory;
+        ASSERT_TRUE(rawDocument->Stream(inMemory));
+        ASSERT_TRUE(inMemory.tokens == s_expectedTokens);
+
+        /* Once spilled, the document is streamed from the file in small chunks */
+        const char *path = "raw_job_document_test.json";
+        ASSERT_TRUE(rawDocument->SpillToFile(path));
+        ASSERT_TRUE(rawDocument->IsSpilled());
+        ASSERT_UINT_EQUALS(0, rawDocument->GetBytes().len);
+
+        RecordingJsonHandler fromFile;
+        ASSERT_TRUE(rawDocument->Stream(fromFile, 3));
+        ASSERT_TRUE(fromFile.tokens == s_expectedTokens);
+        ASSERT_TRUE(rawDocument->View().GetString("operation") == "install");
+        std::remove(path);
+
+        /* Payloads without a job document are left alone */
+        Aws::Crt::String noDocument("{\"execution\":{\"jobId\":\"job-1\",\"status\":\"QUEUED\"},\"jobDocument\":{}}");
+        ASSERT_NULL(RawJobDocument::ExtractFromExecution(Aws::Crt::ByteCursorFromString(noDocument), remainder));
+
+        RecordingJsonHandler malformed;
+        Aws::Iotdevicecommon::JsonStreamParser parser(malformed, allocator);
+        ASSERT_TRUE(parser.Feed(Aws::Crt::ByteCursorFromCString("{\"a\":[1")));
+        ASSERT_FALSE(parser.Feed(Aws::Crt::ByteCursorFromCString(",}")));
+        ASSERT_FALSE(parser.Finish());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(RawJobDocumentExtractAndSpill, s_RawJobDocumentExtractAndSpill)
+
+/* Captures the handlers of submitted requests and created streams, so tests can deliver payloads directly */
+class RawDocumentRequestResponseClient : public Aws::Iot::RequestResponse::IMqttRequestResponseClient
+{
+  public:
+    int SubmitRequest(
+        const aws_mqtt_request_operation_options &requestOptions,
+        Aws::Iot::RequestResponse::UnmodeledResultHandler &&handler) override
+    {
+        publishTopic = Aws::Crt::String(
+            reinterpret_cast<const char *>(requestOptions.publish_topic.ptr), requestOptions.publish_topic.len);
+        resultHandler = std::move(handler);
+        return AWS_OP_SUCCESS;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateStream(
+        const Aws::Iot::RequestResponse::StreamingOperationOptionsInternal &options) override
+    {
+        publishHandler = options.incomingPublishEventHandler;
+        return std::make_shared<RawDocumentTestStream>();
+    }
+
+    void Respond(const char *suffix, const Aws::Crt::String &payload)
+    {
+        Aws::Crt::String topic = publishTopic + suffix;
+        Aws::Iot::RequestResponse::UnmodeledResponse response(
+            Aws::Crt::ByteCursorFromString(topic), Aws::Crt::ByteCursorFromString(payload));
+        resultHandler(Aws::Iot::RequestResponse::UnmodeledResult(std::move(response)));
+    }
+
+    void Publish(const Aws::Crt::String &payload)
+    {
+        Aws::Iot::RequestResponse::IncomingPublishEvent publishEvent;
+        publishEvent.WithTopic(Aws::Crt::ByteCursorFromCString("$aws/things/thing/jobs/notify-next"))
+            .WithPayload(Aws::Crt::ByteCursorFromString(payload));
+        publishHandler(std::move(publishEvent));
+    }
+
+    Aws::Crt::String publishTopic;
+    Aws::Iot::RequestResponse::UnmodeledResultHandler resultHandler;
+    Aws::Iot::RequestResponse::IncomingPublishEventHandler publishHandler;
+
+  private:
+    class RawDocumentTestStream : public Aws::Iot::RequestResponse::IStreamingOperation
+    {
+      public:
+        void Open() override {}
+    };
+};
+
+static int s_RawJobDocumentClientDelivery(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto bindingClient = std::make_shared<RawDocumentRequestResponseClient>();
+        auto client = NewClientFromRequestResponseClient(bindingClient, nullptr, allocator);
+        ASSERT_NOT_NULL(client.get());
+
+        const char *document = "{\"operation\":\"install\"}";
+        Aws::Crt::String payload("{\"execution\":{\"jobId\":\"job-1\",\"jobDocument\":");
+        payload.append(document);
+        payload.append(",\"status\":\"QUEUED\"}}");
+
+        DescribeJobExecutionRequest request;
+        request.ThingName = "thing";
+        request.JobId = "job-1";
+
+        /* The raw operation delivers the document beside an execution that has none */
+        Aws::Crt::Optional<DescribeJobExecutionRawResult> rawResult;
+        ASSERT_TRUE(client->DescribeJobExecutionRaw(
+            request, [&rawResult](DescribeJobExecutionRawResult &&result) { rawResult = std::move(result); }));
+        ASSERT_TRUE(bindingClient->publishTopic == "$aws/things/thing/jobs/job-1/get");
+        bindingClient->Respond("/accepted", payload);
+        ASSERT_TRUE(rawResult.has_value() && rawResult->IsSuccess());
+        const auto &message = rawResult->GetResponse();
+        ASSERT_TRUE(*message.Message.Execution->JobId == "job-1");
+        ASSERT_TRUE(*message.Message.Execution->Status == JobStatus::QUEUED);
+        ASSERT_FALSE(message.Message.Execution->JobDocument.has_value());
+        ASSERT_NOT_NULL(message.Document.get());
+        struct aws_byte_cursor bytes = message.Document->GetBytes();
+        ASSERT_BIN_ARRAYS_EQUALS(document, strlen(document), bytes.ptr, bytes.len);
+
+        /* The modeled operation still parses the document into the execution */
+        Aws::Crt::Optional<DescribeJobExecutionResult> modeledResult;
+        ASSERT_TRUE(client->DescribeJobExecution(
+            request, [&modeledResult](DescribeJobExecutionResult &&result) { modeledResult = std::move(result); }));
+        bindingClient->Respond("/accepted", payload);
+        ASSERT_TRUE(modeledResult.has_value() && modeledResult->IsSuccess());
+        const auto &execution = modeledResult->GetResponse().Execution;
+        ASSERT_TRUE(execution->JobDocument->View().GetString("operation") == "install");
+
+        /* Rejections carry the modeled error */
+        rawResult.reset();
+        ASSERT_TRUE(client->DescribeJobExecutionRaw(
+            request, [&rawResult](DescribeJobExecutionRawResult &&result) { rawResult = std::move(result); }));
+        bindingClient->Respond("/rejected", "{\"code\":\"ResourceNotFound\"}");
+        ASSERT_TRUE(rawResult.has_value() && !rawResult->IsSuccess());
+        ASSERT_INT_EQUALS(AWS_ERROR_MQTT_REQUEST_RESPONSE_MODELED_SERVICE_ERROR, rawResult->GetError().GetErrorCode());
+        ASSERT_TRUE(rawResult->GetError().HasModeledError());
+
+        /* Raw stream events carry the document beside the execution as well */
+        NextJobExecutionChangedSubscriptionRequest subscriptionRequest;
+        subscriptionRequest.ThingName = "thing";
+        Aws::Crt::Vector<RawJobDocumentMessage<NextJobExecutionChangedEvent>> events;
+        Aws::Iot::RequestResponse::StreamingOperationOptions<RawJobDocumentMessage<NextJobExecutionChangedEvent>>
+            options;
+        options.WithStreamHandler([&events](RawJobDocumentMessage<NextJobExecutionChangedEvent> &&event)
+                                  { events.push_back(std::move(event)); });
+        auto stream = client->CreateNextJobExecutionChangedRawStream(subscriptionRequest, options);
+        ASSERT_NOT_NULL(stream.get());
+
+        bindingClient->Publish(payload);
+        bindingClient->Publish("{\"timestamp\":1}");
+        ASSERT_INT_EQUALS(2, events.size());
+        ASSERT_FALSE(events[0].Message.Execution->JobDocument.has_value());
+        ASSERT_TRUE(events[0].Document->View().GetString("operation") == "install");
+        ASSERT_FALSE(events[1].Message.Execution.has_value());
+        ASSERT_NULL(events[1].Document.get());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(RawJobDocumentClientDelivery, s_RawJobDocumentClientDelivery)
@@ -0,0 +1,203 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Types.h>
+
+#include <aws/iotjobs/DescribeJobExecutionRequest.h>
+#include <aws/iotjobs/GetPendingJobExecutionsRequest.h>
+#include <aws/iotjobs/GetPendingJobExecutionsResponse.h>
+#include <aws/iotjobs/IotJobsClientV2.h>
+#include <aws/iotjobs/JobExecutionData.h>
+#include <aws/iotjobs/JobExecutionState.h>
+#include <aws/iotjobs/JobExecutionsChangedEvent.h>
+#include <aws/iotjobs/JobExecutionsChangedSubscriptionRequest.h>
+#include <aws/iotjobs/NextJobExecutionChangedEvent.h>
+#include <aws/iotjobs/NextJobExecutionChangedSubscriptionRequest.h>
+#include <aws/iotjobs/RejectedErrorCode.h>
+#include <aws/iotjobs/StartNextJobExecutionResponse.h>
+#include <aws/iotjobs/StartNextPendingJobExecutionRequest.h>
+#include <aws/iotjobs/UpdateJobExecutionRequest.h>
+#include <aws/iotjobs/UpdateJobExecutionResponse.h>
+#include <aws/iotjobs/V2ErrorResponse.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+class RecordingJobsStream : public Aws::Iot::RequestResponse::IStreamingOperation
+{
+  public:
+    void Open() override { ++openCount; }
+
+    int openCount = 0;
+};
+
+/*
+ * Fake jobs service client shared by the jobs unit tests.  Captures the streams it creates and records start, pending
+ * and update requests, which may arrive on event loop threads.  Answers updates right away with the next execution
+ * version if autoAccept is set, otherwise the test decides when and how the service answers them.
+ */
+class RecordingJobsClient : public Aws::Iotjobs::IClientV2
+{
+  public:
+    bool DescribeJobExecution(
+        const Aws::Iotjobs::DescribeJobExecutionRequest &,
+        const Aws::Iotjobs::DescribeJobExecutionResultHandler &) override
+    {
+        return false;
+    }
+
+    bool GetPendingJobExecutions(
+        const Aws::Iotjobs::GetPendingJobExecutionsRequest &,
+        const Aws::Iotjobs::GetPendingJobExecutionsResultHandler &handler) override
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        pendingHandlers.push_back(handler);
+        return true;
+    }
+
+    bool StartNextPendingJobExecution(
+        const Aws::Iotjobs::StartNextPendingJobExecutionRequest &,
+        const Aws::Iotjobs::StartNextPendingJobExecutionResultHandler &handler) override
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        startHandlers.push_back(handler);
+        return true;
+    }
+
+    bool UpdateJobExecution(
+        const Aws::Iotjobs::UpdateJobExecutionRequest &request,
+        const Aws::Iotjobs::UpdateJobExecutionResultHandler &handler) override
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            updateRequests.push_back(request);
+            updateHandlers.push_back(handler);
+            updated.notify_all();
+        }
+
+        if (autoAccept)
+        {
+            Aws::Iotjobs::UpdateJobExecutionResponse response;
+            if (request.ExpectedVersion.has_value())
+            {
+                Aws::Iotjobs::JobExecutionState executionState;
+                executionState.VersionNumber = *request.ExpectedVersion + 1;
+                response.ExecutionState = executionState;
+            }
+            handler(Aws::Iotjobs::UpdateJobExecutionResult(std::move(response)));
+        }
+
+        return true;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateJobExecutionsChangedStream(
+        const Aws::Iotjobs::JobExecutionsChangedSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotjobs::JobExecutionsChangedEvent> &) override
+    {
+        ++streamCount;
+        changesStream = std::make_shared<RecordingJobsStream>();
+        return changesStream;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateNextJobExecutionChangedStream(
+        const Aws::Iotjobs::NextJobExecutionChangedSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotjobs::NextJobExecutionChangedEvent>
+            &options) override
+    {
+        ++streamCount;
+        nextJobHandler = options.GetStreamHandler();
+        nextJobStream = std::make_shared<RecordingJobsStream>();
+        return nextJobStream;
+    }
+
+    /* Answers the oldest unanswered start request with the given execution, or with none */
+    void AnswerStart(const Aws::Crt::Optional<Aws::Iotjobs::JobExecutionData> &execution)
+    {
+        Aws::Iotjobs::StartNextPendingJobExecutionResultHandler handler;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            handler = std::move(startHandlers.front());
+            startHandlers.erase(startHandlers.begin());
+        }
+
+        Aws::Iotjobs::StartNextJobExecutionResponse response;
+        response.Execution = execution;
+        handler(Aws::Iotjobs::StartNextPendingJobExecutionResult(std::move(response)));
+    }
+
+    /* Accepts the oldest unanswered update */
+    void AnswerUpdate()
+    {
+        Aws::Iotjobs::UpdateJobExecutionResultHandler handler;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            handler = std::move(updateHandlers.front());
+            updateHandlers.erase(updateHandlers.begin());
+        }
+
+        handler(Aws::Iotjobs::UpdateJobExecutionResult(Aws::Iotjobs::UpdateJobExecutionResponse()));
+    }
+
+    /* Rejects the update with a modeled service error, optionally carrying the current execution version */
+    void RejectUpdate(
+        size_t index,
+        Aws::Iotjobs::RejectedErrorCode code,
+        const Aws::Crt::Optional<int32_t> &currentVersion = {})
+    {
+        Aws::Iotjobs::UpdateJobExecutionResultHandler handler;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            handler = std::move(updateHandlers[index]);
+        }
+
+        Aws::Iotjobs::V2ErrorResponse error;
+        error.Code = code;
+        if (currentVersion.has_value())
+        {
+            Aws::Iotjobs::JobExecutionState executionState;
+            executionState.VersionNumber = *currentVersion;
+            error.ExecutionState = executionState;
+        }
+
+        handler(Aws::Iotjobs::UpdateJobExecutionResult(Aws::Iotjobs::ServiceErrorV2<Aws::Iotjobs::V2ErrorResponse>(
+            AWS_ERROR_MQTT_REQUEST_RESPONSE_MODELED_SERVICE_ERROR, std::move(error))));
+    }
+
+    bool WaitForUpdates(size_t count)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        return updated.wait_for(
+            guard, std::chrono::seconds(5), [this, count]() { return updateRequests.size() >= count; });
+    }
+
+    size_t GetUpdateCount()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return updateRequests.size();
+    }
+
+    Aws::Iotjobs::UpdateJobExecutionRequest GetUpdate(size_t index)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return updateRequests[index];
+    }
+
+    bool autoAccept = false;
+
+    std::mutex lock;
+    std::condition_variable updated;
+    std::vector<Aws::Iotjobs::StartNextPendingJobExecutionResultHandler> startHandlers;
+    std::vector<Aws::Iotjobs::GetPendingJobExecutionsResultHandler> pendingHandlers;
+    std::vector<Aws::Iotjobs::UpdateJobExecutionRequest> updateRequests;
+    std::vector<Aws::Iotjobs::UpdateJobExecutionResultHandler> updateHandlers;
+
+    int streamCount = 0;
+    std::shared_ptr<RecordingJobsStream> changesStream;
+    std::shared_ptr<RecordingJobsStream> nextJobStream;
+    std::function<void(Aws::Iotjobs::NextJobExecutionChangedEvent &&)> nextJobHandler;
+};
@@ -0,0 +1,176 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotdevicecommon/JsonWriter.h>
+#include <aws/iotjobs/IotJobsClientV2.h>
+#include <aws/iotjobs/StatusDetailsBuilder.h>
+#include <aws/iotjobs/UpdateJobExecutionRequest.h>
+#include <aws/iotjobs/UpdateJobExecutionResponse.h>
+#include <aws/iotjobs/V2ErrorResponse.h>
+
+using namespace Aws::Iotjobs;
+
+static Aws::Crt::String s_serialize(Aws::Crt::Allocator *allocator, const StatusDetailsBuilder &statusDetails)
+{
+    Aws::Iotdevicecommon::JsonWriter writer(allocator);
+    writer.BeginObject();
+    statusDetails.SerializeTo(writer);
+    writer.EndObject();
+    struct aws_byte_cursor json = writer.ToCursor();
+    return Aws::Crt::String(reinterpret_cast<const char *>(json.ptr), json.len);
+}
+
+static int s_StatusDetailsBuilderSerialize(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        StatusDetailsKeyTable keys(allocator);
+        StatusDetailKey step = keys.Intern("step");
+        StatusDetailKey progress = keys.Intern("progress");
+        StatusDetailKey message = keys.Intern("message");
+        ASSERT_TRUE(step == keys.Intern("step"));
+        ASSERT_TRUE(step != progress);
+
+        StatusDetailsBuilder statusDetails(allocator);
+        statusDetails.Set(step, "download").SetInt64(progress, 10).Set(message, "a \"quoted\" path");
+
+        /* Shorter values are overwritten in place, longer ones appended */
+        statusDetails.SetInt64(progress, 9);
+        statusDetails.SetInt64(progress, -1234);
+        statusDetails.Set(step, "install");
+        ASSERT_INT_EQUALS(3, statusDetails.GetSize());
+
+        ASSERT_TRUE(
+            s_serialize(allocator, statusDetails) == "{\"step\":\"install\",\"progress\":\"-1234\","
+                                                     "\"message\":\"a \\\"quoted\\\" path\"}");
+
+        auto statusDetailsMap = statusDetails.ToMap();
+        ASSERT_TRUE(statusDetailsMap["progress"] == "-1234");
+
+        statusDetails.Clear();
+        ASSERT_INT_EQUALS(0, statusDetails.GetSize());
+        ASSERT_TRUE(s_serialize(allocator, statusDetails) == "{}");
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(StatusDetailsBuilderSerialize, s_StatusDetailsBuilderSerialize)
+
+static int s_StatusDetailsBuilderGrowthAndCopy(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        StatusDetailsKeyTable keys(allocator);
+        StatusDetailKey step = keys.Intern("step");
+        StatusDetailKey progress = keys.Intern("progress");
+
+        /* A value that keeps growing abandons its old ranges, which are compacted away as it goes */
+        StatusDetailsBuilder statusDetails(allocator);
+        statusDetails.Set(step, "verify");
+        Aws::Crt::String log;
+        for (int i = 0; i < 64; ++i)
+        {
+            log.append("x");
+            statusDetails.Set(progress, log.c_str());
+        }
+        ASSERT_INT_EQUALS(2, statusDetails.GetSize());
+        Aws::Crt::String expected = "{\"step\":\"verify\",\"progress\":\"" + log + "\"}";
+        ASSERT_TRUE(s_serialize(allocator, statusDetails) == expected);
+
+        /* Copies keep the live values only */
+        StatusDetailsBuilder copy(statusDetails);
+        ASSERT_TRUE(s_serialize(allocator, copy) == expected);
+
+        StatusDetailsBuilder assigned(allocator);
+        assigned.Set(step, "a value longer than any of the copied ones");
+        assigned = statusDetails;
+        ASSERT_INT_EQUALS(2, assigned.GetSize());
+        ASSERT_TRUE(s_serialize(allocator, assigned) == expected);
+
+        /* Copies are independent of their source */
+        copy.Set(step, "install");
+        ASSERT_TRUE(s_serialize(allocator, statusDetails) == expected);
+
+        StatusDetailsBuilder moved(std::move(assigned));
+        ASSERT_TRUE(s_serialize(allocator, moved) == expected);
+        ASSERT_INT_EQUALS(0, assigned.GetSize());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(StatusDetailsBuilderGrowthAndCopy, s_StatusDetailsBuilderGrowthAndCopy)
+
+/* Captures the payload of the last submitted request */
+class StatusDetailsRequestResponseClient : public Aws::Iot::RequestResponse::IMqttRequestResponseClient
+{
+  public:
+    int SubmitRequest(
+        const aws_mqtt_request_operation_options &requestOptions,
+        Aws::Iot::RequestResponse::UnmodeledResultHandler &&) override
+    {
+        payload = Aws::Crt::String(
+            reinterpret_cast<const char *>(requestOptions.serialized_request.ptr),
+            requestOptions.serialized_request.len);
+        return AWS_OP_SUCCESS;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateStream(
+        const Aws::Iot::RequestResponse::StreamingOperationOptionsInternal &) override
+    {
+        return nullptr;
+    }
+
+    Aws::Crt::String payload;
+};
+
+static int s_StatusDetailsBuilderClientUpdate(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto bindingClient = std::make_shared<StatusDetailsRequestResponseClient>();
+        auto client = NewClientFromRequestResponseClient(bindingClient, nullptr, allocator);
+        ASSERT_NOT_NULL(client.get());
+
+        StatusDetailsKeyTable keys(allocator);
+        StatusDetailsBuilder statusDetails(allocator);
+        statusDetails.Set(keys.Intern("step"), "install").SetInt64(keys.Intern("progress"), 50);
+
+        UpdateJobExecutionRequest request;
+        request.ThingName = "thing";
+        request.JobId = "job-1";
+        request.Status = JobStatus::IN_PROGRESS;
+
+        ASSERT_TRUE(
+            client->UpdateJobExecutionWithStatusDetails(request, statusDetails, [](UpdateJobExecutionResult &&) {}));
+
+        /* The details are written after the request's own members, after the generated client token */
+        Aws::Crt::String suffix(",\"status\":\"IN_PROGRESS\","
+                                "\"statusDetails\":{\"step\":\"install\",\"progress\":\"50\"}}");
+        const Aws::Crt::String &payload = bindingClient->payload;
+        ASSERT_TRUE(payload.size() > suffix.size());
+        ASSERT_TRUE(payload.compare(payload.size() - suffix.size(), suffix.size(), suffix) == 0);
+
+        /* The builder cannot be combined with the request's own map */
+        bindingClient->payload.clear();
+        request.StatusDetails = Aws::Crt::Map<Aws::Crt::String, Aws::Crt::String>();
+        ASSERT_FALSE(
+            client->UpdateJobExecutionWithStatusDetails(request, statusDetails, [](UpdateJobExecutionResult &&) {}));
+        ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+        ASSERT_TRUE(bindingClient->payload.empty());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(StatusDetailsBuilderClientUpdate, s_StatusDetailsBuilderClientUpdate)
@@ -15,6 +15,8 @@
 */
 #include <aws/iotsecuretunneling/IotSecureTunnelingClient.h>
 
+#include <aws/iotdevicecommon/TopicBuilder.h>
+
 #include <aws/iotsecuretunneling/SecureTunnelingNotifyResponse.h>
 #include <aws/iotsecuretunneling/SubscribeToTunnelsNotifyRequest.h>
 
@@ -74,17 +76,11 @@ namespace Aws
                 handler(&response, AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws"
-                               << "/"
-                               << "things"
-                               << "/" << *request.ThingName << "/"
-                               << "tunnels"
-                               << "/"
-                               << "notify";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws", "/", "things", "/", *request.ThingName, "/", "tunnels", "/", "notify");
 
             return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
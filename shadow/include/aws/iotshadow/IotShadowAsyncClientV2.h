@@ -0,0 +1,186 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotshadow/IotShadowClientV2.h>
+
+#include <aws/iotshadow/DeleteShadowResponse.h>
+#include <aws/iotshadow/GetShadowResponse.h>
+#include <aws/iotshadow/ShadowDocument.h>
+#include <aws/iotshadow/UpdateShadowResponse.h>
+#include <aws/iotshadow/V2ErrorResponse.h>
+
+#include <aws/iotdevicecommon/RequestFuture.h>
+
+#include <memory>
+#include <utility>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        /**
+         * Future-based facade over the shadow service client.  Each request operation returns a future for its
+         * result instead of taking a handler.  When compiled as C++20, the futures can be awaited directly:
+         *
+         *     UpdateShadowResult result = co_await asyncClient.UpdateShadow(request);
+         *
+         * Futures complete on the event loop thread that delivered the response; see
+         * Aws::Iotdevicecommon::RequestFuture for the threading rules.
+         */
+        class AsyncClientV2 final
+        {
+          public:
+            /**
+             * @param client service client to submit requests with
+             * @param allocator memory allocator for the state of each request
+             */
+            explicit AsyncClientV2(
+                std::shared_ptr<IClientV2> client,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator())
+                : m_client(std::move(client)), m_allocator(allocator)
+            {
+            }
+
+            /**
+             * Deletes a named shadow for an AWS IoT thing.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<DeleteNamedShadowResult> DeleteNamedShadow(
+                const DeleteNamedShadowRequest &request)
+            {
+                return Submit<DeleteNamedShadowResult>(
+                    [this, &request](const DeleteNamedShadowResultHandler &handler)
+                    { return m_client->DeleteNamedShadow(request, handler); });
+            }
+
+            /**
+             * Deletes the (classic) shadow for an AWS IoT thing.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<DeleteShadowResult> DeleteShadow(const DeleteShadowRequest &request)
+            {
+                return Submit<DeleteShadowResult>(
+                    [this, &request](const DeleteShadowResultHandler &handler)
+                    { return m_client->DeleteShadow(request, handler); });
+            }
+
+            /**
+             * Gets a named shadow for an AWS IoT thing.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<GetNamedShadowResult> GetNamedShadow(
+                const GetNamedShadowRequest &request)
+            {
+                return Submit<GetNamedShadowResult>(
+                    [this, &request](const GetNamedShadowResultHandler &handler)
+                    { return m_client->GetNamedShadow(request, handler); });
+            }
+
+            /**
+             * Gets the (classic) shadow for an AWS IoT thing.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<GetShadowResult> GetShadow(const GetShadowRequest &request)
+            {
+                return Submit<GetShadowResult>(
+                    [this, &request](const GetShadowResultHandler &handler)
+                    { return m_client->GetShadow(request, handler); });
+            }
+
+            /**
+             * Update a named shadow for a device.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<UpdateNamedShadowResult> UpdateNamedShadow(
+                const UpdateNamedShadowRequest &request)
+            {
+                return Submit<UpdateNamedShadowResult>(
+                    [this, &request](const UpdateNamedShadowResultHandler &handler)
+                    { return m_client->UpdateNamedShadow(request, handler); });
+            }
+
+            /**
+             * Update a device's (classic) shadow.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<UpdateShadowResult> UpdateShadow(const UpdateShadowRequest &request)
+            {
+                return Submit<UpdateShadowResult>(
+                    [this, &request](const UpdateShadowResultHandler &handler)
+                    { return m_client->UpdateShadow(request, handler); });
+            }
+
+            /**
+             * Gets a named shadow for an AWS IoT thing as a lazily materialized document.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<GetShadowDocumentResult> GetNamedShadowDocument(
+                const GetNamedShadowRequest &request)
+            {
+                return Submit<GetShadowDocumentResult>(
+                    [this, &request](const GetShadowDocumentResultHandler &handler)
+                    { return m_client->GetNamedShadowDocument(request, handler); });
+            }
+
+            /**
+             * Gets the (classic) shadow for an AWS IoT thing as a lazily materialized document.
+             *
+             * @param request operation to perform
+             *
+             * @return a future for the result of the operation
+             */
+            Aws::Iotdevicecommon::RequestFuture<GetShadowDocumentResult> GetShadowDocument(
+                const GetShadowRequest &request)
+            {
+                return Submit<GetShadowDocumentResult>(
+                    [this, &request](const GetShadowDocumentResultHandler &handler)
+                    { return m_client->GetShadowDocument(request, handler); });
+            }
+
+            /**
+             * @return the wrapped service client, e.g. for creating streaming operations
+             */
+            const std::shared_ptr<IClientV2> &GetClient() const { return m_client; }
+
+          private:
+            template <typename R, typename Submitter>
+            Aws::Iotdevicecommon::RequestFuture<R> Submit(Submitter &&submit)
+            {
+                return Aws::Iotdevicecommon::RequestFuture<R>::Start(
+                    m_allocator,
+                    std::forward<Submitter>(submit),
+                    [](int errorCode) { return R(ServiceErrorV2<V2ErrorResponse>(errorCode)); });
+            }
+
+            std::shared_ptr<IClientV2> m_client;
+            Aws::Crt::Allocator *m_allocator;
+        };
+
+    } // namespace Iotshadow
+} // namespace Aws
@@ -27,6 +27,11 @@ namespace Aws
             class Mqtt5Client;
         }
     } // namespace Crt
+
+    namespace Iotdevicecommon
+    {
+        class ICorrelationTokenGenerator;
+    }
 } // namespace Aws
 
 namespace Aws
@@ -64,6 +69,35 @@ namespace Aws
             Aws::Crt::Optional<E> m_modeledError;
         };
 
+        /**
+         * A single subscription to an event topic of every named shadow of a thing, with events routed to per-shadow
+         * handlers.  Adding or removing a handler does not change the underlying subscription.
+         */
+        template <typename T>
+        class INamedShadowMultiplexedStream : public Aws::Iot::RequestResponse::IStreamingOperation
+        {
+          public:
+            virtual ~INamedShadowMultiplexedStream() = default;
+
+            /**
+             * Routes the events of a named shadow to a handler, replacing any handler previously set for it.
+             *
+             * @param shadowName name of the shadow to route
+             * @param handler function object to invoke for every event of the shadow
+             */
+            virtual void SetShadowHandler(
+                const Aws::Crt::String &shadowName,
+                const std::function<void(T &&)> &handler) = 0;
+
+            /**
+             * Stops routing the events of a named shadow.  Subsequent events of the shadow go to the stream handler
+             * of the options the stream was created with, if one was set.
+             *
+             * @param shadowName name of the shadow to stop routing
+             */
+            virtual void RemoveShadowHandler(const Aws::Crt::String &shadowName) = 0;
+        };
+
         class DeleteNamedShadowRequest;
         class DeleteShadowRequest;
         class DeleteShadowResponse;
@@ -74,6 +108,7 @@ namespace Aws
         class NamedShadowUpdatedSubscriptionRequest;
         class ShadowDeltaUpdatedEvent;
         class ShadowDeltaUpdatedSubscriptionRequest;
+        class ShadowDocument;
         class ShadowUpdatedEvent;
         class ShadowUpdatedSubscriptionRequest;
         class UpdateNamedShadowRequest;
@@ -96,6 +131,10 @@ namespace Aws
         using GetShadowResult = Aws::Iot::RequestResponse::Result<GetShadowResponse, ServiceErrorV2<V2ErrorResponse>>;
         using GetShadowResultHandler = std::function<void(GetShadowResult &&)>;
 
+        using GetShadowDocumentResult =
+            Aws::Iot::RequestResponse::Result<ShadowDocument, ServiceErrorV2<V2ErrorResponse>>;
+        using GetShadowDocumentResultHandler = std::function<void(GetShadowDocumentResult &&)>;
+
         using UpdateNamedShadowResult =
             Aws::Iot::RequestResponse::Result<UpdateShadowResponse, ServiceErrorV2<V2ErrorResponse>>;
         using UpdateNamedShadowResultHandler = std::function<void(UpdateNamedShadowResult &&)>;
@@ -274,6 +313,179 @@ namespace Aws
             virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateShadowUpdatedStream(
                 const ShadowUpdatedSubscriptionRequest &request,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowUpdatedEvent> &options) = 0;
+
+            /*
+             * Operations added after IClientV2 was first released have default implementations that fail with
+             * AWS_ERROR_UNSUPPORTED_OPERATION, so existing implementations of the interface keep compiling.
+             */
+
+            /**
+             * Gets a named shadow for an AWS IoT thing as a lazily materialized document.
+             *
+             * Unlike GetNamedShadow, the state sections of the response are not copied out of the parsed payload
+             * until requested through the returned document.
+             *
+             * @param request operation to perform
+             * @param handler function object to invoke upon operation completion
+             *
+             * @return success/failure
+             */
+            virtual bool GetNamedShadowDocument(
+                const GetNamedShadowRequest &request,
+                const GetShadowDocumentResultHandler &handler)
+            {
+                (void)request;
+                (void)handler;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return false;
+            }
+
+            /**
+             * Gets the (classic) shadow for an AWS IoT thing as a lazily materialized document.
+             *
+             * Unlike GetShadow, the state sections of the response are not copied out of the parsed payload until
+             * requested through the returned document.
+             *
+             * @param request operation to perform
+             * @param handler function object to invoke upon operation completion
+             *
+             * @return success/failure
+             */
+            virtual bool GetShadowDocument(
+                const GetShadowRequest &request,
+                const GetShadowDocumentResultHandler &handler)
+            {
+                (void)request;
+                (void)handler;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return false;
+            }
+
+            /**
+             * Create a stream for NamedShadowDelta events for a named shadow of an AWS IoT thing that emits lazily
+             * materialized documents instead of ShadowDeltaUpdatedEvent.
+             *
+             * @param request Modeled streaming operation subscription configuration.
+             * @param options Configuration options for the streaming operation.
+             *
+             * @return A streaming operation which will emit a document every time a message is received on the
+             * associated MQTT topic.
+             */
+            virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>
+                CreateNamedShadowDeltaUpdatedDocumentStream(
+                    const NamedShadowDeltaUpdatedSubscriptionRequest &request,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options)
+            {
+                (void)request;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
+
+            /**
+             * Create a stream for ShadowUpdated events for a named shadow of an AWS IoT thing that emits lazily
+             * materialized documents instead of ShadowUpdatedEvent.
+             *
+             * @param request Modeled streaming operation subscription configuration.
+             * @param options Configuration options for the streaming operation.
+             *
+             * @return A streaming operation which will emit a document every time a message is received on the
+             * associated MQTT topic.
+             */
+            virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>
+                CreateNamedShadowUpdatedDocumentStream(
+                    const NamedShadowUpdatedSubscriptionRequest &request,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options)
+            {
+                (void)request;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
+
+            /**
+             * Create a stream for ShadowDelta events for the (classic) shadow of an AWS IoT thing that emits lazily
+             * materialized documents instead of ShadowDeltaUpdatedEvent.
+             *
+             * @param request Modeled streaming operation subscription configuration.
+             * @param options Configuration options for the streaming operation.
+             *
+             * @return A streaming operation which will emit a document every time a message is received on the
+             * associated MQTT topic.
+             */
+            virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation>
+                CreateShadowDeltaUpdatedDocumentStream(
+                    const ShadowDeltaUpdatedSubscriptionRequest &request,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options)
+            {
+                (void)request;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
+
+            /**
+             * Create a stream for ShadowUpdated events for the (classic) shadow of an AWS IoT thing that emits
+             * lazily materialized documents instead of ShadowUpdatedEvent.  The previous and current snapshots share
+             * a single parsed payload.
+             *
+             * @param request Modeled streaming operation subscription configuration.
+             * @param options Configuration options for the streaming operation.
+             *
+             * @return A streaming operation which will emit a document every time a message is received on the
+             * associated MQTT topic.
+             */
+            virtual std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateShadowUpdatedDocumentStream(
+                const ShadowUpdatedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options)
+            {
+                (void)request;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
+
+            /**
+             * Create a single stream for NamedShadowDelta events of every named shadow of an AWS IoT thing.  Events
+             * are only parsed for shadows that have a handler, or if the options carry a stream handler for
+             * unrouted events.
+             *
+             * @param thingName name of the thing whose named shadows should be observed
+             * @param options Subscription status handler and optional handler for unrouted events.
+             *
+             * @return A multiplexed streaming operation backed by one wildcard subscription.
+             */
+            virtual std::shared_ptr<INamedShadowMultiplexedStream<ShadowDeltaUpdatedEvent>>
+                CreateNamedShadowDeltaUpdatedMultiplexedStream(
+                    const Aws::Crt::String &thingName,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDeltaUpdatedEvent> &options)
+            {
+                (void)thingName;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
+
+            /**
+             * Create a single stream for ShadowUpdated events of every named shadow of an AWS IoT thing.  Events are
+             * only parsed for shadows that have a handler, or if the options carry a stream handler for unrouted
+             * events.
+             *
+             * @param thingName name of the thing whose named shadows should be observed
+             * @param options Subscription status handler and optional handler for unrouted events.
+             *
+             * @return A multiplexed streaming operation backed by one wildcard subscription.
+             */
+            virtual std::shared_ptr<INamedShadowMultiplexedStream<ShadowUpdatedEvent>>
+                CreateNamedShadowUpdatedMultiplexedStream(
+                    const Aws::Crt::String &thingName,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowUpdatedEvent> &options)
+            {
+                (void)thingName;
+                (void)options;
+                aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+                return nullptr;
+            }
         };
 
         /**
@@ -290,6 +502,24 @@ namespace Aws
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
             Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
 
+        /**
+         * Creates a new service client that uses an SDK MQTT5 client for transport and a custom source of
+         * correlation tokens.
+         *
+         * @param protocolClient MQTT client to use as transport
+         * @param options request-response MQTT client configuration options
+         * @param correlationTokenGenerator generator for request correlation tokens.  If null, each request gets a
+         * freshly generated UUID.
+         * @param allocator memory allocator to use for all client functionality
+         *
+         * @return a new service client
+         */
+        AWS_IOTSHADOW_API std::shared_ptr<IClientV2> NewClientFrom5(
+            const Aws::Crt::Mqtt5::Mqtt5Client &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
+            Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
         /**
          * Creates a new service client that uses an SDK MQTT311 client for transport.
          *
@@ -304,5 +534,39 @@ namespace Aws
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
             Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
 
+        /**
+         * Creates a new service client that uses an SDK MQTT311 client for transport and a custom source of
+         * correlation tokens.
+         *
+         * @param protocolClient MQTT client to use as transport
+         * @param options request-response MQTT client configuration options
+         * @param correlationTokenGenerator generator for request correlation tokens.  If null, each request gets a
+         * freshly generated UUID.
+         * @param allocator memory allocator to use for all client functionality
+         *
+         * @return a new service client
+         */
+        AWS_IOTSHADOW_API std::shared_ptr<IClientV2> NewClientFrom311(
+            const Aws::Crt::Mqtt::MqttConnection &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
+            Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+        /**
+         * Creates a new service client on top of an existing request-response MQTT client, e.g. one shared with other
+         * service clients.
+         *
+         * @param bindingClient request-response MQTT client to use as transport
+         * @param correlationTokenGenerator generator for request correlation tokens.  If null, each request gets a
+         * freshly generated UUID.
+         * @param allocator memory allocator to use for all client functionality
+         *
+         * @return a new service client
+         */
+        AWS_IOTSHADOW_API std::shared_ptr<IClientV2> NewClientFromRequestResponseClient(
+            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator = nullptr,
+            Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
     } // namespace Iotshadow
 } // namespace Aws
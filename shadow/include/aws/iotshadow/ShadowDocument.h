@@ -0,0 +1,163 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotshadow/Exports.h>
+
+#include <aws/crt/DateTime.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <memory>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        /**
+         * Read-only, lazily materialized view of a shadow document received from the AWS IoT Device Shadow service.
+         *
+         * The payload is parsed exactly once and the parsed tree is shared by every document derived from it.  State
+         * sections are exposed as views into that tree and are only deep-copied when the caller takes ownership
+         * through one of the Materialize functions.  Views obtained from a document remain valid for as long as any
+         * document referencing the same payload is alive.
+         *
+         * Depending on the source, the document has one of the following shapes:
+         *  - get/accepted: state.desired, state.reported, state.delta, metadata, version, timestamp, clientToken
+         *  - update/documents: previous and current sub-documents, timestamp, clientToken
+         *  - update/delta: state (the delta itself), metadata, version, timestamp, clientToken
+         */
+        class AWS_IOTSHADOW_API ShadowDocument final
+        {
+          public:
+            ShadowDocument() = default;
+
+            /**
+             * Takes ownership of an already parsed shadow document.
+             *
+             * @param document parsed shadow document
+             * @param allocator allocator used for the shared document tree
+             */
+            explicit ShadowDocument(
+                Aws::Crt::JsonObject &&document,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * Parses a shadow document from a raw JSON payload.
+             *
+             * @param payload serialized JSON shadow document
+             * @param allocator allocator used for the shared document tree
+             *
+             * @return the parsed document, or an invalid document if the payload is not valid JSON
+             */
+            static ShadowDocument FromPayload(
+                Aws::Crt::ByteCursor payload,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * @return true if this document references a successfully parsed JSON object
+             */
+            bool IsValid() const;
+
+            /**
+             * @return a view of the entire document
+             */
+            Aws::Crt::JsonView GetView() const;
+
+            /**
+             * @return the "previous" sub-document of an update/documents event, or an invalid document if absent
+             */
+            ShadowDocument GetPrevious() const;
+
+            /**
+             * @return the "current" sub-document of an update/documents event, or an invalid document if absent
+             */
+            ShadowDocument GetCurrent() const;
+
+            /**
+             * @return a view of the "state" section.  For update/delta events this is the delta itself.
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonView> GetState() const;
+
+            /**
+             * @return a view of state.desired, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonView> GetDesired() const;
+
+            /**
+             * @return a view of state.reported, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonView> GetReported() const;
+
+            /**
+             * @return a view of state.delta, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonView> GetDelta() const;
+
+            /**
+             * @return a view of the "metadata" section, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonView> GetMetadata() const;
+
+            /**
+             * @return an owned copy of the "state" section, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonObject> MaterializeState() const;
+
+            /**
+             * @return an owned copy of state.desired, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonObject> MaterializeDesired() const;
+
+            /**
+             * @return an owned copy of state.reported, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonObject> MaterializeReported() const;
+
+            /**
+             * @return an owned copy of state.delta, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonObject> MaterializeDelta() const;
+
+            /**
+             * @return an owned copy of the "metadata" section, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonObject> MaterializeMetadata() const;
+
+            /**
+             * @return the shadow document version, if present
+             */
+            Aws::Crt::Optional<int32_t> GetVersion() const;
+
+            /**
+             * @return the time at which the service generated the message, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::DateTime> GetTimestamp() const;
+
+            /**
+             * @return the client token used to correlate the message with a request, if present
+             */
+            Aws::Crt::Optional<Aws::Crt::String> GetClientToken() const;
+
+          private:
+            ShadowDocument(std::shared_ptr<const Aws::Crt::JsonObject> root, const Aws::Crt::JsonView &view);
+
+            ShadowDocument GetChildDocument(const char *key) const;
+
+            Aws::Crt::Optional<Aws::Crt::JsonView> GetStateSection(const char *key) const;
+
+            static Aws::Crt::Optional<Aws::Crt::JsonObject> Materialize(
+                const Aws::Crt::Optional<Aws::Crt::JsonView> &view);
+
+            std::shared_ptr<const Aws::Crt::JsonObject> m_root;
+
+            Aws::Crt::JsonView m_view;
+        };
+
+    } // namespace Iotshadow
+} // namespace Aws
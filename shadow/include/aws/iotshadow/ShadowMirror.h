@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotshadow/Exports.h>
+#include <aws/iotshadow/IotShadowClientV2.h>
+
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <functional>
+#include <memory>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        class ShadowMirrorState;
+
+        /**
+         * Invoked once the mirror has completed its initial synchronization with the service.  The error code is
+         * AWS_ERROR_SUCCESS on success.
+         */
+        using ShadowMirrorSyncHandler = std::function<void(int errorCode)>;
+
+        /**
+         * Invoked with the delta section of every update/delta event received for the mirrored shadow.
+         */
+        using ShadowMirrorDeltaHandler = std::function<void(const Aws::Crt::JsonView &delta)>;
+
+        /**
+         * Local copy of the desired and reported state of a single (classic or named) shadow.
+         *
+         * The mirror subscribes to the update/documents and update/delta topics of its shadow and keeps the last state
+         * acknowledged by the service.  UpdateReported computes the difference between the requested reported state
+         * and the acknowledged one, with the updates still in flight applied on top, and only publishes the keys that
+         * changed.
+         *
+         * All functions are thread-safe.  Handlers are invoked from the client's event loop threads.
+         */
+        class AWS_IOTSHADOW_API ShadowMirror final
+        {
+          public:
+            /**
+             * @param client service client used for all shadow operations
+             * @param thingName name of the thing owning the shadow
+             * @param shadowName name of the shadow to mirror; the classic shadow is mirrored if not set
+             * @param allocator memory allocator to use for mirror state
+             */
+            ShadowMirror(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::Optional<Aws::Crt::String> &shadowName = {},
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            ~ShadowMirror();
+
+            ShadowMirror(const ShadowMirror &) = delete;
+            ShadowMirror &operator=(const ShadowMirror &) = delete;
+
+            /**
+             * Opens the update/documents and update/delta streams and fetches the current shadow document.  A shadow
+             * that does not exist yet is treated as empty.
+             *
+             * @param syncHandler invoked once the initial fetch completes
+             * @param deltaHandler optional handler for desired state changes the device has not reported yet
+             *
+             * @return success/failure
+             */
+            bool Start(const ShadowMirrorSyncHandler &syncHandler, const ShadowMirrorDeltaHandler &deltaHandler = {});
+
+            /**
+             * Requests that the reported section of the shadow become exactly the given document.  Only keys that
+             * differ from the last acknowledged reported state, with the updates still in flight applied on top, are
+             * published; keys that are no longer present are deleted.  If nothing changed, the handler is completed
+             * immediately without contacting the service.  If an update in flight fails, later updates that relied on
+             * it do not resend its keys.
+             *
+             * @param reported complete reported state
+             * @param handler function object to invoke upon operation completion
+             *
+             * @return success/failure
+             */
+            bool UpdateReported(const Aws::Crt::JsonView &reported, const UpdateShadowResultHandler &handler);
+
+            /**
+             * @return a copy of the last acknowledged reported state, if known
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonObject> GetReported() const;
+
+            /**
+             * @return a copy of the last known desired state, if known
+             */
+            Aws::Crt::Optional<Aws::Crt::JsonObject> GetDesired() const;
+
+            /**
+             * @return the last shadow document version observed by the mirror, if any
+             */
+            Aws::Crt::Optional<int32_t> GetVersion() const;
+
+          private:
+            std::shared_ptr<ShadowMirrorState> m_state;
+        };
+
+    } // namespace Iotshadow
+} // namespace Aws
@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotshadow/Exports.h>
+
+#include <aws/crt/JsonObject.h>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        /**
+         * Computes the smallest shadow state update that transforms one state section into another.
+         *
+         * Nested objects are compared key by key; all other values, including arrays, are compared as a whole.  Keys
+         * that are present in base but absent from target are emitted with a null value, which the Device Shadow
+         * service interprets as a deletion.
+         *
+         * @param base state section the service is known to hold
+         * @param target state section the caller wants the service to hold
+         * @param diff output parameter receiving the update document; only written when a difference is found
+         *
+         * @return true if base and target differ, false otherwise
+         */
+        AWS_IOTSHADOW_API bool ComputeShadowStateDiff(
+            const Aws::Crt::JsonView &base,
+            const Aws::Crt::JsonView &target,
+            Aws::Crt::JsonObject &diff);
+
+        /**
+         * Applies a shadow state update to a state section the same way the Device Shadow service does: objects are
+         * merged recursively, null values delete keys and all other values replace the existing value.
+         *
+         * @param base state section to update
+         * @param patch state update to apply
+         *
+         * @return the updated state section
+         */
+        AWS_IOTSHADOW_API Aws::Crt::JsonObject ApplyShadowStatePatch(
+            const Aws::Crt::JsonView &base,
+            const Aws::Crt::JsonView &patch);
+
+        /**
+         * Combines two shadow state updates into a single update with the same effect as applying older and then
+         * newer.  Unlike ApplyShadowStatePatch, null values are kept so that deletions still reach the service.
+         *
+         * Not every pair can be combined.  If older deletes a key or sets it to a non-object value and newer sets the
+         * same key to an object, applying the two in sequence replaces whatever the service held under the key,
+         * while a single update would merge into it.  Such pairs must be sent as separate updates.
+         *
+         * @param older update that was generated first
+         * @param newer update that was generated last; wins on every conflicting key
+         * @param merged output parameter receiving the combined update; only written on success
+         *
+         * @return true if the updates were combined, false if they must be sent separately
+         */
+        AWS_IOTSHADOW_API bool MergeShadowStatePatches(
+            const Aws::Crt::JsonView &older,
+            const Aws::Crt::JsonView &newer,
+            Aws::Crt::JsonObject &merged);
+
+    } // namespace Iotshadow
+} // namespace Aws
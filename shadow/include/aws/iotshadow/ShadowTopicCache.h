@@ -0,0 +1,148 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotshadow/Exports.h>
+
+#include <aws/crt/Types.h>
+#include <aws/iot/MqttRequestResponseClient.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        enum class ShadowTopicOperation
+        {
+            Delete,
+            Get,
+            Update,
+        };
+
+        /**
+         * Every topic needed to submit a single shadow request-response operation, along with cursors that point
+         * into the owned strings.  Never copied or moved once built so that the cursors stay valid.
+         */
+        struct AWS_IOTSHADOW_API ShadowOperationTopics
+        {
+            explicit ShadowOperationTopics(Aws::Crt::Allocator *allocator);
+
+            ShadowOperationTopics(const ShadowOperationTopics &) = delete;
+            ShadowOperationTopics &operator=(const ShadowOperationTopics &) = delete;
+
+            void Initialize(const Aws::Crt::String &prefix, const char *operation, bool wildcardSubscription);
+
+            Aws::Crt::String publishTopic;
+            Aws::Crt::String subscriptionTopic0;
+            Aws::Crt::String subscriptionTopic1;
+            size_t subscriptionTopicCount;
+            Aws::Crt::String responsePathTopicAccepted;
+            Aws::Crt::String responsePathTopicRejected;
+
+            struct aws_byte_cursor subscriptionTopicFilters[2];
+            struct aws_mqtt_request_operation_response_path responsePaths[2];
+        };
+
+        /**
+         * The pre-built topics for every request-response operation against a single (thing, shadow) pair.
+         * Immutable after construction, so in-flight requests can hold on to it without synchronization.
+         */
+        class AWS_IOTSHADOW_API ShadowTopicSet
+        {
+          public:
+            /**
+             * @param allocator memory allocator to use for the topics
+             * @param thingName name of the thing
+             * @param shadowName name of the shadow, or null for the classic shadow
+             * @param hash hash of the (thing, shadow) pair, as computed by ShadowTopicCache
+             */
+            ShadowTopicSet(
+                Aws::Crt::Allocator *allocator,
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::String *shadowName,
+                uint64_t hash);
+
+            ShadowTopicSet(const ShadowTopicSet &) = delete;
+            ShadowTopicSet &operator=(const ShadowTopicSet &) = delete;
+
+            bool Matches(const Aws::Crt::String &thingName, const Aws::Crt::String *shadowName) const;
+
+            uint64_t GetHash() const { return m_hash; }
+
+            const ShadowOperationTopics &GetTopics(ShadowTopicOperation operation) const;
+
+          private:
+            Aws::Crt::String m_thingName;
+            Aws::Crt::String m_shadowName;
+            bool m_isNamed;
+            uint64_t m_hash;
+
+            ShadowOperationTopics m_deleteTopics;
+            ShadowOperationTopics m_getTopics;
+            ShadowOperationTopics m_updateTopics;
+        };
+
+        /**
+         * Bounded LRU cache of topic sets keyed by (thing, shadow).  Lookups hash the request's names in place, so a
+         * hit performs no heap allocations.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTSHADOW_API ShadowTopicCache
+        {
+          public:
+            /**
+             * @param allocator memory allocator to use for the cache and its topic sets
+             * @param capacity maximum number of topic sets kept; the least recently used one is evicted beyond it
+             */
+            ShadowTopicCache(Aws::Crt::Allocator *allocator, size_t capacity);
+
+            ShadowTopicCache(const ShadowTopicCache &) = delete;
+            ShadowTopicCache &operator=(const ShadowTopicCache &) = delete;
+
+            /**
+             * Returns the topic set of a (thing, shadow) pair, building it on a miss, and marks it as the most
+             * recently used one.  Evicted topic sets stay valid for as long as they are referenced.
+             *
+             * @param thingName name of the thing
+             * @param shadowName name of the shadow, or null for the classic shadow
+             *
+             * @return the topic set of the pair
+             */
+            std::shared_ptr<const ShadowTopicSet> GetTopicSet(
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::String *shadowName);
+
+            /**
+             * @return the number of topic sets currently cached
+             */
+            size_t GetSize() const;
+
+          private:
+            using LruList = Aws::Crt::List<std::shared_ptr<const ShadowTopicSet>>;
+            using LruIndex = std::unordered_multimap<
+                uint64_t,
+                LruList::iterator,
+                std::hash<uint64_t>,
+                std::equal_to<uint64_t>,
+                Aws::Crt::StlAllocator<std::pair<const uint64_t, LruList::iterator>>>;
+
+            void Evict(LruList::iterator entry);
+
+            Aws::Crt::Allocator *m_allocator;
+            size_t m_capacity;
+
+            mutable std::mutex m_lock;
+            LruList m_lru;
+            LruIndex m_index;
+        };
+
+    } // namespace Iotshadow
+} // namespace Aws
@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotshadow/Exports.h>
+#include <aws/iotshadow/IotShadowClientV2.h>
+
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <functional>
+#include <memory>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        class ShadowDocument;
+        class ShadowState;
+        class ShadowTransactionState;
+
+        /**
+         * Computes a shadow state update from the current shadow document.
+         *
+         * The document exposes the state, metadata and version of the shadow; it has no version if the shadow does
+         * not exist yet.  The mutator may be invoked several times for a single commit if the update conflicts with
+         * a concurrent writer, and must therefore be free of side effects.  Returning false aborts the commit.
+         */
+        using ShadowTransactionMutator = std::function<bool(const ShadowDocument &current, ShadowState &update)>;
+
+        /**
+         * Read-modify-write helper for a single (classic or named) shadow using the service's optimistic
+         * concurrency control.
+         *
+         * The transaction caches the latest shadow document seen on the update/documents topic and on its own
+         * accepted updates, and sends updates with the cached version as the expected version.  The shadow is only
+         * fetched when nothing is cached yet or when the service rejects an update with a version conflict (409) and
+         * no newer document has been cached meanwhile; the mutator is then re-run against the fresh document.
+         * Commits that need the shadow while a fetch is in flight wait for that fetch instead of issuing another.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTSHADOW_API ShadowTransaction final
+        {
+          public:
+            /**
+             * @param client service client used for all shadow operations
+             * @param thingName name of the thing owning the shadow
+             * @param shadowName name of the shadow; the classic shadow is used if not set
+             * @param maxAttempts maximum number of update attempts per commit, including the first one
+             * @param allocator memory allocator to use for transaction state
+             */
+            ShadowTransaction(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::Optional<Aws::Crt::String> &shadowName = {},
+                uint32_t maxAttempts = 3,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            ~ShadowTransaction();
+
+            ShadowTransaction(const ShadowTransaction &) = delete;
+            ShadowTransaction &operator=(const ShadowTransaction &) = delete;
+
+            /**
+             * Opens the update/documents stream used to keep the cached document current.  Commits work without it,
+             * but will then need a fetch whenever another writer changed the shadow.
+             *
+             * @return success/failure
+             */
+            bool Start();
+
+            /**
+             * Runs the mutator against the cached document and sends the resulting update with the cached version.
+             * On a version conflict the shadow is fetched and the mutator re-run, up to the configured number of
+             * attempts.  If the mutator aborts, the handler receives AWS_ERROR_INVALID_STATE.
+             *
+             * @param mutator computes the update to send
+             * @param handler function object to invoke upon operation completion
+             *
+             * @return success/failure
+             */
+            bool Commit(const ShadowTransactionMutator &mutator, const UpdateShadowResultHandler &handler);
+
+            /**
+             * @return the version of the cached shadow document, if any
+             */
+            Aws::Crt::Optional<int32_t> GetCachedVersion() const;
+
+          private:
+            std::shared_ptr<ShadowTransactionState> m_state;
+        };
+
+    } // namespace Iotshadow
+} // namespace Aws
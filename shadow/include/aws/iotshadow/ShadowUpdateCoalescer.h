@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/iotshadow/Exports.h>
+#include <aws/iotshadow/IotShadowClientV2.h>
+
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Optional.h>
+#include <aws/crt/Types.h>
+
+#include <chrono>
+#include <memory>
+
+namespace Aws
+{
+    namespace Crt
+    {
+        namespace Io
+        {
+            class EventLoopGroup;
+        }
+    } // namespace Crt
+
+    namespace Iotshadow
+    {
+
+        class ShadowUpdateCoalescerState;
+
+        /**
+         * Configuration options for a ShadowUpdateCoalescer.
+         */
+        class AWS_IOTSHADOW_API ShadowUpdateCoalescerOptions final
+        {
+          public:
+            ShadowUpdateCoalescerOptions() = default;
+
+            /**
+             * Sets how long the first pending update of a shadow waits for further updates before being sent.  A
+             * window of zero only coalesces updates issued while a previous update of the same shadow is in flight.
+             * A non-zero window requires an event loop group.
+             *
+             * @param window coalescing window
+             * @return reference to this options object
+             */
+            ShadowUpdateCoalescerOptions &WithCoalescingWindow(std::chrono::milliseconds window);
+
+            /**
+             * Sets the serialized size of pending updates at which a shadow's pending updates are sent without
+             * waiting for the coalescing window to elapse.  Zero disables the limit.
+             *
+             * @param maxPendingBytes byte budget per shadow
+             * @return reference to this options object
+             */
+            ShadowUpdateCoalescerOptions &WithMaxPendingBytes(size_t maxPendingBytes);
+
+            /**
+             * Sets the event loop group used to schedule coalescing window expirations.  The group must outlive the
+             * coalescer.
+             *
+             * @param eventLoopGroup event loop group to schedule timers on
+             * @return reference to this options object
+             */
+            ShadowUpdateCoalescerOptions &WithEventLoopGroup(Aws::Crt::Io::EventLoopGroup &eventLoopGroup);
+
+            std::chrono::milliseconds GetCoalescingWindow() const { return m_coalescingWindow; }
+
+            size_t GetMaxPendingBytes() const { return m_maxPendingBytes; }
+
+            Aws::Crt::Io::EventLoopGroup *GetEventLoopGroup() const { return m_eventLoopGroup; }
+
+          private:
+            std::chrono::milliseconds m_coalescingWindow{0};
+            size_t m_maxPendingBytes = 0;
+            Aws::Crt::Io::EventLoopGroup *m_eventLoopGroup = nullptr;
+        };
+
+        /**
+         * Opt-in write-behind layer that merges reported state updates per shadow.
+         *
+         * Updates to the same (thing, shadow) pair are merged key by key, with later updates winning, and sent as a
+         * single update request.  An update that cannot be merged with the previous one, see
+         * MergeShadowStatePatches, starts a new request instead, sent after the previous one.  At most one update per
+         * shadow is in flight at a time; updates issued meanwhile are merged and sent once it completes.  Every
+         * caller's handler is completed from the response to the merged request its update was part of.
+         *
+         * All functions are thread-safe.
+         */
+        class AWS_IOTSHADOW_API ShadowUpdateCoalescer final
+        {
+          public:
+            /**
+             * @param client service client used to send the merged updates
+             * @param options coalescing configuration
+             * @param allocator memory allocator to use for coalescer state
+             */
+            ShadowUpdateCoalescer(
+                std::shared_ptr<IClientV2> client,
+                const ShadowUpdateCoalescerOptions &options,
+                Aws::Crt::Allocator *allocator = Aws::Crt::ApiAllocator());
+
+            /**
+             * Sends all pending updates.  Handlers of updates still in flight are completed normally.
+             */
+            ~ShadowUpdateCoalescer();
+
+            ShadowUpdateCoalescer(const ShadowUpdateCoalescer &) = delete;
+            ShadowUpdateCoalescer &operator=(const ShadowUpdateCoalescer &) = delete;
+
+            /**
+             * Queues a (partial) reported state update for a shadow.
+             *
+             * @param thingName name of the thing owning the shadow
+             * @param shadowName name of the shadow; the classic shadow is updated if not set
+             * @param reported reported state keys to update.  Null values delete keys.
+             * @param handler function object to invoke upon completion of the merged update
+             *
+             * @return success/failure
+             */
+            bool UpdateReported(
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::Optional<Aws::Crt::String> &shadowName,
+                const Aws::Crt::JsonView &reported,
+                const UpdateShadowResultHandler &handler);
+
+            /**
+             * Sends the pending updates of every shadow that does not have an update in flight, without waiting for
+             * the coalescing window to elapse.
+             */
+            void Flush();
+
+            /**
+             * @return true if the coalescer was configured successfully, false otherwise
+             */
+            explicit operator bool() const noexcept;
+
+          private:
+            std::shared_ptr<ShadowUpdateCoalescerState> m_state;
+        };
+
+    } // namespace Iotshadow
+} // namespace Aws
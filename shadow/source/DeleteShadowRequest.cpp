@@ -5,6 +5,8 @@
  */
 #include <aws/iotshadow/DeleteShadowRequest.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotshadow
@@ -31,6 +33,16 @@ namespace Aws
             }
         }
 
+        void DeleteShadowRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (ClientToken)
+            {
+                writer.WithString("clientToken", *ClientToken);
+            }
+        }
+
         DeleteShadowRequest::DeleteShadowRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
@@ -5,6 +5,9 @@
  */
 #include <aws/iotshadow/IotShadowClient.h>
 
+#include <aws/iotdevicecommon/MqttSubscriptionRegistry.h>
+#include <aws/iotdevicecommon/TopicBuilder.h>
+
 #include <aws/iotshadow/DeleteNamedShadowRequest.h>
 #include <aws/iotshadow/DeleteNamedShadowSubscriptionRequest.h>
 #include <aws/iotshadow/DeleteShadowRequest.h>
@@ -53,6 +56,11 @@ namespace Aws
             return aws_last_error();
         }
 
+        void IotShadowClient::ReleaseSubscriptions()
+        {
+            Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection)->ReleaseOwner(this);
+        }
+
         bool IotShadowClient::SubscribeToDeleteNamedShadowAccepted(
             const Aws::Iotshadow::DeleteNamedShadowSubscriptionRequest &request,
             Aws::Crt::Mqtt::QOS qos,
@@ -79,21 +87,30 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::DeleteShadowResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::DeleteShadowResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/delete/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append(
+                "$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/delete/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -125,21 +142,30 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ErrorResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ErrorResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/delete/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append(
+                "$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/delete/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -171,20 +197,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::DeleteShadowResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::DeleteShadowResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/delete/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/shadow/delete/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -216,20 +251,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ErrorResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ErrorResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/delete/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/shadow/delete/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -261,21 +305,30 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::GetShadowResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::GetShadowResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/get/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append(
+                "$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/get/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -307,21 +360,30 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ErrorResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ErrorResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/get/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append(
+                "$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/get/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -353,20 +415,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::GetShadowResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::GetShadowResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/get/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/shadow/get/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -398,20 +469,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ErrorResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ErrorResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/get/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/shadow/get/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -443,21 +523,30 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ShadowDeltaUpdatedEvent response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ShadowDeltaUpdatedEvent>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/update/delta";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append(
+                "$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/update/delta");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -489,21 +578,30 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ShadowUpdatedEvent response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ShadowUpdatedEvent>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/update/documents";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append(
+                "$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/update/documents");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -535,20 +633,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ShadowDeltaUpdatedEvent response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ShadowDeltaUpdatedEvent>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/update/delta";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/shadow/update/delta");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -580,20 +687,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ShadowUpdatedEvent response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ShadowUpdatedEvent>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/update/documents";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/shadow/update/documents");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -625,21 +741,30 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::UpdateShadowResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::UpdateShadowResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/update/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append(
+                "$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/update/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -671,21 +796,30 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ErrorResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ErrorResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/update/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append(
+                "$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/update/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -717,20 +851,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::UpdateShadowResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::UpdateShadowResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/update/accepted";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/shadow/update/accepted");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -762,20 +905,29 @@ namespace Aws
                 }
             };
 
-            auto onSubscribePublish =
-                [handler](Aws::Crt::Mqtt::MqttConnection &, const Aws::Crt::String &, const Aws::Crt::ByteBuf &payload)
+            auto onSubscribePublish = [handler](
+                                          Aws::Crt::Mqtt::MqttConnection &,
+                                          const Aws::Crt::String &,
+                                          const Aws::Crt::ByteBuf &payload,
+                                          Aws::Iotdevicecommon::MqttMessageCache &cache)
             {
-                Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.buffer), payload.len);
-                Aws::Crt::JsonObject jsonObject(objectStr);
-                Aws::Iotshadow::ErrorResponse response(jsonObject);
-                handler(&response, AWS_ERROR_SUCCESS);
+                auto response = cache.DecodeJsonValue<Aws::Iotshadow::ErrorResponse>(payload);
+                if (!response.has_value())
+                {
+                    handler(nullptr, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                    return;
+                }
+
+                handler(&response.value(), AWS_ERROR_SUCCESS);
             };
 
-            Aws::Crt::StringStream subscribeTopicSStr;
-            subscribeTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/update/rejected";
+            Aws::Iotdevicecommon::TopicBuilder subscribeTopic;
+            subscribeTopic.Append("$aws/things/", *request.ThingName, "/shadow/update/rejected");
 
-            return m_connection->Subscribe(
-                       subscribeTopicSStr.str().c_str(),
+            auto registry = Aws::Iotdevicecommon::MqttSubscriptionRegistry::ForConnection(m_connection);
+            return registry->Subscribe(
+                       this,
+                       subscribeTopic.c_str(),
                        qos,
                        std::move(onSubscribePublish),
                        std::move(onSubscribeComplete)) != 0;
@@ -786,9 +938,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                             << "/delete";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/delete");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -803,7 +954,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotShadowClient::PublishDeleteShadow(
@@ -811,8 +962,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/delete";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/shadow/delete");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -827,7 +978,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotShadowClient::PublishGetNamedShadow(
@@ -835,9 +986,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                             << "/get";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/get");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -852,7 +1002,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotShadowClient::PublishGetShadow(
@@ -860,8 +1010,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/get";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/shadow/get");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -876,7 +1026,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotShadowClient::PublishUpdateNamedShadow(
@@ -884,9 +1034,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                             << "/update";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/update");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -901,7 +1050,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
         bool IotShadowClient::PublishUpdateShadow(
@@ -909,8 +1058,8 @@ namespace Aws
             Aws::Crt::Mqtt::QOS qos,
             const OnPublishComplete &onPubAck)
         {
-            Aws::Crt::StringStream publishTopicSStr;
-            publishTopicSStr << "$aws/things/" << *request.ThingName << "/shadow/update";
+            Aws::Iotdevicecommon::TopicBuilder publishTopic;
+            publishTopic.Append("$aws/things/", *request.ThingName, "/shadow/update");
 
             Aws::Crt::JsonObject jsonObject;
             request.SerializeToObject(jsonObject);
@@ -925,7 +1074,7 @@ namespace Aws
             };
 
             return m_connection->Publish(
-                       publishTopicSStr.str().c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
+                       publishTopic.c_str(), qos, false, buf, std::move(onPublishComplete)) != 0;
         }
 
     } // namespace Iotshadow
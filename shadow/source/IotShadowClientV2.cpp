@@ -5,7 +5,10 @@
  */
 #include <aws/iotshadow/IotShadowClientV2.h>
 
-#include <aws/crt/UUID.h>
+#include <aws/common/hash_table.h>
+#include <aws/iotdevicecommon/CorrelationTokenGenerator.h>
+#include <aws/iotdevicecommon/JsonWriter.h>
+#include <aws/iotdevicecommon/TopicBuilder.h>
 
 #include <aws/iotshadow/DeleteNamedShadowRequest.h>
 #include <aws/iotshadow/DeleteShadowRequest.h>
@@ -17,24 +20,36 @@
 #include <aws/iotshadow/NamedShadowUpdatedSubscriptionRequest.h>
 #include <aws/iotshadow/ShadowDeltaUpdatedEvent.h>
 #include <aws/iotshadow/ShadowDeltaUpdatedSubscriptionRequest.h>
+#include <aws/iotshadow/ShadowDocument.h>
 #include <aws/iotshadow/ShadowUpdatedEvent.h>
+#include <aws/iotshadow/ShadowTopicCache.h>
 #include <aws/iotshadow/ShadowUpdatedSubscriptionRequest.h>
 #include <aws/iotshadow/UpdateNamedShadowRequest.h>
 #include <aws/iotshadow/UpdateShadowRequest.h>
 #include <aws/iotshadow/UpdateShadowResponse.h>
 #include <aws/iotshadow/V2ErrorResponse.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace Aws
 {
     namespace Iotshadow
     {
 
+        /*
+         * Upper bound on the number of (thing, shadow) pairs whose request topics are kept pre-built.  Entries are
+         * only created on first use and cost roughly a kilobyte each.
+         */
+        static const size_t SHADOW_TOPIC_CACHE_CAPACITY = 1024;
+
         class ClientV2 : public IClientV2
         {
           public:
             ClientV2(
                 Aws::Crt::Allocator *allocator,
-                std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient);
+                std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+                std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator);
             virtual ~ClientV2() = default;
 
             bool DeleteNamedShadow(
@@ -70,21 +85,110 @@ namespace Aws
                 const ShadowUpdatedSubscriptionRequest &request,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowUpdatedEvent> &options) override;
 
+            bool GetNamedShadowDocument(
+                const GetNamedShadowRequest &request,
+                const GetShadowDocumentResultHandler &handler) override;
+
+            bool GetShadowDocument(const GetShadowRequest &request, const GetShadowDocumentResultHandler &handler)
+                override;
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateNamedShadowDeltaUpdatedDocumentStream(
+                const NamedShadowDeltaUpdatedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options) override;
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateNamedShadowUpdatedDocumentStream(
+                const NamedShadowUpdatedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options) override;
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateShadowDeltaUpdatedDocumentStream(
+                const ShadowDeltaUpdatedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options) override;
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateShadowUpdatedDocumentStream(
+                const ShadowUpdatedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options) override;
+
+            std::shared_ptr<INamedShadowMultiplexedStream<ShadowDeltaUpdatedEvent>>
+                CreateNamedShadowDeltaUpdatedMultiplexedStream(
+                    const Aws::Crt::String &thingName,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDeltaUpdatedEvent> &options)
+                    override;
+
+            std::shared_ptr<INamedShadowMultiplexedStream<ShadowUpdatedEvent>>
+                CreateNamedShadowUpdatedMultiplexedStream(
+                    const Aws::Crt::String &thingName,
+                    const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowUpdatedEvent> &options) override;
+
           private:
+            bool SubmitGetShadowDocumentRequest(
+                const std::shared_ptr<const ShadowTopicSet> &topicSet,
+                struct aws_byte_cursor outgoingJson,
+                struct aws_byte_cursor correlationToken,
+                const GetShadowDocumentResultHandler &handler);
+
+            int SubmitShadowRequest(
+                const ShadowOperationTopics &topics,
+                struct aws_byte_cursor outgoingJson,
+                struct aws_byte_cursor correlationToken,
+                Aws::Iot::RequestResponse::UnmodeledResultHandler &&resultHandler);
+
             Aws::Crt::Allocator *m_allocator;
 
             std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> m_bindingClient;
+
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> m_correlationTokenGenerator;
+
+            ShadowTopicCache m_topicCache;
         };
 
         ClientV2::ClientV2(
             Aws::Crt::Allocator *allocator,
-            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient)
-            : m_allocator(allocator), m_bindingClient(std::move(bindingClient))
+            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator)
+            : m_allocator(allocator), m_bindingClient(std::move(bindingClient)),
+              m_correlationTokenGenerator(std::move(correlationTokenGenerator)),
+              m_topicCache(allocator, SHADOW_TOPIC_CACHE_CAPACITY)
         {
+            if (!m_correlationTokenGenerator)
+            {
+                m_correlationTokenGenerator =
+                    Aws::Crt::MakeShared<Aws::Iotdevicecommon::UuidCorrelationTokenGenerator>(allocator);
+            }
+
             // It's simpler to do this than branch the codegen based on the presence of streaming operations
             (void)m_allocator;
         }
 
+        int ClientV2::SubmitShadowRequest(
+            const ShadowOperationTopics &topics,
+            struct aws_byte_cursor outgoingJson,
+            struct aws_byte_cursor correlationToken,
+            Aws::Iot::RequestResponse::UnmodeledResultHandler &&resultHandler)
+        {
+            struct aws_byte_cursor subscriptionTopicFilters[2] = {
+                topics.subscriptionTopicFilters[0],
+                topics.subscriptionTopicFilters[1],
+            };
+
+            struct aws_mqtt_request_operation_response_path responsePaths[2] = {
+                topics.responsePaths[0],
+                topics.responsePaths[1],
+            };
+
+            struct aws_mqtt_request_operation_options options;
+            AWS_ZERO_STRUCT(options);
+            options.subscription_topic_filters = subscriptionTopicFilters;
+            options.subscription_topic_filter_count = topics.subscriptionTopicCount;
+            options.response_paths = responsePaths;
+            options.response_path_count = 2;
+            options.publish_topic = Aws::Crt::ByteCursorFromString(topics.publishTopic);
+            options.serialized_request = outgoingJson;
+
+            options.correlation_token = correlationToken;
+
+            return m_bindingClient->SubmitRequest(options, std::move(resultHandler));
+        }
+
         template <typename R, typename E>
         static void s_applyUnmodeledErrorToHandler(const std::function<void(R &&)> &handler, int errorCode)
         {
@@ -116,7 +220,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -126,86 +240,56 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 DeleteShadowResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<DeleteShadowResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::DeleteNamedShadow(
             const DeleteNamedShadowRequest &request,
             const DeleteNamedShadowResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/delete";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
-
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                                     << "/delete/+";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
-
-            struct aws_byte_cursor subscriptionTopicFilters[1] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
-            };
-
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
-
-            struct aws_mqtt_request_operation_response_path responsePaths[2];
-            responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
-            responsePaths[1].topic = Aws::Crt::ByteCursorFromString(responsePathTopicRejected);
-            responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-            responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
-
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
+            auto topicSet = m_topicCache.GetTopicSet(*request.ThingName, &*request.ShadowName);
+            const ShadowOperationTopics &topics = topicSet->GetTopics(ShadowTopicOperation::Delete);
 
-            struct aws_mqtt_request_operation_options options;
-            AWS_ZERO_STRUCT(options);
-            options.subscription_topic_filters = subscriptionTopicFilters;
-            options.subscription_topic_filter_count = 1;
-            options.response_paths = responsePaths;
-            options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
-            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
-                                     Aws::Iot::RequestResponse::UnmodeledResult &&result)
+            auto resultHandler = [handler, topicSet](Aws::Iot::RequestResponse::UnmodeledResult &&result)
             {
+                const ShadowOperationTopics &resultTopics = topicSet->GetTopics(ShadowTopicOperation::Delete);
                 s_DeleteNamedShadowResponseHandler(
-                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                    std::move(result),
+                    handler,
+                    resultTopics.responsePathTopicAccepted,
+                    resultTopics.responsePathTopicRejected);
             };
 
-            int submitResult = m_bindingClient->SubmitRequest(options, std::move(resultHandler));
+            int submitResult =
+                SubmitShadowRequest(topics, writer.ToCursor(), correlationToken.ToCursor(), std::move(resultHandler));
 
             return submitResult == AWS_OP_SUCCESS;
         }
@@ -225,7 +309,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -235,81 +329,54 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 DeleteShadowResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<DeleteShadowResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::DeleteShadow(const DeleteShadowRequest &request, const DeleteShadowResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/shadow/delete";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
-
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/shadow/delete/+";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
-
-            struct aws_byte_cursor subscriptionTopicFilters[1] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
-            };
-
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            auto topicSet = m_topicCache.GetTopicSet(*request.ThingName, nullptr);
+            const ShadowOperationTopics &topics = topicSet->GetTopics(ShadowTopicOperation::Delete);
 
-            struct aws_mqtt_request_operation_response_path responsePaths[2];
-            responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
-            responsePaths[1].topic = Aws::Crt::ByteCursorFromString(responsePathTopicRejected);
-            responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-            responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
-
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
-
-            struct aws_mqtt_request_operation_options options;
-            AWS_ZERO_STRUCT(options);
-            options.subscription_topic_filters = subscriptionTopicFilters;
-            options.subscription_topic_filter_count = 1;
-            options.response_paths = responsePaths;
-            options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
-            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
-                                     Aws::Iot::RequestResponse::UnmodeledResult &&result) {
+            auto resultHandler = [handler, topicSet](Aws::Iot::RequestResponse::UnmodeledResult &&result)
+            {
+                const ShadowOperationTopics &resultTopics = topicSet->GetTopics(ShadowTopicOperation::Delete);
                 s_DeleteShadowResponseHandler(
-                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                    std::move(result),
+                    handler,
+                    resultTopics.responsePathTopicAccepted,
+                    resultTopics.responsePathTopicRejected);
             };
 
-            int submitResult = m_bindingClient->SubmitRequest(options, std::move(resultHandler));
+            int submitResult =
+                SubmitShadowRequest(topics, writer.ToCursor(), correlationToken.ToCursor(), std::move(resultHandler));
 
             return submitResult == AWS_OP_SUCCESS;
         }
@@ -329,7 +396,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -339,83 +416,54 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 GetShadowResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<GetShadowResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::GetNamedShadow(const GetNamedShadowRequest &request, const GetNamedShadowResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/get";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
+            auto topicSet = m_topicCache.GetTopicSet(*request.ThingName, &*request.ShadowName);
+            const ShadowOperationTopics &topics = topicSet->GetTopics(ShadowTopicOperation::Get);
 
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                                     << "/get/+";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
-
-            struct aws_byte_cursor subscriptionTopicFilters[1] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
-            };
-
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
-
-            struct aws_mqtt_request_operation_response_path responsePaths[2];
-            responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
-            responsePaths[1].topic = Aws::Crt::ByteCursorFromString(responsePathTopicRejected);
-            responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-            responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
-
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
-
-            struct aws_mqtt_request_operation_options options;
-            AWS_ZERO_STRUCT(options);
-            options.subscription_topic_filters = subscriptionTopicFilters;
-            options.subscription_topic_filter_count = 1;
-            options.response_paths = responsePaths;
-            options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
-            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
-                                     Aws::Iot::RequestResponse::UnmodeledResult &&result) {
+            auto resultHandler = [handler, topicSet](Aws::Iot::RequestResponse::UnmodeledResult &&result)
+            {
+                const ShadowOperationTopics &resultTopics = topicSet->GetTopics(ShadowTopicOperation::Get);
                 s_GetNamedShadowResponseHandler(
-                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                    std::move(result),
+                    handler,
+                    resultTopics.responsePathTopicAccepted,
+                    resultTopics.responsePathTopicRejected);
             };
 
-            int submitResult = m_bindingClient->SubmitRequest(options, std::move(resultHandler));
+            int submitResult =
+                SubmitShadowRequest(topics, writer.ToCursor(), correlationToken.ToCursor(), std::move(resultHandler));
 
             return submitResult == AWS_OP_SUCCESS;
         }
@@ -435,7 +483,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -445,85 +503,182 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 GetShadowResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<GetShadowResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::GetShadow(const GetShadowRequest &request, const GetShadowResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/shadow/get";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
+            auto topicSet = m_topicCache.GetTopicSet(*request.ThingName, nullptr);
+            const ShadowOperationTopics &topics = topicSet->GetTopics(ShadowTopicOperation::Get);
+
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/shadow/get/+";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
-            struct aws_byte_cursor subscriptionTopicFilters[1] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
+            auto resultHandler = [handler, topicSet](Aws::Iot::RequestResponse::UnmodeledResult &&result)
+            {
+                const ShadowOperationTopics &resultTopics = topicSet->GetTopics(ShadowTopicOperation::Get);
+                s_GetShadowResponseHandler(
+                    std::move(result),
+                    handler,
+                    resultTopics.responsePathTopicAccepted,
+                    resultTopics.responsePathTopicRejected);
             };
 
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
+            int submitResult =
+                SubmitShadowRequest(topics, writer.ToCursor(), correlationToken.ToCursor(), std::move(resultHandler));
 
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            return submitResult == AWS_OP_SUCCESS;
+        }
 
-            struct aws_mqtt_request_operation_response_path responsePaths[2];
-            responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
-            responsePaths[1].topic = Aws::Crt::ByteCursorFromString(responsePathTopicRejected);
-            responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-            responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
+        static void s_GetShadowDocumentResponseHandler(
+            Aws::Iot::RequestResponse::UnmodeledResult &&result,
+            const GetShadowDocumentResultHandler &handler,
+            Aws::Crt::Allocator *allocator,
+            const Aws::Crt::String &successPathTopic,
+            const Aws::Crt::String &failurePathTopic)
+        {
+            using E = V2ErrorResponse;
+            using R = GetShadowDocumentResult;
 
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
+            if (!result.IsSuccess())
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, result.GetError());
+                return;
+            }
 
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
 
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
+            const auto &payload = response.GetPayload();
+            Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
+            Aws::Crt::JsonObject jsonObject(objectStr);
+            if (!jsonObject.WasParseSuccessful())
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_PAYLOAD_PARSE_ERROR);
+                return;
+            }
 
-            struct aws_mqtt_request_operation_options options;
-            AWS_ZERO_STRUCT(options);
-            options.subscription_topic_filters = subscriptionTopicFilters;
-            options.subscription_topic_filter_count = 1;
-            options.response_paths = responsePaths;
-            options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            if (isSuccessPath)
+            {
+                ShadowDocument document(std::move(jsonObject), allocator);
+                R finalResult(std::move(document));
+                handler(std::move(finalResult));
+            }
+            else
+            {
+                V2ErrorResponse modeledError(jsonObject);
+                s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
+            }
+        }
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+        bool ClientV2::SubmitGetShadowDocumentRequest(
+            const std::shared_ptr<const ShadowTopicSet> &topicSet,
+            struct aws_byte_cursor outgoingJson,
+            struct aws_byte_cursor correlationToken,
+            const GetShadowDocumentResultHandler &handler)
+        {
+            const ShadowOperationTopics &topics = topicSet->GetTopics(ShadowTopicOperation::Get);
 
-            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
-                                     Aws::Iot::RequestResponse::UnmodeledResult &&result) {
-                s_GetShadowResponseHandler(
-                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+            Aws::Crt::Allocator *allocator = m_allocator;
+            auto resultHandler = [handler, allocator, topicSet](Aws::Iot::RequestResponse::UnmodeledResult &&result)
+            {
+                const ShadowOperationTopics &resultTopics = topicSet->GetTopics(ShadowTopicOperation::Get);
+                s_GetShadowDocumentResponseHandler(
+                    std::move(result),
+                    handler,
+                    allocator,
+                    resultTopics.responsePathTopicAccepted,
+                    resultTopics.responsePathTopicRejected);
             };
 
-            int submitResult = m_bindingClient->SubmitRequest(options, std::move(resultHandler));
+            int submitResult = SubmitShadowRequest(topics, outgoingJson, correlationToken, std::move(resultHandler));
 
             return submitResult == AWS_OP_SUCCESS;
         }
 
+        bool ClientV2::GetNamedShadowDocument(
+            const GetNamedShadowRequest &request,
+            const GetShadowDocumentResultHandler &handler)
+        {
+            auto topicSet = m_topicCache.GetTopicSet(*request.ThingName, &*request.ShadowName);
+
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
+
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
+
+            return SubmitGetShadowDocumentRequest(topicSet, writer.ToCursor(), correlationToken.ToCursor(), handler);
+        }
+
+        bool ClientV2::GetShadowDocument(const GetShadowRequest &request, const GetShadowDocumentResultHandler &handler)
+        {
+            auto topicSet = m_topicCache.GetTopicSet(*request.ThingName, nullptr);
+
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
+
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
+
+            return SubmitGetShadowDocumentRequest(topicSet, writer.ToCursor(), correlationToken.ToCursor(), handler);
+        }
+
         static void s_UpdateNamedShadowResponseHandler(
             Aws::Iot::RequestResponse::UnmodeledResult &&result,
             const UpdateNamedShadowResultHandler &handler,
@@ -539,7 +694,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -549,92 +714,56 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 UpdateShadowResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<UpdateShadowResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::UpdateNamedShadow(
             const UpdateNamedShadowRequest &request,
             const UpdateNamedShadowResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                               << "/update";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
-
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                                     << "/update/accepted";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
-
-            Aws::Crt::StringStream subscriptionTopicStream1;
-            subscriptionTopicStream1 << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                                     << "/update/rejected";
-            Aws::Crt::String subscriptionTopic1 = subscriptionTopicStream1.str();
-
-            struct aws_byte_cursor subscriptionTopicFilters[2] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
-                Aws::Crt::ByteCursorFromString(subscriptionTopic1),
-            };
-
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
+            auto topicSet = m_topicCache.GetTopicSet(*request.ThingName, &*request.ShadowName);
+            const ShadowOperationTopics &topics = topicSet->GetTopics(ShadowTopicOperation::Update);
 
-            struct aws_mqtt_request_operation_response_path responsePaths[2];
-            responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
-            responsePaths[1].topic = Aws::Crt::ByteCursorFromString(responsePathTopicRejected);
-            responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-            responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
-
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
-
-            struct aws_mqtt_request_operation_options options;
-            AWS_ZERO_STRUCT(options);
-            options.subscription_topic_filters = subscriptionTopicFilters;
-            options.subscription_topic_filter_count = 2;
-            options.response_paths = responsePaths;
-            options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
-            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
-                                     Aws::Iot::RequestResponse::UnmodeledResult &&result)
+            auto resultHandler = [handler, topicSet](Aws::Iot::RequestResponse::UnmodeledResult &&result)
             {
+                const ShadowOperationTopics &resultTopics = topicSet->GetTopics(ShadowTopicOperation::Update);
                 s_UpdateNamedShadowResponseHandler(
-                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                    std::move(result),
+                    handler,
+                    resultTopics.responsePathTopicAccepted,
+                    resultTopics.responsePathTopicRejected);
             };
 
-            int submitResult = m_bindingClient->SubmitRequest(options, std::move(resultHandler));
+            int submitResult =
+                SubmitShadowRequest(topics, writer.ToCursor(), correlationToken.ToCursor(), std::move(resultHandler));
 
             return submitResult == AWS_OP_SUCCESS;
         }
@@ -654,7 +783,17 @@ namespace Aws
                 return;
             }
 
-            auto response = result.GetResponse();
+            const auto &response = result.GetResponse();
+            const auto &topic = response.GetTopic();
+            auto successPathCursor = Aws::Crt::ByteCursorFromString(successPathTopic);
+            auto failurePathCursor = Aws::Crt::ByteCursorFromString(failurePathTopic);
+            bool isSuccessPath = aws_byte_cursor_eq(&topic, &successPathCursor);
+            if (!isSuccessPath && !aws_byte_cursor_eq(&topic, &failurePathCursor))
+            {
+                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
+                return;
+            }
+
             const auto &payload = response.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -664,94 +803,64 @@ namespace Aws
                 return;
             }
 
-            const auto &topic = response.GetTopic();
-            auto responseTopic = Aws::Crt::String((const char *)topic.ptr, topic.len);
-            if (responseTopic == successPathTopic)
+            if (isSuccessPath)
             {
                 UpdateShadowResponse modeledResponse(jsonObject);
                 Aws::Iot::RequestResponse::Result<UpdateShadowResponse, ServiceErrorV2<E>> finalResult(
                     std::move(modeledResponse));
                 handler(std::move(finalResult));
             }
-            else if (responseTopic == failurePathTopic)
+            else
             {
                 V2ErrorResponse modeledError(jsonObject);
                 s_applyModeledErrorToHandler<R, E>(handler, std::move(modeledError));
             }
-            else
-            {
-                s_applyUnmodeledErrorToHandler<R, E>(handler, AWS_ERROR_MQTT_REQUEST_RESPONSE_INVALID_RESPONSE_PATH);
-            }
         }
 
         bool ClientV2::UpdateShadow(const UpdateShadowRequest &request, const UpdateShadowResultHandler &handler)
         {
-            Aws::Crt::StringStream publishTopicStream;
-            publishTopicStream << "$aws/things/" << *request.ThingName << "/shadow/update";
-            Aws::Crt::String publishTopic = publishTopicStream.str();
-
-            Aws::Crt::StringStream subscriptionTopicStream0;
-            subscriptionTopicStream0 << "$aws/things/" << *request.ThingName << "/shadow/update/accepted";
-            Aws::Crt::String subscriptionTopic0 = subscriptionTopicStream0.str();
+            auto topicSet = m_topicCache.GetTopicSet(*request.ThingName, nullptr);
+            const ShadowOperationTopics &topics = topicSet->GetTopics(ShadowTopicOperation::Update);
 
-            Aws::Crt::StringStream subscriptionTopicStream1;
-            subscriptionTopicStream1 << "$aws/things/" << *request.ThingName << "/shadow/update/rejected";
-            Aws::Crt::String subscriptionTopic1 = subscriptionTopicStream1.str();
-
-            struct aws_byte_cursor subscriptionTopicFilters[2] = {
-                Aws::Crt::ByteCursorFromString(subscriptionTopic0),
-                Aws::Crt::ByteCursorFromString(subscriptionTopic1),
-            };
-
-            Aws::Crt::StringStream responsePathTopicAcceptedStream;
-            responsePathTopicAcceptedStream << publishTopic << "/accepted";
-            Aws::Crt::String responsePathTopicAccepted = responsePathTopicAcceptedStream.str();
-
-            Aws::Crt::StringStream responsePathTopicRejectedStream;
-            responsePathTopicRejectedStream << publishTopic << "/rejected";
-            Aws::Crt::String responsePathTopicRejected = responsePathTopicRejectedStream.str();
-
-            struct aws_mqtt_request_operation_response_path responsePaths[2];
-            responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
-            responsePaths[1].topic = Aws::Crt::ByteCursorFromString(responsePathTopicRejected);
-            responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-            responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
-
-            Aws::Crt::JsonObject jsonObject;
-            request.SerializeToObject(jsonObject);
-
-            auto uuid = Aws::Crt::UUID().ToString();
-            jsonObject.WithString("clientToken", uuid);
-
-            Aws::Crt::String outgoingJson = jsonObject.View().WriteCompact(true);
-
-            struct aws_mqtt_request_operation_options options;
-            AWS_ZERO_STRUCT(options);
-            options.subscription_topic_filters = subscriptionTopicFilters;
-            options.subscription_topic_filter_count = 2;
-            options.response_paths = responsePaths;
-            options.response_path_count = 2;
-            options.publish_topic = Aws::Crt::ByteCursorFromString(publishTopic);
-            options.serialized_request =
-                Aws::Crt::ByteCursorFromArray((uint8_t *)outgoingJson.data(), outgoingJson.length());
+            Aws::Iotdevicecommon::CorrelationToken correlationToken;
+            if (!m_correlationTokenGenerator->Generate(correlationToken))
+            {
+                return false;
+            }
 
-            options.correlation_token = Aws::Crt::ByteCursorFromString(uuid);
+            Aws::Iotdevicecommon::JsonWriter writer(m_allocator);
+            writer.BeginObject();
+            writer.WithString("clientToken", correlationToken.ToCursor());
+            writer.ReserveKey("clientToken");
+            request.SerializeTo(writer);
+            writer.EndObject();
+            if (!writer)
+            {
+                return false;
+            }
 
-            auto resultHandler = [handler, responsePathTopicAccepted, responsePathTopicRejected](
-                                     Aws::Iot::RequestResponse::UnmodeledResult &&result) {
+            auto resultHandler = [handler, topicSet](Aws::Iot::RequestResponse::UnmodeledResult &&result)
+            {
+                const ShadowOperationTopics &resultTopics = topicSet->GetTopics(ShadowTopicOperation::Update);
                 s_UpdateShadowResponseHandler(
-                    std::move(result), handler, responsePathTopicAccepted, responsePathTopicRejected);
+                    std::move(result),
+                    handler,
+                    resultTopics.responsePathTopicAccepted,
+                    resultTopics.responsePathTopicRejected);
             };
 
-            int submitResult = m_bindingClient->SubmitRequest(options, std::move(resultHandler));
+            int submitResult =
+                SubmitShadowRequest(topics, writer.ToCursor(), correlationToken.ToCursor(), std::move(resultHandler));
 
             return submitResult == AWS_OP_SUCCESS;
         }
 
         static bool s_initModeledEvent(
+            Aws::Crt::Allocator *allocator,
             const Aws::Iot::RequestResponse::IncomingPublishEvent &publishEvent,
             ShadowUpdatedEvent &modeledEvent)
         {
+            (void)allocator;
             const auto &payload = publishEvent.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -765,9 +874,11 @@ namespace Aws
         }
 
         static bool s_initModeledEvent(
+            Aws::Crt::Allocator *allocator,
             const Aws::Iot::RequestResponse::IncomingPublishEvent &publishEvent,
             ShadowDeltaUpdatedEvent &modeledEvent)
         {
+            (void)allocator;
             const auto &payload = publishEvent.GetPayload();
             Aws::Crt::String objectStr(reinterpret_cast<char *>(payload.ptr), payload.len);
             Aws::Crt::JsonObject jsonObject(objectStr);
@@ -780,6 +891,15 @@ namespace Aws
             return true;
         }
 
+        static bool s_initModeledEvent(
+            Aws::Crt::Allocator *allocator,
+            const Aws::Iot::RequestResponse::IncomingPublishEvent &publishEvent,
+            ShadowDocument &modeledEvent)
+        {
+            modeledEvent = ShadowDocument::FromPayload(publishEvent.GetPayload(), allocator);
+            return modeledEvent.IsValid();
+        }
+
         template <typename T> class ServiceStreamingOperation : public Aws::Iot::RequestResponse::IStreamingOperation
         {
           public:
@@ -791,15 +911,15 @@ namespace Aws
             static std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> Create(
                 Aws::Crt::Allocator *allocator,
                 const std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> &bindingClient,
-                const Aws::Crt::String &subscriptionTopicFilter,
+                struct aws_byte_cursor subscriptionTopicFilter,
                 const Aws::Iot::RequestResponse::StreamingOperationOptions<T> &options)
             {
 
                 std::function<void(Aws::Iot::RequestResponse::IncomingPublishEvent &&)> unmodeledHandler =
-                    [options](Aws::Iot::RequestResponse::IncomingPublishEvent &&publishEvent)
+                    [allocator, options](Aws::Iot::RequestResponse::IncomingPublishEvent &&publishEvent)
                 {
                     T modeledEvent;
-                    if (!s_initModeledEvent(publishEvent, modeledEvent))
+                    if (!s_initModeledEvent(allocator, publishEvent, modeledEvent))
                     {
                         return;
                     }
@@ -807,7 +927,7 @@ namespace Aws
                 };
 
                 Aws::Iot::RequestResponse::StreamingOperationOptionsInternal internalOptions;
-                internalOptions.subscriptionTopicFilter = Aws::Crt::ByteCursorFromString(subscriptionTopicFilter);
+                internalOptions.subscriptionTopicFilter = subscriptionTopicFilter;
                 internalOptions.subscriptionStatusEventHandler = options.GetSubscriptionStatusEventHandler();
                 internalOptions.incomingPublishEventHandler = unmodeledHandler;
 
@@ -826,57 +946,326 @@ namespace Aws
             std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> m_stream;
         };
 
+        static struct aws_byte_cursor s_getSegmentFromTopic(const Aws::Crt::ByteCursor &topic, int segment)
+        {
+            struct aws_byte_cursor topicSegment;
+            AWS_ZERO_STRUCT(topicSegment);
+            int segmentPosition = 0;
+            while (aws_byte_cursor_next_split(&topic, '/', &topicSegment))
+            {
+                if (segmentPosition == segment)
+                {
+                    return topicSegment;
+                }
+                ++segmentPosition;
+            }
+            return {};
+        }
+
+        template <typename T> struct NamedShadowRoute
+        {
+            NamedShadowRoute(const Aws::Crt::String &name, const std::function<void(T &&)> &routeHandler)
+                : shadowName(name), handler(routeHandler)
+            {
+            }
+
+            Aws::Crt::String shadowName;
+            std::function<void(T &&)> handler;
+        };
+
+        /*
+         * Per-shadow handlers of a multiplexed stream, shared with the publish handler of the underlying subscription.
+         * Routes are indexed by a hash of the shadow name so that dispatch can look up the topic segment in place.
+         */
+        template <typename T> class NamedShadowRouteTable
+        {
+          public:
+            explicit NamedShadowRouteTable(Aws::Crt::Allocator *allocator)
+                : m_allocator(allocator),
+                  m_routes(
+                      0,
+                      std::hash<uint64_t>(),
+                      std::equal_to<uint64_t>(),
+                      typename RouteIndex::allocator_type(allocator))
+            {
+            }
+
+            void SetHandler(const Aws::Crt::String &shadowName, const std::function<void(T &&)> &handler)
+            {
+                auto route = Aws::Crt::MakeShared<NamedShadowRoute<T>>(m_allocator, shadowName, handler);
+                auto shadowNameCursor = Aws::Crt::ByteCursorFromString(shadowName);
+                uint64_t hash = aws_hash_byte_cursor_ptr(&shadowNameCursor);
+
+                std::lock_guard<std::mutex> guard(m_lock);
+                auto existing = FindLocked(hash, shadowNameCursor);
+                if (existing != m_routes.end())
+                {
+                    m_routes.erase(existing);
+                }
+                m_routes.emplace(hash, std::move(route));
+            }
+
+            void RemoveHandler(const Aws::Crt::String &shadowName)
+            {
+                auto shadowNameCursor = Aws::Crt::ByteCursorFromString(shadowName);
+                uint64_t hash = aws_hash_byte_cursor_ptr(&shadowNameCursor);
+
+                std::lock_guard<std::mutex> guard(m_lock);
+                auto existing = FindLocked(hash, shadowNameCursor);
+                if (existing != m_routes.end())
+                {
+                    m_routes.erase(existing);
+                }
+            }
+
+            std::shared_ptr<const NamedShadowRoute<T>> Find(const struct aws_byte_cursor &shadowName) const
+            {
+                uint64_t hash = aws_hash_byte_cursor_ptr(&shadowName);
+
+                std::lock_guard<std::mutex> guard(m_lock);
+                auto existing = FindLocked(hash, shadowName);
+                if (existing == m_routes.end())
+                {
+                    return nullptr;
+                }
+
+                return existing->second;
+            }
+
+          private:
+            using RouteIndex = std::unordered_multimap<
+                uint64_t,
+                std::shared_ptr<const NamedShadowRoute<T>>,
+                std::hash<uint64_t>,
+                std::equal_to<uint64_t>,
+                Aws::Crt::StlAllocator<std::pair<const uint64_t, std::shared_ptr<const NamedShadowRoute<T>>>>>;
+
+            typename RouteIndex::const_iterator FindLocked(uint64_t hash, struct aws_byte_cursor shadowName) const
+            {
+                auto range = m_routes.equal_range(hash);
+                for (auto iter = range.first; iter != range.second; ++iter)
+                {
+                    auto routeName = Aws::Crt::ByteCursorFromString(iter->second->shadowName);
+                    if (aws_byte_cursor_eq(&routeName, &shadowName))
+                    {
+                        return iter;
+                    }
+                }
+
+                return m_routes.end();
+            }
+
+            Aws::Crt::Allocator *m_allocator;
+
+            mutable std::mutex m_lock;
+            RouteIndex m_routes;
+        };
+
+        template <typename T> class NamedShadowMultiplexedStream : public INamedShadowMultiplexedStream<T>
+        {
+          public:
+            NamedShadowMultiplexedStream(
+                std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> stream,
+                std::shared_ptr<NamedShadowRouteTable<T>> routes)
+                : m_stream(std::move(stream)), m_routes(std::move(routes))
+            {
+            }
+
+            static std::shared_ptr<INamedShadowMultiplexedStream<T>> Create(
+                Aws::Crt::Allocator *allocator,
+                const std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> &bindingClient,
+                struct aws_byte_cursor subscriptionTopicFilter,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<T> &options)
+            {
+                auto routes = Aws::Crt::MakeShared<NamedShadowRouteTable<T>>(allocator, allocator);
+                std::function<void(T &&)> unroutedHandler = options.GetStreamHandler();
+
+                std::function<void(Aws::Iot::RequestResponse::IncomingPublishEvent &&)> unmodeledHandler =
+                    [allocator, routes, unroutedHandler](Aws::Iot::RequestResponse::IncomingPublishEvent &&publishEvent)
+                {
+                    /* $aws/things/{thing}/shadow/name/{shadow}/... */
+                    auto shadowName = s_getSegmentFromTopic(publishEvent.GetTopic(), 5);
+                    auto route = routes->Find(shadowName);
+                    if (!route && !unroutedHandler)
+                    {
+                        return;
+                    }
+
+                    T modeledEvent;
+                    if (!s_initModeledEvent(allocator, publishEvent, modeledEvent))
+                    {
+                        return;
+                    }
+
+                    if (route)
+                    {
+                        route->handler(std::move(modeledEvent));
+                    }
+                    else
+                    {
+                        unroutedHandler(std::move(modeledEvent));
+                    }
+                };
+
+                Aws::Iot::RequestResponse::StreamingOperationOptionsInternal internalOptions;
+                internalOptions.subscriptionTopicFilter = subscriptionTopicFilter;
+                internalOptions.subscriptionStatusEventHandler = options.GetSubscriptionStatusEventHandler();
+                internalOptions.incomingPublishEventHandler = unmodeledHandler;
+
+                auto unmodeledStream = bindingClient->CreateStream(internalOptions);
+                if (!unmodeledStream)
+                {
+                    return nullptr;
+                }
+
+                return Aws::Crt::MakeShared<NamedShadowMultiplexedStream<T>>(allocator, unmodeledStream, routes);
+            }
+
+            void Open() override { m_stream->Open(); }
+
+            void SetShadowHandler(const Aws::Crt::String &shadowName, const std::function<void(T &&)> &handler)
+                override
+            {
+                m_routes->SetHandler(shadowName, handler);
+            }
+
+            void RemoveShadowHandler(const Aws::Crt::String &shadowName) override
+            {
+                m_routes->RemoveHandler(shadowName);
+            }
+
+          private:
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> m_stream;
+            std::shared_ptr<NamedShadowRouteTable<T>> m_routes;
+        };
+
         std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::CreateNamedShadowDeltaUpdatedStream(
             const NamedShadowDeltaUpdatedSubscriptionRequest &request,
             const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDeltaUpdatedEvent> &options)
         {
-            Aws::Crt::StringStream topicStream;
-            topicStream << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                        << "/update/delta";
-            Aws::Crt::String topic = topicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/update/delta");
 
             return ServiceStreamingOperation<ShadowDeltaUpdatedEvent>::Create(
-                m_allocator, m_bindingClient, topic, options);
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
         }
 
         std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::CreateNamedShadowUpdatedStream(
             const NamedShadowUpdatedSubscriptionRequest &request,
             const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowUpdatedEvent> &options)
         {
-            Aws::Crt::StringStream topicStream;
-            topicStream << "$aws/things/" << *request.ThingName << "/shadow/name/" << *request.ShadowName
-                        << "/update/documents";
-            Aws::Crt::String topic = topicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/update/documents");
 
-            return ServiceStreamingOperation<ShadowUpdatedEvent>::Create(m_allocator, m_bindingClient, topic, options);
+            return ServiceStreamingOperation<ShadowUpdatedEvent>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
         }
 
         std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::CreateShadowDeltaUpdatedStream(
             const ShadowDeltaUpdatedSubscriptionRequest &request,
             const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDeltaUpdatedEvent> &options)
         {
-            Aws::Crt::StringStream topicStream;
-            topicStream << "$aws/things/" << *request.ThingName << "/shadow/update/delta";
-            Aws::Crt::String topic = topicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/shadow/update/delta");
 
             return ServiceStreamingOperation<ShadowDeltaUpdatedEvent>::Create(
-                m_allocator, m_bindingClient, topic, options);
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
         }
 
         std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::CreateShadowUpdatedStream(
             const ShadowUpdatedSubscriptionRequest &request,
             const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowUpdatedEvent> &options)
         {
-            Aws::Crt::StringStream topicStream;
-            topicStream << "$aws/things/" << *request.ThingName << "/shadow/update/documents";
-            Aws::Crt::String topic = topicStream.str();
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/shadow/update/documents");
+
+            return ServiceStreamingOperation<ShadowUpdatedEvent>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::
+            CreateNamedShadowDeltaUpdatedDocumentStream(
+                const NamedShadowDeltaUpdatedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/update/delta");
+
+            return ServiceStreamingOperation<ShadowDocument>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::
+            CreateNamedShadowUpdatedDocumentStream(
+                const NamedShadowUpdatedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/shadow/name/", *request.ShadowName, "/update/documents");
+
+            return ServiceStreamingOperation<ShadowDocument>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::
+            CreateShadowDeltaUpdatedDocumentStream(
+                const ShadowDeltaUpdatedSubscriptionRequest &request,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/shadow/update/delta");
+
+            return ServiceStreamingOperation<ShadowDocument>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> ClientV2::CreateShadowUpdatedDocumentStream(
+            const ShadowUpdatedSubscriptionRequest &request,
+            const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", *request.ThingName, "/shadow/update/documents");
+
+            return ServiceStreamingOperation<ShadowDocument>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<INamedShadowMultiplexedStream<ShadowDeltaUpdatedEvent>> ClientV2::
+            CreateNamedShadowDeltaUpdatedMultiplexedStream(
+                const Aws::Crt::String &thingName,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDeltaUpdatedEvent> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", thingName, "/shadow/name/+/update/delta");
+
+            return NamedShadowMultiplexedStream<ShadowDeltaUpdatedEvent>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
+
+        std::shared_ptr<INamedShadowMultiplexedStream<ShadowUpdatedEvent>> ClientV2::
+            CreateNamedShadowUpdatedMultiplexedStream(
+                const Aws::Crt::String &thingName,
+                const Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowUpdatedEvent> &options)
+        {
+            Aws::Iotdevicecommon::TopicBuilder topic(m_allocator);
+            topic.Append("$aws/things/", thingName, "/shadow/name/+/update/documents");
+
+            return NamedShadowMultiplexedStream<ShadowUpdatedEvent>::Create(
+                m_allocator, m_bindingClient, topic.ToCursor(), options);
+        }
 
-            return ServiceStreamingOperation<ShadowUpdatedEvent>::Create(m_allocator, m_bindingClient, topic, options);
+        std::shared_ptr<IClientV2> NewClientFrom5(
+            const Aws::Crt::Mqtt5::Mqtt5Client &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            Aws::Crt::Allocator *allocator)
+        {
+            return NewClientFrom5(protocolClient, options, {}, allocator);
         }
 
         std::shared_ptr<IClientV2> NewClientFrom5(
             const Aws::Crt::Mqtt5::Mqtt5Client &protocolClient,
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
             Aws::Crt::Allocator *allocator)
         {
 
@@ -887,12 +1276,22 @@ namespace Aws
                 return nullptr;
             }
 
-            return Aws::Crt::MakeShared<ClientV2>(allocator, allocator, bindingClient);
+            return Aws::Crt::MakeShared<ClientV2>(
+                allocator, allocator, bindingClient, std::move(correlationTokenGenerator));
+        }
+
+        std::shared_ptr<IClientV2> NewClientFrom311(
+            const Aws::Crt::Mqtt::MqttConnection &protocolClient,
+            const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            Aws::Crt::Allocator *allocator)
+        {
+            return NewClientFrom311(protocolClient, options, {}, allocator);
         }
 
         std::shared_ptr<IClientV2> NewClientFrom311(
             const Aws::Crt::Mqtt::MqttConnection &protocolClient,
             const Aws::Iot::RequestResponse::RequestResponseClientOptions &options,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
             Aws::Crt::Allocator *allocator)
         {
 
@@ -903,7 +1302,23 @@ namespace Aws
                 return nullptr;
             }
 
-            return Aws::Crt::MakeShared<ClientV2>(allocator, allocator, bindingClient);
+            return Aws::Crt::MakeShared<ClientV2>(
+                allocator, allocator, bindingClient, std::move(correlationTokenGenerator));
+        }
+
+        std::shared_ptr<IClientV2> NewClientFromRequestResponseClient(
+            std::shared_ptr<Aws::Iot::RequestResponse::IMqttRequestResponseClient> bindingClient,
+            std::shared_ptr<Aws::Iotdevicecommon::ICorrelationTokenGenerator> correlationTokenGenerator,
+            Aws::Crt::Allocator *allocator)
+        {
+            if (nullptr == bindingClient)
+            {
+                aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+                return nullptr;
+            }
+
+            return Aws::Crt::MakeShared<ClientV2>(
+                allocator, allocator, std::move(bindingClient), std::move(correlationTokenGenerator));
         }
 
     } // namespace Iotshadow
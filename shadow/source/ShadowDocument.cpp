@@ -0,0 +1,179 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotshadow/ShadowDocument.h>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        ShadowDocument::ShadowDocument(Aws::Crt::JsonObject &&document, Aws::Crt::Allocator *allocator)
+        {
+            if (!document.WasParseSuccessful())
+            {
+                return;
+            }
+
+            m_root = Aws::Crt::MakeShared<Aws::Crt::JsonObject>(allocator, std::move(document));
+            m_view = m_root->View();
+        }
+
+        ShadowDocument::ShadowDocument(std::shared_ptr<const Aws::Crt::JsonObject> root, const Aws::Crt::JsonView &view)
+            : m_root(std::move(root)), m_view(view)
+        {
+        }
+
+        ShadowDocument ShadowDocument::FromPayload(Aws::Crt::ByteCursor payload, Aws::Crt::Allocator *allocator)
+        {
+            Aws::Crt::String objectStr(
+                reinterpret_cast<const char *>(payload.ptr), payload.len, Aws::Crt::StlAllocator<char>(allocator));
+
+            return ShadowDocument(Aws::Crt::JsonObject(objectStr), allocator);
+        }
+
+        bool ShadowDocument::IsValid() const
+        {
+            return m_root != nullptr;
+        }
+
+        Aws::Crt::JsonView ShadowDocument::GetView() const
+        {
+            return m_view;
+        }
+
+        ShadowDocument ShadowDocument::GetChildDocument(const char *key) const
+        {
+            if (!IsValid() || !m_view.ValueExists(key))
+            {
+                return ShadowDocument();
+            }
+
+            return ShadowDocument(m_root, m_view.GetJsonObject(key));
+        }
+
+        ShadowDocument ShadowDocument::GetPrevious() const
+        {
+            return GetChildDocument("previous");
+        }
+
+        ShadowDocument ShadowDocument::GetCurrent() const
+        {
+            return GetChildDocument("current");
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonView> ShadowDocument::GetState() const
+        {
+            if (!IsValid() || !m_view.ValueExists("state"))
+            {
+                return {};
+            }
+
+            return m_view.GetJsonObject("state");
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonView> ShadowDocument::GetStateSection(const char *key) const
+        {
+            auto state = GetState();
+            if (!state || !state->ValueExists(key))
+            {
+                return {};
+            }
+
+            return state->GetJsonObject(key);
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonView> ShadowDocument::GetDesired() const
+        {
+            return GetStateSection("desired");
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonView> ShadowDocument::GetReported() const
+        {
+            return GetStateSection("reported");
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonView> ShadowDocument::GetDelta() const
+        {
+            return GetStateSection("delta");
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonView> ShadowDocument::GetMetadata() const
+        {
+            if (!IsValid() || !m_view.ValueExists("metadata"))
+            {
+                return {};
+            }
+
+            return m_view.GetJsonObject("metadata");
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonObject> ShadowDocument::Materialize(
+            const Aws::Crt::Optional<Aws::Crt::JsonView> &view)
+        {
+            if (!view)
+            {
+                return {};
+            }
+
+            return view->Materialize();
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonObject> ShadowDocument::MaterializeState() const
+        {
+            return Materialize(GetState());
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonObject> ShadowDocument::MaterializeDesired() const
+        {
+            return Materialize(GetDesired());
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonObject> ShadowDocument::MaterializeReported() const
+        {
+            return Materialize(GetReported());
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonObject> ShadowDocument::MaterializeDelta() const
+        {
+            return Materialize(GetDelta());
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonObject> ShadowDocument::MaterializeMetadata() const
+        {
+            return Materialize(GetMetadata());
+        }
+
+        Aws::Crt::Optional<int32_t> ShadowDocument::GetVersion() const
+        {
+            if (!IsValid() || !m_view.ValueExists("version"))
+            {
+                return {};
+            }
+
+            return m_view.GetInteger("version");
+        }
+
+        Aws::Crt::Optional<Aws::Crt::DateTime> ShadowDocument::GetTimestamp() const
+        {
+            if (!IsValid() || !m_view.ValueExists("timestamp"))
+            {
+                return {};
+            }
+
+            return Aws::Crt::DateTime(m_view.GetDouble("timestamp"));
+        }
+
+        Aws::Crt::Optional<Aws::Crt::String> ShadowDocument::GetClientToken() const
+        {
+            if (!IsValid() || !m_view.ValueExists("clientToken"))
+            {
+                return {};
+            }
+
+            return m_view.GetString("clientToken");
+        }
+
+    } // namespace Iotshadow
+} // namespace Aws
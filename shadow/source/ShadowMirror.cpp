@@ -0,0 +1,504 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotshadow/ShadowMirror.h>
+
+#include <aws/iotshadow/GetNamedShadowRequest.h>
+#include <aws/iotshadow/GetShadowRequest.h>
+#include <aws/iotshadow/NamedShadowDeltaUpdatedSubscriptionRequest.h>
+#include <aws/iotshadow/NamedShadowUpdatedSubscriptionRequest.h>
+#include <aws/iotshadow/ShadowDeltaUpdatedSubscriptionRequest.h>
+#include <aws/iotshadow/ShadowDocument.h>
+#include <aws/iotshadow/ShadowState.h>
+#include <aws/iotshadow/ShadowStateDiff.h>
+#include <aws/iotshadow/ShadowUpdatedSubscriptionRequest.h>
+#include <aws/iotshadow/UpdateNamedShadowRequest.h>
+#include <aws/iotshadow/UpdateShadowRequest.h>
+#include <aws/iotshadow/UpdateShadowResponse.h>
+#include <aws/iotshadow/V2ErrorResponse.h>
+
+#include <mutex>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        static const int32_t SHADOW_NOT_FOUND_CODE = 404;
+
+        class ShadowMirrorState : public std::enable_shared_from_this<ShadowMirrorState>
+        {
+          public:
+            ShadowMirrorState(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::Optional<Aws::Crt::String> &shadowName)
+                : m_client(std::move(client)), m_thingName(thingName), m_shadowName(shadowName)
+            {
+            }
+
+            bool Start(const ShadowMirrorSyncHandler &syncHandler, const ShadowMirrorDeltaHandler &deltaHandler);
+
+            void Stop();
+
+            bool UpdateReported(const Aws::Crt::JsonView &reported, const UpdateShadowResultHandler &handler);
+
+            Aws::Crt::Optional<Aws::Crt::JsonObject> GetReported() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_reported;
+            }
+
+            Aws::Crt::Optional<Aws::Crt::JsonObject> GetDesired() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_desired;
+            }
+
+            Aws::Crt::Optional<int32_t> GetVersion() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_version;
+            }
+
+          private:
+            void OnDocumentsEvent(const ShadowDocument &document);
+
+            void OnDeltaEvent(const ShadowDocument &document);
+
+            void OnGetResult(GetShadowDocumentResult &&result, const ShadowMirrorSyncHandler &syncHandler);
+
+            void OnUpdateCompleted(
+                uint64_t patchId,
+                const Aws::Crt::JsonObject &patch,
+                const UpdateShadowResult &result);
+
+            /* Must be called with the lock held */
+            void RemovePendingPatch(uint64_t patchId);
+
+            /* Must be called with the lock held */
+            bool IsStale(const Aws::Crt::Optional<int32_t> &version) const
+            {
+                return m_version.has_value() && version.has_value() && *version < *m_version;
+            }
+
+            /* Must be called with the lock held */
+            void ApplySnapshot(const ShadowDocument &snapshot);
+
+            std::shared_ptr<IClientV2> m_client;
+            Aws::Crt::String m_thingName;
+            Aws::Crt::Optional<Aws::Crt::String> m_shadowName;
+
+            ShadowMirrorDeltaHandler m_deltaHandler;
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> m_documentsStream;
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> m_deltaStream;
+
+            mutable std::mutex m_lock;
+            Aws::Crt::Optional<Aws::Crt::JsonObject> m_reported;
+            Aws::Crt::Optional<Aws::Crt::JsonObject> m_desired;
+            Aws::Crt::Optional<int32_t> m_version;
+
+            /* Version of the last full document applied; acknowledgements up to it are already part of the state */
+            Aws::Crt::Optional<int32_t> m_snapshotVersion;
+
+            /* Patches acknowledged while other updates were in flight, by version, to rebase late acknowledgements */
+            Aws::Crt::Map<int32_t, Aws::Crt::JsonObject> m_acknowledgedPatches;
+
+            struct PendingPatch
+            {
+                uint64_t id;
+                Aws::Crt::JsonObject patch;
+            };
+
+            /* Patches of the updates in flight, in submission order; new updates are diffed against them as well */
+            Aws::Crt::List<PendingPatch> m_pendingPatches;
+            uint64_t m_nextPatchId = 0;
+        };
+
+        bool ShadowMirrorState::Start(
+            const ShadowMirrorSyncHandler &syncHandler,
+            const ShadowMirrorDeltaHandler &deltaHandler)
+        {
+            m_deltaHandler = deltaHandler;
+
+            std::weak_ptr<ShadowMirrorState> weakState = shared_from_this();
+
+            Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> documentsOptions;
+            documentsOptions.WithStreamHandler(
+                [weakState](ShadowDocument &&document)
+                {
+                    if (auto state = weakState.lock())
+                    {
+                        state->OnDocumentsEvent(document);
+                    }
+                });
+
+            Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> deltaOptions;
+            deltaOptions.WithStreamHandler(
+                [weakState](ShadowDocument &&document)
+                {
+                    if (auto state = weakState.lock())
+                    {
+                        state->OnDeltaEvent(document);
+                    }
+                });
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> documentsStream;
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> deltaStream;
+            if (m_shadowName.has_value())
+            {
+                NamedShadowUpdatedSubscriptionRequest documentsRequest;
+                documentsRequest.ThingName = m_thingName;
+                documentsRequest.ShadowName = *m_shadowName;
+                documentsStream = m_client->CreateNamedShadowUpdatedDocumentStream(documentsRequest, documentsOptions);
+
+                NamedShadowDeltaUpdatedSubscriptionRequest deltaRequest;
+                deltaRequest.ThingName = m_thingName;
+                deltaRequest.ShadowName = *m_shadowName;
+                deltaStream = m_client->CreateNamedShadowDeltaUpdatedDocumentStream(deltaRequest, deltaOptions);
+            }
+            else
+            {
+                ShadowUpdatedSubscriptionRequest documentsRequest;
+                documentsRequest.ThingName = m_thingName;
+                documentsStream = m_client->CreateShadowUpdatedDocumentStream(documentsRequest, documentsOptions);
+
+                ShadowDeltaUpdatedSubscriptionRequest deltaRequest;
+                deltaRequest.ThingName = m_thingName;
+                deltaStream = m_client->CreateShadowDeltaUpdatedDocumentStream(deltaRequest, deltaOptions);
+            }
+
+            if (!documentsStream || !deltaStream)
+            {
+                return false;
+            }
+
+            documentsStream->Open();
+            deltaStream->Open();
+
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_documentsStream = std::move(documentsStream);
+                m_deltaStream = std::move(deltaStream);
+            }
+
+            auto state = shared_from_this();
+            auto getHandler = [state, syncHandler](GetShadowDocumentResult &&result)
+            { state->OnGetResult(std::move(result), syncHandler); };
+
+            if (m_shadowName.has_value())
+            {
+                GetNamedShadowRequest getRequest;
+                getRequest.ThingName = m_thingName;
+                getRequest.ShadowName = *m_shadowName;
+                return m_client->GetNamedShadowDocument(getRequest, getHandler);
+            }
+
+            GetShadowRequest getRequest;
+            getRequest.ThingName = m_thingName;
+            return m_client->GetShadowDocument(getRequest, getHandler);
+        }
+
+        void ShadowMirrorState::Stop()
+        {
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> documentsStream;
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> deltaStream;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                documentsStream = std::move(m_documentsStream);
+                deltaStream = std::move(m_deltaStream);
+            }
+
+            /* The streams are released outside the lock, which their handlers take */
+        }
+
+        void ShadowMirrorState::ApplySnapshot(const ShadowDocument &snapshot)
+        {
+            auto reported = snapshot.MaterializeReported();
+            m_reported = reported.has_value() ? std::move(*reported) : Aws::Crt::JsonObject();
+
+            auto desired = snapshot.MaterializeDesired();
+            m_desired = desired.has_value() ? std::move(*desired) : Aws::Crt::JsonObject();
+
+            auto version = snapshot.GetVersion();
+            if (version.has_value())
+            {
+                m_version = *version;
+                m_snapshotVersion = *version;
+                m_acknowledgedPatches.erase(
+                    m_acknowledgedPatches.begin(), m_acknowledgedPatches.upper_bound(*version));
+            }
+        }
+
+        void ShadowMirrorState::OnDocumentsEvent(const ShadowDocument &document)
+        {
+            ShadowDocument current = document.GetCurrent();
+            if (!current.IsValid())
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (!IsStale(current.GetVersion()))
+            {
+                ApplySnapshot(current);
+            }
+        }
+
+        void ShadowMirrorState::OnDeltaEvent(const ShadowDocument &document)
+        {
+            auto delta = document.GetState();
+            if (!delta.has_value())
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!IsStale(document.GetVersion()))
+                {
+                    Aws::Crt::JsonObject empty;
+                    Aws::Crt::JsonView desired = m_desired.has_value() ? m_desired->View() : empty.View();
+                    m_desired = ApplyShadowStatePatch(desired, *delta);
+                }
+            }
+
+            if (m_deltaHandler)
+            {
+                m_deltaHandler(*delta);
+            }
+        }
+
+        void ShadowMirrorState::OnGetResult(
+            GetShadowDocumentResult &&result,
+            const ShadowMirrorSyncHandler &syncHandler)
+        {
+            int errorCode = AWS_ERROR_SUCCESS;
+
+            if (result.IsSuccess())
+            {
+                const ShadowDocument &document = result.GetResponse();
+
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!IsStale(document.GetVersion()))
+                {
+                    ApplySnapshot(document);
+                }
+            }
+            else
+            {
+                const auto &error = result.GetError();
+                bool notFound = error.HasModeledError() && error.GetModeledError().Code.has_value() &&
+                                *error.GetModeledError().Code == SHADOW_NOT_FOUND_CODE;
+                if (notFound)
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    if (!m_reported.has_value())
+                    {
+                        m_reported = Aws::Crt::JsonObject();
+                        m_desired = Aws::Crt::JsonObject();
+                    }
+                }
+                else
+                {
+                    errorCode = error.GetErrorCode();
+                }
+            }
+
+            if (syncHandler)
+            {
+                syncHandler(errorCode);
+            }
+        }
+
+        void ShadowMirrorState::RemovePendingPatch(uint64_t patchId)
+        {
+            for (auto it = m_pendingPatches.begin(); it != m_pendingPatches.end(); ++it)
+            {
+                if (it->id == patchId)
+                {
+                    m_pendingPatches.erase(it);
+                    break;
+                }
+            }
+
+            /* Without updates in flight no acknowledgement can arrive late */
+            if (m_pendingPatches.empty())
+            {
+                m_acknowledgedPatches.clear();
+            }
+        }
+
+        void ShadowMirrorState::OnUpdateCompleted(
+            uint64_t patchId,
+            const Aws::Crt::JsonObject &patch,
+            const UpdateShadowResult &result)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            if (result.IsSuccess())
+            {
+                Aws::Crt::Optional<int32_t> version = result.GetResponse().Version;
+                if (!version.has_value() || !m_snapshotVersion.has_value() || *version > *m_snapshotVersion)
+                {
+                    Aws::Crt::JsonObject empty;
+                    Aws::Crt::JsonView reported = m_reported.has_value() ? m_reported->View() : empty.View();
+                    m_reported = ApplyShadowStatePatch(reported, patch.View());
+
+                    if (version.has_value() && IsStale(version))
+                    {
+                        /*
+                         * Acknowledgements arrived out of order.  The service applied the updates acknowledged with
+                         * later versions after this one, so they win on every key they share with it.
+                         */
+                        for (auto it = m_acknowledgedPatches.upper_bound(*version); it != m_acknowledgedPatches.end();
+                             ++it)
+                        {
+                            m_reported = ApplyShadowStatePatch(m_reported->View(), it->second.View());
+                        }
+                    }
+                    else if (version.has_value())
+                    {
+                        m_version = *version;
+                    }
+
+                    if (version.has_value())
+                    {
+                        m_acknowledgedPatches[*version] = patch;
+                    }
+                }
+            }
+
+            RemovePendingPatch(patchId);
+        }
+
+        bool ShadowMirrorState::UpdateReported(
+            const Aws::Crt::JsonView &reported,
+            const UpdateShadowResultHandler &handler)
+        {
+            Aws::Crt::JsonObject patch;
+            bool changed = false;
+            uint64_t patchId = 0;
+            Aws::Crt::Optional<int32_t> version;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+
+                /*
+                 * Diff against the state the service will hold once the updates in flight land, so that a value
+                 * reverted while its update is in flight is sent again.
+                 */
+                Aws::Crt::JsonObject empty;
+                Aws::Crt::JsonObject expected;
+                Aws::Crt::JsonView base = m_reported.has_value() ? m_reported->View() : empty.View();
+                for (const auto &pending : m_pendingPatches)
+                {
+                    expected = ApplyShadowStatePatch(base, pending.patch.View());
+                    base = expected.View();
+                }
+
+                changed = ComputeShadowStateDiff(base, reported, patch);
+                if (m_version.has_value())
+                {
+                    version = *m_version;
+                }
+                if (changed)
+                {
+                    patchId = m_nextPatchId++;
+                    m_pendingPatches.push_back({patchId, patch});
+                }
+            }
+
+            if (!changed)
+            {
+                UpdateShadowResponse response;
+                if (version.has_value())
+                {
+                    response.Version = *version;
+                }
+                handler(UpdateShadowResult(std::move(response)));
+                return true;
+            }
+
+            ShadowState stateUpdate;
+            stateUpdate.Reported = patch;
+
+            auto state = shared_from_this();
+            auto resultHandler = [state, patchId, patch, handler](UpdateShadowResult &&result)
+            {
+                state->OnUpdateCompleted(patchId, patch, result);
+                handler(std::move(result));
+            };
+
+            bool submitted = false;
+            if (m_shadowName.has_value())
+            {
+                UpdateNamedShadowRequest request;
+                request.ThingName = m_thingName;
+                request.ShadowName = *m_shadowName;
+                request.State = std::move(stateUpdate);
+                submitted = m_client->UpdateNamedShadow(request, resultHandler);
+            }
+            else
+            {
+                UpdateShadowRequest request;
+                request.ThingName = m_thingName;
+                request.State = std::move(stateUpdate);
+                submitted = m_client->UpdateShadow(request, resultHandler);
+            }
+
+            if (!submitted)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                RemovePendingPatch(patchId);
+            }
+
+            return submitted;
+        }
+
+        ShadowMirror::ShadowMirror(
+            std::shared_ptr<IClientV2> client,
+            const Aws::Crt::String &thingName,
+            const Aws::Crt::Optional<Aws::Crt::String> &shadowName,
+            Aws::Crt::Allocator *allocator)
+            : m_state(Aws::Crt::MakeShared<ShadowMirrorState>(allocator, std::move(client), thingName, shadowName))
+        {
+        }
+
+        ShadowMirror::~ShadowMirror()
+        {
+            m_state->Stop();
+        }
+
+        bool ShadowMirror::Start(
+            const ShadowMirrorSyncHandler &syncHandler,
+            const ShadowMirrorDeltaHandler &deltaHandler)
+        {
+            return m_state->Start(syncHandler, deltaHandler);
+        }
+
+        bool ShadowMirror::UpdateReported(
+            const Aws::Crt::JsonView &reported,
+            const UpdateShadowResultHandler &handler)
+        {
+            return m_state->UpdateReported(reported, handler);
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonObject> ShadowMirror::GetReported() const
+        {
+            return m_state->GetReported();
+        }
+
+        Aws::Crt::Optional<Aws::Crt::JsonObject> ShadowMirror::GetDesired() const
+        {
+            return m_state->GetDesired();
+        }
+
+        Aws::Crt::Optional<int32_t> ShadowMirror::GetVersion() const
+        {
+            return m_state->GetVersion();
+        }
+
+    } // namespace Iotshadow
+} // namespace Aws
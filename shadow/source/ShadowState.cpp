@@ -5,6 +5,8 @@
  */
 #include <aws/iotshadow/ShadowState.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotshadow
@@ -41,6 +43,21 @@ namespace Aws
             }
         }
 
+        void ShadowState::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (Desired)
+            {
+                writer.WithJson("desired", Desired->View());
+            }
+
+            if (Reported)
+            {
+                writer.WithJson("reported", Reported->View());
+            }
+        }
+
         ShadowState::ShadowState(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
@@ -0,0 +1,206 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotshadow/ShadowStateDiff.h>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        static bool s_valuesEqual(const Aws::Crt::JsonView &lhs, const Aws::Crt::JsonView &rhs)
+        {
+            if (lhs.IsObject() != rhs.IsObject())
+            {
+                return false;
+            }
+
+            if (lhs.IsObject())
+            {
+                Aws::Crt::JsonObject unused;
+                return !ComputeShadowStateDiff(lhs, rhs, unused);
+            }
+
+            return lhs.WriteCompact(false) == rhs.WriteCompact(false);
+        }
+
+        static Aws::Crt::JsonObject s_nullValue()
+        {
+            Aws::Crt::JsonObject value;
+            value.AsNull();
+            return value;
+        }
+
+        bool ComputeShadowStateDiff(
+            const Aws::Crt::JsonView &base,
+            const Aws::Crt::JsonView &target,
+            Aws::Crt::JsonObject &diff)
+        {
+            auto baseMembers = base.GetAllObjects();
+            auto targetMembers = target.GetAllObjects();
+
+            Aws::Crt::JsonObject result;
+            bool changed = false;
+
+            for (const auto &targetMember : targetMembers)
+            {
+                const auto &key = targetMember.first;
+                const auto &targetValue = targetMember.second;
+
+                auto baseIter = baseMembers.find(key);
+                if (baseIter == baseMembers.end() || baseIter->second.IsNull())
+                {
+                    if (!targetValue.IsNull())
+                    {
+                        result.WithObject(key, targetValue.Materialize());
+                        changed = true;
+                    }
+                    continue;
+                }
+
+                const auto &baseValue = baseIter->second;
+                if (baseValue.IsObject() && targetValue.IsObject())
+                {
+                    Aws::Crt::JsonObject nestedDiff;
+                    if (ComputeShadowStateDiff(baseValue, targetValue, nestedDiff))
+                    {
+                        result.WithObject(key, std::move(nestedDiff));
+                        changed = true;
+                    }
+                }
+                else if (!s_valuesEqual(baseValue, targetValue))
+                {
+                    result.WithObject(key, targetValue.Materialize());
+                    changed = true;
+                }
+            }
+
+            for (const auto &baseMember : baseMembers)
+            {
+                if (!baseMember.second.IsNull() && targetMembers.find(baseMember.first) == targetMembers.end())
+                {
+                    result.WithObject(baseMember.first, s_nullValue());
+                    changed = true;
+                }
+            }
+
+            if (changed)
+            {
+                diff = std::move(result);
+            }
+
+            return changed;
+        }
+
+        static Aws::Crt::JsonObject s_applyPatch(const Aws::Crt::JsonView &base, const Aws::Crt::JsonView &patch)
+        {
+            auto baseMembers = base.GetAllObjects();
+            auto patchMembers = patch.GetAllObjects();
+
+            Aws::Crt::JsonObject result;
+            for (const auto &baseMember : baseMembers)
+            {
+                if (patchMembers.find(baseMember.first) == patchMembers.end())
+                {
+                    result.WithObject(baseMember.first, baseMember.second.Materialize());
+                }
+            }
+
+            for (const auto &patchMember : patchMembers)
+            {
+                const auto &key = patchMember.first;
+                const auto &patchValue = patchMember.second;
+
+                if (patchValue.IsNull())
+                {
+                    continue;
+                }
+
+                if (!patchValue.IsObject())
+                {
+                    result.WithObject(key, patchValue.Materialize());
+                    continue;
+                }
+
+                auto baseIter = baseMembers.find(key);
+                if (baseIter != baseMembers.end() && baseIter->second.IsObject())
+                {
+                    result.WithObject(key, s_applyPatch(baseIter->second, patchValue));
+                }
+                else
+                {
+                    Aws::Crt::JsonObject empty;
+                    result.WithObject(key, s_applyPatch(empty.View(), patchValue));
+                }
+            }
+
+            return result;
+        }
+
+        static bool s_mergePatches(
+            const Aws::Crt::JsonView &older,
+            const Aws::Crt::JsonView &newer,
+            Aws::Crt::JsonObject &merged)
+        {
+            auto olderMembers = older.GetAllObjects();
+            auto newerMembers = newer.GetAllObjects();
+
+            Aws::Crt::JsonObject result;
+            for (const auto &olderMember : olderMembers)
+            {
+                if (newerMembers.find(olderMember.first) == newerMembers.end())
+                {
+                    result.WithObject(olderMember.first, olderMember.second.Materialize());
+                }
+            }
+
+            for (const auto &newerMember : newerMembers)
+            {
+                const auto &key = newerMember.first;
+                const auto &newerValue = newerMember.second;
+
+                auto olderIter = olderMembers.find(key);
+                if (!newerValue.IsObject() || olderIter == olderMembers.end())
+                {
+                    result.WithObject(key, newerValue.Materialize());
+                    continue;
+                }
+
+                /*
+                 * The service merges an object into whatever the key holds.  If older deleted or replaced the key,
+                 * the object must land on nothing, which a single update cannot express when the service still
+                 * holds an object there.
+                 */
+                if (!olderIter->second.IsObject())
+                {
+                    return false;
+                }
+
+                Aws::Crt::JsonObject nested;
+                if (!s_mergePatches(olderIter->second, newerValue, nested))
+                {
+                    return false;
+                }
+                result.WithObject(key, std::move(nested));
+            }
+
+            merged = std::move(result);
+            return true;
+        }
+
+        Aws::Crt::JsonObject ApplyShadowStatePatch(const Aws::Crt::JsonView &base, const Aws::Crt::JsonView &patch)
+        {
+            return s_applyPatch(base, patch);
+        }
+
+        bool MergeShadowStatePatches(
+            const Aws::Crt::JsonView &older,
+            const Aws::Crt::JsonView &newer,
+            Aws::Crt::JsonObject &merged)
+        {
+            return s_mergePatches(older, newer, merged);
+        }
+
+    } // namespace Iotshadow
+} // namespace Aws
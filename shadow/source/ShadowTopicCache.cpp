@@ -0,0 +1,185 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotshadow/ShadowTopicCache.h>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        ShadowOperationTopics::ShadowOperationTopics(Aws::Crt::Allocator *allocator)
+            : publishTopic(Aws::Crt::StlAllocator<char>(allocator)),
+              subscriptionTopic0(Aws::Crt::StlAllocator<char>(allocator)),
+              subscriptionTopic1(Aws::Crt::StlAllocator<char>(allocator)), subscriptionTopicCount(0),
+              responsePathTopicAccepted(Aws::Crt::StlAllocator<char>(allocator)),
+              responsePathTopicRejected(Aws::Crt::StlAllocator<char>(allocator))
+        {
+            AWS_ZERO_STRUCT(subscriptionTopicFilters);
+            AWS_ZERO_STRUCT(responsePaths);
+        }
+
+        void ShadowOperationTopics::Initialize(
+            const Aws::Crt::String &prefix,
+            const char *operation,
+            bool wildcardSubscription)
+        {
+            publishTopic.append(prefix).append(operation);
+
+            if (wildcardSubscription)
+            {
+                subscriptionTopic0.append(publishTopic).append("/+");
+                subscriptionTopicCount = 1;
+            }
+            else
+            {
+                subscriptionTopic0.append(publishTopic).append("/accepted");
+                subscriptionTopic1.append(publishTopic).append("/rejected");
+                subscriptionTopicCount = 2;
+            }
+
+            responsePathTopicAccepted.append(publishTopic).append("/accepted");
+            responsePathTopicRejected.append(publishTopic).append("/rejected");
+
+            subscriptionTopicFilters[0] = Aws::Crt::ByteCursorFromString(subscriptionTopic0);
+            subscriptionTopicFilters[1] = Aws::Crt::ByteCursorFromString(subscriptionTopic1);
+
+            responsePaths[0].topic = Aws::Crt::ByteCursorFromString(responsePathTopicAccepted);
+            responsePaths[1].topic = Aws::Crt::ByteCursorFromString(responsePathTopicRejected);
+            responsePaths[0].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
+            responsePaths[1].correlation_token_json_path = Aws::Crt::ByteCursorFromCString("clientToken");
+        }
+
+        static const uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ULL;
+
+        static uint64_t s_fnv1a(uint64_t hash, const char *data, size_t length)
+        {
+            for (size_t i = 0; i < length; ++i)
+            {
+                hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ULL;
+            }
+
+            return hash;
+        }
+
+        static uint64_t s_hashShadowKey(const Aws::Crt::String &thingName, const Aws::Crt::String *shadowName)
+        {
+            /* Collisions are resolved by ShadowTopicSet::Matches */
+            uint64_t hash = s_fnv1a(FNV1A_OFFSET_BASIS, thingName.data(), thingName.length());
+
+            if (shadowName != nullptr)
+            {
+                hash = s_fnv1a(hash, "/", 1);
+                hash = s_fnv1a(hash, shadowName->data(), shadowName->length());
+            }
+
+            return hash;
+        }
+
+        ShadowTopicSet::ShadowTopicSet(
+            Aws::Crt::Allocator *allocator,
+            const Aws::Crt::String &thingName,
+            const Aws::Crt::String *shadowName,
+            uint64_t hash)
+            : m_thingName(thingName.c_str(), thingName.length(), Aws::Crt::StlAllocator<char>(allocator)),
+              m_shadowName(Aws::Crt::StlAllocator<char>(allocator)), m_isNamed(shadowName != nullptr), m_hash(hash),
+              m_deleteTopics(allocator), m_getTopics(allocator), m_updateTopics(allocator)
+        {
+            Aws::Crt::String prefix{Aws::Crt::StlAllocator<char>(allocator)};
+            prefix.append("$aws/things/").append(m_thingName).append("/shadow");
+            if (m_isNamed)
+            {
+                m_shadowName.append(*shadowName);
+                prefix.append("/name/").append(m_shadowName);
+            }
+
+            m_deleteTopics.Initialize(prefix, "/delete", true);
+            m_getTopics.Initialize(prefix, "/get", true);
+            m_updateTopics.Initialize(prefix, "/update", false);
+        }
+
+        bool ShadowTopicSet::Matches(const Aws::Crt::String &thingName, const Aws::Crt::String *shadowName) const
+        {
+            if (m_isNamed != (shadowName != nullptr) || m_thingName != thingName)
+            {
+                return false;
+            }
+
+            return !m_isNamed || m_shadowName == *shadowName;
+        }
+
+        const ShadowOperationTopics &ShadowTopicSet::GetTopics(ShadowTopicOperation operation) const
+        {
+            switch (operation)
+            {
+                case ShadowTopicOperation::Delete:
+                    return m_deleteTopics;
+                case ShadowTopicOperation::Get:
+                    return m_getTopics;
+                default:
+                    return m_updateTopics;
+            }
+        }
+
+        ShadowTopicCache::ShadowTopicCache(Aws::Crt::Allocator *allocator, size_t capacity)
+            : m_allocator(allocator), m_capacity(capacity), m_lru(LruList::allocator_type(allocator)),
+              m_index(0, std::hash<uint64_t>(), std::equal_to<uint64_t>(), LruIndex::allocator_type(allocator))
+        {
+        }
+
+        std::shared_ptr<const ShadowTopicSet> ShadowTopicCache::GetTopicSet(
+            const Aws::Crt::String &thingName,
+            const Aws::Crt::String *shadowName)
+        {
+            uint64_t hash = s_hashShadowKey(thingName, shadowName);
+
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            auto range = m_index.equal_range(hash);
+            for (auto iter = range.first; iter != range.second; ++iter)
+            {
+                if ((*iter->second)->Matches(thingName, shadowName))
+                {
+                    m_lru.splice(m_lru.begin(), m_lru, iter->second);
+                    return m_lru.front();
+                }
+            }
+
+            std::shared_ptr<const ShadowTopicSet> topicSet =
+                Aws::Crt::MakeShared<ShadowTopicSet>(m_allocator, m_allocator, thingName, shadowName, hash);
+
+            m_lru.push_front(topicSet);
+            m_index.emplace(hash, m_lru.begin());
+
+            if (m_lru.size() > m_capacity)
+            {
+                Evict(std::prev(m_lru.end()));
+            }
+
+            return topicSet;
+        }
+
+        size_t ShadowTopicCache::GetSize() const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return m_lru.size();
+        }
+
+        void ShadowTopicCache::Evict(LruList::iterator entry)
+        {
+            auto range = m_index.equal_range((*entry)->GetHash());
+            for (auto iter = range.first; iter != range.second; ++iter)
+            {
+                if (iter->second == entry)
+                {
+                    m_index.erase(iter);
+                    break;
+                }
+            }
+
+            m_lru.erase(entry);
+        }
+
+    } // namespace Iotshadow
+} // namespace Aws
@@ -0,0 +1,428 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotshadow/ShadowTransaction.h>
+
+#include <aws/iotshadow/GetNamedShadowRequest.h>
+#include <aws/iotshadow/GetShadowRequest.h>
+#include <aws/iotshadow/NamedShadowUpdatedSubscriptionRequest.h>
+#include <aws/iotshadow/ShadowDocument.h>
+#include <aws/iotshadow/ShadowState.h>
+#include <aws/iotshadow/ShadowStateDiff.h>
+#include <aws/iotshadow/ShadowUpdatedSubscriptionRequest.h>
+#include <aws/iotshadow/UpdateNamedShadowRequest.h>
+#include <aws/iotshadow/UpdateShadowRequest.h>
+#include <aws/iotshadow/UpdateShadowResponse.h>
+#include <aws/iotshadow/V2ErrorResponse.h>
+
+#include <mutex>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        static const int32_t SHADOW_NOT_FOUND_CODE = 404;
+        static const int32_t SHADOW_VERSION_CONFLICT_CODE = 409;
+
+        static bool s_hasModeledErrorCode(const ServiceErrorV2<V2ErrorResponse> &error, int32_t code)
+        {
+            return error.HasModeledError() && error.GetModeledError().Code.has_value() &&
+                   *error.GetModeledError().Code == code;
+        }
+
+        static Aws::Crt::JsonObject s_applySection(
+            const Aws::Crt::Optional<Aws::Crt::JsonView> &current,
+            const Aws::Crt::Optional<Aws::Crt::JsonObject> &patch)
+        {
+            Aws::Crt::JsonObject empty;
+            Aws::Crt::JsonView base = current.has_value() ? *current : empty.View();
+            if (!patch.has_value())
+            {
+                return base.Materialize();
+            }
+
+            return ApplyShadowStatePatch(base, patch->View());
+        }
+
+        struct ShadowCommit
+        {
+            ShadowTransactionMutator mutator;
+            UpdateShadowResultHandler handler;
+            uint32_t attemptsLeft;
+        };
+
+        class ShadowTransactionState : public std::enable_shared_from_this<ShadowTransactionState>
+        {
+          public:
+            ShadowTransactionState(
+                std::shared_ptr<IClientV2> client,
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::Optional<Aws::Crt::String> &shadowName,
+                uint32_t maxAttempts,
+                Aws::Crt::Allocator *allocator)
+                : m_allocator(allocator), m_client(std::move(client)), m_thingName(thingName),
+                  m_shadowName(shadowName), m_maxAttempts(maxAttempts > 0 ? maxAttempts : 1)
+            {
+            }
+
+            bool Start();
+
+            void Stop() { m_documentsStream = nullptr; }
+
+            bool Commit(const ShadowTransactionMutator &mutator, const UpdateShadowResultHandler &handler);
+
+            Aws::Crt::Optional<int32_t> GetCachedVersion() const
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_cached.GetVersion();
+            }
+
+          private:
+            bool Attempt(const std::shared_ptr<ShadowCommit> &commit);
+
+            bool Refresh(const std::shared_ptr<ShadowCommit> &commit);
+
+            void OnRefreshResult(GetShadowDocumentResult &&result);
+
+            bool SendUpdate(const std::shared_ptr<ShadowCommit> &commit, const ShadowDocument &snapshot);
+
+            void OnUpdateResult(
+                const std::shared_ptr<ShadowCommit> &commit,
+                const ShadowDocument &snapshot,
+                const ShadowState &update,
+                UpdateShadowResult &&result);
+
+            void CacheDocument(const ShadowDocument &document);
+
+            Aws::Crt::Allocator *m_allocator;
+            std::shared_ptr<IClientV2> m_client;
+            Aws::Crt::String m_thingName;
+            Aws::Crt::Optional<Aws::Crt::String> m_shadowName;
+            uint32_t m_maxAttempts;
+
+            std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> m_documentsStream;
+
+            mutable std::mutex m_lock;
+            ShadowDocument m_cached;
+
+            /* Commits waiting for the fetch in flight, if any; concurrent refreshes share a single fetch */
+            bool m_refreshing = false;
+            Aws::Crt::Vector<std::shared_ptr<ShadowCommit>> m_awaitingRefresh;
+        };
+
+        bool ShadowTransactionState::Start()
+        {
+            std::weak_ptr<ShadowTransactionState> weakState = shared_from_this();
+
+            Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDocument> documentsOptions;
+            documentsOptions.WithStreamHandler(
+                [weakState](ShadowDocument &&document)
+                {
+                    if (auto state = weakState.lock())
+                    {
+                        state->CacheDocument(document.GetCurrent());
+                    }
+                });
+
+            if (m_shadowName.has_value())
+            {
+                NamedShadowUpdatedSubscriptionRequest request;
+                request.ThingName = m_thingName;
+                request.ShadowName = *m_shadowName;
+                m_documentsStream = m_client->CreateNamedShadowUpdatedDocumentStream(request, documentsOptions);
+            }
+            else
+            {
+                ShadowUpdatedSubscriptionRequest request;
+                request.ThingName = m_thingName;
+                m_documentsStream = m_client->CreateShadowUpdatedDocumentStream(request, documentsOptions);
+            }
+
+            if (!m_documentsStream)
+            {
+                return false;
+            }
+
+            m_documentsStream->Open();
+            return true;
+        }
+
+        void ShadowTransactionState::CacheDocument(const ShadowDocument &document)
+        {
+            if (!document.IsValid())
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            auto cachedVersion = m_cached.GetVersion();
+            auto version = document.GetVersion();
+            if (cachedVersion.has_value() && (!version.has_value() || *version < *cachedVersion))
+            {
+                return;
+            }
+
+            m_cached = document;
+        }
+
+        bool ShadowTransactionState::Commit(
+            const ShadowTransactionMutator &mutator,
+            const UpdateShadowResultHandler &handler)
+        {
+            auto commit = Aws::Crt::MakeShared<ShadowCommit>(m_allocator);
+            commit->mutator = mutator;
+            commit->handler = handler;
+            commit->attemptsLeft = m_maxAttempts;
+
+            return Attempt(commit);
+        }
+
+        bool ShadowTransactionState::Attempt(const std::shared_ptr<ShadowCommit> &commit)
+        {
+            ShadowDocument snapshot;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                snapshot = m_cached;
+            }
+
+            if (!snapshot.IsValid())
+            {
+                return Refresh(commit);
+            }
+
+            return SendUpdate(commit, snapshot);
+        }
+
+        bool ShadowTransactionState::Refresh(const std::shared_ptr<ShadowCommit> &commit)
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_awaitingRefresh.push_back(commit);
+                if (m_refreshing)
+                {
+                    return true;
+                }
+                m_refreshing = true;
+            }
+
+            auto state = shared_from_this();
+            auto getHandler = [state](GetShadowDocumentResult &&result) { state->OnRefreshResult(std::move(result)); };
+
+            bool submitted = false;
+            if (m_shadowName.has_value())
+            {
+                GetNamedShadowRequest request;
+                request.ThingName = m_thingName;
+                request.ShadowName = *m_shadowName;
+                submitted = m_client->GetNamedShadowDocument(request, getHandler);
+            }
+            else
+            {
+                GetShadowRequest request;
+                request.ThingName = m_thingName;
+                submitted = m_client->GetShadowDocument(request, getHandler);
+            }
+
+            if (submitted)
+            {
+                return true;
+            }
+
+            int errorCode = aws_last_error();
+            Aws::Crt::Vector<std::shared_ptr<ShadowCommit>> waiters;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                waiters.swap(m_awaitingRefresh);
+                m_refreshing = false;
+            }
+
+            /* The caller reports the failure for its own commit */
+            for (const auto &waiter : waiters)
+            {
+                if (waiter != commit)
+                {
+                    waiter->handler(UpdateShadowResult(ServiceErrorV2<V2ErrorResponse>(
+                        errorCode != AWS_ERROR_SUCCESS ? errorCode : AWS_ERROR_UNKNOWN)));
+                }
+            }
+
+            aws_raise_error(errorCode);
+            return false;
+        }
+
+        void ShadowTransactionState::OnRefreshResult(GetShadowDocumentResult &&result)
+        {
+            bool failed = false;
+            if (result.IsSuccess())
+            {
+                CacheDocument(result.GetResponse());
+            }
+            else if (s_hasModeledErrorCode(result.GetError(), SHADOW_NOT_FOUND_CODE))
+            {
+                /* A shadow that does not exist is represented by an empty, unversioned document */
+                ShadowDocument empty(Aws::Crt::JsonObject(), m_allocator);
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_cached = empty;
+            }
+            else
+            {
+                failed = true;
+            }
+
+            Aws::Crt::Vector<std::shared_ptr<ShadowCommit>> waiters;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                waiters.swap(m_awaitingRefresh);
+                m_refreshing = false;
+            }
+
+            for (const auto &waiter : waiters)
+            {
+                if (failed)
+                {
+                    waiter->handler(UpdateShadowResult(ServiceErrorV2<V2ErrorResponse>(result.GetError())));
+                }
+                else if (!Attempt(waiter))
+                {
+                    int errorCode = aws_last_error();
+                    waiter->handler(UpdateShadowResult(ServiceErrorV2<V2ErrorResponse>(
+                        errorCode != AWS_ERROR_SUCCESS ? errorCode : AWS_ERROR_UNKNOWN)));
+                }
+            }
+        }
+
+        bool ShadowTransactionState::SendUpdate(
+            const std::shared_ptr<ShadowCommit> &commit,
+            const ShadowDocument &snapshot)
+        {
+            ShadowState update;
+            if (!commit->mutator(snapshot, update))
+            {
+                commit->handler(UpdateShadowResult(ServiceErrorV2<V2ErrorResponse>(AWS_ERROR_INVALID_STATE)));
+                return true;
+            }
+
+            --commit->attemptsLeft;
+
+            auto state = shared_from_this();
+            auto resultHandler = [state, commit, snapshot, update](UpdateShadowResult &&result)
+            { state->OnUpdateResult(commit, snapshot, update, std::move(result)); };
+
+            auto version = snapshot.GetVersion();
+            if (m_shadowName.has_value())
+            {
+                UpdateNamedShadowRequest request;
+                request.ThingName = m_thingName;
+                request.ShadowName = *m_shadowName;
+                request.State = update;
+                if (version.has_value())
+                {
+                    request.Version = *version;
+                }
+                return m_client->UpdateNamedShadow(request, resultHandler);
+            }
+
+            UpdateShadowRequest request;
+            request.ThingName = m_thingName;
+            request.State = update;
+            if (version.has_value())
+            {
+                request.Version = *version;
+            }
+            return m_client->UpdateShadow(request, resultHandler);
+        }
+
+        void ShadowTransactionState::OnUpdateResult(
+            const std::shared_ptr<ShadowCommit> &commit,
+            const ShadowDocument &snapshot,
+            const ShadowState &update,
+            UpdateShadowResult &&result)
+        {
+            if (result.IsSuccess())
+            {
+                auto newVersion = result.GetResponse().Version;
+                if (newVersion.has_value())
+                {
+                    /*
+                     * Derive the post-update document locally so that back-to-back commits from this writer do not
+                     * need a fetch or have to wait for the update/documents event.
+                     */
+                    Aws::Crt::JsonObject nextState;
+                    nextState.WithObject("desired", s_applySection(snapshot.GetDesired(), update.Desired));
+                    nextState.WithObject("reported", s_applySection(snapshot.GetReported(), update.Reported));
+
+                    Aws::Crt::JsonObject nextDocument;
+                    nextDocument.WithObject("state", std::move(nextState));
+                    nextDocument.WithInteger("version", *newVersion);
+
+                    CacheDocument(ShadowDocument(std::move(nextDocument), m_allocator));
+                }
+
+                commit->handler(std::move(result));
+                return;
+            }
+
+            if (commit->attemptsLeft > 0 && s_hasModeledErrorCode(result.GetError(), SHADOW_VERSION_CONFLICT_CODE))
+            {
+                /* The update/documents stream or another commit may already have cached a newer document */
+                bool cachedIsNewer = false;
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    auto cachedVersion = m_cached.GetVersion();
+                    auto attemptedVersion = snapshot.GetVersion();
+                    cachedIsNewer = cachedVersion.has_value() &&
+                                    (!attemptedVersion.has_value() || *cachedVersion > *attemptedVersion);
+                }
+
+                if (cachedIsNewer ? Attempt(commit) : Refresh(commit))
+                {
+                    return;
+                }
+            }
+
+            commit->handler(std::move(result));
+        }
+
+        ShadowTransaction::ShadowTransaction(
+            std::shared_ptr<IClientV2> client,
+            const Aws::Crt::String &thingName,
+            const Aws::Crt::Optional<Aws::Crt::String> &shadowName,
+            uint32_t maxAttempts,
+            Aws::Crt::Allocator *allocator)
+            : m_state(Aws::Crt::MakeShared<ShadowTransactionState>(
+                  allocator,
+                  std::move(client),
+                  thingName,
+                  shadowName,
+                  maxAttempts,
+                  allocator))
+        {
+        }
+
+        ShadowTransaction::~ShadowTransaction()
+        {
+            m_state->Stop();
+        }
+
+        bool ShadowTransaction::Start()
+        {
+            return m_state->Start();
+        }
+
+        bool ShadowTransaction::Commit(
+            const ShadowTransactionMutator &mutator,
+            const UpdateShadowResultHandler &handler)
+        {
+            return m_state->Commit(mutator, handler);
+        }
+
+        Aws::Crt::Optional<int32_t> ShadowTransaction::GetCachedVersion() const
+        {
+            return m_state->GetCachedVersion();
+        }
+
+    } // namespace Iotshadow
+} // namespace Aws
@@ -0,0 +1,468 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/iotshadow/ShadowUpdateCoalescer.h>
+
+#include <aws/common/clock.h>
+#include <aws/crt/io/EventLoopGroup.h>
+#include <aws/io/event_loop.h>
+
+#include <aws/iotshadow/ShadowState.h>
+#include <aws/iotshadow/ShadowStateDiff.h>
+#include <aws/iotshadow/UpdateNamedShadowRequest.h>
+#include <aws/iotshadow/UpdateShadowRequest.h>
+#include <aws/iotshadow/UpdateShadowResponse.h>
+#include <aws/iotshadow/V2ErrorResponse.h>
+
+#include <mutex>
+
+namespace Aws
+{
+    namespace Iotshadow
+    {
+
+        ShadowUpdateCoalescerOptions &ShadowUpdateCoalescerOptions::WithCoalescingWindow(
+            std::chrono::milliseconds window)
+        {
+            m_coalescingWindow = window;
+            return *this;
+        }
+
+        ShadowUpdateCoalescerOptions &ShadowUpdateCoalescerOptions::WithMaxPendingBytes(size_t maxPendingBytes)
+        {
+            m_maxPendingBytes = maxPendingBytes;
+            return *this;
+        }
+
+        ShadowUpdateCoalescerOptions &ShadowUpdateCoalescerOptions::WithEventLoopGroup(
+            Aws::Crt::Io::EventLoopGroup &eventLoopGroup)
+        {
+            m_eventLoopGroup = &eventLoopGroup;
+            return *this;
+        }
+
+        using UpdateShadowResultHandlerList = Aws::Crt::Vector<UpdateShadowResultHandler>;
+
+        /*
+         * Merged reported state that will be sent as a single update request, and the handlers its response completes.
+         */
+        struct PendingShadowBatch
+        {
+            Aws::Crt::JsonObject reported;
+            size_t pendingBytes = 0;
+            UpdateShadowResultHandlerList handlers;
+        };
+
+        /*
+         * Reported state of a shadow that has not been sent yet, plus the bookkeeping needed to decide when to send it.
+         */
+        struct PendingShadowUpdate
+        {
+            Aws::Crt::String thingName;
+            Aws::Crt::Optional<Aws::Crt::String> shadowName;
+
+            /* Oldest first.  A new batch is only started by an update that cannot be merged into the last one. */
+            Aws::Crt::List<PendingShadowBatch> batches;
+            size_t pendingBytes = 0;
+            bool inFlight = false;
+            bool timerScheduled = false;
+        };
+
+        struct ShadowUpdateBatch
+        {
+            Aws::Crt::String key;
+            Aws::Crt::String thingName;
+            Aws::Crt::Optional<Aws::Crt::String> shadowName;
+            Aws::Crt::JsonObject reported;
+            UpdateShadowResultHandlerList handlers;
+        };
+
+        class ShadowUpdateCoalescerState : public std::enable_shared_from_this<ShadowUpdateCoalescerState>
+        {
+          public:
+            ShadowUpdateCoalescerState(
+                std::shared_ptr<IClientV2> client,
+                const ShadowUpdateCoalescerOptions &options,
+                Aws::Crt::Allocator *allocator)
+                : m_allocator(allocator), m_client(std::move(client)), m_window(options.GetCoalescingWindow()),
+                  m_maxPendingBytes(options.GetMaxPendingBytes()), m_eventLoopGroup(options.GetEventLoopGroup())
+            {
+            }
+
+            bool IsValid() const { return m_client && (m_window.count() == 0 || m_eventLoopGroup != nullptr); }
+
+            bool UpdateReported(
+                const Aws::Crt::String &thingName,
+                const Aws::Crt::Optional<Aws::Crt::String> &shadowName,
+                const Aws::Crt::JsonView &reported,
+                const UpdateShadowResultHandler &handler);
+
+            void Flush();
+
+            void OnCoalescingWindowElapsed(const Aws::Crt::String &key);
+
+          private:
+            /* Must be called with the lock held */
+            void TakeBatch(const Aws::Crt::String &key, PendingShadowUpdate &pending, ShadowUpdateBatch &batch);
+
+            /* Must be called with the lock held */
+            bool ScheduleCoalescingWindow(const Aws::Crt::String &key);
+
+            void SendBatch(ShadowUpdateBatch &&batch);
+
+            void OnBatchComplete(
+                const Aws::Crt::String &key,
+                const UpdateShadowResultHandlerList &handlers,
+                const UpdateShadowResult &result);
+
+            Aws::Crt::Allocator *m_allocator;
+            std::shared_ptr<IClientV2> m_client;
+            std::chrono::milliseconds m_window;
+            size_t m_maxPendingBytes;
+            Aws::Crt::Io::EventLoopGroup *m_eventLoopGroup;
+
+            std::mutex m_lock;
+            Aws::Crt::Map<Aws::Crt::String, PendingShadowUpdate> m_pending;
+        };
+
+        struct CoalescingWindowTask
+        {
+            CoalescingWindowTask(
+                Aws::Crt::Allocator *allocator,
+                std::weak_ptr<ShadowUpdateCoalescerState> state,
+                const Aws::Crt::String &key)
+                : allocator(allocator), state(std::move(state)), key(key)
+            {
+                AWS_ZERO_STRUCT(task);
+            }
+
+            struct aws_task task;
+            Aws::Crt::Allocator *allocator;
+            std::weak_ptr<ShadowUpdateCoalescerState> state;
+            Aws::Crt::String key;
+        };
+
+        static void s_onCoalescingWindowElapsed(struct aws_task *task, void *arg, enum aws_task_status status)
+        {
+            (void)task;
+
+            auto *windowTask = static_cast<CoalescingWindowTask *>(arg);
+            if (status == AWS_TASK_STATUS_RUN_READY)
+            {
+                if (auto state = windowTask->state.lock())
+                {
+                    state->OnCoalescingWindowElapsed(windowTask->key);
+                }
+            }
+
+            Aws::Crt::Delete(windowTask, windowTask->allocator);
+        }
+
+        static Aws::Crt::String s_makeShadowKey(
+            const Aws::Crt::String &thingName,
+            const Aws::Crt::Optional<Aws::Crt::String> &shadowName)
+        {
+            /* Thing names cannot contain '/', so this never maps a named shadow onto a classic one */
+            Aws::Crt::String key(thingName);
+            if (shadowName.has_value())
+            {
+                key.append("/");
+                key.append(*shadowName);
+            }
+
+            return key;
+        }
+
+        bool ShadowUpdateCoalescerState::UpdateReported(
+            const Aws::Crt::String &thingName,
+            const Aws::Crt::Optional<Aws::Crt::String> &shadowName,
+            const Aws::Crt::JsonView &reported,
+            const UpdateShadowResultHandler &handler)
+        {
+            if (!IsValid())
+            {
+                return false;
+            }
+
+            Aws::Crt::String key = s_makeShadowKey(thingName, shadowName);
+            size_t updateBytes = m_maxPendingBytes > 0 ? reported.WriteCompact().length() : 0;
+
+            ShadowUpdateBatch batch;
+            bool sendNow = false;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+
+                PendingShadowUpdate &pending = m_pending[key];
+                pending.thingName = thingName;
+                pending.shadowName = shadowName;
+
+                Aws::Crt::JsonObject merged;
+                if (!pending.batches.empty() &&
+                    MergeShadowStatePatches(pending.batches.back().reported.View(), reported, merged))
+                {
+                    pending.batches.back().reported = std::move(merged);
+                }
+                else
+                {
+                    pending.batches.emplace_back();
+                    pending.batches.back().reported = reported.Materialize();
+                }
+
+                PendingShadowBatch &last = pending.batches.back();
+                last.pendingBytes += updateBytes;
+                last.handlers.push_back(handler);
+                pending.pendingBytes += updateBytes;
+
+                if (!pending.inFlight)
+                {
+                    /* A batch followed by another can no longer grow, so there is no point in waiting */
+                    bool overBudget = m_maxPendingBytes > 0 && pending.pendingBytes >= m_maxPendingBytes;
+                    if (m_window.count() == 0 || overBudget || pending.batches.size() > 1)
+                    {
+                        sendNow = true;
+                    }
+                    else if (!pending.timerScheduled)
+                    {
+                        pending.timerScheduled = ScheduleCoalescingWindow(key);
+                        sendNow = !pending.timerScheduled;
+                    }
+                }
+
+                if (sendNow)
+                {
+                    TakeBatch(key, pending, batch);
+                }
+            }
+
+            if (sendNow)
+            {
+                SendBatch(std::move(batch));
+            }
+
+            return true;
+        }
+
+        void ShadowUpdateCoalescerState::Flush()
+        {
+            Aws::Crt::Vector<ShadowUpdateBatch> batches;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                for (auto &entry : m_pending)
+                {
+                    PendingShadowUpdate &pending = entry.second;
+                    if (!pending.inFlight && !pending.batches.empty())
+                    {
+                        batches.emplace_back();
+                        TakeBatch(entry.first, pending, batches.back());
+                    }
+                }
+            }
+
+            for (auto &batch : batches)
+            {
+                SendBatch(std::move(batch));
+            }
+        }
+
+        void ShadowUpdateCoalescerState::OnCoalescingWindowElapsed(const Aws::Crt::String &key)
+        {
+            ShadowUpdateBatch batch;
+            bool sendNow = false;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+
+                auto iter = m_pending.find(key);
+                if (iter == m_pending.end())
+                {
+                    return;
+                }
+
+                PendingShadowUpdate &pending = iter->second;
+                pending.timerScheduled = false;
+                if (pending.inFlight)
+                {
+                    /* Sent by OnBatchComplete once the in-flight update finishes */
+                    return;
+                }
+
+                if (!pending.batches.empty())
+                {
+                    TakeBatch(key, pending, batch);
+                    sendNow = true;
+                }
+                else
+                {
+                    m_pending.erase(iter);
+                }
+            }
+
+            if (sendNow)
+            {
+                SendBatch(std::move(batch));
+            }
+        }
+
+        void ShadowUpdateCoalescerState::TakeBatch(
+            const Aws::Crt::String &key,
+            PendingShadowUpdate &pending,
+            ShadowUpdateBatch &batch)
+        {
+            batch.key = key;
+            batch.thingName = pending.thingName;
+            if (pending.shadowName.has_value())
+            {
+                batch.shadowName = *pending.shadowName;
+            }
+
+            PendingShadowBatch &oldest = pending.batches.front();
+            batch.reported = std::move(oldest.reported);
+            batch.handlers = std::move(oldest.handlers);
+            pending.pendingBytes -= oldest.pendingBytes;
+            pending.batches.pop_front();
+            pending.inFlight = true;
+        }
+
+        bool ShadowUpdateCoalescerState::ScheduleCoalescingWindow(const Aws::Crt::String &key)
+        {
+            struct aws_event_loop *eventLoop =
+                aws_event_loop_group_get_next_loop(m_eventLoopGroup->GetUnderlyingHandle());
+            if (eventLoop == nullptr)
+            {
+                return false;
+            }
+
+            uint64_t now = 0;
+            if (aws_event_loop_current_clock_time(eventLoop, &now))
+            {
+                return false;
+            }
+
+            auto *windowTask = Aws::Crt::New<CoalescingWindowTask>(m_allocator, m_allocator, shared_from_this(), key);
+            aws_task_init(&windowTask->task, s_onCoalescingWindowElapsed, windowTask, "ShadowUpdateCoalescingWindow");
+
+            uint64_t windowNs = aws_timestamp_convert(
+                static_cast<uint64_t>(m_window.count()), AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, nullptr);
+            aws_event_loop_schedule_task_future(eventLoop, &windowTask->task, now + windowNs);
+
+            return true;
+        }
+
+        void ShadowUpdateCoalescerState::SendBatch(ShadowUpdateBatch &&batch)
+        {
+            auto state = shared_from_this();
+            auto key = batch.key;
+            auto handlers = Aws::Crt::MakeShared<UpdateShadowResultHandlerList>(m_allocator, std::move(batch.handlers));
+
+            auto resultHandler = [state, key, handlers](UpdateShadowResult &&result)
+            { state->OnBatchComplete(key, *handlers, result); };
+
+            ShadowState stateUpdate;
+            stateUpdate.Reported = std::move(batch.reported);
+
+            bool submitted = false;
+            if (batch.shadowName.has_value())
+            {
+                UpdateNamedShadowRequest request;
+                request.ThingName = batch.thingName;
+                request.ShadowName = *batch.shadowName;
+                request.State = std::move(stateUpdate);
+                submitted = m_client->UpdateNamedShadow(request, resultHandler);
+            }
+            else
+            {
+                UpdateShadowRequest request;
+                request.ThingName = batch.thingName;
+                request.State = std::move(stateUpdate);
+                submitted = m_client->UpdateShadow(request, resultHandler);
+            }
+
+            if (!submitted)
+            {
+                int errorCode = aws_last_error();
+                UpdateShadowResult failure(
+                    ServiceErrorV2<V2ErrorResponse>(errorCode != AWS_ERROR_SUCCESS ? errorCode : AWS_ERROR_UNKNOWN));
+                OnBatchComplete(key, *handlers, failure);
+            }
+        }
+
+        void ShadowUpdateCoalescerState::OnBatchComplete(
+            const Aws::Crt::String &key,
+            const UpdateShadowResultHandlerList &handlers,
+            const UpdateShadowResult &result)
+        {
+            for (const auto &handler : handlers)
+            {
+                UpdateShadowResult handlerResult(result);
+                handler(std::move(handlerResult));
+            }
+
+            ShadowUpdateBatch batch;
+            bool sendNow = false;
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+
+                auto iter = m_pending.find(key);
+                if (iter == m_pending.end())
+                {
+                    return;
+                }
+
+                PendingShadowUpdate &pending = iter->second;
+                pending.inFlight = false;
+                if (!pending.batches.empty())
+                {
+                    /* Updates that arrived while in flight have already waited one round trip */
+                    if (!pending.timerScheduled)
+                    {
+                        TakeBatch(key, pending, batch);
+                        sendNow = true;
+                    }
+                }
+                else if (!pending.timerScheduled)
+                {
+                    m_pending.erase(iter);
+                }
+            }
+
+            if (sendNow)
+            {
+                SendBatch(std::move(batch));
+            }
+        }
+
+        ShadowUpdateCoalescer::ShadowUpdateCoalescer(
+            std::shared_ptr<IClientV2> client,
+            const ShadowUpdateCoalescerOptions &options,
+            Aws::Crt::Allocator *allocator)
+            : m_state(
+                  Aws::Crt::MakeShared<ShadowUpdateCoalescerState>(allocator, std::move(client), options, allocator))
+        {
+        }
+
+        ShadowUpdateCoalescer::~ShadowUpdateCoalescer()
+        {
+            m_state->Flush();
+        }
+
+        bool ShadowUpdateCoalescer::UpdateReported(
+            const Aws::Crt::String &thingName,
+            const Aws::Crt::Optional<Aws::Crt::String> &shadowName,
+            const Aws::Crt::JsonView &reported,
+            const UpdateShadowResultHandler &handler)
+        {
+            return m_state->UpdateReported(thingName, shadowName, reported, handler);
+        }
+
+        void ShadowUpdateCoalescer::Flush()
+        {
+            m_state->Flush();
+        }
+
+        ShadowUpdateCoalescer::operator bool() const noexcept
+        {
+            return m_state->IsValid();
+        }
+
+    } // namespace Iotshadow
+} // namespace Aws
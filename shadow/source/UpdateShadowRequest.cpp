@@ -5,6 +5,8 @@
  */
 #include <aws/iotshadow/UpdateShadowRequest.h>
 
+#include <aws/iotdevicecommon/JsonWriter.h>
+
 namespace Aws
 {
     namespace Iotshadow
@@ -53,6 +55,28 @@ namespace Aws
             }
         }
 
+        void UpdateShadowRequest::SerializeTo(Aws::Iotdevicecommon::JsonWriter &writer) const
+        {
+            (void)writer;
+
+            if (ClientToken)
+            {
+                writer.WithString("clientToken", *ClientToken);
+            }
+
+            if (State)
+            {
+                writer.BeginObject("state");
+                State->SerializeTo(writer);
+                writer.EndObject();
+            }
+
+            if (Version)
+            {
+                writer.WithInteger("version", *Version);
+            }
+        }
+
         UpdateShadowRequest::UpdateShadowRequest(const Crt::JsonView &doc)
         {
             LoadFromObject(*this, doc);
@@ -0,0 +1,66 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotdevicecommon/JsonWriter.h>
+#include <aws/iotshadow/ShadowState.h>
+#include <aws/iotshadow/UpdateShadowRequest.h>
+
+static Aws::Crt::String s_toString(const Aws::Iotdevicecommon::JsonWriter &writer)
+{
+    struct aws_byte_cursor cursor = writer.ToCursor();
+    return Aws::Crt::String(reinterpret_cast<const char *>(cursor.ptr), cursor.len);
+}
+
+static int s_JsonWriterUpdateShadowRequest(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        Aws::Crt::JsonObject desired;
+        desired.WithString("color", "green");
+        desired.WithInteger("brightness", 7);
+
+        Aws::Iotshadow::ShadowState state;
+        state.Desired = desired;
+
+        Aws::Iotshadow::UpdateShadowRequest request;
+        request.ThingName = "thing";
+        request.ClientToken = "caller-supplied";
+        request.State = state;
+        request.Version = 12;
+
+        Aws::Iotdevicecommon::JsonWriter writer(allocator);
+        writer.BeginObject();
+        writer.WithString("clientToken", "generated");
+        writer.ReserveKey("clientToken");
+        request.SerializeTo(writer);
+        writer.EndObject();
+        ASSERT_TRUE(static_cast<bool>(writer));
+
+        /* The writer's output must match the JsonObject path, except for the reserved token */
+        Aws::Crt::String json = s_toString(writer);
+        ASSERT_TRUE(json.find("caller-supplied") == Aws::Crt::String::npos);
+
+        Aws::Crt::JsonObject parsed(json);
+        ASSERT_TRUE(parsed.WasParseSuccessful());
+        ASSERT_TRUE(parsed.View().GetString("clientToken") == "generated");
+        ASSERT_INT_EQUALS(12, parsed.View().GetInteger("version"));
+        ASSERT_FALSE(parsed.View().ValueExists("thingName"));
+
+        Aws::Crt::JsonView parsedDesired = parsed.View().GetJsonObject("state").GetJsonObject("desired");
+        ASSERT_TRUE(parsedDesired.GetString("color") == "green");
+        ASSERT_INT_EQUALS(7, parsedDesired.GetInteger("brightness"));
+        ASSERT_FALSE(parsed.View().GetJsonObject("state").ValueExists("reported"));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(JsonWriterUpdateShadowRequest, s_JsonWriterUpdateShadowRequest)
@@ -0,0 +1,234 @@
+#pragma once
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+
+#include <aws/iotshadow/GetNamedShadowRequest.h>
+#include <aws/iotshadow/GetShadowRequest.h>
+#include <aws/iotshadow/IotShadowClientV2.h>
+#include <aws/iotshadow/ShadowDocument.h>
+#include <aws/iotshadow/ShadowState.h>
+#include <aws/iotshadow/UpdateNamedShadowRequest.h>
+#include <aws/iotshadow/UpdateShadowRequest.h>
+#include <aws/iotshadow/UpdateShadowResponse.h>
+#include <aws/iotshadow/V2ErrorResponse.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+class RecordingShadowStream : public Aws::Iot::RequestResponse::IStreamingOperation
+{
+  public:
+    void Open() override { opened = true; }
+
+    bool opened = false;
+};
+
+/*
+ * Fake shadow service client shared by the shadow unit tests.  Records update and get requests, which may arrive on
+ * event loop threads, and lets the test decide when and how the service answers them.
+ */
+class RecordingShadowClient : public Aws::Iotshadow::IClientV2
+{
+  public:
+    struct RecordedUpdate
+    {
+        Aws::Crt::Optional<Aws::Crt::String> shadowName;
+        Aws::Crt::Optional<Aws::Iotshadow::ShadowState> state;
+        Aws::Crt::Optional<int32_t> version;
+        Aws::Iotshadow::UpdateShadowResultHandler handler;
+    };
+
+    bool DeleteNamedShadow(
+        const Aws::Iotshadow::DeleteNamedShadowRequest &,
+        const Aws::Iotshadow::DeleteNamedShadowResultHandler &) override
+    {
+        return false;
+    }
+
+    bool DeleteShadow(const Aws::Iotshadow::DeleteShadowRequest &, const Aws::Iotshadow::DeleteShadowResultHandler &)
+        override
+    {
+        return false;
+    }
+
+    bool GetNamedShadow(
+        const Aws::Iotshadow::GetNamedShadowRequest &,
+        const Aws::Iotshadow::GetNamedShadowResultHandler &) override
+    {
+        return false;
+    }
+
+    bool GetShadow(const Aws::Iotshadow::GetShadowRequest &, const Aws::Iotshadow::GetShadowResultHandler &) override
+    {
+        return false;
+    }
+
+    bool UpdateNamedShadow(
+        const Aws::Iotshadow::UpdateNamedShadowRequest &request,
+        const Aws::Iotshadow::UpdateNamedShadowResultHandler &handler) override
+    {
+        RecordedUpdate update;
+        update.shadowName = request.ShadowName;
+        update.state = request.State;
+        update.version = request.Version;
+        update.handler = handler;
+        return Record(std::move(update));
+    }
+
+    bool UpdateShadow(
+        const Aws::Iotshadow::UpdateShadowRequest &request,
+        const Aws::Iotshadow::UpdateShadowResultHandler &handler) override
+    {
+        RecordedUpdate update;
+        update.state = request.State;
+        update.version = request.Version;
+        update.handler = handler;
+        return Record(std::move(update));
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateNamedShadowDeltaUpdatedStream(
+        const Aws::Iotshadow::NamedShadowDeltaUpdatedSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotshadow::ShadowDeltaUpdatedEvent> &) override
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateNamedShadowUpdatedStream(
+        const Aws::Iotshadow::NamedShadowUpdatedSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotshadow::ShadowUpdatedEvent> &) override
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateShadowDeltaUpdatedStream(
+        const Aws::Iotshadow::ShadowDeltaUpdatedSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotshadow::ShadowDeltaUpdatedEvent> &) override
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateShadowUpdatedStream(
+        const Aws::Iotshadow::ShadowUpdatedSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotshadow::ShadowUpdatedEvent> &) override
+    {
+        return nullptr;
+    }
+
+    bool GetShadowDocument(
+        const Aws::Iotshadow::GetShadowRequest &,
+        const Aws::Iotshadow::GetShadowDocumentResultHandler &handler) override
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        getHandlers.push_back(handler);
+        return true;
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateShadowDeltaUpdatedDocumentStream(
+        const Aws::Iotshadow::ShadowDeltaUpdatedSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotshadow::ShadowDocument> &options) override
+    {
+        deltaHandler = options.GetStreamHandler();
+        return std::make_shared<RecordingShadowStream>();
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateShadowUpdatedDocumentStream(
+        const Aws::Iotshadow::ShadowUpdatedSubscriptionRequest &,
+        const Aws::Iot::RequestResponse::StreamingOperationOptions<Aws::Iotshadow::ShadowDocument> &options) override
+    {
+        documentsHandler = options.GetStreamHandler();
+        return std::make_shared<RecordingShadowStream>();
+    }
+
+    bool WaitForUpdates(size_t count)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        return updated.wait_for(guard, std::chrono::seconds(5), [this, count]() { return updates.size() >= count; });
+    }
+
+    /* Answers the get request with the given JSON document, or with a modeled error if the document is null */
+    void AnswerGet(size_t index, const char *document, int32_t errorCode = 404)
+    {
+        Aws::Iotshadow::GetShadowDocumentResultHandler handler;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            handler = std::move(getHandlers[index]);
+        }
+
+        if (document != nullptr)
+        {
+            handler(Aws::Iotshadow::GetShadowDocumentResult(
+                Aws::Iotshadow::ShadowDocument::FromPayload(Aws::Crt::ByteCursorFromCString(document))));
+            return;
+        }
+
+        Aws::Iotshadow::V2ErrorResponse error;
+        error.Code = errorCode;
+        handler(Aws::Iotshadow::GetShadowDocumentResult(Aws::Iotshadow::ServiceErrorV2<Aws::Iotshadow::V2ErrorResponse>(
+            AWS_ERROR_MQTT_REQUEST_RESPONSE_MODELED_SERVICE_ERROR, std::move(error))));
+    }
+
+    /* Accepts the update with the given resulting version */
+    void AcceptUpdate(size_t index, int32_t version)
+    {
+        Aws::Iotshadow::UpdateShadowResponse response;
+        response.Version = version;
+        Answer(index, Aws::Iotshadow::UpdateShadowResult(std::move(response)));
+    }
+
+    /* Rejects the update with a modeled service error */
+    void RejectUpdate(size_t index, int32_t errorCode)
+    {
+        Aws::Iotshadow::V2ErrorResponse error;
+        error.Code = errorCode;
+        Answer(
+            index,
+            Aws::Iotshadow::UpdateShadowResult(Aws::Iotshadow::ServiceErrorV2<Aws::Iotshadow::V2ErrorResponse>(
+                AWS_ERROR_MQTT_REQUEST_RESPONSE_MODELED_SERVICE_ERROR, std::move(error))));
+    }
+
+    /* Serialized reported section of a recorded update */
+    Aws::Crt::String GetReported(size_t index)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return updates[index].state->Reported->View().WriteCompact();
+    }
+
+    size_t GetUpdateCount()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return updates.size();
+    }
+
+    std::mutex lock;
+    std::condition_variable updated;
+    Aws::Crt::Vector<RecordedUpdate> updates;
+    Aws::Crt::Vector<Aws::Iotshadow::GetShadowDocumentResultHandler> getHandlers;
+    std::function<void(Aws::Iotshadow::ShadowDocument &&)> documentsHandler;
+    std::function<void(Aws::Iotshadow::ShadowDocument &&)> deltaHandler;
+
+  private:
+    bool Record(RecordedUpdate &&update)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        updates.push_back(std::move(update));
+        updated.notify_all();
+        return true;
+    }
+
+    void Answer(size_t index, Aws::Iotshadow::UpdateShadowResult &&result)
+    {
+        Aws::Iotshadow::UpdateShadowResultHandler handler;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            handler = std::move(updates[index].handler);
+        }
+
+        handler(std::move(result));
+    }
+};
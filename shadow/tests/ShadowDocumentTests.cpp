@@ -0,0 +1,73 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotshadow/ShadowDocument.h>
+
+static const char *s_updatedDocumentPayload =
+    "{\"previous\":{\"state\":{\"desired\":{\"color\":\"green\"},\"reported\":{\"color\":\"red\"}},"
+    "\"metadata\":{},\"version\":4},"
+    "\"current\":{\"state\":{\"desired\":{\"color\":\"blue\"},\"reported\":{\"color\":\"red\"}},"
+    "\"metadata\":{},\"version\":5},"
+    "\"timestamp\":1700000000,\"clientToken\":\"token\"}";
+
+static int s_ShadowDocumentUpdatedViews(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto payload = Aws::Crt::ByteCursorFromCString(s_updatedDocumentPayload);
+        auto document = Aws::Iotshadow::ShadowDocument::FromPayload(payload, allocator);
+        ASSERT_TRUE(document.IsValid());
+        ASSERT_TRUE(document.GetClientToken().value() == "token");
+        ASSERT_TRUE(document.GetTimestamp().has_value());
+        ASSERT_FALSE(document.GetState().has_value());
+
+        auto previous = document.GetPrevious();
+        auto current = document.GetCurrent();
+        ASSERT_TRUE(previous.IsValid());
+        ASSERT_TRUE(current.IsValid());
+        ASSERT_INT_EQUALS(4, previous.GetVersion().value());
+        ASSERT_INT_EQUALS(5, current.GetVersion().value());
+        ASSERT_TRUE(previous.GetDesired()->GetString("color") == "green");
+        ASSERT_TRUE(current.GetDesired()->GetString("color") == "blue");
+        ASSERT_FALSE(current.GetDelta().has_value());
+
+        auto reported = current.MaterializeReported();
+        ASSERT_TRUE(reported.has_value());
+
+        /* the materialized copy must outlive every view of the original payload */
+        document = Aws::Iotshadow::ShadowDocument();
+        previous = Aws::Iotshadow::ShadowDocument();
+        current = Aws::Iotshadow::ShadowDocument();
+        ASSERT_TRUE(reported->View().GetString("color") == "red");
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowDocumentUpdatedViews, s_ShadowDocumentUpdatedViews)
+
+static int s_ShadowDocumentInvalidPayload(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto document =
+            Aws::Iotshadow::ShadowDocument::FromPayload(Aws::Crt::ByteCursorFromCString("{\"state\":"), allocator);
+        ASSERT_FALSE(document.IsValid());
+        ASSERT_FALSE(document.GetPrevious().IsValid());
+        ASSERT_FALSE(document.GetDesired().has_value());
+        ASSERT_FALSE(document.GetVersion().has_value());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowDocumentInvalidPayload, s_ShadowDocumentInvalidPayload)
@@ -0,0 +1,127 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotshadow/ShadowMirror.h>
+
+#include "RecordingShadowClient.h"
+
+using namespace Aws::Iotshadow;
+
+static int s_ShadowMirrorOutOfOrderAcks(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingShadowClient>();
+        ShadowMirror mirror(client, "thing", {}, allocator);
+
+        int syncError = -1;
+        ASSERT_TRUE(mirror.Start([&syncError](int errorCode) { syncError = errorCode; }));
+        ASSERT_INT_EQUALS(1, client->getHandlers.size());
+        client->AnswerGet(0, "{\"state\":{\"reported\":{\"a\":1,\"b\":1}},\"version\":1}");
+        ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, syncError);
+        ASSERT_INT_EQUALS(1, *mirror.GetVersion());
+
+        int completed = 0;
+        auto handler = [&completed](UpdateShadowResult &&result)
+        {
+            if (result.IsSuccess())
+            {
+                ++completed;
+            }
+        };
+
+        /* Both updates are in flight at the same time; the second is diffed against the first */
+        Aws::Crt::JsonObject first(Aws::Crt::String("{\"a\":2,\"b\":1,\"c\":1}"));
+        Aws::Crt::JsonObject second(Aws::Crt::String("{\"a\":3,\"b\":2,\"c\":1}"));
+        ASSERT_TRUE(mirror.UpdateReported(first.View(), handler));
+        ASSERT_TRUE(mirror.UpdateReported(second.View(), handler));
+        ASSERT_INT_EQUALS(2, client->GetUpdateCount());
+        ASSERT_TRUE(client->GetReported(0) == "{\"a\":2,\"c\":1}");
+        ASSERT_TRUE(client->GetReported(1) == "{\"a\":3,\"b\":2}");
+
+        /* The service applied them in order, but the second acknowledgement arrives first */
+        client->AcceptUpdate(1, 3);
+        client->AcceptUpdate(0, 2);
+        ASSERT_INT_EQUALS(2, completed);
+
+        ASSERT_INT_EQUALS(3, *mirror.GetVersion());
+        Aws::Crt::JsonObject reported = *mirror.GetReported();
+        ASSERT_INT_EQUALS(3, reported.View().GetInteger("a"));
+        ASSERT_INT_EQUALS(2, reported.View().GetInteger("b"));
+        ASSERT_INT_EQUALS(1, reported.View().GetInteger("c"));
+
+        /* A full document already includes every update up to its version */
+        ASSERT_TRUE(client->documentsHandler != nullptr);
+        Aws::Crt::JsonObject third(Aws::Crt::String("{\"a\":4,\"b\":2,\"c\":1}"));
+        ASSERT_TRUE(mirror.UpdateReported(third.View(), handler));
+        client->documentsHandler(ShadowDocument::FromPayload(Aws::Crt::ByteCursorFromCString(
+            "{\"current\":{\"state\":{\"reported\":{\"a\":5,\"b\":2,\"c\":1}},\"version\":5}}")));
+        client->AcceptUpdate(2, 4);
+        ASSERT_INT_EQUALS(5, *mirror.GetVersion());
+        ASSERT_INT_EQUALS(5, mirror.GetReported()->View().GetInteger("a"));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowMirrorOutOfOrderAcks, s_ShadowMirrorOutOfOrderAcks)
+
+static int s_ShadowMirrorRevertWhileInFlight(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingShadowClient>();
+        ShadowMirror mirror(client, "thing", {}, allocator);
+
+        ASSERT_TRUE(mirror.Start([](int) {}));
+        client->AnswerGet(0, "{\"state\":{\"reported\":{\"a\":0}},\"version\":1}");
+
+        int completed = 0;
+        auto handler = [&completed](UpdateShadowResult &&result)
+        {
+            if (result.IsSuccess())
+            {
+                ++completed;
+            }
+        };
+
+        Aws::Crt::JsonObject changed(Aws::Crt::String("{\"a\":1}"));
+        Aws::Crt::JsonObject reverted(Aws::Crt::String("{\"a\":0}"));
+        ASSERT_TRUE(mirror.UpdateReported(changed.View(), handler));
+        ASSERT_INT_EQUALS(1, client->GetUpdateCount());
+
+        /* Repeating the update in flight sends nothing */
+        ASSERT_TRUE(mirror.UpdateReported(changed.View(), handler));
+        ASSERT_INT_EQUALS(1, client->GetUpdateCount());
+        ASSERT_INT_EQUALS(1, completed);
+
+        /* Reverting it while it is in flight must still reach the service */
+        ASSERT_TRUE(mirror.UpdateReported(reverted.View(), handler));
+        ASSERT_INT_EQUALS(2, client->GetUpdateCount());
+        ASSERT_TRUE(client->GetReported(1) == "{\"a\":0}");
+
+        client->AcceptUpdate(0, 2);
+        client->AcceptUpdate(1, 3);
+        ASSERT_INT_EQUALS(3, completed);
+        ASSERT_INT_EQUALS(3, *mirror.GetVersion());
+        ASSERT_INT_EQUALS(0, mirror.GetReported()->View().GetInteger("a"));
+
+        /* With nothing in flight, the acknowledged state is the reference again */
+        ASSERT_TRUE(mirror.UpdateReported(reverted.View(), handler));
+        ASSERT_INT_EQUALS(2, client->GetUpdateCount());
+        ASSERT_INT_EQUALS(4, completed);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowMirrorRevertWhileInFlight, s_ShadowMirrorRevertWhileInFlight)
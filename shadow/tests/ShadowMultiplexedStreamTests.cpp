@@ -0,0 +1,223 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotshadow/IotShadowClientV2.h>
+#include <aws/iotshadow/ShadowDeltaUpdatedEvent.h>
+#include <aws/iotshadow/ShadowUpdatedEvent.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace Aws::Iotshadow;
+
+class MultiplexedTestStream : public Aws::Iot::RequestResponse::IStreamingOperation
+{
+  public:
+    void Open() override { opened = true; }
+
+    bool opened = false;
+};
+
+/* Captures the subscription of the one stream the multiplexer creates, so tests can publish to it directly */
+class StreamCapturingRequestResponseClient : public Aws::Iot::RequestResponse::IMqttRequestResponseClient
+{
+  public:
+    int SubmitRequest(
+        const aws_mqtt_request_operation_options &,
+        Aws::Iot::RequestResponse::UnmodeledResultHandler &&) override
+    {
+        return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+    }
+
+    std::shared_ptr<Aws::Iot::RequestResponse::IStreamingOperation> CreateStream(
+        const Aws::Iot::RequestResponse::StreamingOperationOptionsInternal &options) override
+    {
+        ++streamCount;
+        subscriptionTopicFilter = Aws::Crt::String(
+            reinterpret_cast<const char *>(options.subscriptionTopicFilter.ptr), options.subscriptionTopicFilter.len);
+        publishHandler = options.incomingPublishEventHandler;
+        stream = std::make_shared<MultiplexedTestStream>();
+        return stream;
+    }
+
+    void Publish(const char *topic, const char *payload)
+    {
+        Aws::Iot::RequestResponse::IncomingPublishEvent publishEvent;
+        publishEvent.WithTopic(Aws::Crt::ByteCursorFromCString(topic))
+            .WithPayload(Aws::Crt::ByteCursorFromCString(payload));
+        publishHandler(std::move(publishEvent));
+    }
+
+    int streamCount = 0;
+    Aws::Crt::String subscriptionTopicFilter;
+    Aws::Iot::RequestResponse::IncomingPublishEventHandler publishHandler;
+    std::shared_ptr<MultiplexedTestStream> stream;
+};
+
+static int s_ShadowMultiplexedStreamRouting(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto bindingClient = std::make_shared<StreamCapturingRequestResponseClient>();
+        auto client = NewClientFromRequestResponseClient(bindingClient, nullptr, allocator);
+        ASSERT_NOT_NULL(client.get());
+
+        int unrouted = 0;
+        Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDeltaUpdatedEvent> options;
+        options.WithStreamHandler([&unrouted](ShadowDeltaUpdatedEvent &&) { ++unrouted; });
+
+        auto stream = client->CreateNamedShadowDeltaUpdatedMultiplexedStream("thing", options);
+        ASSERT_NOT_NULL(stream.get());
+        ASSERT_INT_EQUALS(1, bindingClient->streamCount);
+        ASSERT_TRUE(bindingClient->subscriptionTopicFilter == "$aws/things/thing/shadow/name/+/update/delta");
+
+        stream->Open();
+        ASSERT_TRUE(bindingClient->stream->opened);
+
+        Aws::Crt::Vector<int32_t> configVersions;
+        Aws::Crt::Vector<int32_t> networkVersions;
+        stream->SetShadowHandler(
+            "config", [&configVersions](ShadowDeltaUpdatedEvent &&event) { configVersions.push_back(*event.Version); });
+        stream->SetShadowHandler(
+            "network",
+            [&networkVersions](ShadowDeltaUpdatedEvent &&event) { networkVersions.push_back(*event.Version); });
+
+        /* Each event goes to the handler of the shadow named in its topic */
+        bindingClient->Publish("$aws/things/thing/shadow/name/config/update/delta", "{\"version\":1}");
+        bindingClient->Publish("$aws/things/thing/shadow/name/network/update/delta", "{\"version\":2}");
+        bindingClient->Publish("$aws/things/thing/shadow/name/config/update/delta", "{\"version\":3}");
+        ASSERT_INT_EQUALS(2, configVersions.size());
+        ASSERT_INT_EQUALS(1, configVersions[0]);
+        ASSERT_INT_EQUALS(3, configVersions[1]);
+        ASSERT_INT_EQUALS(1, networkVersions.size());
+        ASSERT_INT_EQUALS(2, networkVersions[0]);
+        ASSERT_INT_EQUALS(0, unrouted);
+
+        /* Names are matched exactly, not by prefix */
+        bindingClient->Publish("$aws/things/thing/shadow/name/conf/update/delta", "{\"version\":4}");
+        bindingClient->Publish("$aws/things/thing/shadow/name/configs/update/delta", "{\"version\":5}");
+        ASSERT_INT_EQUALS(2, configVersions.size());
+        ASSERT_INT_EQUALS(2, unrouted);
+
+        /* Replacing a handler takes effect on the next event, and a removed shadow falls back to the stream handler */
+        int replaced = 0;
+        stream->SetShadowHandler("config", [&replaced](ShadowDeltaUpdatedEvent &&) { ++replaced; });
+        stream->RemoveShadowHandler("network");
+        bindingClient->Publish("$aws/things/thing/shadow/name/config/update/delta", "{\"version\":6}");
+        bindingClient->Publish("$aws/things/thing/shadow/name/network/update/delta", "{\"version\":7}");
+        ASSERT_INT_EQUALS(1, replaced);
+        ASSERT_INT_EQUALS(2, configVersions.size());
+        ASSERT_INT_EQUALS(1, networkVersions.size());
+        ASSERT_INT_EQUALS(3, unrouted);
+
+        /* Unparseable payloads are dropped */
+        bindingClient->Publish("$aws/things/thing/shadow/name/config/update/delta", "{");
+        ASSERT_INT_EQUALS(1, replaced);
+        ASSERT_INT_EQUALS(3, unrouted);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowMultiplexedStreamRouting, s_ShadowMultiplexedStreamRouting)
+
+static int s_ShadowMultiplexedStreamUpdatedEvents(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto bindingClient = std::make_shared<StreamCapturingRequestResponseClient>();
+        auto client = NewClientFromRequestResponseClient(bindingClient, nullptr, allocator);
+        ASSERT_NOT_NULL(client.get());
+
+        /* Without a stream handler, events of shadows that have no route are dropped */
+        auto stream = client->CreateNamedShadowUpdatedMultiplexedStream(
+            "thing", Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowUpdatedEvent>());
+        ASSERT_NOT_NULL(stream.get());
+        ASSERT_TRUE(bindingClient->subscriptionTopicFilter == "$aws/things/thing/shadow/name/+/update/documents");
+
+        Aws::Crt::Vector<int32_t> versions;
+        stream->SetShadowHandler(
+            "config",
+            [&versions](ShadowUpdatedEvent &&event) { versions.push_back(*event.Current->Version); });
+
+        bindingClient->Publish(
+            "$aws/things/thing/shadow/name/other/update/documents", "{\"current\":{\"version\":1}}");
+        bindingClient->Publish(
+            "$aws/things/thing/shadow/name/config/update/documents", "{\"current\":{\"version\":2}}");
+        ASSERT_INT_EQUALS(1, versions.size());
+        ASSERT_INT_EQUALS(2, versions[0]);
+
+        /* A handler may remove its own route; the event it is handling still completes */
+        stream->SetShadowHandler(
+            "config",
+            [&versions, &stream](ShadowUpdatedEvent &&event)
+            {
+                stream->RemoveShadowHandler("config");
+                versions.push_back(*event.Current->Version);
+            });
+        bindingClient->Publish(
+            "$aws/things/thing/shadow/name/config/update/documents", "{\"current\":{\"version\":3}}");
+        bindingClient->Publish(
+            "$aws/things/thing/shadow/name/config/update/documents", "{\"current\":{\"version\":4}}");
+        ASSERT_INT_EQUALS(2, versions.size());
+        ASSERT_INT_EQUALS(3, versions[1]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowMultiplexedStreamUpdatedEvents, s_ShadowMultiplexedStreamUpdatedEvents)
+
+static int s_ShadowMultiplexedStreamRouteChurn(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto bindingClient = std::make_shared<StreamCapturingRequestResponseClient>();
+        auto client = NewClientFromRequestResponseClient(bindingClient, nullptr, allocator);
+        ASSERT_NOT_NULL(client.get());
+
+        std::atomic<int> unrouted(0);
+        Aws::Iot::RequestResponse::StreamingOperationOptions<ShadowDeltaUpdatedEvent> options;
+        options.WithStreamHandler([&unrouted](ShadowDeltaUpdatedEvent &&) { ++unrouted; });
+        auto stream = client->CreateNamedShadowDeltaUpdatedMultiplexedStream("thing", options);
+        ASSERT_NOT_NULL(stream.get());
+
+        std::atomic<int> routed(0);
+        std::atomic<bool> publishing(true);
+        const int eventCount = 2000;
+
+        /* Events keep arriving on the subscription while the route of their shadow is added and removed */
+        std::thread publisher(
+            [&]()
+            {
+                for (int i = 0; i < eventCount; ++i)
+                {
+                    bindingClient->Publish("$aws/things/thing/shadow/name/config/update/delta", "{\"version\":1}");
+                }
+                publishing = false;
+            });
+
+        while (publishing)
+        {
+            stream->SetShadowHandler("config", [&routed](ShadowDeltaUpdatedEvent &&) { ++routed; });
+            stream->RemoveShadowHandler("config");
+        }
+        publisher.join();
+
+        /* Every event was delivered exactly once, either to the route or to the stream handler */
+        ASSERT_INT_EQUALS(eventCount, routed + unrouted);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowMultiplexedStreamRouteChurn, s_ShadowMultiplexedStreamRouteChurn)
@@ -0,0 +1,101 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotshadow/ShadowStateDiff.h>
+
+static int s_ShadowStateDiffMinimalUpdate(Aws::Crt::Allocator *allocator, void *)
+{
+    (void)allocator;
+    {
+        Aws::Crt::ApiHandle handle;
+
+        Aws::Crt::JsonObject base(Aws::Crt::String(
+            "{\"color\":\"red\",\"fw\":{\"version\":\"1.0\",\"slot\":1},\"tags\":[1,2],\"removed\":true}"));
+        Aws::Crt::JsonObject target(
+            Aws::Crt::String("{\"color\":\"red\",\"fw\":{\"version\":\"1.1\",\"slot\":1},\"tags\":[1,2],\"added\":5}"));
+
+        Aws::Crt::JsonObject diff;
+        ASSERT_TRUE(Aws::Iotshadow::ComputeShadowStateDiff(base.View(), target.View(), diff));
+
+        Aws::Crt::JsonView diffView = diff.View();
+        ASSERT_FALSE(diffView.KeyExists("color"));
+        ASSERT_FALSE(diffView.KeyExists("tags"));
+        ASSERT_TRUE(diffView.GetJsonObject("fw").GetString("version") == "1.1");
+        ASSERT_FALSE(diffView.GetJsonObject("fw").KeyExists("slot"));
+        ASSERT_INT_EQUALS(5, diffView.GetInteger("added"));
+        ASSERT_TRUE(diffView.KeyExists("removed"));
+        ASSERT_TRUE(diffView.GetJsonObject("removed").IsNull());
+
+        Aws::Crt::JsonObject applied = Aws::Iotshadow::ApplyShadowStatePatch(base.View(), diffView);
+        Aws::Crt::JsonObject unused;
+        ASSERT_FALSE(Aws::Iotshadow::ComputeShadowStateDiff(applied.View(), target.View(), unused));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowStateDiffMinimalUpdate, s_ShadowStateDiffMinimalUpdate)
+
+static int s_ShadowStatePatchMerge(Aws::Crt::Allocator *allocator, void *)
+{
+    (void)allocator;
+    {
+        Aws::Crt::ApiHandle handle;
+
+        Aws::Crt::JsonObject older(Aws::Crt::String("{\"a\":1,\"b\":{\"x\":1,\"y\":2},\"c\":null}"));
+        Aws::Crt::JsonObject newer(Aws::Crt::String("{\"a\":2,\"b\":{\"y\":null}}"));
+
+        Aws::Crt::JsonObject merged;
+        ASSERT_TRUE(Aws::Iotshadow::MergeShadowStatePatches(older.View(), newer.View(), merged));
+        Aws::Crt::JsonView mergedView = merged.View();
+        ASSERT_INT_EQUALS(2, mergedView.GetInteger("a"));
+        ASSERT_INT_EQUALS(1, mergedView.GetJsonObject("b").GetInteger("x"));
+        ASSERT_TRUE(mergedView.GetJsonObject("b").GetJsonObject("y").IsNull());
+        ASSERT_TRUE(mergedView.GetJsonObject("c").IsNull());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowStatePatchMerge, s_ShadowStatePatchMerge)
+
+static int s_ShadowStatePatchMergeReplacement(Aws::Crt::Allocator *allocator, void *)
+{
+    (void)allocator;
+    {
+        Aws::Crt::ApiHandle handle;
+
+        /* A deletion followed by an object would merge into the old value if sent as one update */
+        Aws::Crt::JsonObject deletion(Aws::Crt::String("{\"k\":null,\"a\":1}"));
+        Aws::Crt::JsonObject object(Aws::Crt::String("{\"k\":{\"x\":1}}"));
+        Aws::Crt::JsonObject merged;
+        ASSERT_FALSE(Aws::Iotshadow::MergeShadowStatePatches(deletion.View(), object.View(), merged));
+
+        Aws::Crt::JsonObject scalar(Aws::Crt::String("{\"k\":5}"));
+        ASSERT_FALSE(Aws::Iotshadow::MergeShadowStatePatches(scalar.View(), object.View(), merged));
+
+        /* The same holds below the top level */
+        Aws::Crt::JsonObject nestedDeletion(Aws::Crt::String("{\"o\":{\"k\":null}}"));
+        Aws::Crt::JsonObject nestedObject(Aws::Crt::String("{\"o\":{\"k\":{\"x\":1}}}"));
+        ASSERT_FALSE(Aws::Iotshadow::MergeShadowStatePatches(nestedDeletion.View(), nestedObject.View(), merged));
+
+        /* An object followed by a deletion or a scalar replaces it either way */
+        ASSERT_TRUE(Aws::Iotshadow::MergeShadowStatePatches(object.View(), deletion.View(), merged));
+        ASSERT_TRUE(merged.View().GetJsonObject("k").IsNull());
+        ASSERT_INT_EQUALS(1, merged.View().GetInteger("a"));
+
+        ASSERT_TRUE(Aws::Iotshadow::MergeShadowStatePatches(object.View(), scalar.View(), merged));
+        ASSERT_INT_EQUALS(5, merged.View().GetInteger("k"));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowStatePatchMergeReplacement, s_ShadowStatePatchMergeReplacement)
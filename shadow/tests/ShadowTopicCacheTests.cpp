@@ -0,0 +1,116 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotshadow/ShadowTopicCache.h>
+
+using namespace Aws::Iotshadow;
+
+static int s_ShadowTopicCacheHit(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        ShadowTopicCache cache(allocator, 4);
+        Aws::Crt::String thing("thing");
+        Aws::Crt::String shadow("config");
+
+        auto named = cache.GetTopicSet(thing, &shadow);
+        auto classic = cache.GetTopicSet(thing, nullptr);
+        ASSERT_INT_EQUALS(2, cache.GetSize());
+        ASSERT_TRUE(named != classic);
+
+        const auto &update = named->GetTopics(ShadowTopicOperation::Update);
+        ASSERT_TRUE(update.publishTopic == "$aws/things/thing/shadow/name/config/update");
+        ASSERT_INT_EQUALS(2, update.subscriptionTopicCount);
+        ASSERT_TRUE(update.subscriptionTopic0 == "$aws/things/thing/shadow/name/config/update/accepted");
+        ASSERT_TRUE(update.subscriptionTopic1 == "$aws/things/thing/shadow/name/config/update/rejected");
+
+        const auto &get = classic->GetTopics(ShadowTopicOperation::Get);
+        ASSERT_TRUE(get.publishTopic == "$aws/things/thing/shadow/get");
+        ASSERT_INT_EQUALS(1, get.subscriptionTopicCount);
+        ASSERT_TRUE(get.subscriptionTopic0 == "$aws/things/thing/shadow/get/+");
+
+        /* Equal names hit the cached set, whatever string they are held in */
+        Aws::Crt::String otherThing("thing");
+        Aws::Crt::String otherShadow("config");
+        ASSERT_TRUE(cache.GetTopicSet(otherThing, &otherShadow) == named);
+        ASSERT_TRUE(cache.GetTopicSet(otherThing, nullptr) == classic);
+        ASSERT_INT_EQUALS(2, cache.GetSize());
+
+        /* A named shadow never matches the classic shadow of a thing with a similar name */
+        Aws::Crt::String joinedThing("thing/config");
+        ASSERT_TRUE(cache.GetTopicSet(joinedThing, nullptr) != named);
+        ASSERT_INT_EQUALS(3, cache.GetSize());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowTopicCacheHit, s_ShadowTopicCacheHit)
+
+static int s_ShadowTopicCacheEviction(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        ShadowTopicCache cache(allocator, 2);
+        Aws::Crt::String thing("thing");
+        Aws::Crt::String a("a");
+        Aws::Crt::String b("b");
+        Aws::Crt::String c("c");
+
+        auto first = cache.GetTopicSet(thing, &a);
+        auto second = cache.GetTopicSet(thing, &b);
+        ASSERT_INT_EQUALS(2, cache.GetSize());
+
+        /* At capacity, the least recently used set ("a") is evicted */
+        auto third = cache.GetTopicSet(thing, &c);
+        ASSERT_INT_EQUALS(2, cache.GetSize());
+        ASSERT_TRUE(cache.GetTopicSet(thing, &b) == second);
+        ASSERT_TRUE(cache.GetTopicSet(thing, &c) == third);
+
+        /* An evicted set stays valid for its holders, and a new one is built on the next lookup */
+        const auto &deleteTopics = first->GetTopics(ShadowTopicOperation::Delete);
+        ASSERT_TRUE(deleteTopics.publishTopic == "$aws/things/thing/shadow/name/a/delete");
+        auto rebuilt = cache.GetTopicSet(thing, &a);
+        ASSERT_TRUE(rebuilt != first);
+        ASSERT_INT_EQUALS(2, cache.GetSize());
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowTopicCacheEviction, s_ShadowTopicCacheEviction)
+
+static int s_ShadowTopicCacheRecency(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        ShadowTopicCache cache(allocator, 2);
+        Aws::Crt::String thing("thing");
+        Aws::Crt::String a("a");
+        Aws::Crt::String b("b");
+        Aws::Crt::String c("c");
+
+        auto first = cache.GetTopicSet(thing, &a);
+        auto second = cache.GetTopicSet(thing, &b);
+
+        /* A hit makes "a" the most recently used set, so "b" is evicted in its place */
+        ASSERT_TRUE(cache.GetTopicSet(thing, &a) == first);
+        cache.GetTopicSet(thing, &c);
+        ASSERT_INT_EQUALS(2, cache.GetSize());
+        ASSERT_TRUE(cache.GetTopicSet(thing, &a) == first);
+        ASSERT_TRUE(cache.GetTopicSet(thing, &b) != second);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowTopicCacheRecency, s_ShadowTopicCacheRecency)
@@ -0,0 +1,135 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotshadow/ShadowTransaction.h>
+
+#include "RecordingShadowClient.h"
+
+using namespace Aws::Iotshadow;
+
+static const int32_t SHADOW_VERSION_CONFLICT_CODE = 409;
+
+/* Increments the reported counter of the shadow */
+static bool s_incrementCount(const ShadowDocument &current, ShadowState &update)
+{
+    auto reported = current.GetReported();
+    int count = reported.has_value() ? reported->GetInteger("count") : 0;
+
+    Aws::Crt::JsonObject next;
+    next.WithInteger("count", count + 1);
+    update.Reported = std::move(next);
+    return true;
+}
+
+static int s_ShadowTransactionConflictRetry(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingShadowClient>();
+        ShadowTransaction transaction(client, "thing", {}, 3, allocator);
+
+        Aws::Crt::Vector<int32_t> versions;
+        auto handler = [&versions](UpdateShadowResult &&result)
+        {
+            versions.push_back(
+                result.IsSuccess() ? *result.GetResponse().Version : *result.GetError().GetModeledError().Code);
+        };
+
+        /* Nothing is cached yet, so the first commit fetches the shadow */
+        ASSERT_TRUE(transaction.Commit(s_incrementCount, handler));
+        ASSERT_INT_EQUALS(1, client->getHandlers.size());
+        client->AnswerGet(0, "{\"state\":{\"reported\":{\"count\":1}},\"version\":5}");
+        ASSERT_INT_EQUALS(1, client->GetUpdateCount());
+        ASSERT_INT_EQUALS(5, *client->updates[0].version);
+        ASSERT_TRUE(client->GetReported(0) == "{\"count\":2}");
+
+        /* Another writer got there first: fetch again and re-run the mutator on the fresh document */
+        client->RejectUpdate(0, SHADOW_VERSION_CONFLICT_CODE);
+        ASSERT_INT_EQUALS(2, client->getHandlers.size());
+        client->AnswerGet(1, "{\"state\":{\"reported\":{\"count\":4}},\"version\":7}");
+        ASSERT_INT_EQUALS(2, client->GetUpdateCount());
+        ASSERT_INT_EQUALS(7, *client->updates[1].version);
+        ASSERT_TRUE(client->GetReported(1) == "{\"count\":5}");
+
+        client->AcceptUpdate(1, 8);
+        ASSERT_INT_EQUALS(1, versions.size());
+        ASSERT_INT_EQUALS(8, versions[0]);
+        ASSERT_INT_EQUALS(8, *transaction.GetCachedVersion());
+
+        /* The post-update document is derived locally, so the next commit needs no fetch */
+        ASSERT_TRUE(transaction.Commit(s_incrementCount, handler));
+        ASSERT_INT_EQUALS(2, client->getHandlers.size());
+        ASSERT_INT_EQUALS(3, client->GetUpdateCount());
+        ASSERT_INT_EQUALS(8, *client->updates[2].version);
+        ASSERT_TRUE(client->GetReported(2) == "{\"count\":6}");
+
+        /* Conflicts past the last attempt are reported to the caller */
+        client->RejectUpdate(2, SHADOW_VERSION_CONFLICT_CODE);
+        client->AnswerGet(2, "{\"state\":{\"reported\":{\"count\":9}},\"version\":10}");
+        client->RejectUpdate(3, SHADOW_VERSION_CONFLICT_CODE);
+        client->AnswerGet(3, "{\"state\":{\"reported\":{\"count\":9}},\"version\":11}");
+        client->RejectUpdate(4, SHADOW_VERSION_CONFLICT_CODE);
+        ASSERT_INT_EQUALS(4, client->getHandlers.size());
+        ASSERT_INT_EQUALS(2, versions.size());
+        ASSERT_INT_EQUALS(SHADOW_VERSION_CONFLICT_CODE, versions[1]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowTransactionConflictRetry, s_ShadowTransactionConflictRetry)
+
+static int s_ShadowTransactionNotFound(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingShadowClient>();
+        ShadowTransaction transaction(client, "thing", {}, 3, allocator);
+
+        int completed = 0;
+        auto handler = [&completed](UpdateShadowResult &&result)
+        {
+            if (result.IsSuccess())
+            {
+                ++completed;
+            }
+        };
+
+        /* Commits needing the shadow while it is being fetched share the fetch */
+        ASSERT_TRUE(transaction.Commit(s_incrementCount, handler));
+        ASSERT_TRUE(transaction.Commit(s_incrementCount, handler));
+        ASSERT_INT_EQUALS(1, client->getHandlers.size());
+
+        /* A missing shadow is an empty document without a version */
+        client->AnswerGet(0, nullptr, 404);
+        ASSERT_INT_EQUALS(2, client->GetUpdateCount());
+        ASSERT_FALSE(client->updates[0].version.has_value());
+        ASSERT_TRUE(client->GetReported(0) == "{\"count\":1}");
+
+        client->AcceptUpdate(0, 1);
+        ASSERT_INT_EQUALS(1, *transaction.GetCachedVersion());
+
+        /* The second commit raced the first; the cached document is newer, so it retries without a fetch */
+        client->RejectUpdate(1, SHADOW_VERSION_CONFLICT_CODE);
+        ASSERT_INT_EQUALS(1, client->getHandlers.size());
+        ASSERT_INT_EQUALS(3, client->GetUpdateCount());
+        ASSERT_INT_EQUALS(1, *client->updates[2].version);
+        ASSERT_TRUE(client->GetReported(2) == "{\"count\":2}");
+
+        client->AcceptUpdate(2, 2);
+        ASSERT_INT_EQUALS(2, completed);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowTransactionNotFound, s_ShadowTransactionNotFound)
@@ -0,0 +1,206 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/crt/Api.h>
+#include <aws/crt/JsonObject.h>
+#include <aws/crt/Types.h>
+#include <aws/crt/io/EventLoopGroup.h>
+#include <aws/testing/aws_test_harness.h>
+
+#include <aws/iotshadow/ShadowUpdateCoalescer.h>
+
+#include "RecordingShadowClient.h"
+
+using namespace Aws::Iotshadow;
+
+static void s_updateReported(
+    ShadowUpdateCoalescer &coalescer,
+    const Aws::Crt::Optional<Aws::Crt::String> &shadowName,
+    const char *reported,
+    Aws::Crt::Vector<int32_t> &versions)
+{
+    Aws::Crt::JsonObject update{Aws::Crt::String(reported)};
+    coalescer.UpdateReported(
+        "thing",
+        shadowName,
+        update.View(),
+        [&versions](UpdateShadowResult &&result)
+        { versions.push_back(result.IsSuccess() ? *result.GetResponse().Version : -1); });
+}
+
+static int s_ShadowUpdateCoalescerSingleInFlight(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingShadowClient>();
+        ShadowUpdateCoalescer coalescer(client, ShadowUpdateCoalescerOptions(), allocator);
+        ASSERT_TRUE(coalescer);
+
+        /* Without a window the first update goes out right away and the next ones wait for it */
+        Aws::Crt::Vector<int32_t> versions;
+        s_updateReported(coalescer, {}, "{\"a\":1}", versions);
+        s_updateReported(coalescer, {}, "{\"b\":{\"x\":1}}", versions);
+        s_updateReported(coalescer, {}, "{\"a\":2,\"b\":{\"y\":null}}", versions);
+        ASSERT_INT_EQUALS(1, client->GetUpdateCount());
+        ASSERT_TRUE(client->GetReported(0) == "{\"a\":1}");
+
+        /* Other shadows are not held back */
+        Aws::Crt::Vector<int32_t> namedVersions;
+        s_updateReported(coalescer, Aws::Crt::String("named"), "{\"a\":1}", namedVersions);
+        ASSERT_INT_EQUALS(2, client->GetUpdateCount());
+        ASSERT_TRUE(*client->updates[1].shadowName == "named");
+        client->AcceptUpdate(1, 7);
+        ASSERT_INT_EQUALS(1, namedVersions.size());
+        ASSERT_INT_EQUALS(7, namedVersions[0]);
+
+        /* Completing the in-flight update sends the merged ones, deletions included */
+        client->AcceptUpdate(0, 1);
+        ASSERT_INT_EQUALS(1, versions.size());
+        ASSERT_INT_EQUALS(3, client->GetUpdateCount());
+        Aws::Crt::JsonObject merged(client->GetReported(2));
+        ASSERT_INT_EQUALS(2, merged.View().GetInteger("a"));
+        ASSERT_INT_EQUALS(1, merged.View().GetJsonObject("b").GetInteger("x"));
+        ASSERT_TRUE(merged.View().GetJsonObject("b").KeyExists("y"));
+        ASSERT_TRUE(merged.View().GetJsonObject("b").GetJsonObject("y").IsNull());
+
+        client->AcceptUpdate(2, 2);
+        ASSERT_INT_EQUALS(3, versions.size());
+        ASSERT_INT_EQUALS(1, versions[0]);
+        ASSERT_INT_EQUALS(2, versions[1]);
+        ASSERT_INT_EQUALS(2, versions[2]);
+        ASSERT_INT_EQUALS(3, client->GetUpdateCount());
+
+        /* A failed update fails every handler merged into it */
+        versions.clear();
+        s_updateReported(coalescer, {}, "{\"a\":3}", versions);
+        s_updateReported(coalescer, {}, "{\"a\":4}", versions);
+        s_updateReported(coalescer, {}, "{\"a\":5}", versions);
+        client->RejectUpdate(3, 400);
+        client->RejectUpdate(4, 400);
+        ASSERT_INT_EQUALS(3, versions.size());
+        ASSERT_INT_EQUALS(-1, versions[2]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowUpdateCoalescerSingleInFlight, s_ShadowUpdateCoalescerSingleInFlight)
+
+static int s_ShadowUpdateCoalescerUnmergeable(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+
+        auto client = std::make_shared<RecordingShadowClient>();
+        ShadowUpdateCoalescer coalescer(client, ShadowUpdateCoalescerOptions(), allocator);
+
+        Aws::Crt::Vector<int32_t> versions;
+        s_updateReported(coalescer, {}, "{\"k\":{\"z\":1}}", versions);
+
+        /* Sent as one update, the object would be merged into the deleted value instead of replacing it */
+        s_updateReported(coalescer, {}, "{\"k\":null}", versions);
+        s_updateReported(coalescer, {}, "{\"k\":{\"x\":1}}", versions);
+        s_updateReported(coalescer, {}, "{\"k\":{\"y\":1}}", versions);
+        ASSERT_INT_EQUALS(1, client->GetUpdateCount());
+
+        client->AcceptUpdate(0, 1);
+        ASSERT_INT_EQUALS(2, client->GetUpdateCount());
+        ASSERT_TRUE(client->GetReported(1) == "{\"k\":null}");
+
+        client->AcceptUpdate(1, 2);
+        ASSERT_INT_EQUALS(3, client->GetUpdateCount());
+        Aws::Crt::JsonObject merged(client->GetReported(2));
+        ASSERT_INT_EQUALS(1, merged.View().GetJsonObject("k").GetInteger("x"));
+        ASSERT_INT_EQUALS(1, merged.View().GetJsonObject("k").GetInteger("y"));
+
+        client->AcceptUpdate(2, 3);
+        ASSERT_INT_EQUALS(4, versions.size());
+        ASSERT_INT_EQUALS(1, versions[0]);
+        ASSERT_INT_EQUALS(2, versions[1]);
+        ASSERT_INT_EQUALS(3, versions[2]);
+        ASSERT_INT_EQUALS(3, versions[3]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowUpdateCoalescerUnmergeable, s_ShadowUpdateCoalescerUnmergeable)
+
+static int s_ShadowUpdateCoalescerWindowAndBudget(Aws::Crt::Allocator *allocator, void *)
+{
+    {
+        Aws::Crt::ApiHandle handle;
+        Aws::Crt::Io::EventLoopGroup eventLoopGroup(1, allocator);
+        ASSERT_TRUE(eventLoopGroup);
+
+        /* A window requires an event loop group to time it */
+        ShadowUpdateCoalescer unscheduled(
+            std::make_shared<RecordingShadowClient>(),
+            ShadowUpdateCoalescerOptions().WithCoalescingWindow(std::chrono::milliseconds(10)),
+            allocator);
+        ASSERT_FALSE(unscheduled);
+
+        Aws::Crt::Vector<int32_t> versions;
+
+        /* Updates within the window are merged and sent once it elapses */
+        auto windowClient = std::make_shared<RecordingShadowClient>();
+        {
+            ShadowUpdateCoalescer coalescer(
+                windowClient,
+                ShadowUpdateCoalescerOptions()
+                    .WithCoalescingWindow(std::chrono::milliseconds(200))
+                    .WithEventLoopGroup(eventLoopGroup),
+                allocator);
+            ASSERT_TRUE(coalescer);
+
+            s_updateReported(coalescer, {}, "{\"a\":1}", versions);
+            s_updateReported(coalescer, {}, "{\"a\":2,\"b\":1}", versions);
+            ASSERT_INT_EQUALS(0, windowClient->GetUpdateCount());
+
+            ASSERT_TRUE(windowClient->WaitForUpdates(1));
+            ASSERT_TRUE(windowClient->GetReported(0) == "{\"a\":2,\"b\":1}");
+            windowClient->AcceptUpdate(0, 1);
+            ASSERT_INT_EQUALS(2, versions.size());
+        }
+
+        /* Reaching the byte budget sends the pending updates without waiting for the window */
+        auto budgetClient = std::make_shared<RecordingShadowClient>();
+        {
+            ShadowUpdateCoalescer coalescer(
+                budgetClient,
+                ShadowUpdateCoalescerOptions()
+                    .WithCoalescingWindow(std::chrono::hours(1))
+                    .WithMaxPendingBytes(24)
+                    .WithEventLoopGroup(eventLoopGroup),
+                allocator);
+
+            s_updateReported(coalescer, {}, "{\"a\":1}", versions);
+            s_updateReported(coalescer, {}, "{\"b\":2}", versions);
+            ASSERT_INT_EQUALS(0, budgetClient->GetUpdateCount());
+
+            s_updateReported(coalescer, {}, "{\"c\":\"0123456789\"}", versions);
+            ASSERT_INT_EQUALS(1, budgetClient->GetUpdateCount());
+            Aws::Crt::JsonObject merged(budgetClient->GetReported(0));
+            ASSERT_INT_EQUALS(1, merged.View().GetInteger("a"));
+            ASSERT_INT_EQUALS(2, merged.View().GetInteger("b"));
+            ASSERT_TRUE(merged.View().GetString("c") == "0123456789");
+            budgetClient->AcceptUpdate(0, 1);
+
+            /* Flush does not wait for the window either */
+            s_updateReported(coalescer, {}, "{\"d\":1}", versions);
+            ASSERT_INT_EQUALS(1, budgetClient->GetUpdateCount());
+            coalescer.Flush();
+            ASSERT_INT_EQUALS(2, budgetClient->GetUpdateCount());
+            ASSERT_TRUE(budgetClient->GetReported(1) == "{\"d\":1}");
+            budgetClient->AcceptUpdate(1, 2);
+            ASSERT_INT_EQUALS(6, versions.size());
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ShadowUpdateCoalescerWindowAndBudget, s_ShadowUpdateCoalescerWindowAndBudget)